@@ -0,0 +1,56 @@
+//================================================================================================
+/// @file benchmark_helpers.hpp
+///
+/// @brief Small helpers shared by the benchmarks, to time a piece of code and print the results.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#ifndef BENCHMARK_HELPERS_HPP
+#define BENCHMARK_HELPERS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace benchmark_helpers
+{
+	/// @brief Runs a function a number of times and measures how long that took
+	/// @param[in] iterations The number of times to run the function
+	/// @param[in] function The function to run, which gets the iteration index
+	/// @returns The average time per iteration in nanoseconds
+	template<typename Function>
+	double measure_nanoseconds_per_iteration(std::uint64_t iterations, Function &&function)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (std::uint64_t i = 0; i < iterations; i++)
+		{
+			function(i);
+		}
+		const auto end = std::chrono::steady_clock::now();
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / static_cast<double>(iterations);
+	}
+
+	/// @brief Prints a single result as an aligned line
+	/// @param[in] name What was measured
+	/// @param[in] value The measured value
+	/// @param[in] unit The unit of the value
+	inline void print_result(const std::string &name, double value, const std::string &unit)
+	{
+		std::cout << std::left << std::setw(48) << name << std::right << std::setw(14) << std::fixed << std::setprecision(1) << value << " " << unit << std::endl;
+	}
+
+	/// @brief Stores a value where the compiler can't prove it's unused, so the work to compute it isn't optimized away
+	/// @param[in] value The value to keep
+	template<typename T>
+	void keep(const T &value)
+	{
+		static volatile T sink;
+		sink = value;
+		(void)sink;
+	}
+} // namespace benchmark_helpers
+
+#endif // BENCHMARK_HELPERS_HPP
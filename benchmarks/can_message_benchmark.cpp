@@ -0,0 +1,74 @@
+//================================================================================================
+/// @file can_message_benchmark.cpp
+///
+/// @brief Measures the cost of constructing, copying, moving and dispatching CAN messages.
+/// @details Each operation is timed for a single frame payload, which is stored inline, and for a
+/// payload that is too large for that, which is stored on the heap like every payload was before.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_message.hpp"
+
+#include "benchmark_helpers.hpp"
+
+#include <array>
+#include <functional>
+#include <utility>
+
+using namespace isobus;
+
+static constexpr std::uint64_t ITERATIONS = 5000000; ///< The number of times each operation is timed
+
+/// @brief Times all operations for one payload length
+/// @param[in] payloadLength The number of bytes in the payload
+static void run(std::uint32_t payloadLength)
+{
+	std::array<std::uint8_t, 64> payload = {};
+	for (std::size_t i = 0; i < payload.size(); i++)
+	{
+		payload[i] = static_cast<std::uint8_t>(i);
+	}
+	const CANIdentifier identifier(0x18FF1046);
+	const std::string suffix = " (" + std::to_string(payloadLength) + " bytes)";
+	std::uint64_t checksum = 0;
+
+	double nanoseconds = benchmark_helpers::measure_nanoseconds_per_iteration(ITERATIONS, [&](std::uint64_t) {
+		CANMessage message(CANMessage::Type::Receive, identifier, payload.data(), payloadLength, nullptr, nullptr, 0);
+		checksum += message.get_data_length();
+	});
+	benchmark_helpers::print_result("construct" + suffix, nanoseconds, "ns");
+
+	const CANMessage original(CANMessage::Type::Receive, identifier, payload.data(), payloadLength, nullptr, nullptr, 0);
+	nanoseconds = benchmark_helpers::measure_nanoseconds_per_iteration(ITERATIONS, [&](std::uint64_t) {
+		CANMessage copy(original);
+		checksum += copy.get_data_length();
+	});
+	benchmark_helpers::print_result("copy" + suffix, nanoseconds, "ns");
+
+	CANMessage moved(original);
+	nanoseconds = benchmark_helpers::measure_nanoseconds_per_iteration(ITERATIONS, [&](std::uint64_t) {
+		CANMessage other(std::move(moved));
+		moved = std::move(other);
+		checksum += moved.get_data_length();
+	});
+	benchmark_helpers::print_result("move there and back" + suffix, nanoseconds, "ns");
+
+	// Dispatching creates a message from a received frame and hands it to a callback, like the network manager does
+	std::function<void(const CANMessage &)> callback = [&checksum](const CANMessage &message) {
+		checksum += message.get_uint16_at(0);
+	};
+	nanoseconds = benchmark_helpers::measure_nanoseconds_per_iteration(ITERATIONS, [&](std::uint64_t) {
+		callback(CANMessage(CANMessage::Type::Receive, identifier, payload.data(), payloadLength, nullptr, nullptr, 0));
+	});
+	benchmark_helpers::print_result("dispatch" + suffix, nanoseconds, "ns");
+
+	benchmark_helpers::keep(checksum);
+}
+
+int main()
+{
+	run(CAN_DATA_LENGTH);
+	run(64);
+	return 0;
+}
@@ -0,0 +1,88 @@
+//================================================================================================
+/// @file event_dispatcher_benchmark.cpp
+///
+/// @brief Measures the cost of invoking an event dispatcher with 1, 4 and 16 listeners.
+/// @details Each listener count is measured twice: once on its own, and once while a second thread keeps
+/// adding and removing a listener, which makes the dispatcher publish a new snapshot all the time.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/utility/event_dispatcher.hpp"
+
+#include "benchmark_helpers.hpp"
+
+#include <atomic>
+#include <string>
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+#include <thread>
+#endif
+
+using namespace isobus;
+
+static constexpr std::uint64_t ITERATIONS = 2000000; ///< The number of calls that are timed per run
+
+/// @brief Times calls of a dispatcher with a number of listeners
+/// @param[in] numberOfListeners The number of listeners to register
+/// @param[in] withChanges true to keep changing the listeners from another thread during the calls
+static void run(std::size_t numberOfListeners, bool withChanges)
+{
+	EventDispatcher<CANMessageFrame> dispatcher;
+	std::uint64_t checksum = 0;
+	for (std::size_t i = 0; i < numberOfListeners; i++)
+	{
+		dispatcher.add_listener([&checksum](const CANMessageFrame &frame) {
+			checksum += frame.identifier;
+		});
+	}
+
+	std::atomic_bool stop = { false };
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+	std::thread changer;
+	if (withChanges)
+	{
+		changer = std::thread([&dispatcher, &stop]() {
+			while (!stop)
+			{
+				dispatcher.remove_listener(dispatcher.add_listener([](const CANMessageFrame &) {}));
+				std::this_thread::yield(); // The caller might share our core
+			}
+		});
+	}
+#else
+	(void)withChanges;
+#endif
+
+	CANMessageFrame frame = {};
+	const double nanoseconds = benchmark_helpers::measure_nanoseconds_per_iteration(ITERATIONS, [&dispatcher, &frame](std::uint64_t i) {
+		frame.identifier = static_cast<std::uint32_t>(i);
+		dispatcher.call(frame);
+	});
+
+	stop = true;
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+	if (changer.joinable())
+	{
+		changer.join();
+	}
+#endif
+	benchmark_helpers::keep(checksum);
+	benchmark_helpers::print_result(std::to_string(numberOfListeners) + " listener(s)" + (withChanges ? ", changing" : ""), nanoseconds, "ns/call");
+}
+
+int main()
+{
+	for (std::size_t numberOfListeners : { 1, 4, 16 })
+	{
+		run(numberOfListeners, false);
+	}
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+	for (std::size_t numberOfListeners : { 1, 4, 16 })
+	{
+		run(numberOfListeners, true);
+	}
+#endif
+	return 0;
+}
@@ -0,0 +1,132 @@
+//================================================================================================
+/// @file extended_transport_protocol_window_benchmark.cpp
+///
+/// @brief Measures how long a large destination specific upload takes for different ETP window sizes.
+/// @details Two internal control functions on two channels of the virtual CAN plugin send a
+/// 300 kB message to each other, like a VT object pool upload. The window granted in each CTS is
+/// set with `CANNetworkConfiguration::set_number_of_packets_per_dpo_message`, and the time from
+/// sending the message until the transmit complete callback is printed for each window size.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/hardware_integration/available_can_drivers.hpp"
+#include "isobus/hardware_integration/can_hardware_interface.hpp"
+#include "isobus/isobus/can_network_manager.hpp"
+#include "isobus/isobus/can_partnered_control_function.hpp"
+
+#include "benchmark_helpers.hpp"
+
+#include <atomic>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#ifdef ISOBUS_VIRTUALCAN_AVAILABLE
+using namespace isobus;
+
+static constexpr std::uint32_t PARAMETER_GROUP_NUMBER = 0xE700; ///< The PGN to upload with, the one a VT client uses
+static constexpr std::uint32_t MESSAGE_LENGTH = 300000; ///< The size of the upload, a large object pool
+static std::atomic_bool transferDone = { false }; ///< Set when the upload has finished
+static std::atomic_bool transferSuccessful = { false }; ///< Set when the upload has finished successfully
+
+/// @brief Called by the stack when the upload has finished
+static void transmit_complete(std::uint32_t, std::uint32_t, std::shared_ptr<InternalControlFunction>, std::shared_ptr<ControlFunction>, bool successful, void *)
+{
+	transferSuccessful = successful;
+	transferDone = true;
+}
+
+/// @brief Creates a NAME for one of the control functions
+/// @param[in] function The function code of the control function
+/// @param[in] identityNumber The identity number of the control function
+/// @returns The NAME
+static NAME create_name(NAME::Function function, std::uint32_t identityNumber)
+{
+	NAME name(0);
+	name.set_arbitrary_address_capable(true);
+	name.set_industry_group(1);
+	name.set_function_code(static_cast<std::uint8_t>(function));
+	name.set_identity_number(identityNumber);
+	name.set_manufacturer_code(1407);
+	return name;
+}
+
+int main()
+{
+	std::shared_ptr<CANHardwarePlugin> senderDriver = std::make_shared<VirtualCANPlugin>("benchmark-channel");
+	std::shared_ptr<CANHardwarePlugin> receiverDriver = std::make_shared<VirtualCANPlugin>("benchmark-channel");
+
+	CANHardwareInterface::set_number_of_can_channels(2);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, senderDriver);
+	CANHardwareInterface::assign_can_channel_frame_handler(1, receiverDriver);
+
+	if ((!CANHardwareInterface::start()) || (!senderDriver->get_is_valid()) || (!receiverDriver->get_is_valid()))
+	{
+		std::cout << "Failed to start hardware interface. The CAN driver might be invalid." << std::endl;
+		return -2;
+	}
+
+	auto senderECU = CANNetworkManager::CANNetwork.create_internal_control_function(create_name(NAME::Function::SteeringControl, 2), 0, 0x1C);
+	auto receiverECU = CANNetworkManager::CANNetwork.create_internal_control_function(create_name(NAME::Function::VirtualTerminal, 1), 1, 0x26);
+	auto receiverPartner = CANNetworkManager::CANNetwork.create_partnered_control_function(0, { NAMEFilter(NAME::NAMEParameters::FunctionCode, static_cast<std::uint8_t>(NAME::Function::VirtualTerminal)) });
+
+	auto addressClaimedFuture = std::async(std::launch::async, [&senderECU, &receiverECU, &receiverPartner]() {
+		while ((!senderECU->get_address_valid()) || (!receiverECU->get_address_valid()) || (!receiverPartner->get_address_valid()))
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+	});
+	if (addressClaimedFuture.wait_for(std::chrono::seconds(5)) == std::future_status::timeout)
+	{
+		std::cout << "Address claiming failed." << std::endl;
+		CANHardwareInterface::stop();
+		return -3;
+	}
+
+	std::vector<std::uint8_t> upload(MESSAGE_LENGTH);
+	for (std::uint32_t i = 0; i < MESSAGE_LENGTH; i++)
+	{
+		upload[i] = static_cast<std::uint8_t>(i);
+	}
+
+	for (std::uint8_t windowSize : { 16, 64, 128, 255 })
+	{
+		// Both control functions share the network manager, so this sets the window the receiver grants
+		CANNetworkManager::CANNetwork.get_configuration().set_number_of_packets_per_dpo_message(windowSize);
+		transferDone = false;
+
+		const auto start = std::chrono::steady_clock::now();
+		if (!CANNetworkManager::CANNetwork.send_can_message(PARAMETER_GROUP_NUMBER, upload.data(), MESSAGE_LENGTH, senderECU, receiverPartner, CANIdentifier::CANPriority::PriorityLowest7, transmit_complete))
+		{
+			std::cout << "Failed to start the upload." << std::endl;
+			break;
+		}
+		while ((!transferDone) && (std::chrono::steady_clock::now() - start < std::chrono::seconds(60)))
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		const std::string name = "window of " + std::to_string(windowSize) + " packets";
+		if (transferDone && transferSuccessful)
+		{
+			benchmark_helpers::print_result(name, milliseconds, "ms");
+		}
+		else
+		{
+			std::cout << name << ": upload failed" << std::endl;
+		}
+	}
+
+	CANHardwareInterface::stop();
+	return 0;
+}
+#else
+int main()
+{
+	std::cout << "This benchmark requires the VirtualCAN plugin to be available. If using CMake, set the `-DCAN_DRIVER=VirtualCAN`." << std::endl;
+	return -1;
+}
+#endif
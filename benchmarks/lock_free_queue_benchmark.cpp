@@ -0,0 +1,149 @@
+//================================================================================================
+/// @file lock_free_queue_benchmark.cpp
+///
+/// @brief Measures the throughput of the lock free queue between a producer and a consumer thread.
+/// @details The same number of CAN frames is passed through the queue with each way of pushing and
+/// popping: one at a time with peek and pop, one at a time with try_pop, and in bulk with push_n and pop_n.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include "benchmark_helpers.hpp"
+
+#include <array>
+#include <iostream>
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+#include <thread>
+
+using namespace isobus;
+
+static constexpr std::uint64_t NUMBER_OF_FRAMES = 20000000; ///< The number of frames to pass through the queue per run
+static constexpr std::size_t QUEUE_CAPACITY = 1024; ///< The capacity of the queue, like the hardware interface's queues
+static constexpr std::size_t BULK_SIZE = 32; ///< The number of frames per bulk push or pop
+
+enum class Method
+{
+	PeekAndPop,
+	TryPop,
+	Bulk
+};
+
+/// @brief Passes frames from a producer thread to a consumer thread and prints the throughput
+/// @param[in] name The name to print the result with
+/// @param[in] method How the frames are pushed and popped
+static void run(const std::string &name, Method method)
+{
+	LockFreeQueue<CANMessageFrame> queue(QUEUE_CAPACITY);
+	const auto start = std::chrono::steady_clock::now();
+
+	std::thread producer([&queue, method]() {
+		std::array<CANMessageFrame, BULK_SIZE> frames = {};
+		std::uint64_t sent = 0;
+		while (sent < NUMBER_OF_FRAMES)
+		{
+			if (Method::Bulk == method)
+			{
+				for (std::size_t i = 0; i < frames.size(); i++)
+				{
+					frames[i].identifier = static_cast<std::uint32_t>(sent + i);
+				}
+				std::size_t remaining = static_cast<std::size_t>(((NUMBER_OF_FRAMES - sent) < BULK_SIZE) ? (NUMBER_OF_FRAMES - sent) : BULK_SIZE);
+				const std::size_t pushed = queue.push_n(frames.data(), remaining);
+				if (0 == pushed)
+				{
+					std::this_thread::yield(); // The consumer might share our core
+				}
+				sent += pushed;
+			}
+			else
+			{
+				frames[0].identifier = static_cast<std::uint32_t>(sent);
+				if (queue.push(frames[0]))
+				{
+					sent++;
+				}
+				else
+				{
+					std::this_thread::yield(); // The consumer might share our core
+				}
+			}
+		}
+	});
+
+	std::array<CANMessageFrame, BULK_SIZE> frames = {};
+	std::uint64_t received = 0;
+	std::uint64_t checksum = 0;
+	while (received < NUMBER_OF_FRAMES)
+	{
+		switch (method)
+		{
+			case Method::PeekAndPop:
+			{
+				if (queue.peek(frames[0]))
+				{
+					queue.pop();
+					checksum += frames[0].identifier;
+					received++;
+				}
+				else
+				{
+					std::this_thread::yield(); // The producer might share our core
+				}
+			}
+			break;
+
+			case Method::TryPop:
+			{
+				if (queue.try_pop(frames[0]))
+				{
+					checksum += frames[0].identifier;
+					received++;
+				}
+				else
+				{
+					std::this_thread::yield(); // The producer might share our core
+				}
+			}
+			break;
+
+			case Method::Bulk:
+			{
+				const std::size_t count = queue.pop_n(frames.data(), frames.size());
+				for (std::size_t i = 0; i < count; i++)
+				{
+					checksum += frames[i].identifier;
+				}
+				received += count;
+				if (0 == count)
+				{
+					std::this_thread::yield(); // The producer might share our core
+				}
+			}
+			break;
+		}
+	}
+	producer.join();
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	benchmark_helpers::keep(checksum);
+	benchmark_helpers::print_result(name, static_cast<double>(NUMBER_OF_FRAMES) / seconds / 1000000.0, "Mframes/s");
+}
+
+int main()
+{
+	run("push + peek/pop", Method::PeekAndPop);
+	run("push + try_pop", Method::TryPop);
+	run("push_n + pop_n (32 frames)", Method::Bulk);
+	return 0;
+}
+#else
+int main()
+{
+	std::cout << "This benchmark needs a producer and a consumer thread, so it requires a build with threads." << std::endl;
+	return -1;
+}
+#endif
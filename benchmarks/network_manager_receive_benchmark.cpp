@@ -0,0 +1,90 @@
+//================================================================================================
+/// @file network_manager_receive_benchmark.cpp
+///
+/// @brief Measures how many received frames per second the network manager can process.
+/// @details 30 ECUs claim an address on the bus, then frames from all of them are fed to
+/// `CANNetworkManager::process_receive_can_message_frame`. The network manager is updated after every
+/// batch of frames, which looks up the source control function of each frame and dispatches it to a
+/// global callback, just like when the frames come from a CAN driver.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_network_manager.hpp"
+
+#include "benchmark_helpers.hpp"
+
+#include <iostream>
+#include <vector>
+
+using namespace isobus;
+
+static constexpr std::uint8_t NUMBER_OF_ECUS = 30; ///< The number of ECUs active on the bus
+static constexpr std::uint32_t BROADCAST_PGN = 0xFEF1; ///< The PGN the ECUs broadcast, wheel-based speed and distance
+static constexpr std::uint32_t FRAMES_PER_UPDATE = 32; ///< The number of frames received between network manager updates
+static constexpr std::uint64_t NUMBER_OF_FRAMES = 3000000; ///< The number of frames to process
+
+/// @brief Creates a frame on the first channel
+/// @param[in] identifier The CAN identifier of the frame
+/// @param[in] data The 8 bytes of the frame, least significant byte first
+/// @returns The frame
+static CANMessageFrame create_frame(std::uint32_t identifier, std::uint64_t data)
+{
+	CANMessageFrame frame = {};
+	frame.identifier = identifier;
+	frame.isExtendedFrame = true;
+	frame.dataLength = CAN_DATA_LENGTH;
+	for (std::uint8_t i = 0; i < CAN_DATA_LENGTH; i++)
+	{
+		frame.data[i] = static_cast<std::uint8_t>(data >> (8 * i));
+	}
+	return frame;
+}
+
+/// @brief Counts the messages that made it through the network manager with a known source
+static void count_message(const CANMessage &message, void *parent)
+{
+	if (nullptr != message.get_source_control_function())
+	{
+		(*static_cast<std::uint64_t *>(parent))++;
+	}
+}
+
+int main()
+{
+	CANNetworkManager::CANNetwork.update();
+
+	// Let the ECUs claim their addresses, so the network manager knows them as control functions
+	std::vector<CANMessageFrame> frames;
+	for (std::uint8_t i = 0; i < NUMBER_OF_ECUS; i++)
+	{
+		NAME name(0);
+		name.set_arbitrary_address_capable(true);
+		name.set_industry_group(2);
+		name.set_function_code(static_cast<std::uint8_t>(NAME::Function::EngineController));
+		name.set_identity_number(100u + i);
+		name.set_manufacturer_code(1407);
+
+		const std::uint8_t address = static_cast<std::uint8_t>(0x80 + i);
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(create_frame(0x18EEFF00 | address, name.get_full_name()));
+		frames.push_back(create_frame(0x18000000 | (BROADCAST_PGN << 8) | address, i));
+	}
+	CANNetworkManager::CANNetwork.update();
+	std::cout << "Control functions on the bus: " << CANNetworkManager::CANNetwork.get_control_functions(false).size() << std::endl;
+
+	std::uint64_t numberOfMessages = 0;
+	CANNetworkManager::CANNetwork.add_global_parameter_group_number_callback(BROADCAST_PGN, count_message, &numberOfMessages);
+
+	const double nanoseconds = benchmark_helpers::measure_nanoseconds_per_iteration(NUMBER_OF_FRAMES / FRAMES_PER_UPDATE, [&frames](std::uint64_t batch) {
+		for (std::uint32_t i = 0; i < FRAMES_PER_UPDATE; i++)
+		{
+			CANNetworkManager::CANNetwork.process_receive_can_message_frame(frames[((batch * FRAMES_PER_UPDATE) + i) % frames.size()]);
+		}
+		CANNetworkManager::CANNetwork.update();
+	});
+
+	CANNetworkManager::CANNetwork.remove_global_parameter_group_number_callback(BROADCAST_PGN, count_message, &numberOfMessages);
+	benchmark_helpers::print_result("dispatched with a known source", static_cast<double>(numberOfMessages), "messages");
+	benchmark_helpers::print_result("receive and dispatch", 1000000000.0 * FRAMES_PER_UPDATE / nanoseconds, "frames/s");
+	return 0;
+}
@@ -0,0 +1,77 @@
+//================================================================================================
+/// @file object_pool_parse_benchmark.cpp
+///
+/// @brief Measures how long it takes a VT working set to parse the seeder example object pool.
+/// @details The pool is parsed with 1, 2, 4 and 8 parsing threads, and with the number of threads
+/// chosen automatically. Each parse uses a new working set, and only the parse itself is timed.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/isobus_virtual_terminal_working_set_base.hpp"
+#include "isobus/utility/iop_file_interface.hpp"
+
+#include "benchmark_helpers.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace isobus;
+
+static constexpr std::uint32_t ITERATIONS = 50; ///< The number of parses that are timed per thread count
+
+/// @brief Times parsing a pool with a number of threads
+/// @param[in] pool The object pool to parse
+/// @param[in] numberOfThreads The number of parsing threads to request, or 0 to choose automatically
+/// @returns true if every parse succeeded, otherwise false
+static bool run(std::vector<std::uint8_t> &pool, std::size_t numberOfThreads)
+{
+	std::chrono::steady_clock::duration total = std::chrono::steady_clock::duration::zero();
+	std::size_t threadsUsed = 0;
+
+	for (std::uint32_t i = 0; i < ITERATIONS; i++)
+	{
+		VirtualTerminalWorkingSetBase workingSet;
+		workingSet.set_object_pool_parsing_threads(numberOfThreads);
+
+		const auto start = std::chrono::steady_clock::now();
+		const bool success = workingSet.parse_iop_into_objects(pool.data(), static_cast<std::uint32_t>(pool.size()));
+		total += std::chrono::steady_clock::now() - start;
+
+		if (!success)
+		{
+			return false;
+		}
+		threadsUsed = workingSet.get_last_object_pool_parsing_threads();
+		benchmark_helpers::keep(workingSet.get_object_tree().size());
+	}
+
+	const double microseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(total).count()) / ITERATIONS;
+	const std::string requested = (0 == numberOfThreads) ? "auto" : std::to_string(numberOfThreads);
+	benchmark_helpers::print_result("parse, " + requested + " requested, " + std::to_string(threadsUsed) + " used", microseconds, "us/pool");
+	return true;
+}
+
+int main()
+{
+	std::vector<std::uint8_t> pool = IOPFileInterface::read_iop_file("BasePool.iop");
+
+	if (pool.empty())
+	{
+		std::cout << "Failed to load BasePool.iop, run the benchmark from its build directory" << std::endl;
+		return -1;
+	}
+	std::cout << "Pool size: " << pool.size() << " bytes" << std::endl;
+
+	const std::size_t threadCounts[] = { 1, 2, 4, 8, 0 };
+	for (std::size_t numberOfThreads : threadCounts)
+	{
+		if (!run(pool, numberOfThreads))
+		{
+			std::cout << "Failed to parse the pool" << std::endl;
+			return -1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,115 @@
+//================================================================================================
+/// @file socket_can_receive_benchmark.cpp
+///
+/// @brief Compares receiving frames one by one with receiving them in batches on a SocketCAN device.
+/// @details A second socket on the same device writes bursts of frames, which are then read back
+/// with `read_frame` and with `read_frames`. Both do one `poll` and one receive call per call, so the
+/// number of system calls per frame follows from the number of calls that were needed.
+/// Run it on a virtual CAN device:
+/// @code
+/// sudo ip link add dev vcan0 type vcan && sudo ip link set up vcan0
+/// ./SocketCANReceiveBenchmark vcan0
+/// @endcode
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/hardware_integration/available_can_drivers.hpp"
+
+#include "benchmark_helpers.hpp"
+
+#include <array>
+#include <iostream>
+#include <string>
+
+#ifdef ISOBUS_SOCKETCAN_AVAILABLE
+#include "isobus/hardware_integration/socket_can_interface.hpp"
+
+using namespace isobus;
+
+static constexpr std::size_t FRAMES_PER_BURST = 64; ///< Small enough to fit in the default socket receive buffer
+static constexpr std::size_t NUMBER_OF_BURSTS = 2000; ///< The number of bursts to time per receive method
+
+/// @brief Writes a burst of frames, then reads them back and counts how many calls that took
+/// @param[in] sender The socket to write the frames with
+/// @param[in] receiver The socket to read the frames with
+/// @param[in] batched true to read with `read_frames`, false to read with `read_frame`
+static void run(SocketCANInterface &sender, SocketCANInterface &receiver, bool batched)
+{
+	std::array<CANMessageFrame, FRAMES_PER_BURST> burst = {};
+	for (std::size_t i = 0; i < burst.size(); i++)
+	{
+		burst[i].identifier = 0x18FF0000 | static_cast<std::uint32_t>(i);
+		burst[i].isExtendedFrame = true;
+		burst[i].dataLength = 8;
+	}
+
+	std::array<CANMessageFrame, SocketCANInterface::MAX_RECEIVE_BATCH_SIZE> receivedFrames = {};
+	std::uint64_t numberOfFrames = 0;
+	std::uint64_t numberOfCalls = 0;
+	std::chrono::steady_clock::duration timeSpentReading(0);
+
+	for (std::size_t i = 0; i < NUMBER_OF_BURSTS; i++)
+	{
+		for (const CANMessageFrame &frame : burst)
+		{
+			sender.write_frame(frame);
+		}
+
+		std::size_t framesInBurst = 0;
+		const auto start = std::chrono::steady_clock::now();
+		while (framesInBurst < burst.size())
+		{
+			std::size_t framesRead;
+			if (batched)
+			{
+				framesRead = receiver.read_frames(receivedFrames.data(), receivedFrames.size());
+			}
+			else
+			{
+				framesRead = receiver.read_frame(receivedFrames[0]) ? 1 : 0;
+			}
+			numberOfCalls++;
+
+			if (0 == framesRead)
+			{
+				break; // Timed out, some frames didn't make it
+			}
+			framesInBurst += framesRead;
+		}
+		timeSpentReading += std::chrono::steady_clock::now() - start;
+		numberOfFrames += framesInBurst;
+	}
+
+	const double seconds = std::chrono::duration<double>(timeSpentReading).count();
+	const std::string method = batched ? "read_frames" : "read_frame";
+	benchmark_helpers::print_result(method + ": received", static_cast<double>(numberOfFrames), "frames");
+	benchmark_helpers::print_result(method + ": throughput", static_cast<double>(numberOfFrames) / seconds, "frames/s");
+	benchmark_helpers::print_result(method + ": system calls", 2.0 * static_cast<double>(numberOfCalls) / static_cast<double>(numberOfFrames), "per frame");
+}
+
+int main(int argc, char **argv)
+{
+	const std::string deviceName = (argc > 1) ? argv[1] : "vcan0";
+	SocketCANInterface sender(deviceName);
+	SocketCANInterface receiver(deviceName);
+	sender.open();
+	receiver.open();
+
+	if ((!sender.get_is_valid()) || (!receiver.get_is_valid()))
+	{
+		std::cout << "Failed to open " << deviceName << ". Create it with `ip link add dev " << deviceName << " type vcan`." << std::endl;
+		return -1;
+	}
+
+	run(sender, receiver, false);
+	run(sender, receiver, true);
+	return 0;
+}
+#else
+int main()
+{
+	std::cout << "This benchmark requires the SocketCAN plugin to be available. If using CMake, set the `-DCAN_DRIVER=SocketCAN`." << std::endl;
+	return -1;
+}
+#endif
@@ -0,0 +1,123 @@
+//================================================================================================
+/// @file transport_protocol_soak_benchmark.cpp
+///
+/// @brief Keeps a transport protocol manager busy with broadcast traffic and reports how its
+/// receive buffer pool holds up.
+/// @details Several simulated ECUs keep broadcasting BAMs of different lengths, with their data
+/// packets interleaved like on a busy bus. After the run the message rate and the pool's counters
+/// are printed. With pooling, the number of allocations stays at the number of concurrent sessions
+/// no matter how long it runs. The duration in seconds can be passed as the first argument,
+/// for example 3600 for an hour long soak.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_control_function.hpp"
+#include "isobus/isobus/can_network_configuration.hpp"
+#include "isobus/isobus/can_transport_protocol.hpp"
+
+#include "benchmark_helpers.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace isobus;
+
+static constexpr std::uint8_t NUMBER_OF_ECUS = 8; ///< The number of ECUs that broadcast at the same time
+static constexpr std::uint32_t BROADCAST_PGN = 0xFEEC; ///< The PGN that is broadcast, the vehicle identification
+
+/// @brief Returns the length of an ECU's next broadcast, so that the lengths vary between rounds
+/// @param[in] round The number of the round
+/// @param[in] ecuIndex The index of the ECU
+/// @returns A message length that needs the transport protocol
+static std::uint16_t get_message_length(std::uint64_t round, std::uint8_t ecuIndex)
+{
+	return static_cast<std::uint16_t>(9 + (((round * 131) + (ecuIndex * 517)) % 1777)); // 9 to 1785 bytes
+}
+
+/// @brief Creates a broadcast message from a simulated ECU
+/// @param[in] parameterGroupNumber The PGN of the message
+/// @param[in] source The ECU that sends the message
+/// @param[in] data The 8 bytes of the message
+/// @returns The message
+static CANMessage create_message(std::uint32_t parameterGroupNumber, const std::shared_ptr<ControlFunction> &source, const std::uint8_t *data)
+{
+	CANIdentifier identifier(CANIdentifier::Type::Extended, parameterGroupNumber, CANIdentifier::CANPriority::PriorityDefault6, CANIdentifier::GLOBAL_ADDRESS, source->get_address());
+	return CANMessage(CANMessage::Type::Receive, identifier, data, CAN_DATA_LENGTH, source, nullptr, 0);
+}
+
+int main(int argc, char **argv)
+{
+	const double durationSeconds = (argc > 1) ? std::atof(argv[1]) : 10.0;
+
+	std::uint64_t numberOfMessages = 0;
+	std::uint64_t numberOfBytes = 0;
+	auto receiveMessageCallback = [&numberOfMessages, &numberOfBytes](const CANMessage &message) {
+		numberOfMessages++;
+		numberOfBytes += message.get_data_length();
+	};
+
+	CANNetworkConfiguration configuration;
+	configuration.set_max_number_transport_protocol_sessions(NUMBER_OF_ECUS);
+	TransportProtocolManager manager(nullptr, receiveMessageCallback, &configuration);
+
+	std::vector<std::shared_ptr<ControlFunction>> ecus;
+	for (std::uint8_t i = 0; i < NUMBER_OF_ECUS; i++)
+	{
+		ecus.push_back(std::make_shared<ControlFunction>(NAME(0), static_cast<std::uint8_t>(0x80 + i), 0));
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	double elapsedSeconds = 0.0;
+	std::uint64_t round = 0;
+	while (elapsedSeconds < durationSeconds)
+	{
+		std::uint16_t lengths[NUMBER_OF_ECUS];
+		std::uint16_t maxNumberOfPackets = 0;
+		for (std::uint8_t i = 0; i < NUMBER_OF_ECUS; i++)
+		{
+			lengths[i] = get_message_length(round, i);
+			const std::uint8_t numberOfPackets = static_cast<std::uint8_t>((lengths[i] + 6) / 7);
+			maxNumberOfPackets = (numberOfPackets > maxNumberOfPackets) ? numberOfPackets : maxNumberOfPackets;
+
+			const std::uint8_t announcement[CAN_DATA_LENGTH] = {
+				32, // Broadcast announce message
+				static_cast<std::uint8_t>(lengths[i] & 0xFF),
+				static_cast<std::uint8_t>(lengths[i] >> 8),
+				numberOfPackets,
+				0xFF,
+				static_cast<std::uint8_t>(BROADCAST_PGN & 0xFF),
+				static_cast<std::uint8_t>((BROADCAST_PGN >> 8) & 0xFF),
+				static_cast<std::uint8_t>((BROADCAST_PGN >> 16) & 0xFF)
+			};
+			manager.process_message(create_message(0xEC00, ecus[i], announcement));
+		}
+
+		// Interleave the data packets of all ECUs, like a bus with several transfers going on at once
+		for (std::uint16_t packet = 1; packet <= maxNumberOfPackets; packet++)
+		{
+			for (std::uint8_t i = 0; i < NUMBER_OF_ECUS; i++)
+			{
+				if (packet <= ((lengths[i] + 6) / 7))
+				{
+					const std::uint8_t dataTransfer[CAN_DATA_LENGTH] = { static_cast<std::uint8_t>(packet), 1, 2, 3, 4, 5, 6, 7 };
+					manager.process_message(create_message(0xEB00, ecus[i], dataTransfer));
+				}
+			}
+		}
+
+		round++;
+		elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	const CANMessageBufferPool &pool = manager.get_receive_buffer_pool();
+	benchmark_helpers::print_result("duration", elapsedSeconds, "s");
+	benchmark_helpers::print_result("completed messages", static_cast<double>(numberOfMessages), "messages");
+	benchmark_helpers::print_result("message rate", static_cast<double>(numberOfMessages) / elapsedSeconds, "messages/s");
+	benchmark_helpers::print_result("payload rate", static_cast<double>(numberOfBytes) / elapsedSeconds / 1000000.0, "MB/s");
+	benchmark_helpers::print_result("receive buffer allocations", static_cast<double>(pool.get_number_of_allocations()), "buffers");
+	benchmark_helpers::print_result("receive buffer reuses", static_cast<double>(pool.get_number_of_reuses()), "buffers");
+	benchmark_helpers::print_result("idle receive buffers", static_cast<double>(pool.get_number_of_idle_buffers()), "buffers");
+	return 0;
+}
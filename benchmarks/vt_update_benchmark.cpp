@@ -0,0 +1,279 @@
+//================================================================================================
+/// @file vt_update_benchmark.cpp
+///
+/// @brief Measures how many value updates per second a VT client gets through to the in-tree VT server.
+/// @details A VT client and a minimal `VirtualTerminalServer` are connected over the virtual CAN plugin,
+/// and the client uploads the version 3 example object pool. Then the two numeric objects of that pool
+/// are updated, first with a separate command per update that waits until the VT has applied it, and then
+/// in transactions, like a dashboard that refreshes its values every frame. Within a transaction, updates of the same object are coalesced into
+/// a single command.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/hardware_integration/available_can_drivers.hpp"
+#include "isobus/hardware_integration/can_hardware_interface.hpp"
+#include "isobus/isobus/can_network_manager.hpp"
+#include "isobus/isobus/can_partnered_control_function.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_client.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_server.hpp"
+#include "isobus/utility/iop_file_interface.hpp"
+
+#include "benchmark_helpers.hpp"
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+#if defined(ISOBUS_VIRTUALCAN_AVAILABLE) && !defined(CAN_STACK_DISABLE_THREADS)
+using namespace isobus;
+
+static constexpr std::uint16_t OUTPUT_NUMBER_ID = 12000; ///< The output number in the example pool
+static constexpr std::uint16_t NUMBER_VARIABLE_ID = 21000; ///< The number variable in the example pool
+static constexpr std::uint32_t NUMBER_OF_SEPARATE_UPDATES = 200; ///< The number of updates sent as separate commands
+static constexpr std::uint32_t NUMBER_OF_FRAMES = 100; ///< The number of dashboard frames sent as transactions
+static constexpr std::uint32_t UPDATES_PER_OBJECT_PER_FRAME = 10; ///< How often each value changes during one frame
+
+/// @brief A VT server that accepts any working set, without storing or drawing anything
+class BenchmarkVTServer : public VirtualTerminalServer
+{
+public:
+	/// @brief Constructor for the server
+	/// @param[in] controlFunction The internal control function the server communicates with
+	explicit BenchmarkVTServer(std::shared_ptr<InternalControlFunction> controlFunction) :
+	  VirtualTerminalServer(controlFunction)
+	{
+	}
+
+	using VirtualTerminalServer::update; // The server's owner has to update it cyclically
+
+	bool get_is_enough_memory(std::uint32_t) const override
+	{
+		return true;
+	}
+
+	VTVersion get_version() const override
+	{
+		return VTVersion::Version4;
+	}
+
+	std::uint8_t get_number_of_navigation_soft_keys() const override
+	{
+		return 0;
+	}
+
+	std::uint8_t get_soft_key_descriptor_x_pixel_width() const override
+	{
+		return 60;
+	}
+
+	std::uint8_t get_soft_key_descriptor_y_pixel_height() const override
+	{
+		return 60;
+	}
+
+	std::uint8_t get_number_of_possible_virtual_soft_keys_in_soft_key_mask() const override
+	{
+		return 6;
+	}
+
+	std::uint8_t get_number_of_physical_soft_keys() const override
+	{
+		return 6;
+	}
+
+	std::uint16_t get_data_mask_area_size_x_pixels() const override
+	{
+		return 480;
+	}
+
+	std::uint16_t get_data_mask_area_size_y_pixels() const override
+	{
+		return 480;
+	}
+
+	void suspend_working_set(std::shared_ptr<VirtualTerminalServerManagedWorkingSet>) override
+	{
+	}
+
+	SupportedWideCharsErrorCode get_supported_wide_chars(std::uint8_t, std::uint16_t, std::uint16_t, std::uint8_t &, std::vector<std::uint8_t> &) override
+	{
+		return SupportedWideCharsErrorCode::AnyOtherError;
+	}
+
+	std::vector<std::array<std::uint8_t, 7>> get_versions(NAME) override
+	{
+		return {};
+	}
+
+	std::vector<std::uint8_t> get_supported_objects() const override
+	{
+		return {};
+	}
+
+	std::vector<std::uint8_t> load_version(const std::vector<std::uint8_t> &, NAME) override
+	{
+		return {};
+	}
+
+	bool save_version(const std::vector<std::uint8_t> &, const std::vector<std::uint8_t> &, NAME) override
+	{
+		return false;
+	}
+
+	bool delete_version(const std::vector<std::uint8_t> &, NAME) override
+	{
+		return false;
+	}
+
+	bool delete_all_versions(NAME) override
+	{
+		return false;
+	}
+
+	bool delete_object_pool(NAME) override
+	{
+		return true;
+	}
+};
+
+/// @brief Creates a NAME for one of the control functions
+/// @param[in] function The function code of the control function
+/// @param[in] identityNumber The identity number of the control function
+/// @returns The NAME
+static NAME create_name(NAME::Function function, std::uint32_t identityNumber)
+{
+	NAME name(0);
+	name.set_arbitrary_address_capable(true);
+	name.set_industry_group(1);
+	name.set_function_code(static_cast<std::uint8_t>(function));
+	name.set_identity_number(identityNumber);
+	name.set_manufacturer_code(1407);
+	return name;
+}
+
+/// @brief Keeps the server updated until a condition is met
+/// @param[in] server The server to update
+/// @param[in] condition The condition to wait for
+/// @param[in] timeout_ms How long to wait at most
+/// @returns true if the condition was met, false on a timeout
+static bool wait_until(BenchmarkVTServer &server, const std::function<bool()> &condition, std::uint32_t timeout_ms)
+{
+	const auto start = std::chrono::steady_clock::now();
+	while (!condition())
+	{
+		if (std::chrono::steady_clock::now() - start > std::chrono::milliseconds(timeout_ms))
+		{
+			return false;
+		}
+		server.update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return true;
+}
+
+int main()
+{
+	std::vector<std::uint8_t> objectPool = IOPFileInterface::read_iop_file("VT3TestPool.iop");
+	if (objectPool.empty())
+	{
+		std::cout << "Failed to load VT3TestPool.iop, it should be next to the executable." << std::endl;
+		return -1;
+	}
+
+	std::shared_ptr<CANHardwarePlugin> clientDriver = std::make_shared<VirtualCANPlugin>("benchmark-channel");
+	std::shared_ptr<CANHardwarePlugin> serverDriver = std::make_shared<VirtualCANPlugin>("benchmark-channel");
+	CANHardwareInterface::set_number_of_can_channels(2);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, clientDriver);
+	CANHardwareInterface::assign_can_channel_frame_handler(1, serverDriver);
+	if ((!CANHardwareInterface::start()) || (!clientDriver->get_is_valid()) || (!serverDriver->get_is_valid()))
+	{
+		std::cout << "Failed to start hardware interface. The CAN driver might be invalid." << std::endl;
+		return -2;
+	}
+
+	auto serverECU = CANNetworkManager::CANNetwork.create_internal_control_function(create_name(NAME::Function::VirtualTerminal, 1), 1, 0x26);
+	auto clientECU = CANNetworkManager::CANNetwork.create_internal_control_function(create_name(NAME::Function::SteeringControl, 2), 0, 0x1C);
+	auto serverPartner = CANNetworkManager::CANNetwork.create_partnered_control_function(0, { NAMEFilter(NAME::NAMEParameters::FunctionCode, static_cast<std::uint8_t>(NAME::Function::VirtualTerminal)) });
+
+	BenchmarkVTServer server(serverECU);
+	server.initialize();
+	std::atomic<std::uint32_t> appliedCommands = { 0 };
+	server.get_on_repaint_event_dispatcher().add_listener([&appliedCommands](const std::shared_ptr<VirtualTerminalServerManagedWorkingSet> &) {
+		appliedCommands++;
+	});
+
+	auto client = std::make_shared<VirtualTerminalClient>(serverPartner, clientECU);
+	client->set_object_pool(0, objectPool.data(), static_cast<std::uint32_t>(objectPool.size()));
+	client->initialize(true);
+	std::atomic<std::uint32_t> completedTransactions = { 0 };
+	client->get_transaction_completed_event_dispatcher().add_listener([&completedTransactions](const VirtualTerminalClient::VTTransactionCompletedEvent &) {
+		completedTransactions++;
+	});
+
+	if (!wait_until(server, [&client]() { return client->get_is_connected(); }, 30000))
+	{
+		std::cout << "The client did not connect to the server." << std::endl;
+		client->terminate();
+		CANHardwareInterface::stop();
+		return -3;
+	}
+
+	// Every update is a separate command, and the application waits until the VT has applied it before sending the next one
+	appliedCommands = 0;
+	bool finished = true;
+	auto start = std::chrono::steady_clock::now();
+	for (std::uint32_t i = 0; (i < NUMBER_OF_SEPARATE_UPDATES) && finished; i++)
+	{
+		client->send_change_numeric_value((0 == (i % 2)) ? OUTPUT_NUMBER_ID : NUMBER_VARIABLE_ID, i);
+		finished = wait_until(server, [&appliedCommands, i]() { return appliedCommands > i; }, 5000);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (finished)
+	{
+		benchmark_helpers::print_result("separate commands: updates", static_cast<double>(NUMBER_OF_SEPARATE_UPDATES) / seconds, "updates/s");
+	}
+	else
+	{
+		std::cout << "separate commands: timed out" << std::endl;
+	}
+
+	// Each frame changes both values several times, but only their final values are sent
+	appliedCommands = 0;
+	completedTransactions = 0;
+	start = std::chrono::steady_clock::now();
+	for (std::uint32_t frame = 0; frame < NUMBER_OF_FRAMES; frame++)
+	{
+		client->begin_transaction();
+		for (std::uint32_t i = 0; i < UPDATES_PER_OBJECT_PER_FRAME; i++)
+		{
+			client->send_change_numeric_value(OUTPUT_NUMBER_ID, frame + i);
+			client->send_change_numeric_value(NUMBER_VARIABLE_ID, frame + i);
+		}
+		client->end_transaction();
+	}
+	finished = wait_until(server, [&completedTransactions]() { return completedTransactions >= NUMBER_OF_FRAMES; }, 60000);
+	seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (finished)
+	{
+		benchmark_helpers::print_result("transactions: application updates", static_cast<double>(NUMBER_OF_FRAMES * UPDATES_PER_OBJECT_PER_FRAME * 2) / seconds, "updates/s");
+		benchmark_helpers::print_result("transactions: commands applied by the VT", static_cast<double>(appliedCommands) / seconds, "commands/s");
+		benchmark_helpers::print_result("transactions: frames", static_cast<double>(NUMBER_OF_FRAMES) / seconds, "frames/s");
+	}
+	else
+	{
+		std::cout << "transactions: timed out" << std::endl;
+	}
+
+	client->terminate();
+	CANHardwareInterface::stop();
+	return 0;
+}
+#else
+int main()
+{
+	std::cout << "This benchmark requires the VirtualCAN plugin and a build with threads. If using CMake, set the `-DCAN_DRIVER=VirtualCAN`." << std::endl;
+	return -1;
+}
+#endif
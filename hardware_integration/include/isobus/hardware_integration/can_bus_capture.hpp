@@ -0,0 +1,234 @@
+//================================================================================================
+/// @file can_bus_capture.hpp
+///
+/// @brief Defines a compact binary CAN bus capture format, with a writer that can hook into the
+/// hardware interface, a reader, and a replay engine to feed a capture back into the stack.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#ifndef CAN_BUS_CAPTURE_HPP
+#define CAN_BUS_CAPTURE_HPP
+
+#include "isobus/hardware_integration/can_hardware_interface.hpp"
+#include "isobus/hardware_integration/can_hardware_plugin.hpp"
+#include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/isobus/can_network_manager.hpp"
+#include "isobus/utility/memory_mapped_file.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace isobus
+{
+	/// @brief Describes the layout of a binary capture file
+	/// @details A capture starts with a header of HEADER_SIZE bytes, followed by one RECORD_SIZE byte record per
+	/// frame, in the order they were captured, followed by the index. All values are little endian.
+	///
+	/// Header: the 8 byte MAGIC, a 16 bit version, 16 bit header size, 16 bit record size, 16 bits reserved,
+	/// then the 64 bit number of records, the 64 bit timestamps of the first and last record,
+	/// the 64 bit byte offset and the 64 bit number of index entries, the 32 bit index interval and 32 bits reserved.
+	///
+	/// Record: the 64 bit timestamp in microseconds, the 32 bit identifier, the 8 bit channel, the 8 bit data length,
+	/// 8 bits of flags (see FLAG_EXTENDED_FRAME and FLAG_TRANSMITTED), 8 bits reserved and the 8 data bytes.
+	///
+	/// Index: the 64 bit timestamp of every INDEX_INTERVAL-th record, so a position in time can be found
+	/// without touching the records in between. The index is written when the capture is closed,
+	/// a capture without an index (for example after a crash) can still be read.
+	namespace CANBusCaptureFormat
+	{
+		constexpr char MAGIC[8] = { 'A', 'G', 'C', 'A', 'N', 'C', 'A', 'P' }; ///< Identifies a capture file
+		constexpr std::uint16_t VERSION = 1; ///< The version of the format
+		constexpr std::size_t HEADER_SIZE = 64; ///< The size of the header in bytes
+		constexpr std::size_t RECORD_SIZE = 24; ///< The size of one record in bytes
+		constexpr std::uint32_t INDEX_INTERVAL = 1024; ///< The number of records between two index entries
+		constexpr std::uint8_t FLAG_EXTENDED_FRAME = 0x01; ///< The record holds an extended (29 bit) frame
+		constexpr std::uint8_t FLAG_TRANSMITTED = 0x02; ///< The frame was transmitted by the capturing device, not received
+	} // namespace CANBusCaptureFormat
+
+	/// @brief Writes frames to a binary capture file through a memory mapping
+	/// @details The file grows in large steps, so writing a frame is only a copy into memory.
+	/// The number of records in the header is kept up to date after every frame, so a capture
+	/// that was never closed can still be read.
+	class CANBusCaptureWriter
+	{
+	public:
+		/// @brief Constructor for a capture writer
+		/// @param[in] filename The name/path of the file to write
+		/// @param[in] captureHardwareInterface If true, all frames received and transmitted by the CANHardwareInterface
+		/// are captured, timestamped with the time they were captured
+		explicit CANBusCaptureWriter(const std::string &filename, bool captureHardwareInterface = true);
+
+		/// @brief Destructor, closes the capture
+		~CANBusCaptureWriter();
+
+		/// @brief Deleted copy constructor
+		CANBusCaptureWriter(const CANBusCaptureWriter &) = delete;
+
+		/// @brief Deleted assignment operator
+		/// @returns Nothing, this function is deleted
+		CANBusCaptureWriter &operator=(const CANBusCaptureWriter &) = delete;
+
+		/// @brief Returns if the capture file was opened
+		/// @returns true if frames can be written
+		bool get_is_open() const;
+
+		/// @brief Adds a frame to the capture, using the frame's own timestamp
+		/// @param[in] frame The frame to add
+		/// @param[in] transmitted true if the frame was transmitted by the capturing device
+		/// @returns true if the frame was written
+		bool write_frame(const CANMessageFrame &frame, bool transmitted);
+
+		/// @brief Writes the index and closes the capture. No frames can be written afterwards.
+		void close();
+
+		/// @brief Returns the number of frames in the capture
+		/// @returns The number of frames written so far
+		std::uint64_t get_number_of_frames() const;
+
+	private:
+		/// @brief Writes the header with the current number of records, timestamps and index
+		void write_header();
+
+		MemoryMappedFile file; ///< The capture file
+		Mutex writerMutex; ///< Serializes frames from the receive and transmit callbacks
+		std::uint64_t numberOfRecords = 0; ///< The number of records written
+		std::uint64_t firstTimestamp_us = 0; ///< The timestamp of the first record
+		std::uint64_t lastTimestamp_us = 0; ///< The timestamp of the last record
+		std::uint64_t indexOffset = 0; ///< The byte offset of the index, or 0 if it was not written yet
+		std::uint64_t numberOfIndexEntries = 0; ///< The number of index entries
+		EventCallbackHandle canFrameReceivedListener = 0; ///< A listener for received frames
+		EventCallbackHandle canFrameSentListener = 0; ///< A listener for sent frames
+		bool isCapturingHardwareInterface = false; ///< Whether the hardware interface listeners are registered
+	};
+
+	/// @brief Reads frames from a binary capture file through a memory mapping
+	class CANBusCaptureReader
+	{
+	public:
+		/// @brief Constructor for a capture reader
+		/// @param[in] filename The name/path of the file to read
+		explicit CANBusCaptureReader(const std::string &filename);
+
+		/// @brief Returns if the file was opened and has a valid header
+		/// @returns true if frames can be read
+		bool get_is_valid() const;
+
+		/// @brief Returns the number of frames in the capture
+		/// @returns The number of frames that can be read
+		std::uint64_t get_number_of_frames() const;
+
+		/// @brief Returns the timestamp of the first frame in the capture
+		/// @returns The timestamp in microseconds, or 0 if the capture is empty
+		std::uint64_t get_first_timestamp_us() const;
+
+		/// @brief Returns the timestamp of the last frame in the capture
+		/// @returns The timestamp in microseconds, or 0 if the capture is empty
+		std::uint64_t get_last_timestamp_us() const;
+
+		/// @brief Reads a frame from the capture
+		/// @param[in] index The position of the frame in the capture
+		/// @param[out] frame The frame that was read
+		/// @param[out] transmitted true if the frame was transmitted by the capturing device
+		/// @returns true if the frame was read, false if the index is out of range
+		bool get_frame(std::uint64_t index, CANMessageFrame &frame, bool &transmitted) const;
+
+		/// @brief Finds the first frame at or after a point in time, using the index to narrow down the search
+		/// @param[in] timestamp_us The point in time in microseconds
+		/// @returns The position of the frame, or the number of frames if all frames are earlier
+		std::uint64_t find_frame(std::uint64_t timestamp_us) const;
+
+	private:
+		/// @brief Returns the timestamp of a record
+		/// @param[in] index The position of the record
+		/// @returns The timestamp of the record in microseconds
+		std::uint64_t get_record_timestamp(std::uint64_t index) const;
+
+		MemoryMappedFile file; ///< The capture file
+		std::uint64_t numberOfRecords = 0; ///< The number of records in the file
+		std::uint64_t indexOffset = 0; ///< The byte offset of the index, or 0 if there is no index
+		std::uint64_t numberOfIndexEntries = 0; ///< The number of index entries
+		std::uint32_t indexInterval = 0; ///< The number of records between two index entries
+		bool isValid = false; ///< Whether the file has a valid header
+	};
+
+	/// @brief Feeds the frames of a capture into the stack
+	/// @details The replay is driven by calling update(), like the rest of the stack.
+	/// With original timing, each update feeds the frames that are due based on the time since start().
+	/// As fast as possible, each update feeds a batch of frames, so that the stack can be updated
+	/// in between to process them.
+	///
+	/// Frames are fed to a target: a hardware plugin (for example a VirtualCANPlugin on the same channel
+	/// as the stack, so the frames arrive as if another device sent them), the receive path of a
+	/// CANNetworkManager, or any function. Frames that the capturing device transmitted are skipped
+	/// by default, since they are normally the stack's own traffic.
+	class CANBusCaptureReplay
+	{
+	public:
+		/// @brief Enumerates how fast a capture is replayed
+		enum class Timing
+		{
+			Original, ///< Frames are fed at the same relative times as they were captured
+			AsFastAsPossible ///< Frames are fed in batches, without waiting
+		};
+
+		/// @brief The default number of frames fed per update when replaying as fast as possible
+		static constexpr std::size_t DEFAULT_BATCH_SIZE = 64;
+
+		/// @brief Constructor for a replay into any target
+		/// @param[in] reader The capture to replay, which must outlive the replay
+		/// @param[in] target The function that is called with every replayed frame
+		/// @param[in] timing How fast the capture is replayed
+		CANBusCaptureReplay(const CANBusCaptureReader &reader, std::function<void(const CANMessageFrame &)> target, Timing timing);
+
+		/// @brief Constructor for a replay that writes the frames to a hardware plugin
+		/// @param[in] reader The capture to replay, which must outlive the replay
+		/// @param[in] plugin The plugin to write the frames to, which must outlive the replay
+		/// @param[in] timing How fast the capture is replayed
+		CANBusCaptureReplay(const CANBusCaptureReader &reader, CANHardwarePlugin &plugin, Timing timing);
+
+		/// @brief Constructor for a replay directly into the receive path of a network manager
+		/// @param[in] reader The capture to replay, which must outlive the replay
+		/// @param[in] networkManager The network manager to feed, which must outlive the replay
+		/// @param[in] timing How fast the capture is replayed
+		CANBusCaptureReplay(const CANBusCaptureReader &reader, CANNetworkManager &networkManager, Timing timing);
+
+		/// @brief Sets whether frames that the capturing device transmitted are replayed too
+		/// @param[in] replay true to replay transmitted frames, false to skip them
+		void set_replay_transmitted_frames(bool replay);
+
+		/// @brief Sets the number of frames fed per update when replaying as fast as possible
+		/// @param[in] batchSize The number of frames per update, or 0 to feed all remaining frames in one update
+		void set_batch_size(std::size_t batchSize);
+
+		/// @brief Starts or restarts the replay at a point in the capture
+		/// @param[in] startTimestamp_us The capture time to start at, frames before it are skipped
+		void start(std::uint64_t startTimestamp_us = 0);
+
+		/// @brief Feeds the frames that are due to the target
+		/// @returns The number of frames fed
+		std::size_t update();
+
+		/// @brief Returns if all frames were replayed
+		/// @returns true if the end of the capture was reached
+		bool get_is_finished() const;
+
+		/// @brief Returns the number of frames fed to the target since start()
+		/// @returns The number of frames replayed
+		std::uint64_t get_number_of_replayed_frames() const;
+
+	private:
+		const CANBusCaptureReader &reader; ///< The capture to replay
+		std::function<void(const CANMessageFrame &)> target; ///< Called with every replayed frame
+		const Timing timing; ///< How fast the capture is replayed
+		std::size_t batchSize = DEFAULT_BATCH_SIZE; ///< The number of frames per update when replaying as fast as possible, 0 for all remaining
+		std::uint64_t nextFrame = 0; ///< The position of the next frame to replay
+		std::uint64_t captureStartTimestamp_us = 0; ///< The capture time the replay started at
+		std::uint64_t replayStartTimestamp_us = 0; ///< The system time the replay started at
+		std::uint64_t replayedFrames = 0; ///< The number of frames fed since start()
+		bool replayTransmittedFrames = false; ///< Whether transmitted frames are replayed
+	};
+} // namespace isobus
+
+#endif // CAN_BUS_CAPTURE_HPP
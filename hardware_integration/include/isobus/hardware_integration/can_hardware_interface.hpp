@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <cstring>
 #include <deque>
+#include <limits>
 #include <vector>
 
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
@@ -36,6 +37,25 @@ namespace isobus
 	class CANHardwareInterface
 	{
 	public:
+		/// @brief What to do with received frames when a channel's receive queue is full
+		enum class QueueOverflowPolicy : std::uint8_t
+		{
+			DropNewest, ///< Read the frames from the driver anyway and drop the ones that don't fit
+			DropOldest, ///< Drop the oldest queued frames to make room for the newly received ones
+			BlockWithTimeout, ///< Stop reading from the driver until there is room, and drop the newest frames after the timeout
+			Grow ///< Keep every frame by growing the queue beyond its capacity
+		};
+
+		/// @brief Statistics about a channel's queues and the frames lost on it
+		struct ChannelStatistics
+		{
+			std::uint64_t receiveQueueDroppedFrames = 0; ///< The number of received frames dropped because the receive queue was full
+			std::uint64_t transmitQueueRejectedFrames = 0; ///< The number of frames refused for transmission because the transmit queue was full
+			std::size_t receiveQueueHighWaterMark = 0; ///< The maximum number of frames that were waiting in the receive queue at once
+			std::size_t transmitQueueHighWaterMark = 0; ///< The maximum number of frames that were waiting in the transmit queue at once
+			std::uint32_t driverDroppedFrames = 0; ///< The number of frames the driver reported as dropped before they reached the stack
+		};
+
 		/// @brief Returns the number of configured CAN channels that the class is managing
 		/// @returns The number of configured CAN channels that the class is managing
 		static std::uint8_t get_number_of_can_channels();
@@ -46,10 +66,30 @@ namespace isobus
 		/// already configured, it will delete the unneeded `CanHardware` objects.
 		/// @note The function will fail if the channel is already assigned to a driver or the interface is already started
 		/// @param value The number of CAN channels to manage
-		/// @param queueCapacity The capacity of the transmit and receive queues
+		/// @param queueCapacity The minimum capacity of the transmit and receive queues, rounded up to a power of two
 		/// @returns `true` if the channel count was set, otherwise `false`.
 		static bool set_number_of_can_channels(std::uint8_t value, std::size_t queueCapacity = 40);
 
+		/// @brief Sets what happens to received frames when a channel's receive queue is full
+		/// @details The default is `QueueOverflowPolicy::BlockWithTimeout` with an infinite timeout, which leaves the
+		/// frames in the driver, where they may be dropped by the driver (see `ChannelStatistics::driverDroppedFrames`).
+		/// Frames that can't be added to a full transmit queue are always refused, and counted in the statistics.
+		/// @note The function will fail if the interface is already started
+		/// @param[in] channelIndex The channel to set the policy for
+		/// @param[in] policy The overflow policy to use
+		/// @param[in] blockTimeout_ms How long to stop reading from the driver before dropping frames, only used by `QueueOverflowPolicy::BlockWithTimeout`
+		/// @returns `true` if the policy was set, otherwise `false`
+		static bool set_queue_overflow_policy(std::uint8_t channelIndex, QueueOverflowPolicy policy, std::uint32_t blockTimeout_ms = std::numeric_limits<std::uint32_t>::max());
+
+		/// @brief Returns the statistics about a channel's queues and the frames lost on it
+		/// @param[in] channelIndex The channel to get the statistics for
+		/// @returns The statistics of the channel, or all zeros if the channel doesn't exist
+		static ChannelStatistics get_channel_statistics(std::uint8_t channelIndex);
+
+		/// @brief Resets a channel's drop counters and high water marks back to zero
+		/// @param[in] channelIndex The channel to reset the statistics of
+		static void reset_channel_statistics(std::uint8_t channelIndex);
+
 		/// @brief Assigns a CAN driver to a channel
 		/// @param[in] channelIndex The channel to assign to
 		/// @param[in] canDriver The driver to assign to the channel
@@ -102,6 +142,9 @@ namespace isobus
 		static void update();
 
 		/// @brief Set the interval between periodic updates to the network manager
+		/// @details On Linux the hardware interface waits on all channels that expose a file descriptor
+		/// (like SocketCAN) with a single epoll reactor, so received frames are processed as soon as they
+		/// arrive and this interval only controls how often the stack is updated without bus activity.
 		/// @param[in] value The interval between update calls in milliseconds
 		static void set_periodic_update_interval(std::uint32_t value);
 
@@ -129,15 +172,31 @@ namespace isobus
 			/// @returns `true` if the channel was stopped, otherwise `false`
 			bool stop();
 
-			/// @brief Try to transmit the frame to the hardware
-			/// @param[in] frame The frame to transmit
-			/// @returns `true` if the frame was transmitted, otherwise `false`
-			bool transmit_can_frame(const CANMessageFrame &frame) const;
+			/// @brief Try to transmit several frames to the hardware, in order
+			/// @param[in] frames The frames to transmit
+			/// @param[in] numberOfFrames The number of frames in `frames`
+			/// @returns The number of frames that were transmitted, counted from the start of `frames`
+			std::size_t transmit_can_frames(const CANMessageFrame *frames, std::size_t numberOfFrames) const;
 
-			/// @brief Receives a frame from the hardware and adds it to the receive queue
-			/// @returns `true` if a frame was received, otherwise `false`
+			/// @brief Receives a batch of frames from the hardware and adds them to the receive queue
+			/// @returns `true` if at least one frame was received, otherwise `false`
 			bool receive_can_frame();
 
+			/// @brief Takes the oldest received frame out of the receive queue
+			/// @param[out] frame The frame that was taken out of the queue
+			/// @returns `true` if a frame was available, otherwise `false`
+			bool pop_received_frame(CANMessageFrame &frame);
+
+			/// @brief Adds received frames to the receive queue, applying the overflow policy if it is full
+			/// @param[in] frames The frames to add
+			/// @param[in] numberOfFrames The number of frames in `frames`
+			void queue_received_frames(const CANMessageFrame *frames, std::size_t numberOfFrames);
+
+			/// @brief Raises a high water mark if the current queue usage exceeds it
+			/// @param[in,out] highWaterMark The high water mark to update
+			/// @param[in] usage The current number of frames in the queue
+			static void update_high_water_mark(std::atomic<std::size_t> &highWaterMark, std::size_t usage);
+
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 			/// @brief Starts the receiving thread for this CAN channel
 			void start_threads();
@@ -156,6 +215,18 @@ namespace isobus
 
 			LockFreeQueue<CANMessageFrame> messagesToBeTransmittedQueue; ///< Transmit message queue for a CAN channel
 			LockFreeQueue<CANMessageFrame> receivedMessagesQueue; ///< Receive message queue for a CAN channel
+			std::deque<CANMessageFrame> receivedMessagesOverflowQueue; ///< Frames that didn't fit in `receivedMessagesQueue` with the `Grow` policy
+			Mutex receivedMessagesMutex; ///< Lets the receiving side take frames out of the queue for the `DropOldest` and `Grow` policies
+
+			QueueOverflowPolicy receiveQueueOverflowPolicy = QueueOverflowPolicy::BlockWithTimeout; ///< What to do with received frames when the receive queue is full
+			std::uint32_t receiveQueueBlockTimeout_ms = std::numeric_limits<std::uint32_t>::max(); ///< How long to stop reading before dropping frames, for `BlockWithTimeout`
+			std::uint32_t receiveQueueFullTimestamp_ms = 0; ///< When the receive queue was first found full, for `BlockWithTimeout`
+			bool receiveQueueFull = false; ///< Whether the receive queue was full the last time a frame was received
+
+			std::atomic<std::uint64_t> receiveQueueDroppedFrames = { 0 }; ///< The number of received frames dropped because the receive queue was full
+			std::atomic<std::uint64_t> transmitQueueRejectedFrames = { 0 }; ///< The number of frames refused because the transmit queue was full
+			std::atomic<std::size_t> receiveQueueHighWaterMark = { 0 }; ///< The maximum number of frames that waited in the receive queue at once
+			std::atomic<std::size_t> transmitQueueHighWaterMark = { 0 }; ///< The maximum number of frames that waited in the transmit queue at once
 		};
 
 		/// @brief Singleton instance of the CANHardwareInterface class
@@ -165,6 +236,12 @@ namespace isobus
 		/// @brief The default update interval for the CAN stack. Mostly arbitrary
 		static constexpr std::uint32_t PERIODIC_UPDATE_INTERVAL = 4;
 
+		/// @brief The maximum number of frames requested from a CAN driver in a single read
+		static constexpr std::size_t RECEIVE_BATCH_SIZE = 32;
+
+		/// @brief The maximum number of frames handed to a CAN driver in a single write
+		static constexpr std::size_t TRANSMIT_BATCH_SIZE = 32;
+
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 		/// @brief Deconstructor for the CANHardwareInterface class for stopping threads
 		virtual ~CANHardwareInterface();
@@ -178,6 +255,37 @@ namespace isobus
 		/// @brief Stops all threads related to the hardware interface
 		static void stop_threads();
 
+		/// @brief Signals the `updateThread` that there is work to do, such as received or queued frames
+		static void wakeup_update_thread();
+
+#ifdef __linux__
+		/// @brief Creates the epoll reactor that the `updateThread` waits on, with its wakeup event and periodic timer
+		/// @returns `true` if the reactor was created, otherwise `false` and the condition variable is used instead
+		static bool create_reactor();
+
+		/// @brief Closes the epoll reactor and its wakeup event and periodic timer
+		static void destroy_reactor();
+
+		/// @brief Arms the reactor's periodic timer with the current periodic update interval
+		static void arm_reactor_timer();
+
+		/// @brief Adds a channel's receive file descriptor to the reactor, if the driver provides one
+		/// @param[in] channelIndex The channel to add
+		static void register_channel_with_reactor(std::uint8_t channelIndex);
+
+		/// @brief Waits on the reactor for frames, wakeups or the periodic timer and updates the stack
+		static void reactor_thread_function();
+
+		static constexpr std::uint64_t REACTOR_WAKEUP_EVENT = 0; ///< The epoll event identifier for the wakeup event
+		static constexpr std::uint64_t REACTOR_TIMER_EVENT = 1; ///< The epoll event identifier for the periodic timer
+		static constexpr std::uint64_t REACTOR_CHANNEL_EVENT_OFFSET = 2; ///< The epoll event identifier of channel 0, other channels follow
+		static constexpr int REACTOR_MAX_EVENTS = 16; ///< The maximum number of epoll events handled per wakeup
+
+		static std::atomic<int> reactorFileDescriptor; ///< The epoll instance the `updateThread` waits on, or -1 if not used
+		static std::atomic<int> wakeupFileDescriptor; ///< An eventfd used to wakeup the `updateThread`, or -1 if not used
+		static std::atomic<int> timerFileDescriptor; ///< A timerfd that expires each periodic update interval, or -1 if not used
+#endif
+
 		static std::unique_ptr<std::thread> updateThread; ///< The main thread
 		static std::condition_variable updateThreadWakeupCondition; ///< A condition variable to allow for signaling the `updateThread` to wakeup
 #endif
@@ -9,6 +9,8 @@
 #ifndef CAN_HARDEWARE_PLUGIN_HPP
 #define CAN_HARDEWARE_PLUGIN_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include "isobus/isobus/can_message_frame.hpp"
 
@@ -47,10 +49,64 @@ namespace isobus
 		/// @returns `true` if a CAN frame was read, otherwise `false`
 		virtual bool read_frame(isobus::CANMessageFrame &canFrame) = 0;
 
+		/// @brief Reads up to `maxFrames` frames from the bus synchronously in one batch
+		/// @details The default implementation reads a single frame using `read_frame`.
+		/// Drivers that can retrieve several frames at once (for example with a single system call)
+		/// should override this to reduce the per-frame overhead on busy buses.
+		/// @param[out] canFrames The buffer to store the CAN frames that were read in
+		/// @param[in] maxFrames The maximum number of frames that fit in `canFrames`
+		/// @returns The number of CAN frames that were read
+		virtual std::size_t read_frames(isobus::CANMessageFrame *canFrames, std::size_t maxFrames)
+		{
+			std::size_t retVal = 0;
+
+			if ((nullptr != canFrames) && (maxFrames > 0) && read_frame(canFrames[0]))
+			{
+				retVal = 1;
+			}
+			return retVal;
+		}
+
 		/// @brief Writes a frame to the bus (synchronous)
 		/// @param[in] canFrame The frame to write to the bus
 		/// @returns `true` if the frame was written, otherwise `false`
 		virtual bool write_frame(const isobus::CANMessageFrame &canFrame) = 0;
+
+		/// @brief Returns a file descriptor that becomes readable when frames can be read, if the driver has one
+		/// @details When a driver provides a pollable file descriptor, the hardware interface can wait
+		/// on it together with the other channels instead of dedicating a receive thread to the driver.
+		/// @returns The file descriptor, or -1 if the driver does not support event driven reception
+		virtual int get_receive_file_descriptor() const
+		{
+			return -1;
+		}
+
+		/// @brief Returns how many received frames the driver or the hardware itself had to drop
+		/// @details This counts frames lost before they reached the stack, for example because the
+		/// driver's or operating system's receive buffer overflowed.
+		/// @returns The number of dropped frames since the driver was opened, or 0 if the driver can't tell
+		virtual std::uint32_t get_number_of_dropped_frames() const
+		{
+			return 0;
+		}
+
+		/// @brief Writes several frames to the bus (synchronous), in order
+		/// @details The default implementation writes the frames one by one using `write_frame`,
+		/// and stops at the first frame that could not be written. Drivers that can transmit
+		/// several frames at once should override this to reduce the per-frame overhead.
+		/// @param[in] canFrames The frames to write to the bus
+		/// @param[in] numberOfFrames The number of frames in `canFrames`
+		/// @returns The number of frames that were written, counted from the start of `canFrames`
+		virtual std::size_t write_frames(const isobus::CANMessageFrame *canFrames, std::size_t numberOfFrames)
+		{
+			std::size_t retVal = 0;
+
+			while ((nullptr != canFrames) && (retVal < numberOfFrames) && write_frame(canFrames[retVal]))
+			{
+				retVal++;
+			}
+			return retVal;
+		}
 	};
 }
 #endif // CAN_HARDEWARE_PLUGIN_HPP
@@ -10,6 +10,8 @@
 #ifndef SOCKET_CAN_INTERFACE_HPP
 #define SOCKET_CAN_INTERFACE_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 #include "isobus/hardware_integration/can_hardware_plugin.hpp"
@@ -17,6 +19,8 @@
 #include "isobus/isobus/can_message_frame.hpp"
 
 struct sockaddr_can; ///< Forward declare the linux sockaddr_can struct
+struct can_frame; ///< Forward declare the linux can_frame struct
+struct msghdr; ///< Forward declare the linux msghdr struct
 
 namespace isobus
 {
@@ -58,20 +62,61 @@ namespace isobus
 		/// @returns `true` if a CAN frame was read, otherwise `false`
 		bool read_frame(isobus::CANMessageFrame &canFrame) override;
 
+		/// @brief Reads a batch of frames from the hardware (synchronous) using a single `recvmmsg` call.
+		/// @details Waits up to 100ms for the first frame, then drains as many pending frames as are
+		/// available without blocking, up to `maxFrames` or `MAX_RECEIVE_BATCH_SIZE`, whichever is smaller.
+		/// Each frame keeps its own hardware (or kernel) timestamp.
+		/// @param[out] canFrames The buffer to store the CAN frames that were read in
+		/// @param[in] maxFrames The maximum number of frames that fit in `canFrames`
+		/// @returns The number of CAN frames that were read
+		std::size_t read_frames(isobus::CANMessageFrame *canFrames, std::size_t maxFrames) override;
+
 		/// @brief Writes a frame to the bus (synchronous)
 		/// @param[in] canFrame The frame to write to the bus
 		/// @returns `true` if the frame was written, otherwise `false`
 		bool write_frame(const isobus::CANMessageFrame &canFrame) override;
 
+		/// @brief Writes a batch of frames to the bus (synchronous) using a single `sendmmsg` call.
+		/// @param[in] canFrames The frames to write to the bus
+		/// @param[in] numberOfFrames The number of frames in `canFrames`
+		/// @returns The number of frames that were written, counted from the start of `canFrames`
+		std::size_t write_frames(const isobus::CANMessageFrame *canFrames, std::size_t numberOfFrames) override;
+
+		/// @brief Returns the socket's file descriptor, which becomes readable when frames are pending
+		/// @returns The socket's file descriptor, or -1 if the socket is not open
+		int get_receive_file_descriptor() const override;
+
+		/// @brief Returns how many frames the kernel dropped because the socket's receive buffer was full
+		/// @details The kernel reports this with every received frame through `SO_RXQ_OVFL`,
+		/// so the value is as recent as the last frame that was read.
+		/// @returns The number of frames the kernel dropped since the socket was opened
+		std::uint32_t get_number_of_dropped_frames() const override;
+
 		/// @brief Changes the name of the device to use, which only works if the device is not open
 		/// @param[in] newName The new name for the device (such as "can0" or "vcan0")
 		/// @returns `true` if the name was changed, otherwise `false` (if the device is open this will return false)
 		bool set_name(const std::string &newName);
 
+		static constexpr std::size_t MAX_RECEIVE_BATCH_SIZE = 32; ///< The maximum number of frames retrieved from the socket per system call
+		static constexpr std::size_t MAX_TRANSMIT_BATCH_SIZE = 32; ///< The maximum number of frames handed to the socket per system call
+
 	private:
+		/// @brief Converts a received socket CAN frame and its ancillary data into a stack frame
+		/// @param[in] rxFrame The raw frame received from the socket
+		/// @param[in] message The message header the frame was received with, which holds the timestamps
+		/// @param[out] canFrame The converted CAN frame
+		/// @returns `true` if the frame was converted, `false` if it was an error frame
+		bool parse_received_frame(const struct can_frame &rxFrame, struct msghdr &message, isobus::CANMessageFrame &canFrame);
+
+		/// @brief Converts a stack frame into a socket CAN frame ready to be transmitted
+		/// @param[in] canFrame The frame to convert
+		/// @param[out] txFrame The converted socket CAN frame
+		static void build_transmit_frame(const isobus::CANMessageFrame &canFrame, struct can_frame &txFrame);
+
 		struct sockaddr_can *pCANDevice; ///< The structure for CAN sockets
 		std::string name; ///< The device name
 		int fileDescriptor; ///< File descriptor for the socket
+		std::atomic<std::uint32_t> droppedFrames; ///< The number of frames dropped by the kernel, as reported by `SO_RXQ_OVFL`
 	};
 }
 #endif // SOCKET_CAN_INTERFACE_HPP
@@ -12,15 +12,36 @@
 
 #include "isobus/hardware_integration/can_hardware_interface.hpp"
 
+#include <atomic>
 #include <ctime>
 #include <fstream>
+#include <string>
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
 
 namespace isobus
 {
 	/// @brief Logs to Vector .asc file
+	/// @details The frame callbacks only copy each frame into a lock free ring buffer. Received and transmitted
+	/// frames share the ring buffer, which keeps them in the order the hardware interface handled them.
+	/// A background writer thread formats the frames and writes them to the file in large blocks,
+	/// so no file I/O happens on the thread that handles the CAN traffic.
+	/// If the ring buffer is full the frame is dropped and counted.
+	/// When threads are disabled, the frames are formatted in the callbacks instead, and written once a block is full.
+	///
+	/// The log can be rotated to a new file after a maximum file size or duration. The first file uses the
+	/// given file name, the following ones get "_1", "_2", etc. inserted before the extension.
 	class VectorASCLogger
 	{
 	public:
+		static constexpr std::size_t DEFAULT_QUEUE_SIZE = 4096; ///< The default number of frames the ring buffer can hold
+		static constexpr std::size_t WRITE_BLOCK_SIZE = 65536; ///< The number of bytes of text that are collected before they are written to the file
+		static constexpr std::uint32_t WRITER_PERIOD_MS = 100; ///< How often the writer thread empties the ring buffer
+
 		/// @brief Constructor for a logger, which uses a default file name
 		VectorASCLogger();
 
@@ -28,27 +49,95 @@ namespace isobus
 		/// @param filename The name/path of the file to log to
 		explicit VectorASCLogger(std::string filename);
 
-		/// @brief Destructor for a logger
+		/// @brief Constructor for a logger that rotates to a new file when the current one gets too large or too old
+		/// @param filename The name/path of the first file to log to
+		/// @param maximumFileSize_bytes The size after which a new file is started, or 0 to not rotate on size
+		/// @param maximumFileDuration_s The duration after which a new file is started, or 0 to not rotate on time
+		/// @param queueSize The number of frames the ring buffer can hold, rounded up to a power of two
+		VectorASCLogger(std::string filename, std::size_t maximumFileSize_bytes, std::uint32_t maximumFileDuration_s, std::size_t queueSize = DEFAULT_QUEUE_SIZE);
+
+		/// @brief Destructor for a logger, writes all frames that are still queued before closing the file
 		~VectorASCLogger();
 
 		/// @brief Deleted copy constructor
 		VectorASCLogger(VectorASCLogger &) = delete;
 
+		/// @brief Returns the number of frames that were not logged because the ring buffer was full
+		/// @returns The number of dropped frames since construction
+		std::size_t get_number_of_dropped_frames() const;
+
+		/// @brief Returns the number of files that were opened, including the first one
+		/// @returns The number of files written since construction
+		std::size_t get_number_of_files() const;
+
 	private:
-		/// @brief Opens the target log file, and passes it the current time information
+		/// @brief A frame waiting in the ring buffer to be written
+		struct LoggedFrame
+		{
+			CANMessageFrame frame; ///< The frame, with the time it was logged as its timestamp
+			bool transmitted; ///< true if the frame was transmitted, false if it was received
+		};
+
+		/// @brief Builds the default file name, which contains the current date and time
+		/// @returns The default file name
+		static std::string get_default_file_name();
+
+		/// @brief Opens a log file and writes the .asc header with the current time to it
 		/// @param[in] filePath The path to the file to open
-		/// @param[in] headerTime A string with a properly formatted .asc file date header in it
-		void openFile(const std::string &filePath, const std::string &headerTime);
+		/// @returns true if the file was opened
+		bool open_file(const std::string &filePath);
+
+		/// @brief Closes the current file and opens the next one in the rotation
+		void rotate_file();
+
+		/// @brief Returns the name of a file in the rotation
+		/// @param[in] index The index of the file, 0 for the first file
+		/// @returns The file name, with the index inserted before the extension for all but the first file
+		std::string get_rotated_file_name(std::size_t index) const;
+
+		/// @brief Called from the frame callbacks to log a frame
+		/// @param[in] frame The frame to log
+		/// @param[in] transmitted true if the frame was transmitted, false if it was received
+		void on_frame(const CANMessageFrame &frame, bool transmitted);
+
+		/// @brief Formats a frame into the write buffer, rotating the file first if needed
+		/// @param[in] frame The frame to log, with the time it was logged as its timestamp
+		/// @param[in] transmitted true if the frame was transmitted, false if it was received
+		void write_frame(const CANMessageFrame &frame, bool transmitted);
+
+		/// @brief Writes the write buffer to the file
+		void flush_write_buffer();
 
 		/// @brief Builds a vector ascii log file date header
 		/// @param[in] currentTime The current time
 		/// @returns A string with a properly formatted .asc file date header in it
 		std::string constructHeaderTime(const std::time_t &currentTime);
 
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		/// @brief Periodically writes the frames from the ring buffer to the file until the logger is destroyed
+		void writer_thread_function();
+
+		/// @brief Writes all frames currently in the ring buffer to the file, in the order they were logged
+		void write_queued_frames();
+
+		LockFreeQueue<LoggedFrame> queuedFrames; ///< Received and transmitted frames waiting for the writer thread
+		std::mutex writerMutex; ///< Protects the wake up of the writer thread when the logger is destroyed
+		std::condition_variable writerWakeUp; ///< Wakes up the writer thread when the logger is destroyed
+		std::atomic<bool> stopWriter = { false }; ///< Tells the writer thread to stop
+		std::thread writerThread; ///< The thread that formats and writes the frames
+#endif
+
 		std::fstream logFileStream; ///< The file to log to
+		std::string fileName; ///< The name of the first file to log to
+		std::string writeBuffer; ///< Formatted text waiting to be written to the file
 		isobus::EventCallbackHandle canFrameReceivedListener = 0; ///< A listener for received frames
 		isobus::EventCallbackHandle canFrameSentListener = 0; ///< A listener for sent frames
-		std::uint32_t initialTimestamp; ///< The initial timestamp of the logger
+		std::uint64_t initialTimestamp_us = 0; ///< The time the current file was started
+		std::size_t currentFileSize_bytes = 0; ///< The number of bytes written to the current file
+		std::size_t maximumFileSize_bytes = 0; ///< The size after which a new file is started, or 0 to not rotate on size
+		std::uint32_t maximumFileDuration_s = 0; ///< The duration after which a new file is started, or 0 to not rotate on time
+		std::atomic<std::size_t> droppedFrames = { 0 }; ///< The number of frames dropped because the ring buffer was full
+		std::atomic<std::size_t> numberOfFiles = { 0 }; ///< The number of files that were opened
 	};
 }
 
@@ -72,6 +72,12 @@ namespace isobus
 		/// @returns `true` if a CAN frame was read, otherwise `false`
 		bool read_frame(isobus::CANMessageFrame &canFrame, std::uint32_t timeout) const;
 
+		/// @brief Returns all queued frames up to `maxFrames` in one go (synchronous). Times out after 1 second.
+		/// @param[out] canFrames The buffer to store the CAN frames that were read in
+		/// @param[in] maxFrames The maximum number of frames that fit in `canFrames`
+		/// @returns The number of CAN frames that were read
+		std::size_t read_frames(isobus::CANMessageFrame *canFrames, std::size_t maxFrames) override;
+
 		/// @brief Writes a frame to the bus (synchronous)
 		/// @param[in] canFrame The frame to write to the bus
 		/// @returns `true` if the frame was written, otherwise `false`
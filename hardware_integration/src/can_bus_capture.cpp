@@ -0,0 +1,401 @@
+//================================================================================================
+/// @file can_bus_capture.cpp
+///
+/// @brief Implements a compact binary CAN bus capture format, with a writer that can hook into the
+/// hardware interface, a reader, and a replay engine to feed a capture back into the stack.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/hardware_integration/can_bus_capture.hpp"
+
+#include "isobus/isobus/can_stack_logger.hpp"
+#include "isobus/utility/system_timing.hpp"
+
+#include <cstring>
+
+namespace isobus
+{
+	/// @brief Stores a value little endian
+	/// @param[out] destination Where to store the value
+	/// @param[in] value The value to store
+	/// @param[in] numberOfBytes The number of bytes of the value to store
+	static void store_little_endian(std::uint8_t *destination, std::uint64_t value, std::size_t numberOfBytes)
+	{
+		for (std::size_t i = 0; i < numberOfBytes; i++)
+		{
+			destination[i] = static_cast<std::uint8_t>(value >> (8 * i));
+		}
+	}
+
+	/// @brief Loads a little endian value
+	/// @param[in] source Where to load the value from
+	/// @param[in] numberOfBytes The number of bytes of the value
+	/// @returns The value
+	static std::uint64_t load_little_endian(const std::uint8_t *source, std::size_t numberOfBytes)
+	{
+		std::uint64_t retVal = 0;
+		for (std::size_t i = 0; i < numberOfBytes; i++)
+		{
+			retVal |= static_cast<std::uint64_t>(source[i]) << (8 * i);
+		}
+		return retVal;
+	}
+
+	/// The number of records the file is grown by at least, so resizing the mapping is rare
+	static constexpr std::uint64_t MINIMUM_GROWTH_RECORDS = 65536;
+
+	CANBusCaptureWriter::CANBusCaptureWriter(const std::string &filename, bool captureHardwareInterface)
+	{
+		if ((file.open(filename, MemoryMappedFile::Mode::ReadWrite)) &&
+		    (file.resize(CANBusCaptureFormat::HEADER_SIZE + (MINIMUM_GROWTH_RECORDS * CANBusCaptureFormat::RECORD_SIZE))))
+		{
+			write_header();
+
+			if (captureHardwareInterface)
+			{
+				isCapturingHardwareInterface = true;
+				canFrameReceivedListener = CANHardwareInterface::get_can_frame_received_event_dispatcher().add_listener([this](const CANMessageFrame &canFrame) {
+					CANMessageFrame capturedFrame = canFrame;
+					capturedFrame.timestamp_us = SystemTiming::get_timestamp_us();
+					write_frame(capturedFrame, false);
+				});
+				canFrameSentListener = CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().add_listener([this](const CANMessageFrame &canFrame) {
+					CANMessageFrame capturedFrame = canFrame;
+					capturedFrame.timestamp_us = SystemTiming::get_timestamp_us();
+					write_frame(capturedFrame, true);
+				});
+			}
+		}
+		else
+		{
+			file.close();
+			LOG_ERROR("[Capture]: Failed to open capture file for writing");
+		}
+	}
+
+	CANBusCaptureWriter::~CANBusCaptureWriter()
+	{
+		close();
+	}
+
+	bool CANBusCaptureWriter::get_is_open() const
+	{
+		return file.get_is_open();
+	}
+
+	bool CANBusCaptureWriter::write_frame(const CANMessageFrame &frame, bool transmitted)
+	{
+		LOCK_GUARD(Mutex, writerMutex);
+
+		if (!file.get_is_open())
+		{
+			return false;
+		}
+
+		std::size_t recordOffset = CANBusCaptureFormat::HEADER_SIZE + (numberOfRecords * CANBusCaptureFormat::RECORD_SIZE);
+		if ((recordOffset + CANBusCaptureFormat::RECORD_SIZE) > file.size())
+		{
+			// Double the number of records, so the mapping is only resized a few times per capture
+			std::uint64_t growth = (numberOfRecords > MINIMUM_GROWTH_RECORDS) ? numberOfRecords : MINIMUM_GROWTH_RECORDS;
+			if (!file.resize(recordOffset + (growth * CANBusCaptureFormat::RECORD_SIZE)))
+			{
+				LOG_ERROR("[Capture]: Failed to grow the capture file, closing it");
+				file.close();
+				return false;
+			}
+		}
+
+		std::uint8_t *record = file.data() + recordOffset;
+		std::uint8_t flags = 0;
+		if (frame.isExtendedFrame)
+		{
+			flags |= CANBusCaptureFormat::FLAG_EXTENDED_FRAME;
+		}
+		if (transmitted)
+		{
+			flags |= CANBusCaptureFormat::FLAG_TRANSMITTED;
+		}
+		store_little_endian(record, frame.timestamp_us, 8);
+		store_little_endian(record + 8, frame.identifier, 4);
+		record[12] = frame.channel;
+		record[13] = (frame.dataLength <= sizeof(frame.data)) ? frame.dataLength : sizeof(frame.data);
+		record[14] = flags;
+		record[15] = 0;
+		std::memcpy(record + 16, frame.data, sizeof(frame.data));
+
+		if (0 == numberOfRecords)
+		{
+			firstTimestamp_us = frame.timestamp_us;
+		}
+		lastTimestamp_us = frame.timestamp_us;
+		numberOfRecords++;
+
+		// Keep the header current, so a capture that is never closed can still be read
+		store_little_endian(file.data() + 16, numberOfRecords, 8);
+		store_little_endian(file.data() + 24, firstTimestamp_us, 8);
+		store_little_endian(file.data() + 32, lastTimestamp_us, 8);
+		return true;
+	}
+
+	void CANBusCaptureWriter::close()
+	{
+		if (isCapturingHardwareInterface)
+		{
+			CANHardwareInterface::get_can_frame_received_event_dispatcher().remove_listener(canFrameReceivedListener);
+			CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().remove_listener(canFrameSentListener);
+			isCapturingHardwareInterface = false;
+		}
+
+		LOCK_GUARD(Mutex, writerMutex);
+		if (file.get_is_open())
+		{
+			// Shrink the file to the records and append the index
+			std::uint64_t recordsEnd = CANBusCaptureFormat::HEADER_SIZE + (numberOfRecords * CANBusCaptureFormat::RECORD_SIZE);
+			std::uint64_t entries = (numberOfRecords + CANBusCaptureFormat::INDEX_INTERVAL - 1) / CANBusCaptureFormat::INDEX_INTERVAL;
+
+			if (file.resize(static_cast<std::size_t>(recordsEnd + (entries * 8))))
+			{
+				for (std::uint64_t i = 0; i < entries; i++)
+				{
+					const std::uint8_t *record = file.data() + CANBusCaptureFormat::HEADER_SIZE + (i * CANBusCaptureFormat::INDEX_INTERVAL * CANBusCaptureFormat::RECORD_SIZE);
+					std::memcpy(file.data() + recordsEnd + (i * 8), record, 8);
+				}
+				indexOffset = (0 != entries) ? recordsEnd : 0;
+				numberOfIndexEntries = entries;
+				write_header();
+			}
+			file.close();
+		}
+	}
+
+	std::uint64_t CANBusCaptureWriter::get_number_of_frames() const
+	{
+		return numberOfRecords;
+	}
+
+	void CANBusCaptureWriter::write_header()
+	{
+		std::uint8_t *header = file.data();
+		std::memcpy(header, CANBusCaptureFormat::MAGIC, sizeof(CANBusCaptureFormat::MAGIC));
+		store_little_endian(header + 8, CANBusCaptureFormat::VERSION, 2);
+		store_little_endian(header + 10, CANBusCaptureFormat::HEADER_SIZE, 2);
+		store_little_endian(header + 12, CANBusCaptureFormat::RECORD_SIZE, 2);
+		store_little_endian(header + 14, 0, 2);
+		store_little_endian(header + 16, numberOfRecords, 8);
+		store_little_endian(header + 24, firstTimestamp_us, 8);
+		store_little_endian(header + 32, lastTimestamp_us, 8);
+		store_little_endian(header + 40, indexOffset, 8);
+		store_little_endian(header + 48, numberOfIndexEntries, 8);
+		store_little_endian(header + 56, CANBusCaptureFormat::INDEX_INTERVAL, 4);
+		store_little_endian(header + 60, 0, 4);
+	}
+
+	CANBusCaptureReader::CANBusCaptureReader(const std::string &filename)
+	{
+		if ((file.open(filename, MemoryMappedFile::Mode::ReadOnly)) &&
+		    (file.size() >= CANBusCaptureFormat::HEADER_SIZE) &&
+		    (0 == std::memcmp(file.data(), CANBusCaptureFormat::MAGIC, sizeof(CANBusCaptureFormat::MAGIC))) &&
+		    (CANBusCaptureFormat::VERSION == load_little_endian(file.data() + 8, 2)) &&
+		    (CANBusCaptureFormat::HEADER_SIZE == load_little_endian(file.data() + 10, 2)) &&
+		    (CANBusCaptureFormat::RECORD_SIZE == load_little_endian(file.data() + 12, 2)))
+		{
+			const std::uint8_t *header = file.data();
+			numberOfRecords = load_little_endian(header + 16, 8);
+			indexOffset = load_little_endian(header + 40, 8);
+			numberOfIndexEntries = load_little_endian(header + 48, 8);
+			indexInterval = static_cast<std::uint32_t>(load_little_endian(header + 56, 4));
+
+			// Only trust what actually fits in the file, in case the capture was cut off
+			std::uint64_t recordsInFile = (file.size() - CANBusCaptureFormat::HEADER_SIZE) / CANBusCaptureFormat::RECORD_SIZE;
+			if (numberOfRecords > recordsInFile)
+			{
+				numberOfRecords = recordsInFile;
+			}
+			if ((0 == indexInterval) ||
+			    (indexOffset < CANBusCaptureFormat::HEADER_SIZE + (numberOfRecords * CANBusCaptureFormat::RECORD_SIZE)) ||
+			    ((indexOffset + (numberOfIndexEntries * 8)) > file.size()))
+			{
+				indexOffset = 0;
+				numberOfIndexEntries = 0;
+			}
+			isValid = true;
+		}
+		else
+		{
+			LOG_ERROR("[Capture]: Failed to open capture file for reading, or it is not a valid capture");
+		}
+	}
+
+	bool CANBusCaptureReader::get_is_valid() const
+	{
+		return isValid;
+	}
+
+	std::uint64_t CANBusCaptureReader::get_number_of_frames() const
+	{
+		return numberOfRecords;
+	}
+
+	std::uint64_t CANBusCaptureReader::get_first_timestamp_us() const
+	{
+		return (0 != numberOfRecords) ? get_record_timestamp(0) : 0;
+	}
+
+	std::uint64_t CANBusCaptureReader::get_last_timestamp_us() const
+	{
+		return (0 != numberOfRecords) ? get_record_timestamp(numberOfRecords - 1) : 0;
+	}
+
+	bool CANBusCaptureReader::get_frame(std::uint64_t index, CANMessageFrame &frame, bool &transmitted) const
+	{
+		if (index >= numberOfRecords)
+		{
+			return false;
+		}
+
+		const std::uint8_t *record = file.data() + CANBusCaptureFormat::HEADER_SIZE + (index * CANBusCaptureFormat::RECORD_SIZE);
+		frame.timestamp_us = load_little_endian(record, 8);
+		frame.identifier = static_cast<std::uint32_t>(load_little_endian(record + 8, 4));
+		frame.channel = record[12];
+		frame.dataLength = (record[13] <= sizeof(frame.data)) ? record[13] : sizeof(frame.data);
+		frame.isExtendedFrame = (0 != (record[14] & CANBusCaptureFormat::FLAG_EXTENDED_FRAME));
+		transmitted = (0 != (record[14] & CANBusCaptureFormat::FLAG_TRANSMITTED));
+		std::memcpy(frame.data, record + 16, sizeof(frame.data));
+		return true;
+	}
+
+	std::uint64_t CANBusCaptureReader::find_frame(std::uint64_t timestamp_us) const
+	{
+		std::uint64_t first = 0;
+		std::uint64_t last = numberOfRecords;
+
+		if (0 != numberOfIndexEntries)
+		{
+			// Find the last index entry before the timestamp, the frame is in the interval after it
+			const std::uint8_t *index = file.data() + indexOffset;
+			std::uint64_t firstEntry = 0;
+			std::uint64_t lastEntry = numberOfIndexEntries;
+			while (firstEntry < lastEntry)
+			{
+				std::uint64_t middle = firstEntry + ((lastEntry - firstEntry) / 2);
+				if (load_little_endian(index + (middle * 8), 8) < timestamp_us)
+				{
+					firstEntry = middle + 1;
+				}
+				else
+				{
+					lastEntry = middle;
+				}
+			}
+
+			if (0 != firstEntry)
+			{
+				first = (firstEntry - 1) * indexInterval;
+			}
+			if ((firstEntry * indexInterval) < numberOfRecords)
+			{
+				last = firstEntry * indexInterval;
+			}
+		}
+
+		while (first < last)
+		{
+			std::uint64_t middle = first + ((last - first) / 2);
+			if (get_record_timestamp(middle) < timestamp_us)
+			{
+				first = middle + 1;
+			}
+			else
+			{
+				last = middle;
+			}
+		}
+		return first;
+	}
+
+	std::uint64_t CANBusCaptureReader::get_record_timestamp(std::uint64_t index) const
+	{
+		return load_little_endian(file.data() + CANBusCaptureFormat::HEADER_SIZE + (index * CANBusCaptureFormat::RECORD_SIZE), 8);
+	}
+
+	constexpr std::size_t CANBusCaptureReplay::DEFAULT_BATCH_SIZE;
+
+	CANBusCaptureReplay::CANBusCaptureReplay(const CANBusCaptureReader &reader, std::function<void(const CANMessageFrame &)> target, Timing timing) :
+	  reader(reader),
+	  target(target),
+	  timing(timing)
+	{
+	}
+
+	CANBusCaptureReplay::CANBusCaptureReplay(const CANBusCaptureReader &reader, CANHardwarePlugin &plugin, Timing timing) :
+	  CANBusCaptureReplay(
+	    reader, [&plugin](const CANMessageFrame &frame) { plugin.write_frame(frame); }, timing)
+	{
+	}
+
+	CANBusCaptureReplay::CANBusCaptureReplay(const CANBusCaptureReader &reader, CANNetworkManager &networkManager, Timing timing) :
+	  CANBusCaptureReplay(
+	    reader, [&networkManager](const CANMessageFrame &frame) { networkManager.process_receive_can_message_frame(frame); }, timing)
+	{
+	}
+
+	void CANBusCaptureReplay::set_replay_transmitted_frames(bool replay)
+	{
+		replayTransmittedFrames = replay;
+	}
+
+	void CANBusCaptureReplay::set_batch_size(std::size_t newBatchSize)
+	{
+		batchSize = newBatchSize;
+	}
+
+	void CANBusCaptureReplay::start(std::uint64_t startTimestamp_us)
+	{
+		nextFrame = reader.find_frame(startTimestamp_us);
+		captureStartTimestamp_us = (startTimestamp_us > reader.get_first_timestamp_us()) ? startTimestamp_us : reader.get_first_timestamp_us();
+		replayStartTimestamp_us = SystemTiming::get_timestamp_us();
+		replayedFrames = 0;
+	}
+
+	std::size_t CANBusCaptureReplay::update()
+	{
+		std::size_t retVal = 0;
+		const std::uint64_t elapsed_us = SystemTiming::get_timestamp_us() - replayStartTimestamp_us;
+		CANMessageFrame frame;
+		bool transmitted = false;
+
+		while ((Timing::Original == timing) || (0 == batchSize) || (retVal < batchSize))
+		{
+			if (!reader.get_frame(nextFrame, frame, transmitted))
+			{
+				break;
+			}
+
+			if ((Timing::Original == timing) &&
+			    ((frame.timestamp_us > captureStartTimestamp_us) && ((frame.timestamp_us - captureStartTimestamp_us) > elapsed_us)))
+			{
+				break; // Not due yet
+			}
+
+			nextFrame++;
+			if ((!transmitted) || replayTransmittedFrames)
+			{
+				target(frame);
+				replayedFrames++;
+				retVal++;
+			}
+		}
+		return retVal;
+	}
+
+	bool CANBusCaptureReplay::get_is_finished() const
+	{
+		return nextFrame >= reader.get_number_of_frames();
+	}
+
+	std::uint64_t CANBusCaptureReplay::get_number_of_replayed_frames() const
+	{
+		return replayedFrames;
+	}
+} // namespace isobus
@@ -13,13 +13,26 @@
 #include "isobus/utility/to_string.hpp"
 
 #include <algorithm>
+#include <array>
 #include <limits>
 
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
 namespace isobus
 {
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 	std::unique_ptr<std::thread> CANHardwareInterface::updateThread;
 	std::condition_variable CANHardwareInterface::updateThreadWakeupCondition;
+#ifdef __linux__
+	std::atomic<int> CANHardwareInterface::reactorFileDescriptor = { -1 };
+	std::atomic<int> CANHardwareInterface::wakeupFileDescriptor = { -1 };
+	std::atomic<int> CANHardwareInterface::timerFileDescriptor = { -1 };
+#endif
 #endif
 	std::uint32_t CANHardwareInterface::periodicUpdateInterval = PERIODIC_UPDATE_INTERVAL;
 	std::uint32_t CANHardwareInterface::lastUpdateTimestamp;
@@ -56,7 +69,15 @@ namespace isobus
 			if (frameHandler->get_is_valid())
 			{
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+#ifdef __linux__
+				// Drivers with a pollable file descriptor are serviced by the reactor instead of a dedicated thread
+				if ((-1 == CANHardwareInterface::reactorFileDescriptor) || (frameHandler->get_receive_file_descriptor() < 0))
+				{
+					start_threads();
+				}
+#else
 				start_threads();
+#endif
 #endif
 				retVal = true;
 			}
@@ -74,37 +95,150 @@ namespace isobus
 			frameHandler = nullptr;
 		}
 		messagesToBeTransmittedQueue.clear();
-		receivedMessagesQueue.clear();
+		{
+			LOCK_GUARD(Mutex, receivedMessagesMutex);
+			receivedMessagesQueue.clear();
+			receivedMessagesOverflowQueue.clear();
+		}
+		receiveQueueFull = false;
 		return false;
 	}
 
-	bool CANHardwareInterface::CANHardware::transmit_can_frame(const CANMessageFrame &frame) const
+	std::size_t CANHardwareInterface::CANHardware::transmit_can_frames(const CANMessageFrame *frames, std::size_t numberOfFrames) const
 	{
-		if ((nullptr != frameHandler) && frameHandler->get_is_valid() && frameHandler->write_frame(frame))
+		if ((nullptr != frameHandler) && frameHandler->get_is_valid())
 		{
-			return true;
+			return frameHandler->write_frames(frames, numberOfFrames);
 		}
-		return false;
+		return 0;
 	}
 
 	bool CANHardwareInterface::CANHardware::receive_can_frame()
 	{
-		if ((nullptr != frameHandler) && frameHandler->get_is_valid() && (!receivedMessagesQueue.is_full()))
+		if ((nullptr == frameHandler) || (!frameHandler->get_is_valid()))
 		{
-			CANMessageFrame frame;
-			if (frameHandler->read_frame(frame))
+			return false;
+		}
+
+		std::size_t maxFrames = receivedMessagesQueue.free_space();
+		if (0 == maxFrames)
+		{
+			if (QueueOverflowPolicy::BlockWithTimeout == receiveQueueOverflowPolicy)
 			{
-				receivedMessagesQueue.push(frame);
-				return true; // Indicate that a frame was read
+				// Leave the frames in the driver for now, only start dropping them once the timeout expired
+				if (!receiveQueueFull)
+				{
+					receiveQueueFull = true;
+					receiveQueueFullTimestamp_ms = SystemTiming::get_timestamp_ms();
+					return false;
+				}
+				else if ((std::numeric_limits<std::uint32_t>::max() == receiveQueueBlockTimeout_ms) ||
+				         (!SystemTiming::time_expired_ms(receiveQueueFullTimestamp_ms, receiveQueueBlockTimeout_ms)))
+				{
+					return false;
+				}
 			}
+			maxFrames = RECEIVE_BATCH_SIZE;
+		}
+		else
+		{
+			receiveQueueFull = false;
+		}
+
+		if (maxFrames > RECEIVE_BATCH_SIZE)
+		{
+			maxFrames = RECEIVE_BATCH_SIZE;
+		}
+
+		std::array<CANMessageFrame, RECEIVE_BATCH_SIZE> frames;
+		const std::size_t numberOfFrames = frameHandler->read_frames(frames.data(), maxFrames);
+		queue_received_frames(frames.data(), numberOfFrames);
+		return (numberOfFrames > 0); // Indicate if any frame was read
+	}
+
+	void CANHardwareInterface::CANHardware::queue_received_frames(const CANMessageFrame *frames, std::size_t numberOfFrames)
+	{
+		std::size_t framesQueued = 0;
+		std::size_t overflowQueueSize = 0;
+
+		switch (receiveQueueOverflowPolicy)
+		{
+			case QueueOverflowPolicy::DropOldest:
+			{
+				LOCK_GUARD(Mutex, receivedMessagesMutex);
+				framesQueued = receivedMessagesQueue.push_n(frames, numberOfFrames);
+				while (framesQueued < numberOfFrames)
+				{
+					// We hold the receiving side's lock, so we may take frames out of the queue ourselves
+					std::size_t framesRemoved = receivedMessagesQueue.pop(numberOfFrames - framesQueued);
+					receiveQueueDroppedFrames += framesRemoved;
+					framesQueued += receivedMessagesQueue.push_n(&frames[framesQueued], numberOfFrames - framesQueued);
+				}
+			}
+			break;
+
+			case QueueOverflowPolicy::Grow:
+			{
+				LOCK_GUARD(Mutex, receivedMessagesMutex);
+				// Once frames overflowed, keep adding to the overflow until it is drained to preserve the order
+				if (receivedMessagesOverflowQueue.empty())
+				{
+					framesQueued = receivedMessagesQueue.push_n(frames, numberOfFrames);
+				}
+				receivedMessagesOverflowQueue.insert(receivedMessagesOverflowQueue.end(), &frames[framesQueued], &frames[numberOfFrames]);
+				overflowQueueSize = receivedMessagesOverflowQueue.size();
+				framesQueued = numberOfFrames;
+			}
+			break;
+
+			case QueueOverflowPolicy::DropNewest:
+			case QueueOverflowPolicy::BlockWithTimeout:
+			default:
+			{
+				framesQueued = receivedMessagesQueue.push_n(frames, numberOfFrames);
+				receiveQueueDroppedFrames += (numberOfFrames - framesQueued);
+			}
+			break;
+		}
+		update_high_water_mark(receiveQueueHighWaterMark, receivedMessagesQueue.size() + overflowQueueSize);
+	}
+
+	bool CANHardwareInterface::CANHardware::pop_received_frame(CANMessageFrame &frame)
+	{
+		if ((QueueOverflowPolicy::DropOldest == receiveQueueOverflowPolicy) ||
+		    (QueueOverflowPolicy::Grow == receiveQueueOverflowPolicy))
+		{
+			LOCK_GUARD(Mutex, receivedMessagesMutex);
+			if (receivedMessagesQueue.try_pop(frame))
+			{
+				return true;
+			}
+			else if (!receivedMessagesOverflowQueue.empty())
+			{
+				frame = receivedMessagesOverflowQueue.front();
+				receivedMessagesOverflowQueue.pop_front();
+				return true;
+			}
+			return false;
+		}
+		return receivedMessagesQueue.try_pop(frame);
+	}
+
+	void CANHardwareInterface::CANHardware::update_high_water_mark(std::atomic<std::size_t> &highWaterMark, std::size_t usage)
+	{
+		std::size_t currentHighWaterMark = highWaterMark.load(std::memory_order_relaxed);
+		while ((usage > currentHighWaterMark) && (!highWaterMark.compare_exchange_weak(currentHighWaterMark, usage, std::memory_order_relaxed)))
+		{
 		}
-		return false;
 	}
 
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 	CANHardwareInterface::~CANHardwareInterface()
 	{
 		stop_threads();
+#ifdef __linux__
+		destroy_reactor();
+#endif
 	}
 
 	void CANHardwareInterface::CANHardware::start_threads()
@@ -142,7 +276,7 @@ namespace isobus
 				}
 				else
 				{
-					CANHardwareInterface::updateThreadWakeupCondition.notify_all();
+					CANHardwareInterface::wakeup_update_thread();
 				}
 			}
 			else
@@ -207,6 +341,63 @@ namespace isobus
 		return true;
 	}
 
+	bool CANHardwareInterface::set_queue_overflow_policy(std::uint8_t channelIndex, QueueOverflowPolicy policy, std::uint32_t blockTimeout_ms)
+	{
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+
+		if (started)
+		{
+			LOG_ERROR("[HardwareInterface] Cannot set a queue overflow policy after interface is started.");
+			return false;
+		}
+
+		if (channelIndex >= static_cast<std::uint8_t>(hardwareChannels.size()))
+		{
+			LOG_ERROR("[HardwareInterface] Unable to set the queue overflow policy of channel " + to_string(channelIndex) +
+			          ", because there are only " + to_string(hardwareChannels.size()) + " channels set.");
+			return false;
+		}
+
+		hardwareChannels[channelIndex]->receiveQueueOverflowPolicy = policy;
+		hardwareChannels[channelIndex]->receiveQueueBlockTimeout_ms = blockTimeout_ms;
+		return true;
+	}
+
+	CANHardwareInterface::ChannelStatistics CANHardwareInterface::get_channel_statistics(std::uint8_t channelIndex)
+	{
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+		ChannelStatistics retVal;
+
+		if (channelIndex < static_cast<std::uint8_t>(hardwareChannels.size()))
+		{
+			const std::unique_ptr<CANHardware> &channel = hardwareChannels[channelIndex];
+			retVal.receiveQueueDroppedFrames = channel->receiveQueueDroppedFrames;
+			retVal.transmitQueueRejectedFrames = channel->transmitQueueRejectedFrames;
+			retVal.receiveQueueHighWaterMark = channel->receiveQueueHighWaterMark;
+			retVal.transmitQueueHighWaterMark = channel->transmitQueueHighWaterMark;
+
+			std::shared_ptr<CANHardwarePlugin> frameHandler = channel->frameHandler;
+			if (nullptr != frameHandler)
+			{
+				retVal.driverDroppedFrames = frameHandler->get_number_of_dropped_frames();
+			}
+		}
+		return retVal;
+	}
+
+	void CANHardwareInterface::reset_channel_statistics(std::uint8_t channelIndex)
+	{
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+		if (channelIndex < static_cast<std::uint8_t>(hardwareChannels.size()))
+		{
+			const std::unique_ptr<CANHardware> &channel = hardwareChannels[channelIndex];
+			channel->receiveQueueDroppedFrames = 0;
+			channel->transmitQueueRejectedFrames = 0;
+			channel->receiveQueueHighWaterMark = 0;
+			channel->transmitQueueHighWaterMark = 0;
+		}
+	}
+
 	std::uint8_t CANHardwareInterface::get_number_of_can_channels()
 	{
 		return static_cast<std::uint8_t>(hardwareChannels.size() & std::numeric_limits<std::uint8_t>::max());
@@ -257,9 +448,15 @@ namespace isobus
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 		start_threads();
 #endif
-		std::for_each(hardwareChannels.begin(), hardwareChannels.end(), [](const std::unique_ptr<CANHardware> &channel) {
-			channel->start();
-		});
+		for (std::uint8_t i = 0; i < hardwareChannels.size(); i++)
+		{
+			if (hardwareChannels[i]->start())
+			{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+				register_channel_with_reactor(i);
+#endif
+			}
+		}
 
 		started = true;
 		return true;
@@ -286,6 +483,11 @@ namespace isobus
 		std::for_each(hardwareChannels.begin(), hardwareChannels.end(), [](const std::unique_ptr<CANHardware> &channel) {
 			channel->stop();
 		});
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+		// Only close the reactor once no receive thread can signal its wakeup event anymore
+		destroy_reactor();
+#endif
 		return true;
 	}
 
@@ -316,13 +518,17 @@ namespace isobus
 			return false;
 		}
 
-		if ((channel->frameHandler->get_is_valid()) &&
-		    (channel->messagesToBeTransmittedQueue.push(frame)))
+		if (channel->frameHandler->get_is_valid())
 		{
+			if (channel->messagesToBeTransmittedQueue.push(frame))
+			{
+				CANHardware::update_high_water_mark(channel->transmitQueueHighWaterMark, channel->messagesToBeTransmittedQueue.size());
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
-			updateThreadWakeupCondition.notify_all();
+				wakeup_update_thread();
 #endif
-			return true;
+				return true;
+			}
+			channel->transmitQueueRejectedFrames++;
 		}
 		return false;
 	}
@@ -345,6 +551,9 @@ namespace isobus
 	void CANHardwareInterface::set_periodic_update_interval(std::uint32_t value)
 	{
 		periodicUpdateInterval = value;
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+		arm_reactor_timer();
+#endif
 	}
 
 	std::uint32_t CANHardwareInterface::get_periodic_update_interval()
@@ -367,12 +576,11 @@ namespace isobus
 #endif
 
 					isobus::CANMessageFrame frame;
-					while (hardwareChannels[i]->receivedMessagesQueue.peek(frame))
+					while (hardwareChannels[i]->pop_received_frame(frame))
 					{
 						frame.channel = i;
 						frameReceivedEventDispatcher.invoke(frame);
 						receive_can_message_frame_from_hardware(frame);
-						hardwareChannels[i]->receivedMessagesQueue.pop();
 					}
 				}
 			}
@@ -389,19 +597,23 @@ namespace isobus
 			{
 				LOCK_GUARD(Mutex, hardwareChannelsMutex);
 				std::for_each(hardwareChannels.begin(), hardwareChannels.end(), [](const std::unique_ptr<CANHardware> &channel) {
-					isobus::CANMessageFrame frame;
-					while (channel->messagesToBeTransmittedQueue.peek(frame))
+					std::array<CANMessageFrame, TRANSMIT_BATCH_SIZE> frames;
+					std::size_t numberOfFrames = channel->messagesToBeTransmittedQueue.peek(frames.data(), frames.size());
+					while (numberOfFrames > 0)
 					{
-						if (channel->transmit_can_frame(frame))
+						const std::size_t framesTransmitted = channel->transmit_can_frames(frames.data(), numberOfFrames);
+						for (std::size_t i = 0; i < framesTransmitted; i++)
 						{
-							frameTransmittedEventDispatcher.invoke(frame);
-							on_transmit_can_message_frame_from_hardware(frame);
-							channel->messagesToBeTransmittedQueue.pop();
+							frameTransmittedEventDispatcher.invoke(frames[i]);
+							on_transmit_can_message_frame_from_hardware(frames[i]);
 						}
-						else
+						channel->messagesToBeTransmittedQueue.pop(framesTransmitted);
+
+						if (framesTransmitted < numberOfFrames)
 						{
-							break;
+							break; // The hardware didn't accept everything, try the remaining frames again next update
 						}
+						numberOfFrames = channel->messagesToBeTransmittedQueue.peek(frames.data(), frames.size());
 					}
 				});
 			}
@@ -415,6 +627,14 @@ namespace isobus
 		// Wait until everything is running
 		hardwareLock.unlock();
 
+#ifdef __linux__
+		if (-1 != reactorFileDescriptor)
+		{
+			reactor_thread_function();
+			return;
+		}
+#endif
+
 		while (started)
 		{
 			std::unique_lock<std::mutex> threadLock(updateMutex);
@@ -428,6 +648,13 @@ namespace isobus
 		started = true;
 		if (nullptr == updateThread)
 		{
+#ifdef __linux__
+			destroy_reactor();
+			if (!create_reactor())
+			{
+				LOG_WARNING("[HardwareInterface] Unable to create the epoll reactor, falling back to a receive thread per channel and a polled update loop.");
+			}
+#endif
 			updateThread.reset(new std::thread(update_thread_function));
 		}
 	}
@@ -439,11 +666,145 @@ namespace isobus
 		{
 			if (updateThread->joinable())
 			{
-				updateThreadWakeupCondition.notify_all();
+				wakeup_update_thread();
 				updateThread->join();
 			}
 			updateThread = nullptr;
 		}
 	}
+
+	void CANHardwareInterface::wakeup_update_thread()
+	{
+#ifdef __linux__
+		if (-1 != wakeupFileDescriptor)
+		{
+			const std::uint64_t increment = 1;
+			if (static_cast<ssize_t>(sizeof(increment)) == write(wakeupFileDescriptor, &increment, sizeof(increment)))
+			{
+				return;
+			}
+		}
+#endif
+		updateThreadWakeupCondition.notify_all();
+	}
+
+#ifdef __linux__
+	bool CANHardwareInterface::create_reactor()
+	{
+		struct epoll_event event;
+
+		reactorFileDescriptor = epoll_create1(EPOLL_CLOEXEC);
+		wakeupFileDescriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		timerFileDescriptor = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+		if ((-1 == reactorFileDescriptor) || (-1 == wakeupFileDescriptor) || (-1 == timerFileDescriptor))
+		{
+			destroy_reactor();
+			return false;
+		}
+
+		event.events = EPOLLIN;
+		event.data.u64 = REACTOR_WAKEUP_EVENT;
+		if (0 != epoll_ctl(reactorFileDescriptor, EPOLL_CTL_ADD, wakeupFileDescriptor, &event))
+		{
+			destroy_reactor();
+			return false;
+		}
+
+		event.events = EPOLLIN;
+		event.data.u64 = REACTOR_TIMER_EVENT;
+		if (0 != epoll_ctl(reactorFileDescriptor, EPOLL_CTL_ADD, timerFileDescriptor, &event))
+		{
+			destroy_reactor();
+			return false;
+		}
+		arm_reactor_timer();
+		return true;
+	}
+
+	void CANHardwareInterface::destroy_reactor()
+	{
+		for (std::atomic<int> *fileDescriptor : { &reactorFileDescriptor, &wakeupFileDescriptor, &timerFileDescriptor })
+		{
+			const int previousFileDescriptor = fileDescriptor->exchange(-1);
+			if (-1 != previousFileDescriptor)
+			{
+				close(previousFileDescriptor);
+			}
+		}
+	}
+
+	void CANHardwareInterface::arm_reactor_timer()
+	{
+		if (-1 != timerFileDescriptor)
+		{
+			struct itimerspec timerSpecification;
+			const std::uint32_t interval_ms = std::max<std::uint32_t>(periodicUpdateInterval, 1);
+
+			timerSpecification.it_interval.tv_sec = interval_ms / 1000;
+			timerSpecification.it_interval.tv_nsec = static_cast<long>(interval_ms % 1000) * 1000000L;
+			timerSpecification.it_value = timerSpecification.it_interval;
+			timerfd_settime(timerFileDescriptor, 0, &timerSpecification, nullptr);
+		}
+	}
+
+	void CANHardwareInterface::register_channel_with_reactor(std::uint8_t channelIndex)
+	{
+		if ((-1 != reactorFileDescriptor) &&
+		    (channelIndex < hardwareChannels.size()) &&
+		    (nullptr != hardwareChannels[channelIndex]->frameHandler))
+		{
+			const int channelFileDescriptor = hardwareChannels[channelIndex]->frameHandler->get_receive_file_descriptor();
+
+			if (channelFileDescriptor >= 0)
+			{
+				struct epoll_event event;
+				event.events = EPOLLIN;
+				event.data.u64 = REACTOR_CHANNEL_EVENT_OFFSET + channelIndex;
+
+				if (0 != epoll_ctl(reactorFileDescriptor, EPOLL_CTL_ADD, channelFileDescriptor, &event))
+				{
+					LOG_ERROR("[HardwareInterface] Unable to add channel " + to_string(channelIndex) + " to the epoll reactor, starting a receive thread for it instead.");
+					hardwareChannels[channelIndex]->start_threads();
+				}
+			}
+		}
+	}
+
+	void CANHardwareInterface::reactor_thread_function()
+	{
+		struct epoll_event events[REACTOR_MAX_EVENTS];
+
+		// The channels can't be added, removed or reassigned while the interface is started, and stop() joins this thread
+		// before stopping them, so the channels are read here without holding the channel mutex.
+		while (started)
+		{
+			const int numberOfEvents = epoll_wait(reactorFileDescriptor, events, REACTOR_MAX_EVENTS, -1);
+
+			for (int i = 0; i < numberOfEvents; i++)
+			{
+				if (REACTOR_CHANNEL_EVENT_OFFSET <= events[i].data.u64)
+				{
+					// Move the frames into the channel's queue, the update below will process them
+					const std::size_t channelIndex = static_cast<std::size_t>(events[i].data.u64 - REACTOR_CHANNEL_EVENT_OFFSET);
+					if (channelIndex < hardwareChannels.size())
+					{
+						hardwareChannels[channelIndex]->receive_can_frame();
+					}
+				}
+				else
+				{
+					// Consume the wakeup or timer expiration count, we only care that it happened.
+					// A failed read means another wakeup already consumed it, which is fine too.
+					std::uint64_t expirations;
+					const int eventFileDescriptor = (REACTOR_TIMER_EVENT == events[i].data.u64) ? timerFileDescriptor : wakeupFileDescriptor;
+					const ssize_t bytesRead = read(eventFileDescriptor, &expirations, sizeof(expirations));
+					static_cast<void>(bytesRead);
+				}
+			}
+			update();
+		}
+	}
+#endif
 #endif
 }
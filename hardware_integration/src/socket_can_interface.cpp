@@ -15,6 +15,7 @@
 #include <net/if.h>
 #include <poll.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
 #include <sys/time.h>
 #include <unistd.h>
 #include <algorithm>
@@ -28,7 +29,8 @@ namespace isobus
 	SocketCANInterface::SocketCANInterface(const std::string deviceName) :
 	  pCANDevice(new sockaddr_can),
 	  name(deviceName),
-	  fileDescriptor(-1)
+	  fileDescriptor(-1),
+	  droppedFrames(0)
 	{
 		if (nullptr != pCANDevice)
 		{
@@ -71,6 +73,7 @@ namespace isobus
 	void SocketCANInterface::open()
 	{
 		fileDescriptor = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+		droppedFrames = 0;
 
 		if (fileDescriptor >= 0)
 		{
@@ -112,9 +115,19 @@ namespace isobus
 	}
 
 	bool SocketCANInterface::read_frame(isobus::CANMessageFrame &canFrame)
+	{
+		return (1 == read_frames(&canFrame, 1));
+	}
+
+	std::size_t SocketCANInterface::read_frames(isobus::CANMessageFrame *canFrames, std::size_t maxFrames)
 	{
 		struct pollfd pollingFileDescriptor;
-		bool retVal = false;
+		std::size_t retVal = 0;
+
+		if ((nullptr == canFrames) || (0 == maxFrames))
+		{
+			return retVal;
+		}
 
 		pollingFileDescriptor.fd = fileDescriptor;
 		pollingFileDescriptor.events = POLLIN;
@@ -122,65 +135,39 @@ namespace isobus
 
 		if (1 == poll(&pollingFileDescriptor, 1, 100))
 		{
-			canFrame.timestamp_us = std::numeric_limits<std::uint64_t>::max();
-			struct can_frame txFrame;
-			struct msghdr message;
-			struct iovec segment;
-
-			char lControlMessage[CMSG_SPACE(sizeof(struct timeval) + (3 * sizeof(struct timespec)) + sizeof(std::uint32_t))];
-
-			segment.iov_base = &txFrame;
-			segment.iov_len = sizeof(struct can_frame);
-			message.msg_iov = &segment;
-			message.msg_iovlen = 1;
-			message.msg_control = &lControlMessage;
-			message.msg_controllen = sizeof(lControlMessage);
-			message.msg_name = pCANDevice;
-			message.msg_namelen = sizeof(struct sockaddr_can);
-			message.msg_flags = 0;
-
-			if (recvmsg(fileDescriptor, &message, 0) > 0)
+			constexpr std::size_t CONTROL_MESSAGE_SIZE = CMSG_SPACE(sizeof(struct timeval) + (3 * sizeof(struct timespec)) + sizeof(std::uint32_t));
+			struct can_frame rxFrames[MAX_RECEIVE_BATCH_SIZE];
+			struct mmsghdr messages[MAX_RECEIVE_BATCH_SIZE];
+			struct iovec segments[MAX_RECEIVE_BATCH_SIZE];
+			struct sockaddr_can sourceAddresses[MAX_RECEIVE_BATCH_SIZE];
+			char controlMessages[MAX_RECEIVE_BATCH_SIZE][CONTROL_MESSAGE_SIZE];
+			const std::size_t batchSize = (maxFrames < MAX_RECEIVE_BATCH_SIZE) ? maxFrames : MAX_RECEIVE_BATCH_SIZE;
+
+			for (std::size_t i = 0; i < batchSize; i++)
 			{
-				if (0 == (txFrame.can_id & CAN_ERR_FLAG))
-				{
-					if (0 != (txFrame.can_id & CAN_EFF_FLAG))
-					{
-						canFrame.identifier = (txFrame.can_id & CAN_EFF_MASK);
-						canFrame.isExtendedFrame = true;
-					}
-					else
-					{
-						canFrame.identifier = (txFrame.can_id & CAN_SFF_MASK);
-						canFrame.isExtendedFrame = false;
-					}
-					canFrame.dataLength = txFrame.can_dlc;
-					memset(canFrame.data, 0, sizeof(canFrame.data));
-					memcpy(canFrame.data, txFrame.data, canFrame.dataLength);
+				segments[i].iov_base = &rxFrames[i];
+				segments[i].iov_len = sizeof(struct can_frame);
+				messages[i].msg_hdr.msg_iov = &segments[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+				messages[i].msg_hdr.msg_control = controlMessages[i];
+				messages[i].msg_hdr.msg_controllen = CONTROL_MESSAGE_SIZE;
+				messages[i].msg_hdr.msg_name = &sourceAddresses[i];
+				messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_can);
+				messages[i].msg_hdr.msg_flags = 0;
+				messages[i].msg_len = 0;
+			}
+
+			// The poll guarantees at least one frame is pending, so don't block waiting for a full batch
+			const int numberOfMessages = recvmmsg(fileDescriptor, messages, static_cast<unsigned int>(batchSize), MSG_DONTWAIT, nullptr);
 
-					for (struct cmsghdr *pControlMessage = CMSG_FIRSTHDR(&message); (nullptr != pControlMessage) && (SOL_SOCKET == pControlMessage->cmsg_level); pControlMessage = CMSG_NXTHDR(&message, pControlMessage))
+			if (numberOfMessages > 0)
+			{
+				for (int i = 0; i < numberOfMessages; i++)
+				{
+					if (parse_received_frame(rxFrames[i], messages[i].msg_hdr, canFrames[retVal]))
 					{
-						switch (pControlMessage->cmsg_type)
-						{
-							case SO_TIMESTAMP:
-							{
-								struct timeval *time = (struct timeval *)CMSG_DATA(pControlMessage);
-
-								if (std::numeric_limits<std::uint64_t>::max() == canFrame.timestamp_us)
-								{
-									canFrame.timestamp_us = static_cast<std::uint64_t>(time->tv_usec) + (static_cast<std::uint64_t>(time->tv_sec) * 1000000);
-								}
-							}
-							break;
-
-							case SO_TIMESTAMPING:
-							{
-								struct timespec *time = (struct timespec *)(CMSG_DATA(pControlMessage));
-								canFrame.timestamp_us = (static_cast<std::uint64_t>(time[2].tv_nsec) / 1000) + (static_cast<std::uint64_t>(time[2].tv_sec) * 1000000);
-							}
-							break;
-						}
+						retVal++;
 					}
-					retVal = true;
 				}
 			}
 			else if (errno == ENETDOWN)
@@ -196,19 +183,70 @@ namespace isobus
 		return retVal;
 	}
 
-	bool SocketCANInterface::write_frame(const isobus::CANMessageFrame &canFrame)
+	bool SocketCANInterface::parse_received_frame(const struct can_frame &rxFrame, struct msghdr &message, isobus::CANMessageFrame &canFrame)
 	{
-		struct can_frame txFrame;
 		bool retVal = false;
 
-		txFrame.can_id = canFrame.identifier;
-		txFrame.can_dlc = canFrame.dataLength;
-		memcpy(txFrame.data, canFrame.data, canFrame.dataLength);
-
-		if (canFrame.isExtendedFrame)
+		if (0 == (rxFrame.can_id & CAN_ERR_FLAG))
 		{
-			txFrame.can_id |= CAN_EFF_FLAG;
+			canFrame.timestamp_us = std::numeric_limits<std::uint64_t>::max();
+
+			if (0 != (rxFrame.can_id & CAN_EFF_FLAG))
+			{
+				canFrame.identifier = (rxFrame.can_id & CAN_EFF_MASK);
+				canFrame.isExtendedFrame = true;
+			}
+			else
+			{
+				canFrame.identifier = (rxFrame.can_id & CAN_SFF_MASK);
+				canFrame.isExtendedFrame = false;
+			}
+			canFrame.dataLength = rxFrame.can_dlc;
+			memset(canFrame.data, 0, sizeof(canFrame.data));
+			memcpy(canFrame.data, rxFrame.data, canFrame.dataLength);
+
+			for (struct cmsghdr *pControlMessage = CMSG_FIRSTHDR(&message); (nullptr != pControlMessage) && (SOL_SOCKET == pControlMessage->cmsg_level); pControlMessage = CMSG_NXTHDR(&message, pControlMessage))
+			{
+				switch (pControlMessage->cmsg_type)
+				{
+					case SO_TIMESTAMP:
+					{
+						struct timeval *time = (struct timeval *)CMSG_DATA(pControlMessage);
+
+						if (std::numeric_limits<std::uint64_t>::max() == canFrame.timestamp_us)
+						{
+							canFrame.timestamp_us = static_cast<std::uint64_t>(time->tv_usec) + (static_cast<std::uint64_t>(time->tv_sec) * 1000000);
+						}
+					}
+					break;
+
+					case SO_TIMESTAMPING:
+					{
+						struct timespec *time = (struct timespec *)(CMSG_DATA(pControlMessage));
+						canFrame.timestamp_us = (static_cast<std::uint64_t>(time[2].tv_nsec) / 1000) + (static_cast<std::uint64_t>(time[2].tv_sec) * 1000000);
+					}
+					break;
+
+					case SO_RXQ_OVFL:
+					{
+						std::uint32_t overflowCount;
+						memcpy(&overflowCount, CMSG_DATA(pControlMessage), sizeof(overflowCount));
+						droppedFrames = overflowCount;
+					}
+					break;
+				}
+			}
+			retVal = true;
 		}
+		return retVal;
+	}
+
+	bool SocketCANInterface::write_frame(const isobus::CANMessageFrame &canFrame)
+	{
+		struct can_frame txFrame;
+		bool retVal = false;
+
+		build_transmit_frame(canFrame, txFrame);
 
 		if (write(fileDescriptor, &txFrame, sizeof(struct can_frame)) > 0)
 		{
@@ -222,6 +260,75 @@ namespace isobus
 		return retVal;
 	}
 
+	std::size_t SocketCANInterface::write_frames(const isobus::CANMessageFrame *canFrames, std::size_t numberOfFrames)
+	{
+		std::size_t retVal = 0;
+
+		while ((nullptr != canFrames) && (retVal < numberOfFrames) && get_is_valid())
+		{
+			struct can_frame txFrames[MAX_TRANSMIT_BATCH_SIZE];
+			struct mmsghdr messages[MAX_TRANSMIT_BATCH_SIZE];
+			struct iovec segments[MAX_TRANSMIT_BATCH_SIZE];
+			const std::size_t remainingFrames = numberOfFrames - retVal;
+			const std::size_t batchSize = (remainingFrames < MAX_TRANSMIT_BATCH_SIZE) ? remainingFrames : MAX_TRANSMIT_BATCH_SIZE;
+
+			for (std::size_t i = 0; i < batchSize; i++)
+			{
+				build_transmit_frame(canFrames[retVal + i], txFrames[i]);
+				segments[i].iov_base = &txFrames[i];
+				segments[i].iov_len = sizeof(struct can_frame);
+				memset(&messages[i], 0, sizeof(struct mmsghdr));
+				messages[i].msg_hdr.msg_iov = &segments[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			const int numberOfMessages = sendmmsg(fileDescriptor, messages, static_cast<unsigned int>(batchSize), 0);
+
+			if (numberOfMessages > 0)
+			{
+				retVal += static_cast<std::size_t>(numberOfMessages);
+
+				if (static_cast<std::size_t>(numberOfMessages) < batchSize)
+				{
+					break; // The socket buffer is full, leave the rest for the next attempt
+				}
+			}
+			else
+			{
+				if (errno == ENETDOWN)
+				{
+					LOG_CRITICAL("[SocketCAN] " + get_device_name() + " interface is down.");
+					close();
+				}
+				break;
+			}
+		}
+		return retVal;
+	}
+
+	void SocketCANInterface::build_transmit_frame(const isobus::CANMessageFrame &canFrame, struct can_frame &txFrame)
+	{
+		memset(&txFrame, 0, sizeof(struct can_frame));
+		txFrame.can_id = canFrame.identifier;
+		txFrame.can_dlc = canFrame.dataLength;
+		memcpy(txFrame.data, canFrame.data, canFrame.dataLength);
+
+		if (canFrame.isExtendedFrame)
+		{
+			txFrame.can_id |= CAN_EFF_FLAG;
+		}
+	}
+
+	int SocketCANInterface::get_receive_file_descriptor() const
+	{
+		return fileDescriptor;
+	}
+
+	std::uint32_t SocketCANInterface::get_number_of_dropped_frames() const
+	{
+		return droppedFrames;
+	}
+
 	bool SocketCANInterface::set_name(const std::string &newName)
 	{
 		bool retVal = false;
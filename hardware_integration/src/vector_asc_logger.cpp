@@ -9,17 +9,91 @@
 #include "isobus/utility/system_timing.hpp"
 #include "isobus/utility/to_string.hpp"
 
-#include <cmath>
+#include <chrono>
+#include <cstdio>
 #include <ctime>
-#include <iomanip>
 
 namespace isobus
 {
-	VectorASCLogger::VectorASCLogger()
+	constexpr std::size_t VectorASCLogger::DEFAULT_QUEUE_SIZE;
+	constexpr std::size_t VectorASCLogger::WRITE_BLOCK_SIZE;
+	constexpr std::uint32_t VectorASCLogger::WRITER_PERIOD_MS;
+
+	VectorASCLogger::VectorASCLogger() :
+	  VectorASCLogger(get_default_file_name(), 0, 0)
+	{
+	}
+
+	VectorASCLogger::VectorASCLogger(std::string filename) :
+	  VectorASCLogger(filename, 0, 0)
+	{
+	}
+
+	VectorASCLogger::VectorASCLogger(std::string filename, std::size_t maximumFileSize_bytes, std::uint32_t maximumFileDuration_s, std::size_t queueSize) :
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+	  queuedFrames(queueSize),
+#endif
+	  fileName(filename),
+	  maximumFileSize_bytes(maximumFileSize_bytes),
+	  maximumFileDuration_s(maximumFileDuration_s)
+	{
+		static_cast<void>(queueSize); // Only used for the ring buffer
+		writeBuffer.reserve(WRITE_BLOCK_SIZE);
+
+		if (open_file(fileName))
+		{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+			writerThread = std::thread([this]() { writer_thread_function(); });
+#endif
+			canFrameReceivedListener = isobus::CANHardwareInterface::get_can_frame_received_event_dispatcher().add_listener([this](const isobus::CANMessageFrame &canFrame) {
+				on_frame(canFrame, false);
+			});
+			canFrameSentListener = isobus::CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().add_listener([this](const isobus::CANMessageFrame &canFrame) {
+				on_frame(canFrame, true);
+			});
+		}
+		else
+		{
+			LOG_ERROR("[ASC Logger]: Failed to open log file for writing");
+		}
+	}
+
+	VectorASCLogger::~VectorASCLogger()
+	{
+		if (logFileStream)
+		{
+			isobus::CANHardwareInterface::get_can_frame_received_event_dispatcher().remove_listener(canFrameReceivedListener);
+			isobus::CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().remove_listener(canFrameSentListener);
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+			{
+				std::lock_guard<std::mutex> lock(writerMutex);
+				stopWriter = true;
+			}
+			writerWakeUp.notify_one();
+			writerThread.join();
+			write_queued_frames();
+#endif
+			flush_write_buffer();
+			logFileStream.close();
+		}
+	}
+
+	std::size_t VectorASCLogger::get_number_of_dropped_frames() const
+	{
+		return droppedFrames;
+	}
+
+	std::size_t VectorASCLogger::get_number_of_files() const
+	{
+		return numberOfFiles;
+	}
+
+	std::string VectorASCLogger::get_default_file_name()
 	{
 		std::time_t currentTime = std::time(0);
 		std::tm *now = std::localtime(&currentTime);
-		std::string defaultFileName = "AgISOStackLog_" +
+		return "AgISOStackLog_" +
 		  isobus::to_string(now->tm_year + 1900) +
 		  "_" +
 		  isobus::to_string(now->tm_mon + 1) +
@@ -32,91 +106,153 @@ namespace isobus
 		  "_" +
 		  isobus::to_string(now->tm_sec) +
 		  ".asc";
-		openFile(defaultFileName, constructHeaderTime(currentTime));
 	}
 
-	VectorASCLogger::VectorASCLogger(std::string filename)
+	bool VectorASCLogger::open_file(const std::string &filePath)
 	{
-		std::time_t currentTime = std::time(0);
+		initialTimestamp_us = SystemTiming::get_timestamp_us();
+		currentFileSize_bytes = 0;
+
+		logFileStream.open(filePath, std::ios::out | std::ios::trunc | std::ios::binary);
 
-		openFile(filename, constructHeaderTime(currentTime));
+		// Write vector ascii header
+		if (logFileStream)
+		{
+			numberOfFiles++;
+			writeBuffer += constructHeaderTime(std::time(0));
+			writeBuffer += "\nbase hex timestamps absolute\nno internal events logged\n";
+		}
+		return static_cast<bool>(logFileStream);
 	}
 
-	VectorASCLogger::~VectorASCLogger()
+	void VectorASCLogger::rotate_file()
 	{
-		if (logFileStream)
+		flush_write_buffer();
+		logFileStream.close();
+
+		if (!open_file(get_rotated_file_name(numberOfFiles)))
 		{
-			isobus::CANHardwareInterface::get_can_frame_received_event_dispatcher().remove_listener(canFrameReceivedListener);
-			isobus::CANHardwareInterface::get_can_frame_received_event_dispatcher().remove_listener(canFrameSentListener);
-			logFileStream.close();
+			LOG_ERROR("[ASC Logger]: Failed to open the next log file for writing");
 		}
 	}
 
-	void VectorASCLogger::openFile(const std::string &filePath, const std::string &headerTime)
+	std::string VectorASCLogger::get_rotated_file_name(std::size_t index) const
 	{
-		initialTimestamp = SystemTiming::get_timestamp_ms();
+		std::string retVal = fileName;
 
-		logFileStream.open(filePath, std::ios::out | std::ios::trunc);
+		if (0 != index)
+		{
+			std::size_t extensionPosition = fileName.find_last_of('.');
+			std::size_t directoryPosition = fileName.find_last_of("/\\");
 
-		// Write vector ascii header
-		if (logFileStream)
+			if ((std::string::npos == extensionPosition) ||
+			    ((std::string::npos != directoryPosition) && (extensionPosition < directoryPosition)))
+			{
+				extensionPosition = fileName.size();
+			}
+			retVal.insert(extensionPosition, "_" + isobus::to_string(index));
+		}
+		return retVal;
+	}
+
+	void VectorASCLogger::on_frame(const CANMessageFrame &frame, bool transmitted)
+	{
+		LoggedFrame loggedFrame = { frame, transmitted };
+		loggedFrame.frame.timestamp_us = SystemTiming::get_timestamp_us();
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		// Only copy the frame here, the writer thread does the formatting and file I/O
+		if (!queuedFrames.push(loggedFrame))
 		{
-			logFileStream << "date " << headerTime << "\n";
-			logFileStream << "base hex timestamps absolute\n";
-			logFileStream << "no internal events logged\n";
-			canFrameReceivedListener = isobus::CANHardwareInterface::get_can_frame_received_event_dispatcher().add_listener([this](const isobus::CANMessageFrame &canFrame) {
-				logFileStream << "   ";
-				auto currentTime = SystemTiming::get_timestamp_ms() - initialTimestamp;
-				auto milliseconds = isobus::to_string(currentTime % 1000);
-
-				while (milliseconds.length() < 3)
-				{
-					milliseconds = "0" + milliseconds;
-				}
-
-				logFileStream << isobus::to_string(std::floor(currentTime / 1000)) +
-				    "." +
-				    milliseconds +
-				    "000 1  ";
-				logFileStream << std::hex << std::uppercase
-				              << std::setw(8) << std::setfill('0') << canFrame.identifier << "x       Rx   d " + isobus::to_string(static_cast<int>(canFrame.dataLength)) + " ";
-
-				for (std::uint_fast8_t i = 0; i < canFrame.dataLength; i++)
-				{
-					logFileStream << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << static_cast<int>(canFrame.data[i]) << " ";
-				}
-				logFileStream << "\n";
-			});
+			droppedFrames++;
+		}
+#else
+		write_frame(loggedFrame.frame, transmitted);
+		if (writeBuffer.size() >= WRITE_BLOCK_SIZE)
+		{
+			flush_write_buffer();
+		}
+#endif
+	}
 
-			canFrameSentListener = isobus::CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().add_listener([this](const isobus::CANMessageFrame &canFrame) {
-				logFileStream << "   ";
-				auto currentTime = SystemTiming::get_timestamp_ms() - initialTimestamp;
-				auto milliseconds = isobus::to_string(currentTime % 1000);
-
-				while (milliseconds.length() < 3)
-				{
-					milliseconds = "0" + milliseconds;
-				}
-
-				logFileStream << isobus::to_string(std::floor(currentTime / 1000)) +
-				    "." +
-				    milliseconds +
-				    "000 1  ";
-				logFileStream << std::hex << std::uppercase
-				              << std::setw(8) << std::setfill('0') << canFrame.identifier << "x       Tx   d " + isobus::to_string(static_cast<int>(canFrame.dataLength)) + " ";
-
-				for (std::uint_fast8_t i = 0; i < canFrame.dataLength; i++)
-				{
-					logFileStream << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << static_cast<int>(canFrame.data[i]) << " ";
-				}
-				logFileStream << "\n";
-			});
+	void VectorASCLogger::write_frame(const CANMessageFrame &frame, bool transmitted)
+	{
+		if (!logFileStream)
+		{
+			return;
 		}
-		else
+
+		std::uint64_t relativeTimestamp_us = (frame.timestamp_us > initialTimestamp_us) ? (frame.timestamp_us - initialTimestamp_us) : 0;
+		if (((0 != maximumFileSize_bytes) && ((currentFileSize_bytes + writeBuffer.size()) >= maximumFileSize_bytes)) ||
+		    ((0 != maximumFileDuration_s) && (relativeTimestamp_us >= (static_cast<std::uint64_t>(maximumFileDuration_s) * 1000000))))
 		{
-			LOG_ERROR("[ASC Logger]: Failed to open log file for writing");
+			rotate_file();
+			relativeTimestamp_us = (frame.timestamp_us > initialTimestamp_us) ? (frame.timestamp_us - initialTimestamp_us) : 0;
+		}
+
+		// Large enough for the longest possible line: a 20 digit timestamp, an extended ID and 8 data bytes
+		char line[128];
+		int length = std::snprintf(line,
+		                           sizeof(line),
+		                           frame.isExtendedFrame ? "   %llu.%06u %u  %08Xx       %s   d %u" : "   %llu.%06u %u  %X       %s   d %u",
+		                           static_cast<unsigned long long>(relativeTimestamp_us / 1000000),
+		                           static_cast<unsigned int>(relativeTimestamp_us % 1000000),
+		                           static_cast<unsigned int>(frame.channel) + 1,
+		                           static_cast<unsigned int>(frame.identifier),
+		                           transmitted ? "Tx" : "Rx",
+		                           static_cast<unsigned int>(frame.dataLength));
+
+		for (std::uint_fast8_t i = 0; (i < frame.dataLength) && (i < sizeof(frame.data)) && (length > 0); i++)
+		{
+			length += std::snprintf(line + length, sizeof(line) - length, " %02X", static_cast<unsigned int>(frame.data[i]));
+		}
+
+		if (length > 0)
+		{
+			writeBuffer.append(line, static_cast<std::size_t>(length));
+			writeBuffer += '\n';
+		}
+	}
+
+	void VectorASCLogger::flush_write_buffer()
+	{
+		if (!writeBuffer.empty())
+		{
+			logFileStream.write(writeBuffer.data(), static_cast<std::streamsize>(writeBuffer.size()));
+			logFileStream.flush();
+			currentFileSize_bytes += writeBuffer.size();
+			writeBuffer.clear();
+		}
+	}
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+	void VectorASCLogger::writer_thread_function()
+	{
+		std::unique_lock<std::mutex> lock(writerMutex);
+		while (!stopWriter)
+		{
+			writerWakeUp.wait_for(lock, std::chrono::milliseconds(WRITER_PERIOD_MS), [this]() { return stopWriter.load(); });
+			write_queued_frames();
+			flush_write_buffer();
+		}
+	}
+
+	void VectorASCLogger::write_queued_frames()
+	{
+		LoggedFrame loggedFrame;
+
+		while (queuedFrames.peek(loggedFrame))
+		{
+			write_frame(loggedFrame.frame, loggedFrame.transmitted);
+			queuedFrames.pop();
+
+			if (writeBuffer.size() >= WRITE_BLOCK_SIZE)
+			{
+				flush_write_buffer();
+			}
 		}
 	}
+#endif
 
 	std::string VectorASCLogger::constructHeaderTime(const std::time_t &currentTime)
 	{
@@ -135,13 +271,13 @@ namespace isobus
 			"Dec"
 		};
 		const std::string DAYS_OF_THE_WEEK_ABBREVIATED[] = {
+			"Sun",
 			"Mon",
 			"Tue",
 			"Wed",
 			"Thu",
 			"Fri",
-			"Sat",
-			"Sun"
+			"Sat"
 		};
 		std ::tm *now = std::localtime(&currentTime);
 		std::string amOrPM = now->tm_hour > 11 ? std::string("pm") : std::string("am");
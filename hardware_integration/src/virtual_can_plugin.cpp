@@ -99,6 +99,20 @@ namespace isobus
 		return false;
 	}
 
+	std::size_t VirtualCANPlugin::read_frames(isobus::CANMessageFrame *canFrames, std::size_t maxFrames)
+	{
+		std::size_t retVal = 0;
+		std::unique_lock<std::mutex> lock(mutex);
+		ourDevice->condition.wait_for(lock, std::chrono::milliseconds(1000), [this] { return !ourDevice->queue.empty() || !running; });
+		while ((retVal < maxFrames) && (!ourDevice->queue.empty()))
+		{
+			canFrames[retVal] = ourDevice->queue.front();
+			ourDevice->queue.pop_front();
+			retVal++;
+		}
+		return retVal;
+	}
+
 	bool VirtualCANPlugin::get_queue_empty() const
 	{
 		const std::lock_guard<std::mutex> lock(mutex);
@@ -43,6 +43,14 @@ namespace isobus
 		/// @returns true if a NAME matches this filter class's components
 		bool check_name_matches_filter(const NAME &nameToCompare) const;
 
+		/// @brief Returns the bits of a raw 64 bit NAME this filter checks, and the value those bits must have
+		/// @details A NAME matches the filter when `(rawNAME & mask) == value`. Several filters can be combined
+		/// into a single mask and value by OR-ing them together, as long as they don't contradict each other.
+		/// @param[out] mask The bits of the NAME that this filter checks
+		/// @param[out] maskedValue The value the masked bits of the NAME must have
+		/// @returns true if the filter can match a NAME, false if its value does not fit in the NAME component
+		bool get_NAME_mask_and_value(std::uint64_t &mask, std::uint64_t &maskedValue) const;
+
 	private:
 		NAME::NAMEParameters parameter; ///< The NAME component to filter against
 		std::uint32_t value; ///< The value of the data associated with the filter component
@@ -0,0 +1,100 @@
+//================================================================================================
+/// @file can_async_stack_logger.hpp
+///
+/// @brief A log sink that hands log text to a background thread, so that writing the log
+/// does not slow down the thread that logged it.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#ifndef CAN_ASYNC_STACK_LOGGER_HPP
+#define CAN_ASYNC_STACK_LOGGER_HPP
+
+#include "isobus/isobus/can_stack_logger.hpp"
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class AsyncCANStackLogger
+	///
+	/// @brief A log sink that copies log text into a ring buffer and passes it on to another
+	/// sink from a background writer thread.
+	/// @details Logging only costs a copy of the text, so slow sinks (like ones writing to a file or a
+	/// console) do not distort the timing of the stack. If the ring buffer is full, the record is dropped
+	/// and counted instead of blocking. Text longer than MAX_RECORD_LENGTH is truncated.
+	/// The CANStackLogger serializes all log calls, so the ring buffer only ever has one producer.
+	//================================================================================================
+	class AsyncCANStackLogger : public CANStackLogger
+	{
+	public:
+		static constexpr std::size_t DEFAULT_QUEUE_SIZE = 256; ///< The default number of records the ring buffer can hold
+		static constexpr std::size_t MAX_RECORD_LENGTH = 255; ///< The maximum number of characters of text in one record
+
+		/// @brief Constructs the logger and starts its writer thread
+		/// @param[in] targetSink The sink that the writer thread passes the log text to
+		/// @param[in] queueSize The number of records the ring buffer can hold, rounded up to a power of two
+		/// @param[in] writerPeriod_ms How often the writer thread empties the ring buffer
+		explicit AsyncCANStackLogger(CANStackLogger &targetSink, std::size_t queueSize = DEFAULT_QUEUE_SIZE, std::uint32_t writerPeriod_ms = 10);
+
+		/// @brief Stops the writer thread, after it has passed on all records still in the ring buffer
+		~AsyncCANStackLogger();
+
+		/// @brief Deleted copy constructor
+		AsyncCANStackLogger(const AsyncCANStackLogger &) = delete;
+
+		/// @brief Deleted assignment operator
+		/// @returns Nothing, this function is deleted
+		AsyncCANStackLogger &operator=(const AsyncCANStackLogger &) = delete;
+
+		/// @brief Queues log text for the writer thread
+		/// @param[in] level The severity level of the log text
+		/// @param[in] logText The information being logged
+		void sink_CAN_stack_log(LoggingLevel level, const std::string &logText) override;
+
+		/// @brief Queues log text for the writer thread
+		/// @param[in] level The severity level of the log text
+		/// @param[in] logText The information being logged
+		/// @param[in] length The number of characters in logText
+		void sink_CAN_stack_log_text(LoggingLevel level, const char *logText, std::size_t length) override;
+
+		/// @brief Returns the number of records that were dropped because the ring buffer was full
+		/// @returns The number of dropped records since construction
+		std::size_t get_number_of_dropped_records() const;
+
+	private:
+		/// @brief One log statement as it is stored in the ring buffer
+		struct LogRecord
+		{
+			LoggingLevel level = LoggingLevel::Debug; ///< The severity level of the text
+			std::uint16_t length = 0; ///< The number of characters in text
+			char text[MAX_RECORD_LENGTH + 1]; ///< The null terminated log text
+		};
+
+		/// @brief Periodically passes records from the ring buffer to the target sink until the logger is destroyed
+		void writer_thread_function();
+
+		/// @brief Passes all records currently in the ring buffer to the target sink
+		void write_records();
+
+		CANStackLogger &targetSink; ///< The sink that the writer thread passes the log text to
+		LockFreeQueue<LogRecord> records; ///< The records waiting for the writer thread
+		std::atomic<std::size_t> droppedRecords = { 0 }; ///< The number of records dropped because the ring buffer was full
+		std::atomic<bool> stopWriter = { false }; ///< Tells the writer thread to stop
+		const std::uint32_t writerPeriod_ms; ///< How often the writer thread empties the ring buffer
+		std::mutex writerMutex; ///< Protects the wake up of the writer thread when the logger is destroyed
+		std::condition_variable writerWakeUp; ///< Wakes up the writer thread when the logger is destroyed
+		std::thread writerThread; ///< The thread that passes records to the target sink
+	};
+} // namespace isobus
+
+#endif
+
+#endif // CAN_ASYNC_STACK_LOGGER_HPP
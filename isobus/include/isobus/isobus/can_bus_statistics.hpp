@@ -0,0 +1,146 @@
+//================================================================================================
+/// @file can_bus_statistics.hpp
+///
+/// @brief Keeps a breakdown of the traffic on a CAN channel by source address and by PGN,
+/// which can be used to find out what is causing a high busload.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+
+#ifndef CAN_BUS_STATISTICS_HPP
+#define CAN_BUS_STATISTICS_HPP
+
+#include "isobus/isobus/can_message_frame.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isobus
+{
+	/// @brief Counts the frames and bits on a CAN channel per source address and per PGN over a sliding window
+	/// @details The window is split into a number of sub-windows. Frames are counted in the current sub-window,
+	/// and each time the window advances the oldest sub-window is dropped from the totals. This way the totals
+	/// always cover the last full window, which is the same window used for the busload estimate.
+	///
+	/// All memory is allocated up front, so counting a frame never allocates and takes constant time.
+	/// A limited number of distinct PGNs is tracked; traffic of any further PGNs, and of standard (11 bit) frames,
+	/// is counted under `UNTRACKED_PARAMETER_GROUP_NUMBER`. A PGN stops being tracked once it has no traffic left in the window.
+	///
+	/// @note This class is not thread safe, the owner is responsible for locking.
+	class CANBusStatistics
+	{
+	public:
+		/// @brief The traffic of a single source address or PGN over the window
+		struct TalkerStatistics
+		{
+			std::uint32_t key; ///< The source address or PGN this traffic belongs to
+			std::uint32_t numberOfFrames; ///< The number of frames in the window
+			std::uint32_t numberOfBits; ///< The number of bits on the bus in the window, including stuff bits
+		};
+
+		static constexpr std::size_t NUMBER_OF_SUB_WINDOWS = 10; ///< The number of sub-windows the window is split into
+		static constexpr std::size_t MAX_NUMBER_OF_PARAMETER_GROUP_NUMBERS = 64; ///< The max number of distinct PGNs that are tracked at once
+		static constexpr std::uint32_t UNTRACKED_PARAMETER_GROUP_NUMBER = 0xFFFFFFFF; ///< The key under which traffic of untracked PGNs is counted
+
+		/// @brief Constructs an empty set of statistics
+		CANBusStatistics();
+
+		/// @brief Counts a frame in the current sub-window
+		/// @param[in] frame The frame that was sent or received
+		/// @param[in] numberOfBits The number of bits the frame took up on the bus
+		void process_frame(const CANMessageFrame &frame, std::uint32_t numberOfBits);
+
+		/// @brief Starts a new sub-window, dropping the oldest one from the totals
+		void advance_window();
+
+		/// @brief Returns the traffic sent by a source address over the window
+		/// @param[in] sourceAddress The source address to get the traffic of
+		/// @returns The traffic sent by the source address
+		TalkerStatistics get_source_address_statistics(std::uint8_t sourceAddress) const;
+
+		/// @brief Returns the traffic of a PGN over the window
+		/// @param[in] parameterGroupNumber The PGN to get the traffic of, or `UNTRACKED_PARAMETER_GROUP_NUMBER`
+		/// @returns The traffic of the PGN, which is empty if the PGN is not being tracked
+		TalkerStatistics get_parameter_group_number_statistics(std::uint32_t parameterGroupNumber) const;
+
+		/// @brief Returns the source addresses that sent the most bits over the window
+		/// @param[in] count The max number of source addresses to return
+		/// @returns Up to `count` source addresses with traffic, sorted by number of bits, highest first
+		std::vector<TalkerStatistics> get_top_source_addresses(std::size_t count) const;
+
+		/// @brief Returns the PGNs that took up the most bits over the window
+		/// @param[in] count The max number of PGNs to return
+		/// @returns Up to `count` PGNs with traffic, sorted by number of bits, highest first
+		std::vector<TalkerStatistics> get_top_parameter_group_numbers(std::size_t count) const;
+
+		/// @brief Resets all counters
+		void clear();
+
+	private:
+		/// @brief A frame and bit count
+		struct Counters
+		{
+			std::uint32_t numberOfFrames = 0; ///< The number of frames
+			std::uint32_t numberOfBits = 0; ///< The number of bits
+		};
+
+		/// @brief The counters of one source address or PGN, for each sub-window and in total
+		struct History
+		{
+			std::array<Counters, NUMBER_OF_SUB_WINDOWS> subWindows; ///< The counters of each sub-window
+			Counters total; ///< The sum of all sub-windows
+		};
+
+		/// @brief A tracked PGN and its history
+		struct ParameterGroupNumberHistory
+		{
+			std::uint32_t parameterGroupNumber = UNTRACKED_PARAMETER_GROUP_NUMBER; ///< The PGN
+			History history; ///< The traffic of the PGN
+		};
+
+		static constexpr std::size_t NUMBER_OF_SOURCE_ADDRESSES = 256; ///< One history for every possible source address
+		static constexpr std::size_t PARAMETER_GROUP_NUMBER_INDEX_SIZE = 2 * MAX_NUMBER_OF_PARAMETER_GROUP_NUMBERS; ///< The size of the PGN hash index, a power of two
+		static constexpr std::uint8_t EMPTY_INDEX_SLOT = 0xFF; ///< Marks an unused slot in the PGN hash index
+
+		/// @brief Adds a frame to the current sub-window of a history
+		/// @param[in] history The history to add the frame to
+		/// @param[in] numberOfBits The number of bits of the frame
+		void add_frame(History &history, std::uint32_t numberOfBits);
+
+		/// @brief Finds the history of a PGN, and starts tracking the PGN if there is room
+		/// @param[in] parameterGroupNumber The PGN to find
+		/// @returns The history of the PGN, or the history of untracked PGNs if there is no room
+		History &find_or_add_parameter_group_number(std::uint32_t parameterGroupNumber);
+
+		/// @brief Finds the slot in the PGN hash index for a PGN
+		/// @param[in] parameterGroupNumber The PGN to find
+		/// @returns The index slot that holds the PGN, or the empty slot where it would go
+		std::size_t find_index_slot(std::uint32_t parameterGroupNumber) const;
+
+		/// @brief Stops tracking PGNs that have no traffic left in the window, and rebuilds the PGN hash index
+		void remove_idle_parameter_group_numbers();
+
+		/// @brief Converts a history to the public statistics format
+		/// @param[in] key The source address or PGN of the history
+		/// @param[in] history The history to convert
+		/// @returns The totals of the history
+		static TalkerStatistics to_talker_statistics(std::uint32_t key, const History &history);
+
+		/// @brief Sorts statistics by number of bits, highest first, and keeps the first `count` of them
+		/// @param[in,out] statistics The statistics to sort
+		/// @param[in] count The max number of statistics to keep
+		static void keep_top(std::vector<TalkerStatistics> &statistics, std::size_t count);
+
+		std::array<History, NUMBER_OF_SOURCE_ADDRESSES> sourceAddressHistories; ///< The traffic of each source address
+		std::array<ParameterGroupNumberHistory, MAX_NUMBER_OF_PARAMETER_GROUP_NUMBERS> parameterGroupNumberHistories; ///< The traffic of each tracked PGN, the first `numberOfParameterGroupNumbers` are in use
+		std::array<std::uint8_t, PARAMETER_GROUP_NUMBER_INDEX_SIZE> parameterGroupNumberIndex; ///< Hash index from PGN to its position in `parameterGroupNumberHistories`
+		History untrackedParameterGroupNumberHistory; ///< The traffic of all PGNs that are not tracked
+		std::size_t numberOfParameterGroupNumbers = 0; ///< The number of PGNs being tracked
+		std::size_t currentSubWindow = 0; ///< The sub-window frames are currently counted in
+	};
+} // namespace isobus
+
+#endif // CAN_BUS_STATISTICS_HPP
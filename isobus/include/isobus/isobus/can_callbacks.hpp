@@ -11,7 +11,11 @@
 #define CAN_CALLBACKS_HPP
 
 #include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 #include "isobus/isobus/can_message.hpp"
+#include "isobus/utility/thread_synchronization.hpp"
 
 namespace isobus
 {
@@ -111,6 +115,53 @@ namespace isobus
 		void *parent; ///< A generic variable that can provide context to which object the callback was meant for
 		std::shared_ptr<InternalControlFunction> internalControlFunctionFilter; ///< An optional way to filter callbacks based on the destination of messages from the partner
 	};
+
+	/// @brief A container of PGN callbacks that is indexed by parameter group number
+	/// @details Callbacks are stored in buckets keyed by PGN, so finding the callbacks for a
+	/// received message is a single hash lookup instead of a compare against every registered callback.
+	/// Each bucket is copy-on-write: adding or removing a callback replaces the bucket for that PGN,
+	/// and dispatching takes a reference to the current bucket. This means callbacks can be added or
+	/// removed from inside a callback without invalidating the dispatch in progress, and without
+	/// holding the table's mutex while user code runs.
+	/// Callbacks for the same PGN are always kept in the order they were added.
+	class ParameterGroupNumberCallbackTable
+	{
+	public:
+		/// @brief An immutable snapshot of the callbacks registered for one PGN, in registration order
+		using CallbackList = std::shared_ptr<const std::vector<ParameterGroupNumberCallbackData>>;
+
+		/// @brief Adds a callback to the table
+		/// @param[in] callbackData The callback to add
+		/// @param[in] allowDuplicates If false, the callback is not added when an identical one is already registered
+		/// @returns true if the callback was added, otherwise false
+		bool add_callback(const ParameterGroupNumberCallbackData &callbackData, bool allowDuplicates = true);
+
+		/// @brief Removes the first callback that matches *exactly* the one passed in
+		/// @param[in] callbackData The callback to remove
+		/// @returns true if a callback was removed, otherwise false
+		bool remove_callback(const ParameterGroupNumberCallbackData &callbackData);
+
+		/// @brief Returns the callbacks registered for a PGN
+		/// @details The returned list is a snapshot. Changes made to the table after this call
+		/// (including ones made by the callbacks themselves) do not affect it.
+		/// @param[in] parameterGroupNumber The PGN to get the callbacks for
+		/// @returns The callbacks registered for the PGN, or nullptr if there are none
+		CallbackList get_callbacks(std::uint32_t parameterGroupNumber) const;
+
+		/// @brief Returns a callback by index, in the order the callbacks were added
+		/// @param[in] index The index of the callback to get
+		/// @returns The callback at the index, or an empty callback if the index is out of range
+		ParameterGroupNumberCallbackData get_callback(std::size_t index) const;
+
+		/// @brief Returns the total number of callbacks in the table
+		/// @returns The total number of callbacks in the table
+		std::size_t size() const;
+
+	private:
+		std::unordered_map<std::uint32_t, CallbackList> callbacksByParameterGroupNumber; ///< The callbacks, bucketed by PGN
+		std::vector<ParameterGroupNumberCallbackData> callbacksInOrder; ///< All callbacks in the order they were added, for indexed access
+		mutable Mutex tableMutex; ///< Protects the table against concurrent modification
+	};
 } // namespace isobus
 
 #endif // CAN_CALLBACKS_HPP
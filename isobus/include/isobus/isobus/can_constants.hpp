@@ -16,6 +16,13 @@
 #define CAN_PORT_MAXIMUM_VALUE 4
 #endif
 
+#ifndef CAN_MESSAGE_INLINE_DATA_LENGTH_VALUE
+/// @brief Number of payload bytes a CAN message stores inline, without a heap allocation
+/// @details This value can be configured at build time using CMake option -DCAN_MESSAGE_INLINE_DATA_LENGTH_VALUE=<value>
+/// The default value is 8, which covers every single frame message. Valid range is 8-1785.
+#define CAN_MESSAGE_INLINE_DATA_LENGTH_VALUE 8
+#endif
+
 #include <cstdint>
 
 namespace isobus
@@ -26,6 +33,7 @@ namespace isobus
 	constexpr std::uint8_t BROADCAST_CAN_ADDRESS = 0xFF; ///< The global/broadcast CAN address
 	constexpr std::uint8_t CAN_DATA_LENGTH = 8; ///< The length of a classical CAN frame
 	constexpr std::uint32_t CAN_PORT_MAXIMUM = CAN_PORT_MAXIMUM_VALUE; ///< An arbitrary limit for memory consumption (configurable via CMake)
+	constexpr std::uint32_t CAN_MESSAGE_INLINE_DATA_LENGTH = CAN_MESSAGE_INLINE_DATA_LENGTH_VALUE; ///< Payloads up to this length are stored inside the CAN message (configurable via CMake)
 	constexpr std::uint16_t NULL_OBJECT_ID = 65535; ///< Special ID used to indicate no object
 
 }
@@ -12,9 +12,13 @@
 #ifndef CAN_EXTENDED_TRANSPORT_PROTOCOL_HPP
 #define CAN_EXTENDED_TRANSPORT_PROTOCOL_HPP
 
+#include "isobus/isobus/can_message_buffer_pool.hpp"
 #include "isobus/isobus/can_message_frame.hpp"
 #include "isobus/isobus/can_network_configuration.hpp"
 #include "isobus/isobus/can_transport_protocol_base.hpp"
+#include "isobus/isobus/can_transport_protocol_session_table.hpp"
+
+#include <vector>
 
 namespace isobus
 {
@@ -155,6 +159,8 @@ namespace isobus
 		static constexpr std::uint8_t TR_TIMEOUT_MS = 200; ///< The Tr Timeout as defined by the standard
 		static constexpr std::uint8_t SEQUENCE_NUMBER_DATA_INDEX = 0; ///< The index of the sequence number in a frame
 		static constexpr std::uint8_t PROTOCOL_BYTES_PER_FRAME = 7; ///< The number of payload bytes per frame minus overhead of sequence number
+		static constexpr std::uint32_t RECEIVE_BUFFER_CHUNK_SIZE = 4096; ///< Receive buffers grow in steps of this many bytes so similar sized messages can share them
+		static constexpr std::uint32_t MAX_POOLED_RECEIVE_BUFFER_SIZE = 65536; ///< Receive buffers larger than this are freed rather than kept for reuse
 
 		/// @brief The constructor for the ExtendedTransportProtocolManager, for advanced use only.
 		/// In most cases, you should use the CANNetworkManager::send_can_message() function to transmit messages.
@@ -179,6 +185,11 @@ namespace isobus
 		/// @returns A list of all the active transport protocol sessions
 		const std::vector<std::shared_ptr<ExtendedTransportProtocolSession>> &get_sessions() const;
 
+		/// @brief Returns the pool that reassembly buffers for received messages are borrowed from
+		/// @details Useful for checking how often receive buffers are reused rather than allocated.
+		/// @returns The pool of receive buffers
+		const CANMessageBufferPool &get_receive_buffer_pool() const;
+
 		/// @brief A generic way for a protocol to process a received message
 		/// @param[in] message A received CAN message
 		void process_message(const CANMessage &message);
@@ -241,9 +252,21 @@ namespace isobus
 		/// @returns true if the EOM was sent, false if sending was not successful
 		bool send_end_of_session_acknowledgement(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const;
 
-		///@brief Sends data transfer packets for the specified ExtendedTransportProtocolSession.
-		/// @param[in] session The ExtendedTransportProtocolSession for which to send data transfer packets.
-		void send_data_transfer_packets(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const;
+		/// @brief Sends the next data transfer packet of the specified session
+		/// @param[in] session The session for which to send a data transfer packet
+		/// @returns true if the packet was sent, false if sending was not successful
+		bool send_data_transfer_packet(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const;
+
+		/// @brief Checks if a session is sending data, and enough time has passed since its last data transfer packet
+		/// @param[in] session The session to check
+		/// @returns true if the session can send a data transfer packet now, otherwise false
+		bool is_ready_to_send_data_transfer_packet(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const;
+
+		/// @brief Sends the data transfer packets of all sessions in @ref dataTransferSchedule
+		/// @details Sessions take turns sending one packet each, until all of them are done with their
+		/// current DPO window or the max number of frames per update is reached, so that one large transfer
+		/// doesn't hold up the other sessions on the same channel. The session that goes first rotates every update.
+		void send_scheduled_data_transfer_packets();
 
 		/// @brief Processes a request to send a message over the CAN transport protocol.
 		/// @param[in] source The shared pointer to the source control function.
@@ -294,13 +317,16 @@ namespace isobus
 		/// @param[in] source The source control function for the session
 		/// @param[in] destination The destination control function for the session
 		/// @returns a matching session, or nullptr if no session matched the supplied parameters
-		std::shared_ptr<ExtendedTransportProtocolSession> get_session(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination);
+		std::shared_ptr<ExtendedTransportProtocolSession> get_session(const std::shared_ptr<ControlFunction> &source, const std::shared_ptr<ControlFunction> &destination);
 
 		/// @brief Update the state machine for the passed in session
 		/// @param[in] session The session to update
 		void update_state_machine(std::shared_ptr<ExtendedTransportProtocolSession> &session);
 
-		std::vector<std::shared_ptr<ExtendedTransportProtocolSession>> activeSessions; ///< A list of all active ETP sessions
+		TransportProtocolSessionTable<ExtendedTransportProtocolSession> activeSessions; ///< All active ETP sessions, indexed by source and destination
+		CANMessageBufferPool receiveBufferPool; ///< Reassembly buffers for received messages, sized in chunks
+		std::vector<std::shared_ptr<ExtendedTransportProtocolSession>> dataTransferSchedule; ///< Sessions that are ready to send data transfer packets in the current update
+		std::size_t dataTransferRoundRobinOffset = 0; ///< Rotates which session sends the first data transfer packet of each update
 		const CANMessageFrameCallback sendCANFrameCallback; ///< A callback for sending a CAN frame
 		const CANMessageCallback canMessageReceivedCallback; ///< A callback for when a complete CAN message is received using the ETP protocol
 		const CANNetworkConfiguration *configuration; ///< The configuration to use for this protocol
@@ -17,6 +17,11 @@
 #include "isobus/isobus/can_identifier.hpp"
 #include "isobus/utility/data_span.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
 #include <vector>
 
 namespace isobus
@@ -24,6 +29,409 @@ namespace isobus
 	/// @brief A read-only span of data for a CAN message
 	using CANDataSpan = DataSpan<const std::uint8_t>;
 
+	//================================================================================================
+	/// @class CANMessagePayload
+	///
+	/// @brief The data payload of a CAN message, with small-buffer optimization.
+	/// @details Payloads up to `CAN_MESSAGE_INLINE_DATA_LENGTH` bytes (by default a single CAN frame)
+	/// are stored inside the object itself, so creating, copying or moving a single frame message
+	/// never touches the heap. Larger payloads, like ones reassembled by a transport protocol,
+	/// are stored in a vector instead.
+	/// The interface mirrors the read-only part of `std::vector`, including the container type aliases,
+	/// a bounds-checked at() and comparisons, along with the common ways of editing a copy of a payload.
+	/// The payload converts implicitly to a `std::vector<std::uint8_t>` where a vector is required.
+	//================================================================================================
+	class CANMessagePayload
+	{
+	public:
+		using value_type = std::uint8_t; ///< The type of a byte in the payload
+		using size_type = std::size_t; ///< The type used for sizes and indices
+		using difference_type = std::ptrdiff_t; ///< The type of the distance between two iterators
+		using reference = std::uint8_t &; ///< A reference to a byte
+		using const_reference = const std::uint8_t &; ///< A read-only reference to a byte
+		using pointer = std::uint8_t *; ///< A pointer to a byte
+		using const_pointer = const std::uint8_t *; ///< A read-only pointer to a byte
+		using iterator = std::uint8_t *; ///< An iterator over the payload
+		using const_iterator = const std::uint8_t *; ///< A read-only iterator over the payload
+		using reverse_iterator = std::reverse_iterator<iterator>; ///< A reverse iterator over the payload
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>; ///< A read-only reverse iterator over the payload
+
+		/// @brief Constructs an empty payload
+		CANMessagePayload() = default;
+
+		/// @brief Constructs a payload by copying a buffer
+		/// @param[in] dataBuffer The start of the data to copy
+		/// @param[in] length The number of bytes to copy
+		CANMessagePayload(const std::uint8_t *dataBuffer, std::size_t length)
+		{
+			assign(dataBuffer, length);
+		}
+
+		/// @brief Constructs a payload from a vector, taking over its storage if it does not fit inline
+		/// @param[in] dataBuffer The data to store
+		explicit CANMessagePayload(std::vector<std::uint8_t> &&dataBuffer)
+		{
+			if (dataBuffer.size() > CAN_MESSAGE_INLINE_DATA_LENGTH)
+			{
+				heapData = std::move(dataBuffer);
+				length = heapData.size();
+			}
+			else
+			{
+				assign(dataBuffer.data(), dataBuffer.size());
+			}
+		}
+
+		/// @brief Returns the byte at an index, without bounds checking
+		/// @param[in] index The index of the byte to get
+		/// @returns The byte at the index
+		std::uint8_t &operator[](std::size_t index)
+		{
+			return data()[index];
+		}
+
+		/// @brief Returns the byte at an index, without bounds checking
+		/// @param[in] index The index of the byte to get
+		/// @returns The byte at the index
+		const std::uint8_t &operator[](std::size_t index) const
+		{
+			return data()[index];
+		}
+
+		/// @brief Returns the byte at an index, like `std::vector::at`
+		/// @param[in] index The index of the byte to get
+		/// @returns The byte at the index
+		/// @throws std::out_of_range if the index is not less than size()
+		std::uint8_t &at(std::size_t index)
+		{
+			check_index(index);
+			return data()[index];
+		}
+
+		/// @brief Returns the byte at an index, like `std::vector::at`
+		/// @param[in] index The index of the byte to get
+		/// @returns The byte at the index
+		/// @throws std::out_of_range if the index is not less than size()
+		const std::uint8_t &at(std::size_t index) const
+		{
+			check_index(index);
+			return data()[index];
+		}
+
+		/// @brief Returns the first byte of the payload
+		/// @attention The payload must not be empty
+		/// @returns The first byte of the payload
+		const std::uint8_t &front() const
+		{
+			return data()[0];
+		}
+
+		/// @brief Returns the last byte of the payload
+		/// @attention The payload must not be empty
+		/// @returns The last byte of the payload
+		const std::uint8_t &back() const
+		{
+			return data()[length - 1];
+		}
+
+		/// @brief Returns the number of bytes in the payload
+		/// @returns The number of bytes in the payload
+		std::size_t size() const
+		{
+			return length;
+		}
+
+		/// @brief Returns if the payload has no bytes in it
+		/// @returns true if the payload is empty, otherwise false
+		bool empty() const
+		{
+			return (0 == length);
+		}
+
+		/// @brief Returns if the payload is stored inside this object rather than on the heap
+		/// @returns true if the payload is stored inline, otherwise false
+		bool is_stored_inline() const
+		{
+			return (length <= CAN_MESSAGE_INLINE_DATA_LENGTH);
+		}
+
+		/// @brief Returns a pointer to the first byte of the payload
+		/// @returns A pointer to the first byte of the payload
+		std::uint8_t *data()
+		{
+			return is_stored_inline() ? inlineData.data() : heapData.data();
+		}
+
+		/// @brief Returns a pointer to the first byte of the payload
+		/// @returns A pointer to the first byte of the payload
+		const std::uint8_t *data() const
+		{
+			return is_stored_inline() ? inlineData.data() : heapData.data();
+		}
+
+		/// @brief Returns an iterator to the first byte of the payload
+		/// @returns An iterator to the first byte of the payload
+		iterator begin()
+		{
+			return data();
+		}
+
+		/// @brief Returns an iterator to one past the last byte of the payload
+		/// @returns An iterator to one past the last byte of the payload
+		iterator end()
+		{
+			return data() + length;
+		}
+
+		/// @brief Returns an iterator to the first byte of the payload
+		/// @returns An iterator to the first byte of the payload
+		const_iterator begin() const
+		{
+			return data();
+		}
+
+		/// @brief Returns an iterator to one past the last byte of the payload
+		/// @returns An iterator to one past the last byte of the payload
+		const_iterator end() const
+		{
+			return data() + length;
+		}
+
+		/// @brief Returns an iterator to the first byte of the payload
+		/// @returns An iterator to the first byte of the payload
+		const_iterator cbegin() const
+		{
+			return begin();
+		}
+
+		/// @brief Returns an iterator to one past the last byte of the payload
+		/// @returns An iterator to one past the last byte of the payload
+		const_iterator cend() const
+		{
+			return end();
+		}
+
+		/// @brief Returns a reverse iterator to the last byte of the payload
+		/// @returns A reverse iterator to the last byte of the payload
+		const_reverse_iterator rbegin() const
+		{
+			return const_reverse_iterator(end());
+		}
+
+		/// @brief Returns a reverse iterator to one before the first byte of the payload
+		/// @returns A reverse iterator to one before the first byte of the payload
+		const_reverse_iterator rend() const
+		{
+			return const_reverse_iterator(begin());
+		}
+
+		/// @brief Returns a reverse iterator to the last byte of the payload
+		/// @returns A reverse iterator to the last byte of the payload
+		const_reverse_iterator crbegin() const
+		{
+			return rbegin();
+		}
+
+		/// @brief Returns a reverse iterator to one before the first byte of the payload
+		/// @returns A reverse iterator to one before the first byte of the payload
+		const_reverse_iterator crend() const
+		{
+			return rend();
+		}
+
+		/// @brief Replaces the payload with a copy of a buffer
+		/// @param[in] dataBuffer The start of the data to copy
+		/// @param[in] newLength The number of bytes to copy
+		void assign(const std::uint8_t *dataBuffer, std::size_t newLength)
+		{
+			if (newLength > CAN_MESSAGE_INLINE_DATA_LENGTH)
+			{
+				heapData.assign(dataBuffer, dataBuffer + newLength);
+			}
+			else
+			{
+				heapData.clear();
+				if (0 != newLength)
+				{
+					std::memcpy(inlineData.data(), dataBuffer, newLength);
+				}
+			}
+			length = newLength;
+		}
+
+		/// @brief Appends a copy of a buffer to the end of the payload
+		/// @param[in] dataBuffer The start of the data to copy
+		/// @param[in] appendLength The number of bytes to copy
+		void append(const std::uint8_t *dataBuffer, std::size_t appendLength)
+		{
+			const std::size_t oldLength = length;
+			resize(oldLength + appendLength);
+			if (0 != appendLength)
+			{
+				std::memcpy(data() + oldLength, dataBuffer, appendLength);
+			}
+		}
+
+		/// @brief Appends a byte to the end of the payload
+		/// @param[in] value The byte to append
+		void push_back(std::uint8_t value)
+		{
+			append(&value, 1);
+		}
+
+		/// @brief Inserts a copy of a range of bytes before a position in the payload
+		/// @param[in] position The position to insert the bytes before, an iterator into this payload
+		/// @param[in] first The first byte to insert
+		/// @param[in] last One past the last byte to insert
+		/// @returns An iterator to the first inserted byte
+		iterator insert(const_iterator position, const std::uint8_t *first, const std::uint8_t *last)
+		{
+			const std::size_t offset = static_cast<std::size_t>(position - begin());
+			const std::size_t insertLength = static_cast<std::size_t>(last - first);
+			const std::size_t oldLength = length;
+
+			if (0 != insertLength)
+			{
+				// Copy the range first, it may point into this payload
+				const std::vector<std::uint8_t> insertedBytes(first, last);
+				resize(oldLength + insertLength);
+				std::memmove(data() + offset + insertLength, data() + offset, oldLength - offset);
+				std::memcpy(data() + offset, insertedBytes.data(), insertLength);
+			}
+			return begin() + offset;
+		}
+
+		/// @brief Removes a byte from the payload
+		/// @param[in] position The byte to remove, an iterator into this payload
+		/// @returns An iterator to the byte after the removed one
+		iterator erase(const_iterator position)
+		{
+			return erase(position, position + 1);
+		}
+
+		/// @brief Removes a range of bytes from the payload
+		/// @param[in] first The first byte to remove, an iterator into this payload
+		/// @param[in] last One past the last byte to remove, an iterator into this payload
+		/// @returns An iterator to the byte after the removed ones
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			const std::size_t offset = static_cast<std::size_t>(first - begin());
+			const std::size_t eraseLength = static_cast<std::size_t>(last - first);
+
+			if (0 != eraseLength)
+			{
+				std::memmove(data() + offset, data() + offset + eraseLength, length - offset - eraseLength);
+				resize(length - eraseLength);
+			}
+			return begin() + offset;
+		}
+
+		/// @brief Removes all bytes from the payload
+		void clear()
+		{
+			resize(0);
+		}
+
+		/// @brief Changes the length of the payload. New bytes are zeroed.
+		/// @param[in] newLength The new length of the payload
+		void resize(std::size_t newLength)
+		{
+			if (newLength > CAN_MESSAGE_INLINE_DATA_LENGTH)
+			{
+				if (is_stored_inline())
+				{
+					heapData.assign(inlineData.data(), inlineData.data() + length);
+				}
+				heapData.resize(newLength, 0);
+			}
+			else
+			{
+				if (!is_stored_inline())
+				{
+					std::memcpy(inlineData.data(), heapData.data(), newLength);
+					heapData.clear();
+				}
+				else if (newLength > length)
+				{
+					std::memset(inlineData.data() + length, 0, newLength - length);
+				}
+			}
+			length = newLength;
+		}
+
+		/// @brief Moves the payload out into a vector, leaving the payload empty
+		/// @details If the payload is stored on the heap, its storage is handed over without copying.
+		/// @returns The payload as a vector
+		std::vector<std::uint8_t> release()
+		{
+			std::vector<std::uint8_t> retVal;
+			if (is_stored_inline())
+			{
+				retVal.assign(begin(), end());
+			}
+			else
+			{
+				retVal.swap(heapData);
+			}
+			length = 0;
+			return retVal;
+		}
+
+		/// @brief Returns a copy of the payload as a vector
+		/// @returns A copy of the payload as a vector
+		operator std::vector<std::uint8_t>() const
+		{
+			return std::vector<std::uint8_t>(begin(), end());
+		}
+
+		/// @brief Compares the bytes of two payloads
+		/// @param[in] other The payload to compare with
+		/// @returns true if both payloads hold the same bytes
+		bool operator==(const CANMessagePayload &other) const
+		{
+			return (length == other.length) && std::equal(begin(), end(), other.begin());
+		}
+
+		/// @brief Compares the bytes of two payloads
+		/// @param[in] other The payload to compare with
+		/// @returns true if the payloads hold different bytes
+		bool operator!=(const CANMessagePayload &other) const
+		{
+			return !(*this == other);
+		}
+
+		/// @brief Compares the bytes of the payload with a vector
+		/// @param[in] other The vector to compare with
+		/// @returns true if the payload and the vector hold the same bytes
+		bool operator==(const std::vector<std::uint8_t> &other) const
+		{
+			return (length == other.size()) && std::equal(begin(), end(), other.begin());
+		}
+
+		/// @brief Compares the bytes of the payload with a vector
+		/// @param[in] other The vector to compare with
+		/// @returns true if the payload and the vector hold different bytes
+		bool operator!=(const std::vector<std::uint8_t> &other) const
+		{
+			return !(*this == other);
+		}
+
+	private:
+		/// @brief Throws if an index is not in the payload, like the bounds check of `std::vector::at`
+		/// @param[in] index The index to check
+		void check_index(std::size_t index) const
+		{
+			if (index >= length)
+			{
+				throw std::out_of_range("CANMessagePayload::at() called with an index out of range");
+			}
+		}
+
+		std::array<std::uint8_t, CAN_MESSAGE_INLINE_DATA_LENGTH> inlineData = {}; ///< Storage for payloads that fit inline
+		std::vector<std::uint8_t> heapData; ///< Storage for payloads that do not fit inline
+		std::size_t length = 0; ///< The number of bytes in the payload
+	};
+
 	//================================================================================================
 	/// @class CANMessage
 	///
@@ -92,23 +500,33 @@ namespace isobus
 
 		/// @brief Gets a reference to the data in the CAN message
 		/// @returns A reference to the data in the CAN message
-		const std::vector<std::uint8_t> &get_data() const;
+		const CANMessagePayload &get_data() const;
+
+		/// @brief Moves the data out of the message, leaving the message without data
+		/// @details This lets the owner of a message reuse its storage once the message has been handled,
+		/// for example the transport protocols recycle their reassembly buffers this way.
+		/// @returns The data of the message
+		std::vector<std::uint8_t> release_data();
 
 		/// @brief Returns the length of the data in the CAN message
 		/// @returns The message data payload length
 		std::uint32_t get_data_length() const;
 
 		/// @brief Gets the source control function that the message is from
+		/// @details A reference is returned so that checking the source of every message doesn't need to
+		/// copy the shared pointer. Copy it if the control function needs to outlive the message.
 		/// @returns The source control function that the message is from
-		std::shared_ptr<ControlFunction> get_source_control_function() const;
+		const std::shared_ptr<ControlFunction> &get_source_control_function() const;
 
 		/// @brief Returns whether the message is sent by a device that claimed its address on the bus.
 		/// @returns True if the source of the message is valid, false otherwise
 		bool has_valid_source_control_function() const;
 
 		/// @brief Gets the destination control function that the message is to
+		/// @details A reference is returned so that checking the destination of every message doesn't need to
+		/// copy the shared pointer. Copy it if the control function needs to outlive the message.
 		/// @returns The destination control function that the message is to
-		std::shared_ptr<ControlFunction> get_destination_control_function() const;
+		const std::shared_ptr<ControlFunction> &get_destination_control_function() const;
 
 		/// @brief Returns whether the message is sent to a specific device on the bus.
 		/// @returns True if the destination of the message is valid, false otherwise
@@ -125,12 +543,12 @@ namespace isobus
 		/// @brief Returns whether the message is destined for the control function.
 		/// @param[in] controlFunction The control function to check
 		/// @returns True if the message is destined for the control function, false otherwise
-		bool is_destination(std::shared_ptr<ControlFunction> controlFunction) const;
+		bool is_destination(const std::shared_ptr<ControlFunction> &controlFunction) const;
 
 		/// @brief Returns whether the message is originated from the control function.
 		/// @param[in] controlFunction The control function to check
 		/// @returns True if the message is originated from the control function, false otherwise
-		bool is_source(std::shared_ptr<ControlFunction> controlFunction) const;
+		bool is_source(const std::shared_ptr<ControlFunction> &controlFunction) const;
 
 		/// @brief Returns the identifier of the message
 		/// @returns The identifier of the message
@@ -260,9 +678,11 @@ namespace isobus
 		std::uint64_t get_data_custom_length(const std::uint32_t startBitIndex, const std::uint32_t length, const ByteFormat format = ByteFormat::LittleEndian) const;
 
 	private:
+		friend class CANMessageRing; ///< Allows the message ring to overwrite preallocated messages in place
+
 		Type messageType; ///< The internal message type associated with the message
 		CANIdentifier identifier; ///< The CAN ID of the message
-		std::vector<std::uint8_t> data; ///< A data buffer for the message, used when not using data chunk callbacks
+		CANMessagePayload data; ///< A data buffer for the message, used when not using data chunk callbacks
 		std::shared_ptr<ControlFunction> source; ///< The source control function of the message
 		std::shared_ptr<ControlFunction> destination; ///< The destination control function of the message
 		std::uint8_t CANPortIndex; ///< The CAN channel index associated with the message
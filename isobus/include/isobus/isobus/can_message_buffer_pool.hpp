@@ -0,0 +1,75 @@
+//================================================================================================
+/// @file can_message_buffer_pool.hpp
+///
+/// @brief A pool of reusable data buffers, used by the transport protocols to avoid
+/// allocating a new reassembly buffer for every received multi-frame message.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+
+#ifndef CAN_MESSAGE_BUFFER_POOL_HPP
+#define CAN_MESSAGE_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isobus
+{
+	/// @brief A pool of reusable, size-classed data buffers
+	/// @details Buffers are handed out as plain vectors so they can be moved into a `CANMessageDataVector`
+	/// and on into a `CANMessage` without copying, and are given back to the pool once the message is handled.
+	///
+	/// Every buffer's capacity is a whole number of chunks, so buffers of similar sizes are interchangeable.
+	/// A protocol with a small maximum message size (like TP or fast packet) should use its maximum
+	/// message size as the chunk size, so every buffer fits every message.
+	/// Protocols with very large messages (like ETP) can use a smaller chunk and a cap on
+	/// the size of buffers that are kept, so an occasional huge message is not held onto forever.
+	///
+	/// @note This class is not thread safe, the owning protocol is responsible for locking.
+	class CANMessageBufferPool
+	{
+	public:
+		/// @brief Constructs a buffer pool. No buffers are allocated until they are first needed.
+		/// @param[in] chunkSize The granularity of buffer capacities in bytes
+		/// @param[in] maximumPooledBuffers The maximum number of idle buffers to keep
+		/// @param[in] maximumPooledBufferSize The largest buffer capacity to keep, larger buffers are freed when released
+		CANMessageBufferPool(std::size_t chunkSize, std::size_t maximumPooledBuffers, std::size_t maximumPooledBufferSize);
+
+		/// @brief Gets a zeroed buffer of a given size, reusing an idle buffer if one is large enough
+		/// @param[in] size The number of bytes the buffer should have
+		/// @returns A buffer with `size` bytes
+		std::vector<std::uint8_t> acquire(std::size_t size);
+
+		/// @brief Gives a buffer back to the pool so it can be reused
+		/// @details The buffer is freed instead if the pool is full, or if it is too large to keep.
+		/// @param[in] buffer The buffer to give back
+		void release(std::vector<std::uint8_t> &&buffer);
+
+		/// @brief Frees all idle buffers
+		void clear();
+
+		/// @brief Returns the number of buffers that had to be allocated because no idle buffer was large enough
+		/// @returns The number of buffers allocated by the pool since construction
+		std::size_t get_number_of_allocations() const;
+
+		/// @brief Returns the number of times an idle buffer was reused
+		/// @returns The number of buffers reused since construction
+		std::size_t get_number_of_reuses() const;
+
+		/// @brief Returns the number of idle buffers currently in the pool
+		/// @returns The number of idle buffers currently in the pool
+		std::size_t get_number_of_idle_buffers() const;
+
+	private:
+		std::vector<std::vector<std::uint8_t>> idleBuffers; ///< Buffers that are ready to be reused
+		const std::size_t chunkSize; ///< The granularity of buffer capacities in bytes
+		const std::size_t maximumPooledBuffers; ///< The maximum number of idle buffers to keep
+		const std::size_t maximumPooledBufferSize; ///< The largest buffer capacity to keep
+		std::size_t numberOfAllocations = 0; ///< The number of buffers allocated since construction
+		std::size_t numberOfReuses = 0; ///< The number of buffers reused since construction
+	};
+} // namespace isobus
+
+#endif // CAN_MESSAGE_BUFFER_POOL_HPP
@@ -56,6 +56,10 @@ namespace isobus
 		/// @param[in] data The data to copy.
 		explicit CANMessageDataVector(const std::vector<std::uint8_t> &data);
 
+		/// @brief Construct a new CANMessageDataVector object by taking over an existing buffer.
+		/// @param[in] data The data to take ownership of, without copying it.
+		explicit CANMessageDataVector(std::vector<std::uint8_t> &&data);
+
 		/// @brief Construct a new CANMessageDataVector object.
 		/// @param[in] data A pointer to the data to copy.
 		/// @param[in] size The size of the data to copy.
@@ -27,6 +27,12 @@ namespace isobus
 		/// @returns The number of bits in the message (with average bit stuffing)
 		std::uint32_t get_number_bits_in_message() const;
 
+		/// Returns the exact number of bits the frame takes up on the bus, including stuff bits
+		/// @details The CRC is calculated to find the stuff bits in the CRC field, so this is slower than
+		/// get_number_bits_in_message(). Interframe space is included, as with get_number_bits_in_message().
+		/// @returns The number of bits the frame takes up on the bus
+		std::uint32_t get_exact_number_bits_in_message() const;
+
 		std::uint64_t timestamp_us; ///< A microsecond timestamp
 		std::uint32_t identifier; ///< The 32 bit identifier of the frame
 		std::uint8_t channel; ///< The CAN channel index associated with the frame
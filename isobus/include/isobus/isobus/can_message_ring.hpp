@@ -0,0 +1,108 @@
+//================================================================================================
+/// @file can_message_ring.hpp
+///
+/// @brief A bounded, preallocated queue of CAN messages used by the network manager to hand
+/// received and transmitted frames from the hardware layer to the stack's update thread.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+
+#ifndef CAN_MESSAGE_RING_HPP
+#define CAN_MESSAGE_RING_HPP
+
+#include "isobus/isobus/can_message.hpp"
+#include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace isobus
+{
+	/// @brief A bounded, preallocated queue of CAN messages
+	/// @details All slots are allocated when the ring is constructed. Pushing a frame writes it
+	/// into the next free slot in place, so steady-state reception of single frame messages does
+	/// not touch the heap.
+	/// The consumer is handed a pointer to the oldest slot, which stays valid until it is popped,
+	/// so messages are processed without being copied out of the ring.
+	///
+	/// If the ring fills up (for example if the stack's update is stalled) messages spill into
+	/// an unbounded overflow queue rather than being dropped. Each time a message is popped, the oldest
+	/// overflowed message moves into the freed slot, so once the burst is drained new messages are
+	/// written into the ring again. Ordering is always preserved.
+	///
+	/// Any number of threads may push, but only one thread may consume (`front`, `pop`, `clear`).
+	class CANMessageRing
+	{
+	public:
+		/// @brief Constructs a ring and preallocates all of its slots
+		/// @param[in] capacity The number of messages the ring can hold before spilling to the overflow queue
+		explicit CANMessageRing(std::size_t capacity);
+
+		/// @brief Copies a CAN frame into the next free slot of the ring
+		/// @param[in] type The type of message to store the frame as
+		/// @param[in] frame The frame to store
+		/// @param[in] source The source control function of the frame, if known
+		/// @param[in] destination The destination control function of the frame, if known
+		void push(CANMessage::Type type,
+		          const CANMessageFrame &frame,
+		          const std::shared_ptr<ControlFunction> &source,
+		          const std::shared_ptr<ControlFunction> &destination);
+
+		/// @brief Returns the oldest message in the ring without removing it
+		/// @details The returned message remains valid until `pop` or `clear` is called.
+		/// @returns The oldest message, or nullptr if the ring is empty
+		const CANMessage *front();
+
+		/// @brief Removes the oldest message from the ring
+		void pop();
+
+		/// @brief Removes all messages from the ring
+		void clear();
+
+		/// @brief Returns if the ring has no messages in it
+		/// @returns true if there are no messages in the ring, otherwise false
+		bool empty() const;
+
+		/// @brief Returns the number of messages currently queued, including ones in the overflow queue
+		/// @returns The number of messages currently queued
+		std::size_t size() const;
+
+		/// @brief Returns the number of preallocated slots in the ring
+		/// @returns The number of preallocated slots in the ring
+		std::size_t get_capacity() const;
+
+		/// @brief Returns the number of messages that did not fit in the ring and had to be stored in the overflow queue
+		/// @returns The number of messages that did not fit in the ring since construction
+		std::size_t get_number_of_overflowed_messages() const;
+
+	private:
+		/// @brief Overwrites a preallocated message with the contents of a frame, reusing its storage
+		/// @param[in] slot The message to overwrite
+		/// @param[in] type The type of message to store the frame as
+		/// @param[in] frame The frame to store
+		/// @param[in] source The source control function of the frame
+		/// @param[in] destination The destination control function of the frame
+		static void write_slot(CANMessage &slot,
+		                       CANMessage::Type type,
+		                       const CANMessageFrame &frame,
+		                       const std::shared_ptr<ControlFunction> &source,
+		                       const std::shared_ptr<ControlFunction> &destination);
+
+		/// @brief Releases the references a slot holds so control functions are not kept alive by the ring
+		/// @param[in] slot The message to release
+		static void release_slot(CANMessage &slot);
+
+		std::vector<CANMessage> slots; ///< The preallocated message slots
+		std::deque<CANMessage> overflowMessages; ///< Messages that arrived while the ring was full, in arrival order
+		std::size_t readIndex = 0; ///< The slot index of the oldest message
+		std::size_t count = 0; ///< The number of messages in the ring's slots
+		std::size_t overflowedMessageCount = 0; ///< The number of messages that had to be stored in the overflow queue
+		mutable Mutex ringMutex; ///< Protects the indices and the overflow queue
+	};
+} // namespace isobus
+
+#endif // CAN_MESSAGE_RING_HPP
@@ -50,9 +50,25 @@ namespace isobus
 		/// @returns The minimum time to wait between sending BAM frames
 		std::uint32_t get_minimum_time_between_transport_protocol_bam_frames() const;
 
+		/// @brief Sets the minimum time to wait between sending data frames of
+		/// destination specific TP and ETP sessions (default is 0 ms, as fast as possible)
+		/// @details Destination specific sessions are flow controlled by the receiver, so normally
+		/// the stack sends all packets granted by a CTS back to back. Setting a gap spreads the packets
+		/// out, which can help receivers that can't keep up, at the expense of transfer time.
+		/// The acceptable range is 0 to 200 ms, as the standard allows at most 200 ms between packets.
+		/// When a gap is set, only one data frame is sent per session per update.
+		/// @param[in] value The minimum time to wait between sending data frames
+		void set_minimum_time_between_transport_protocol_data_frames(std::uint32_t value);
+
+		/// @brief Returns the minimum time to wait between sending data frames of destination specific TP and ETP sessions
+		/// @returns The minimum time to wait between sending data frames of destination specific sessions
+		std::uint32_t get_minimum_time_between_transport_protocol_data_frames() const;
+
 		/// @brief Sets the max number of data frames the stack will use when
 		/// in an ETP session, between EDPO phases. The default is 16.
 		/// Note that the sending control function may choose to use a lower number of frames.
+		/// @details When receiving, this is the window granted in each CTS. Granting up to 255 frames
+		/// means fewer CTS/DPO round trips, which speeds up large transfers like object pool uploads.
 		/// @param[in] numberFrames The max number of data frames to use
 		void set_number_of_packets_per_dpo_message(std::uint8_t numberFrames);
 
@@ -65,6 +81,7 @@ namespace isobus
 		/// @brief Sets the max number of data frames the stack will send from each
 		/// transport layer protocol, per update. The default is 255,
 		/// but decreasing it may reduce bus load at the expense of transfer time.
+		/// @details The frames are shared by all sessions of a protocol, which take turns sending one frame each.
 		/// @param[in] numberFrames The max number of frames to use
 		void set_max_number_of_network_manager_protocol_frames_per_update(std::uint8_t numberFrames);
 
@@ -89,6 +106,7 @@ namespace isobus
 
 		std::uint32_t maxNumberTransportProtocolSessions = 4; ///< The max number of TP sessions allowed
 		std::uint32_t minimumTimeBetweenTransportProtocolBAMFrames = DEFAULT_BAM_PACKET_DELAY_TIME_MS; ///< The configurable time between BAM frames
+		std::uint32_t minimumTimeBetweenTransportProtocolDataFrames = 0; ///< The configurable time between data frames of destination specific sessions
 		std::uint8_t networkManagerMaxFramesToSendPerUpdate = 0xFF; ///< Used to control the max number of transport layer frames added to the driver queue per network manager update
 		std::uint8_t numberOfPacketsPerDPOMessage = 16; ///< The number of packets per DPO message for ETP sessions
 		std::uint8_t numberOfPacketsPerCTSMessage = 16; ///< The number of packets per CTS message for TP sessions
@@ -13,6 +13,7 @@
 #define CAN_NETWORK_MANAGER_HPP
 
 #include "isobus/isobus/can_badge.hpp"
+#include "isobus/isobus/can_bus_statistics.hpp"
 #include "isobus/isobus/can_callbacks.hpp"
 #include "isobus/isobus/can_constants.hpp"
 #include "isobus/isobus/can_control_function.hpp"
@@ -20,7 +21,9 @@
 #include "isobus/isobus/can_identifier.hpp"
 #include "isobus/isobus/can_internal_control_function.hpp"
 #include "isobus/isobus/can_message.hpp"
+#include "isobus/isobus/can_message_data.hpp"
 #include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/isobus/can_message_ring.hpp"
 #include "isobus/isobus/can_network_configuration.hpp"
 #include "isobus/isobus/can_partnered_control_function.hpp"
 #include "isobus/isobus/can_transport_protocol.hpp"
@@ -33,7 +36,7 @@
 #include <deque>
 #include <list>
 #include <memory>
-#include <queue>
+#include <vector>
 
 /// @brief This namespace encompasses all of the ISO11783 stack's functionality to reduce global namespace pollution
 namespace isobus
@@ -121,14 +124,35 @@ namespace isobus
 		std::shared_ptr<InternalControlFunction> get_internal_control_function(std::shared_ptr<ControlFunction> controlFunction) const;
 
 		/// @brief Returns an estimated busload between 0.0f and 100.0f
-		/// @details This calculates busload over a 1 second window.
-		/// @note This function averages between best and worst case bit-stuffing.
-		/// This may be more or less aggressive than the actual amount of bit stuffing. Knowing
-		/// the actual amount of bit stuffing is impossible, so this should only be used as an estimate.
+		/// @details This calculates busload over a 1 second window, counting the exact number of
+		/// bits of each frame including bit-stuffing.
+		/// @note The bus is assumed to run at the ISOBUS baud rate of 250 kbit/s, and only frames
+		/// the stack knows about (received, or sent by the stack) are counted, so this should only be used as an estimate.
 		/// @param[in] canChannel The channel to estimate the bus load for
 		/// @returns Estimated busload over the last 1 second
 		float get_estimated_busload(std::uint8_t canChannel);
 
+		/// @brief Enables or disables the per source address and per PGN traffic statistics of a channel
+		/// @details The statistics cover the same 1 second window as the busload estimate, and can be used to find
+		/// out which control function or PGN is causing a high busload.
+		/// They need about 30 kB of memory per channel, so they are disabled by default.
+		/// @param[in] canChannel The channel to enable or disable the statistics for
+		/// @param[in] enabled true to start collecting statistics, false to stop and free them
+		/// @returns true if the channel is valid, otherwise false
+		bool set_bus_statistics_enabled(std::uint8_t canChannel, bool enabled);
+
+		/// @brief Returns the source addresses that used the most bits on a channel over the last second
+		/// @param[in] canChannel The channel to get the statistics of
+		/// @param[in] count The max number of source addresses to return
+		/// @returns Up to `count` source addresses sorted by number of bits, or an empty list if statistics are disabled
+		std::vector<CANBusStatistics::TalkerStatistics> get_top_talkers_by_source_address(std::uint8_t canChannel, std::size_t count);
+
+		/// @brief Returns the PGNs that used the most bits on a channel over the last second
+		/// @param[in] canChannel The channel to get the statistics of
+		/// @param[in] count The max number of PGNs to return
+		/// @returns Up to `count` PGNs sorted by number of bits, or an empty list if statistics are disabled
+		std::vector<CANBusStatistics::TalkerStatistics> get_top_talkers_by_parameter_group_number(std::uint8_t canChannel, std::size_t count);
+
 		/// @brief This is the main way to send a CAN message of any length.
 		/// @details This function will automatically choose an appropriate transport protocol if needed.
 		/// If you don't specify a destination (or use nullptr) you message will be sent as a broadcast
@@ -154,6 +178,29 @@ namespace isobus
 		                      void *parentPointer = nullptr,
 		                      DataChunkCallback frameChunkCallback = nullptr);
 
+		/// @brief Sends a CAN message of any length, handing the data object straight to the transport protocol.
+		/// @details This works like the other `send_can_message`, but the payload is supplied as a
+		/// `CANMessageData` object. If the data owns its buffer (like `CANMessageDataVector`) the
+		/// transport protocol session takes it over as-is, so large payloads are never copied.
+		/// Views (`CANMessageDataView`) are still copied by the transport protocol, since the stack can't
+		/// know how long the viewed buffer will live.
+		/// @param[in] parameterGroupNumber The PGN to use when sending the message
+		/// @param[in,out] data The data to send. Ownership is taken (and this is reset) only if the message was sent.
+		/// If the message could not be sent, the data is left untouched so that it can be retried.
+		/// @param[in] sourceControlFunction The control function that is sending the message
+		/// @param[in] destinationControlFunction The control function that the message is destined for or nullptr if broadcast
+		/// @param[in] priority The CAN priority of the message being sent
+		/// @param[in] txCompleteCallback A callback to be called when the message is sent or fails to send
+		/// @param[in] parentPointer A generic context variable that helps identify what object the callback is destined for
+		/// @returns `true` if the message was sent, otherwise `false`
+		bool send_can_message(std::uint32_t parameterGroupNumber,
+		                      std::unique_ptr<CANMessageData> &data,
+		                      std::shared_ptr<InternalControlFunction> sourceControlFunction,
+		                      std::shared_ptr<ControlFunction> destinationControlFunction = nullptr,
+		                      CANIdentifier::CANPriority priority = CANIdentifier::CANPriority::PriorityDefault6,
+		                      TransmitCompleteCallback txCompleteCallback = nullptr,
+		                      void *parentPointer = nullptr);
+
 		/// @brief The main update function for the network manager. Updates all protocols.
 		void update();
 
@@ -292,19 +339,27 @@ namespace isobus
 		/// @param[in] message The message to process
 		void process_rx_message_for_address_claiming(const CANMessage &message) const;
 
-		/// @brief Processes a CAN message's contribution to the current busload
-		/// @param[in] channelIndex The CAN channel index associated to the message being processed
-		/// @param[in] numberOfBitsProcessed The number of bits to add to the busload calculation
-		void update_busload(std::uint8_t channelIndex, std::uint32_t numberOfBitsProcessed);
+		/// @brief Processes a CAN frame's contribution to the current busload and bus statistics
+		/// @param[in] frame The frame being processed
+		void update_busload(const CANMessageFrame &frame);
 
 		/// @brief Updates the stored bit accumulators for calculating the bus load over a multiple sample windows
 		void update_busload_history();
 
+		/// @brief Looks up a control function in the address table without copying it, for the frame processing path
+		/// @attention The reference is only valid until the address table changes, so it must be copied before the
+		/// frame has been processed. Use get_control_function everywhere else.
+		/// @param[in] channelIndex CAN Channel index of the control function
+		/// @param[in] address Address of the control function
+		/// @returns A reference to the control function at the address, or to a nullptr if there is none
+		const std::shared_ptr<ControlFunction> &get_control_function_for_frame(std::uint8_t channelIndex, std::uint8_t address) const;
+
 		/// @brief Creates new control function classes based on the frames coming in from the bus
 		/// @param[in] rxFrame Raw frames coming in from the bus
 		void update_control_functions(const CANMessageFrame &rxFrame);
 
-		/// @brief Checks if new partners have been created and matches them to existing control functions
+		/// @brief Matches partners created since the last update to existing control functions
+		/// @details After this, partners are only matched against NAMEs when an address claim is received.
 		void update_new_partners();
 
 		/// @brief Builds a CAN frame from a frame's discrete components
@@ -324,16 +379,6 @@ namespace isobus
 		                                const void *data,
 		                                std::uint32_t size) const;
 
-		/// @brief Get the next CAN message from the received message queue, and remove it from the queue.
-		/// @note This will only ever get an 8 byte message because they are directly translated from CAN frames.
-		/// @returns The message that was at the front of the queue, or an invalid message if the queue is empty
-		CANMessage get_next_can_message_from_rx_queue();
-
-		/// @brief Get the next CAN message from the received message queue, and remove it from the queue
-		/// @note This will only ever get an 8 byte message because they are directly translated from CAN frames.
-		/// @returns The message that was at the front of the queue, or an invalid message if the queue is empty
-		CANMessage get_next_can_message_from_tx_queue();
-
 		/// @brief Processes a can message for callbacks added with add_any_control_function_parameter_group_number_callback
 		/// @param[in] currentMessage The message to process
 		void process_any_control_function_pgn_callbacks(const CANMessage &currentMessage);
@@ -386,6 +431,25 @@ namespace isobus
 		                          const void *data,
 		                          std::uint32_t size) const;
 
+		/// @brief Sends a message that fits in a single CAN frame, and calls the transmit complete callback if it was sent
+		/// @param[in] parameterGroupNumber The PGN to use when sending the message
+		/// @param[in] dataBuffer A pointer to the data buffer to send from
+		/// @param[in] dataLength The size of the message to send, at most 8 bytes
+		/// @param[in] sourceControlFunction The control function that is sending the message
+		/// @param[in] destinationControlFunction The control function that the message is destined for or nullptr if broadcast
+		/// @param[in] priority The CAN priority of the message being sent
+		/// @param[in] txCompleteCallback A callback to be called when the message is sent
+		/// @param[in] parentPointer A generic context variable that helps identify what object the callback is destined for
+		/// @returns `true` if the message was sent, otherwise `false`
+		bool send_single_frame_message(std::uint32_t parameterGroupNumber,
+		                               const std::uint8_t *dataBuffer,
+		                               std::uint32_t dataLength,
+		                               std::shared_ptr<InternalControlFunction> sourceControlFunction,
+		                               std::shared_ptr<ControlFunction> destinationControlFunction,
+		                               CANIdentifier::CANPriority priority,
+		                               TransmitCompleteCallback txCompleteCallback,
+		                               void *parentPointer) const;
+
 		/// @brief Gets a PGN callback for the global address by index
 		/// @param[in] index The index of the callback to get
 		/// @returns A structure containing the global PGN callback data
@@ -393,6 +457,7 @@ namespace isobus
 
 		static constexpr std::uint32_t BUSLOAD_SAMPLE_WINDOW_MS = 1000; ///< Using a 1s window to average the bus load, otherwise it's very erratic
 		static constexpr std::uint32_t BUSLOAD_UPDATE_FREQUENCY_MS = 100; ///< Bus load bit accumulation happens over a 100ms window
+		static constexpr std::size_t MESSAGE_RING_SIZE = 64; ///< The number of preallocated slots in each of the rx and tx message queues
 
 		CANNetworkConfiguration configuration; ///< The configuration for this network manager
 		std::array<std::unique_ptr<TransportProtocolManager>, CAN_PORT_MAXIMUM> transportProtocols; ///< One instance of the transport protocol manager for each channel
@@ -400,8 +465,9 @@ namespace isobus
 		std::array<std::unique_ptr<FastPacketProtocol>, CAN_PORT_MAXIMUM> fastPacketProtocol; ///< One instance of the fast packet protocol for each channel
 		std::array<std::unique_ptr<HeartbeatInterface>, CAN_PORT_MAXIMUM> heartBeatInterfaces; ///< Manages ISOBUS heartbeat requests, one per channel
 
-		std::array<std::deque<std::uint32_t>, CAN_PORT_MAXIMUM> busloadMessageBitsHistory; ///< Stores the approximate number of bits processed on each channel over multiple previous time windows
-		std::array<std::uint32_t, CAN_PORT_MAXIMUM> currentBusloadBitAccumulator; ///< Accumulates the approximate number of bits processed on each channel during the current time window
+		std::array<std::deque<std::uint32_t>, CAN_PORT_MAXIMUM> busloadMessageBitsHistory; ///< Stores the number of bits processed on each channel over multiple previous time windows
+		std::array<std::uint32_t, CAN_PORT_MAXIMUM> currentBusloadBitAccumulator; ///< Accumulates the number of bits processed on each channel during the current time window
+		std::array<std::unique_ptr<CANBusStatistics>, CAN_PORT_MAXIMUM> busStatistics; ///< Per source address and per PGN traffic of each channel, if enabled
 		std::array<std::uint32_t, CAN_PORT_MAXIMUM> lastAddressClaimRequestTimestamp_ms; ///< Stores timestamps for when the last request for the address claim PGN was received. Used to prune stale CFs.
 
 		std::array<std::array<std::shared_ptr<ControlFunction>, NULL_CAN_ADDRESS>, CAN_PORT_MAXIMUM> controlFunctionTable; ///< Table to maintain address to NAME mappings
@@ -409,21 +475,18 @@ namespace isobus
 		std::list<std::shared_ptr<InternalControlFunction>> internalControlFunctions; ///< A list of the internal control functions
 		Mutex internalControlFunctionsMutex; ///< A mutex for internal control functions thread safety
 		std::list<std::shared_ptr<PartneredControlFunction>> partneredControlFunctions; ///< A list of the partnered control functions
+		std::vector<std::shared_ptr<PartneredControlFunction>> newPartneredControlFunctions; ///< Partners that have not been matched against the known control functions yet
 
-		std::list<ParameterGroupNumberCallbackData> protocolPGNCallbacks; ///< A list of PGN callback registered by CAN protocols
-		std::queue<CANMessage> receivedMessageQueue; ///< A queue of received messages to process
-		std::queue<CANMessage> transmittedMessageQueue; ///< A queue of transmitted messages to process (already sent, so changes to the message won't affect the bus)
+		ParameterGroupNumberCallbackTable protocolPGNCallbacks; ///< PGN callbacks registered by CAN protocols, indexed by PGN
+		CANMessageRing receivedMessageQueue{ MESSAGE_RING_SIZE }; ///< A queue of received messages to process
+		CANMessageRing transmittedMessageQueue{ MESSAGE_RING_SIZE }; ///< A queue of transmitted messages to process (already sent, so changes to the message won't affect the bus)
 		std::list<ControlFunctionStateCallback> controlFunctionStateCallbacks; ///< List of all control function state callbacks
-		std::vector<ParameterGroupNumberCallbackData> globalParameterGroupNumberCallbacks; ///< A list of all global PGN callbacks
-		std::vector<ParameterGroupNumberCallbackData> anyControlFunctionParameterGroupNumberCallbacks; ///< A list of all global PGN callbacks
+		ParameterGroupNumberCallbackTable globalParameterGroupNumberCallbacks; ///< All global PGN callbacks, indexed by PGN
+		ParameterGroupNumberCallbackTable anyControlFunctionParameterGroupNumberCallbacks; ///< All "any CF" PGN callbacks, indexed by PGN
 		EventDispatcher<CANMessage> messageTransmittedEventDispatcher; ///< An event dispatcher for notifying consumers about transmitted messages by our application
 		EventDispatcher<std::shared_ptr<InternalControlFunction>> addressViolationEventDispatcher; ///< An event dispatcher for notifying consumers about address violations
-		Mutex receivedMessageQueueMutex; ///< A mutex for receive messages thread safety
-		Mutex protocolPGNCallbacksMutex; ///< A mutex for PGN callback thread safety
-		Mutex anyControlFunctionCallbacksMutex; ///< Mutex to protect the "any CF" callbacks
 		Mutex busloadUpdateMutex; ///< A mutex that protects the busload metrics since we calculate it on our own thread
 		Mutex controlFunctionStatusCallbacksMutex; ///< A Mutex that protects access to the control function status callback list
-		Mutex transmittedMessageQueueMutex; ///< A mutex for protecting the transmitted message queue
 		std::uint32_t busloadUpdateTimestamp_ms = 0; ///< Tracks a time window for determining approximate busload
 		std::uint32_t updateTimestamp_ms = 0; ///< Keeps track of the last time the CAN stack was update in milliseconds
 		bool initialized = false; ///< True if the network manager has been initialized by the update function
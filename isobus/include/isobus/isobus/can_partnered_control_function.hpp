@@ -84,21 +84,28 @@ namespace isobus
 		bool get_name_filter_parameter(std::size_t index, NAME::NAMEParameters &parameter, std::uint32_t &filterValue) const;
 
 		/// @brief Checks to see if a NAME matches this CF's NAME filters
+		/// @details The filters are combined into a single mask and value when the partner is created,
+		/// so this is a single compare no matter how many filters there are.
 		/// @param[in] NAMEToCheck The NAME to check against this control function's filters
 		/// @returns true if this control function matches the NAME that was passed in, false otherwise
 		bool check_matches_name(NAME NAMEToCheck) const;
 
 	private:
-		friend class CANNetworkManager; ///< Allows the network manager to use get_parameter_group_number_callback
+		friend class CANNetworkManager; ///< Allows the network manager to dispatch messages to this CF's PGN callbacks
 
 		/// @brief Returns a parameter group number associated with this control function by index
 		/// @param[in] index The index from which to get the PGN callback data object
-		/// @returns A reference to the PGN callback data object at the index specified
-		ParameterGroupNumberCallbackData &get_parameter_group_number_callback(std::size_t index);
+		/// @returns A copy of the PGN callback data object at the index specified
+		ParameterGroupNumberCallbackData get_parameter_group_number_callback(std::size_t index) const;
+
+		/// @brief Combines the NAME filters into `NAMEFilterMask` and `NAMEFilterValue`
+		void compile_name_filters();
 
 		const std::vector<NAMEFilter> NAMEFilterList; ///< A list of NAME parameters that describe this control function's identity
-		std::vector<ParameterGroupNumberCallbackData> parameterGroupNumberCallbacks; ///< A list of all parameter group number callbacks associated with this control function
-		bool initialized = false; ///< A way to track if the network manager has processed this CF against existing CFs
+		ParameterGroupNumberCallbackTable parameterGroupNumberCallbacks; ///< All parameter group number callbacks associated with this control function, indexed by PGN
+		std::uint64_t NAMEFilterMask = 0; ///< The bits of a raw NAME that are checked by the NAME filters
+		std::uint64_t NAMEFilterValue = 0; ///< The value the masked bits of a raw NAME must have to match the NAME filters
+		bool NAMEFiltersCanMatch = false; ///< false if there are no filters, or if they contradict each other so no NAME can match
 	};
 
 } // namespace isobus
@@ -12,8 +12,19 @@
 
 #include "isobus/utility/thread_synchronization.hpp"
 
+#include <cstdio>
 #include <memory>
 #include <string>
+#include <type_traits>
+
+//! @cond Doxygen_Suppress
+#if defined(__GNUC__) || defined(__clang__)
+/// @brief Lets GCC and Clang check the arguments of a printf style log function against its format string
+#define CAN_STACK_LOG_FORMAT_ATTRIBUTE(formatIndex, firstArgumentIndex) __attribute__((format(printf, formatIndex, firstArgumentIndex)))
+#else
+#define CAN_STACK_LOG_FORMAT_ATTRIBUTE(formatIndex, firstArgumentIndex)
+#endif
+//! @endcond
 
 namespace isobus
 {
@@ -46,99 +57,195 @@ namespace isobus
 
 #ifndef DISABLE_CAN_STACK_LOGGER
 
-		/// @brief Gets called from the CAN stack to log information. Wraps sink_CAN_stack_log.
+		/// @brief The size of the buffer that printf style log text is formatted into, longer text is truncated
+		static constexpr std::size_t FORMAT_BUFFER_SIZE = 512;
+
+		/// @brief Gets called from the CAN stack to log information. Wraps sink_CAN_stack_log_text.
 		/// @param[in] level The log level for this text
 		/// @param[in] logText The text to be logged
 		static void CAN_stack_log(LoggingLevel level, const std::string &logText);
 
-		/// @brief Gets called from the CAN stack to log information. Wraps sink_CAN_stack_log.
+		/// @brief Gets called from the CAN stack to log information. Wraps sink_CAN_stack_log_text.
+		/// @param[in] level The log level for this text
+		/// @param[in] logText The null terminated text to be logged
+		static void CAN_stack_log(LoggingLevel level, const char *logText);
+
+		/// @brief Gets called from the CAN stack to log information. Wraps sink_CAN_stack_log_text.
+		/// @details The text is only formatted if the level is not filtered out. It is formatted into a
+		/// thread local buffer of FORMAT_BUFFER_SIZE bytes, so no memory is allocated for it.
 		/// @param[in] level The log level for this text
 		/// @param[in] format A format string of text to log, similar to printf
 		/// @param[in] args A list of printf style arguments to use with the format string when logging
 		template<typename... Args>
-		static void CAN_stack_log(LoggingLevel level, const std::string &format, Args... args)
+		static void CAN_stack_log(LoggingLevel level, const char *format, Args... args)
 		{
-			int size_s = std::snprintf(nullptr, 0, format.c_str(), args...) + 1; // Extra space for '\0'
-			if (size_s > 0)
+			if (is_log_level_enabled(level))
 			{
-				auto size = static_cast<std::size_t>(size_s);
-				std::unique_ptr<char[]> buf(new char[size]);
-				std::snprintf(buf.get(), size, format.c_str(), args...);
-				CAN_stack_log(level, std::string(buf.get(), buf.get() + size - 1)); // We don't want the '\0' inside
-			}
-			else if (size_s < 0)
-			{
-				CAN_stack_log(level, format); // If snprintf had some error, at least print the format string
+				char *buffer = get_format_buffer();
+				int length = std::snprintf(buffer, FORMAT_BUFFER_SIZE, format, args...);
+				if (length >= 0)
+				{
+					auto textLength = static_cast<std::size_t>(length);
+					log_text(level, buffer, (textLength < FORMAT_BUFFER_SIZE) ? textLength : (FORMAT_BUFFER_SIZE - 1));
+				}
+				else
+				{
+					CAN_stack_log(level, format); // If snprintf had some error, at least print the format string
+				}
 			}
 		}
 
-		/// @brief Logs a string to the log sink with `Debug` severity. Wraps sink_CAN_stack_log.
+		/// @brief Gets called from the CAN stack to log information. Wraps sink_CAN_stack_log_text.
+		/// @param[in] level The log level for this text
+		/// @param[in] format A format string of text to log, similar to printf
+		/// @param[in] args A list of printf style arguments to use with the format string when logging
+		template<typename... Args>
+		static void CAN_stack_log(LoggingLevel level, const std::string &format, Args... args)
+		{
+			CAN_stack_log(level, format.c_str(), args...);
+		}
+
+		/// @brief Logs a string to the log sink with `Debug` severity. Wraps sink_CAN_stack_log_text.
 		/// @param[in] logText The text to be logged at `Debug` severity
 		static void debug(const std::string &logText);
 
-		/// @brief Logs a printf formatted string to the log sink with `Debug` severity. Wraps sink_CAN_stack_log.
+		/// @brief Logs a printf formatted string to the log sink with `Debug` severity. Wraps sink_CAN_stack_log_text.
 		/// @param[in] format The format string, similar to printf
 		/// @param[in] args The variadic arguments to format, similar to printf
 		template<typename... Args>
-		static void debug(const std::string &format, Args... args)
+		static void debug(const char *format, Args... args)
 		{
 			CAN_stack_log(LoggingLevel::Debug, format, args...);
 		}
 
-		/// @brief Logs a string to the log sink with `Info` severity. Wraps sink_CAN_stack_log.
+		/// @brief Logs a printf formatted string to the log sink with `Debug` severity. Wraps sink_CAN_stack_log_text.
+		/// @param[in] format The format string, similar to printf
+		/// @param[in] args The variadic arguments to format, similar to printf
+		template<typename... Args>
+		static void debug(const std::string &format, Args... args)
+		{
+			CAN_stack_log(LoggingLevel::Debug, format.c_str(), args...);
+		}
+
+		/// @brief Logs a string to the log sink with `Info` severity. Wraps sink_CAN_stack_log_text.
 		/// @param[in] logText The text to be logged at `Info` severity
 		static void info(const std::string &logText);
 
-		/// @brief Logs a printf formatted string to the log sink with `Info` severity. Wraps sink_CAN_stack_log.
+		/// @brief Logs a printf formatted string to the log sink with `Info` severity. Wraps sink_CAN_stack_log_text.
 		/// @param[in] format The format string, similar to printf
 		/// @param[in] args The variadic arguments to format, similar to printf
 		template<typename... Args>
-		static void info(const std::string &format, Args... args)
+		static void info(const char *format, Args... args)
 		{
 			CAN_stack_log(LoggingLevel::Info, format, args...);
 		}
 
-		/// @brief Logs a string to the log sink with `Warning` severity. Wraps sink_CAN_stack_log.
+		/// @brief Logs a printf formatted string to the log sink with `Info` severity. Wraps sink_CAN_stack_log_text.
+		/// @param[in] format The format string, similar to printf
+		/// @param[in] args The variadic arguments to format, similar to printf
+		template<typename... Args>
+		static void info(const std::string &format, Args... args)
+		{
+			CAN_stack_log(LoggingLevel::Info, format.c_str(), args...);
+		}
+
+		/// @brief Logs a string to the log sink with `Warning` severity. Wraps sink_CAN_stack_log_text.
 		/// @param[in] logText The text to be logged at `Warning` severity
 		static void warn(const std::string &logText);
 
-		/// @brief Logs a printf formatted string to the log sink with `Warning` severity. Wraps sink_CAN_stack_log.
+		/// @brief Logs a printf formatted string to the log sink with `Warning` severity. Wraps sink_CAN_stack_log_text.
 		/// @param[in] format The format string, similar to printf
 		/// @param[in] args The variadic arguments to format, similar to printf
 		template<typename... Args>
-		static void warn(const std::string &format, Args... args)
+		static void warn(const char *format, Args... args)
 		{
 			CAN_stack_log(LoggingLevel::Warning, format, args...);
 		}
 
-		/// @brief Logs a string to the log sink with `Error` severity. Wraps sink_CAN_stack_log.
+		/// @brief Logs a printf formatted string to the log sink with `Warning` severity. Wraps sink_CAN_stack_log_text.
+		/// @param[in] format The format string, similar to printf
+		/// @param[in] args The variadic arguments to format, similar to printf
+		template<typename... Args>
+		static void warn(const std::string &format, Args... args)
+		{
+			CAN_stack_log(LoggingLevel::Warning, format.c_str(), args...);
+		}
+
+		/// @brief Logs a string to the log sink with `Error` severity. Wraps sink_CAN_stack_log_text.
 		/// @param[in] logText The text to be logged at `Error` severity
 		static void error(const std::string &logText);
 
-		/// @brief Logs a printf formatted string to the log sink with `Error` severity. Wraps sink_CAN_stack_log.
+		/// @brief Logs a printf formatted string to the log sink with `Error` severity. Wraps sink_CAN_stack_log_text.
 		/// @param[in] format The format string, similar to printf
 		/// @param[in] args The variadic arguments to format, similar to printf
 		template<typename... Args>
-		static void error(const std::string &format, Args... args)
+		static void error(const char *format, Args... args)
 		{
 			CAN_stack_log(LoggingLevel::Error, format, args...);
 		}
 
-		/// @brief Logs a string to the log sink with `Critical` severity. Wraps sink_CAN_stack_log.
+		/// @brief Logs a printf formatted string to the log sink with `Error` severity. Wraps sink_CAN_stack_log_text.
+		/// @param[in] format The format string, similar to printf
+		/// @param[in] args The variadic arguments to format, similar to printf
+		template<typename... Args>
+		static void error(const std::string &format, Args... args)
+		{
+			CAN_stack_log(LoggingLevel::Error, format.c_str(), args...);
+		}
+
+		/// @brief Logs a string to the log sink with `Critical` severity. Wraps sink_CAN_stack_log_text.
 		/// @param[in] logText The text to be logged at `Critical` severity
 		static void critical(const std::string &logText);
 
-		/// @brief Logs a printf formatted string to the log sink with `Critical` severity. Wraps sink_CAN_stack_log.
+		/// @brief Logs a printf formatted string to the log sink with `Critical` severity. Wraps sink_CAN_stack_log_text.
 		/// @param[in] format The format string, similar to printf
 		/// @param[in] args The variadic arguments to format, similar to printf
 		template<typename... Args>
-		static void critical(const std::string &format, Args... args)
+		static void critical(const char *format, Args... args)
 		{
 			CAN_stack_log(LoggingLevel::Critical, format, args...);
 		}
 
+		/// @brief Logs a printf formatted string to the log sink with `Critical` severity. Wraps sink_CAN_stack_log_text.
+		/// @param[in] format The format string, similar to printf
+		/// @param[in] args The variadic arguments to format, similar to printf
+		template<typename... Args>
+		static void critical(const std::string &format, Args... args)
+		{
+			CAN_stack_log(LoggingLevel::Critical, format.c_str(), args...);
+		}
+
+		/// @brief Lets the compiler check a plain text log statement, only used in unevaluated context by the LOG_ macros
+		/// @param[in] logText The text to be logged
+		/// @returns Never returns, there is no definition
+		static int check_log_format(const std::string &logText);
+
+		/// @brief Lets the compiler check a printf style log statement against its arguments,
+		/// only used in unevaluated context by the LOG_ macros. A literal without arguments is checked as well,
+		/// which catches conversions that were written without passing the matching argument.
+		/// @param[in] format The format string, similar to printf
+		/// @returns Never returns, there is no definition
+		static int check_log_format(const char *format, ...) CAN_STACK_LOG_FORMAT_ATTRIBUTE(1, 2);
+
+		/// @brief Lets the compiler check a log statement with a runtime format string, only used in unevaluated context by the LOG_ macros
+		/// @param[in] format The format string, similar to printf
+		/// @param[in] args The variadic arguments to format, similar to printf
+		/// @returns Never returns, there is no definition
+		template<typename String, typename... Args>
+		static typename std::enable_if<std::is_same<String, std::string>::value, int>::type check_log_format(const String &format, Args... args);
+
 #endif
 
+		/// @brief Checks if a log statement at a level would currently be passed to the log sink
+		/// @details Use this to skip building log text that would be dropped anyway, the LOG_ macros
+		/// already do this before evaluating any of their arguments.
+		/// @param[in] level The log level to check
+		/// @returns true if a log sink is set and the level is not below the current log level
+		static bool is_log_level_enabled(LoggingLevel level)
+		{
+			return (nullptr != logger) && (level >= currentLogLevel);
+		}
+
 		/// @brief Assigns a derived logger class to be used as the log sink
 		/// @param[in] logSink A pointer to a derived CANStackLogger class
 		static void set_can_stack_logger_sink(CANStackLogger *logSink);
@@ -160,7 +267,26 @@ namespace isobus
 		/// @param[in] logText The information being logged
 		virtual void sink_CAN_stack_log(LoggingLevel level, const std::string &logText);
 
+		/// @brief Override this instead of sink_CAN_stack_log to receive log text without it being copied into a std::string
+		/// @details The default implementation copies the text into a std::string and passes it to sink_CAN_stack_log.
+		/// @param[in] level The severity level of the log text
+		/// @param[in] logText The information being logged, only valid during this call
+		/// @param[in] length The number of characters in logText, not including the null terminator
+		virtual void sink_CAN_stack_log_text(LoggingLevel level, const char *logText, std::size_t length);
+
 	private:
+#ifndef DISABLE_CAN_STACK_LOGGER
+		/// @brief Passes log text to the log sink if its level is not filtered out
+		/// @param[in] level The log level for this text
+		/// @param[in] logText The null terminated text to be logged
+		/// @param[in] length The number of characters in logText
+		static void log_text(LoggingLevel level, const char *logText, std::size_t length);
+
+		/// @brief Returns the buffer that printf style log text is formatted into
+		/// @returns A buffer of FORMAT_BUFFER_SIZE bytes, one per thread if threads are enabled
+		static char *get_format_buffer();
+#endif
+
 		/// @brief Provides a pointer to the static instance of the logger, and returns if the pointer is valid
 		/// @param[out] canStackLogger The static logger instance
 		/// @returns true if the logger is not `nullptr` or false if it is `nullptr`
@@ -190,26 +316,39 @@ namespace isobus
 /// @param logString A log statement
 #define LOG_DEBUG(...)
 #else
+/// @brief Logs a statement if its level is enabled, otherwise the arguments are not even evaluated.
+/// The format string is checked against its arguments at compile time.
+/// @param[in] level The logging level of the statement
+/// @param[in] function The CANStackLogger function that logs at that level
+#define CAN_STACK_LOG_AT_LEVEL(level, function, ...)                                      \
+	do                                                                                    \
+	{                                                                                     \
+		if (isobus::CANStackLogger::is_log_level_enabled(level))                          \
+		{                                                                                 \
+			isobus::CANStackLogger::function(__VA_ARGS__);                                \
+		}                                                                                 \
+		static_cast<void>(sizeof(isobus::CANStackLogger::check_log_format(__VA_ARGS__))); \
+	} while (false)
 /// @brief A macro which logs a string at "critical" logging level
 /// @param[in] logString A log statement
 /// @param[in] args (optional) A list of printf style arguments to format the logString with
-#define LOG_CRITICAL(...) isobus::CANStackLogger::critical(__VA_ARGS__)
+#define LOG_CRITICAL(...) CAN_STACK_LOG_AT_LEVEL(isobus::CANStackLogger::LoggingLevel::Critical, critical, __VA_ARGS__)
 /// @brief A macro which logs a string at "error" logging level
 /// @param[in] logString A log statement
 /// @param[in] args (optional) A list of printf style arguments to format the logString with
-#define LOG_ERROR(...) isobus::CANStackLogger::error(__VA_ARGS__)
+#define LOG_ERROR(...) CAN_STACK_LOG_AT_LEVEL(isobus::CANStackLogger::LoggingLevel::Error, error, __VA_ARGS__)
 /// @brief A macro which logs a string at "warning" logging level
 /// @param[in] logString A log statement
 /// @param[in] args (optional) A list of printf style arguments to format the logString with
-#define LOG_WARNING(...) isobus::CANStackLogger::warn(__VA_ARGS__)
+#define LOG_WARNING(...) CAN_STACK_LOG_AT_LEVEL(isobus::CANStackLogger::LoggingLevel::Warning, warn, __VA_ARGS__)
 /// @brief A macro which logs a string at "info" logging level
 /// @param[in] logString A log statement
 /// @param[in] args (optional) A list of printf style arguments to format the logString with
-#define LOG_INFO(...) isobus::CANStackLogger::info(__VA_ARGS__)
+#define LOG_INFO(...) CAN_STACK_LOG_AT_LEVEL(isobus::CANStackLogger::LoggingLevel::Info, info, __VA_ARGS__)
 /// @brief A macro which logs a string at "debug" logging level
 /// @param[in] logString A log statement
 /// @param[in] args (optional) A list of printf style arguments to format the logString with
-#define LOG_DEBUG(...) isobus::CANStackLogger::debug(__VA_ARGS__)
+#define LOG_DEBUG(...) CAN_STACK_LOG_AT_LEVEL(isobus::CANStackLogger::LoggingLevel::Debug, debug, __VA_ARGS__)
 #endif
 //! @endcond
 
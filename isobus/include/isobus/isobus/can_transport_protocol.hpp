@@ -14,10 +14,13 @@
 
 #include <list>
 #include <mutex>
+#include <vector>
 
+#include "isobus/isobus/can_message_buffer_pool.hpp"
 #include "isobus/isobus/can_message_frame.hpp"
 #include "isobus/isobus/can_network_configuration.hpp"
 #include "isobus/isobus/can_transport_protocol_base.hpp"
+#include "isobus/isobus/can_transport_protocol_session_table.hpp"
 
 namespace isobus
 {
@@ -196,6 +199,11 @@ namespace isobus
 		/// @returns A list of all the active transport protocol sessions
 		std::list<std::shared_ptr<TransportProtocolSession>> get_sessions() const;
 
+		/// @brief Returns the pool that reassembly buffers for received messages are borrowed from
+		/// @details Useful for checking how often receive buffers are reused rather than allocated.
+		/// @returns The pool of receive buffers
+		const CANMessageBufferPool &get_receive_buffer_pool() const;
+
 		/// @brief A generic way for a protocol to process a received message
 		/// @param[in] message A received CAN message
 		void process_message(const CANMessage &message);
@@ -258,9 +266,23 @@ namespace isobus
 		/// @returns true if the EOM was sent, false if sending was not successful
 		bool send_end_of_session_acknowledgement(const std::shared_ptr<TransportProtocolSession> &session) const;
 
-		///@brief Sends data transfer packets for the specified TransportProtocolSession.
-		/// @param[in] session The TransportProtocolSession for which to send data transfer packets.
-		void send_data_transfer_packets(const std::shared_ptr<TransportProtocolSession> &session);
+		/// @brief Sends the next data transfer packet of the specified session
+		/// @param[in] session The session for which to send a data transfer packet
+		/// @returns true if the packet was sent, false if sending was not successful
+		bool send_data_transfer_packet(const std::shared_ptr<TransportProtocolSession> &session);
+
+		/// @brief Checks if a session is sending data, and enough time has passed since its last data transfer packet
+		/// @param[in] session The session to check
+		/// @returns true if the session can send a data transfer packet now, otherwise false
+		bool is_ready_to_send_data_transfer_packet(const std::shared_ptr<TransportProtocolSession> &session) const;
+
+		/// @brief Sends the data transfer packets of all sessions in @ref dataTransferSchedule
+		/// @details Sessions take turns sending one packet each, until all of them are done with their
+		/// current window or the max number of frames per update is reached. This keeps one large transfer from
+		/// holding up the other sessions on the same channel. The session that goes first rotates every update.
+		/// Sessions that have to space out their packets (broadcasts, or when a minimum time between
+		/// data frames is configured) send at most one packet per update.
+		void send_scheduled_data_transfer_packets();
 
 		/// @brief Processes a broadcast announce message.
 		/// @param[in] source The source control function that sent the broadcast announce message.
@@ -311,7 +333,7 @@ namespace isobus
 		/// @param[in] source The source control function for the session
 		/// @param[in] destination The destination control function for the session
 		/// @returns a matching session, or nullptr if no session matched the supplied parameters
-		std::shared_ptr<TransportProtocolSession> get_session(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination);
+		std::shared_ptr<TransportProtocolSession> get_session(const std::shared_ptr<ControlFunction> &source, const std::shared_ptr<ControlFunction> &destination);
 
 		/// @brief Get the number of active sessions.
 		/// @return The number of active sessions
@@ -322,7 +344,10 @@ namespace isobus
 		void update_state_machine(std::shared_ptr<TransportProtocolSession> &session);
 
 		mutable std::mutex activeSessionsMutex; ///< Synchronizes access to @ref activeSessions
-		std::list<std::shared_ptr<TransportProtocolSession>> activeSessions; ///< A list of all active TP sessions
+		TransportProtocolSessionTable<TransportProtocolSession> activeSessions; ///< All active TP sessions, indexed by source and destination
+		CANMessageBufferPool receiveBufferPool; ///< Reassembly buffers for received messages, each large enough for any TP message
+		std::vector<std::shared_ptr<TransportProtocolSession>> dataTransferSchedule; ///< Sessions that are ready to send data transfer packets in the current update
+		std::size_t dataTransferRoundRobinOffset = 0; ///< Rotates which session sends the first data transfer packet of each update
 
 		const CANMessageFrameCallback sendCANFrameCallback; ///< A callback for sending a CAN frame
 		const CANMessageCallback canMessageReceivedCallback; ///< A callback for when a complete CAN message is received using the TP protocol
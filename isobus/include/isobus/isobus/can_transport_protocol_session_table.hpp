@@ -0,0 +1,468 @@
+//================================================================================================
+/// @file can_transport_protocol_session_table.hpp
+///
+/// @brief A preallocated hash table used by the transport protocols to look up their active
+/// sessions by source and destination in constant time.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+
+#ifndef CAN_TRANSPORT_PROTOCOL_SESSION_TABLE_HPP
+#define CAN_TRANSPORT_PROTOCOL_SESSION_TABLE_HPP
+
+#include "isobus/isobus/can_control_function.hpp"
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace isobus
+{
+	/// @brief Fixed size memory blocks that transport protocol sessions are constructed in
+	/// @details The block size is taken from the first allocation, which is the session together with
+	/// its shared pointer control block. Blocks are carved out of chunks that each hold the expected
+	/// number of sessions, and freed blocks are reused, so once the first chunk exists, creating and
+	/// destroying sessions does not touch the heap unless more sessions than expected are alive at once.
+	///
+	/// Sessions can be released on any thread, for example by an application that copied the session list,
+	/// so the storage has its own mutex. It is kept alive by every session allocated from it.
+	class TransportProtocolSessionStorage
+	{
+	public:
+		/// @brief Constructs the storage. No memory is allocated until the first session is created.
+		/// @param[in] blocksPerChunk The number of sessions each chunk can hold
+		explicit TransportProtocolSessionStorage(std::size_t blocksPerChunk) :
+		  blocksPerChunk(std::max<std::size_t>(1, blocksPerChunk))
+		{
+		}
+
+		/// @brief Deleted copy constructor, the storage owns its chunks
+		TransportProtocolSessionStorage(const TransportProtocolSessionStorage &) = delete;
+
+		/// @brief Deleted copy assignment operator, the storage owns its chunks
+		/// @returns Nothing, this is deleted
+		TransportProtocolSessionStorage &operator=(const TransportProtocolSessionStorage &) = delete;
+
+		/// @brief Frees all chunks. Every session must have been destroyed.
+		~TransportProtocolSessionStorage()
+		{
+			for (void *chunk : chunks)
+			{
+				::operator delete(chunk);
+			}
+		}
+
+		/// @brief Gets a block of memory for a session
+		/// @param[in] size The number of bytes needed
+		/// @returns A block of at least `size` bytes
+		void *allocate(std::size_t size)
+		{
+			LOCK_GUARD(Mutex, storageMutex);
+			if (0 == blockSize)
+			{
+				blockSize = ((size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t)) * alignof(std::max_align_t);
+			}
+
+			if (size > blockSize)
+			{
+				// Not a session of the type the blocks were sized for, which the tables never ask for
+				return ::operator new(size);
+			}
+
+			if (freeBlocks.empty())
+			{
+				add_chunk();
+			}
+			void *retVal = freeBlocks.back();
+			freeBlocks.pop_back();
+			return retVal;
+		}
+
+		/// @brief Gives a block back so it can be reused
+		/// @param[in] block The block to give back
+		/// @param[in] size The number of bytes that were asked for when the block was allocated
+		void deallocate(void *block, std::size_t size)
+		{
+			LOCK_GUARD(Mutex, storageMutex);
+			if (size > blockSize)
+			{
+				::operator delete(block);
+			}
+			else
+			{
+				// There is room for every block of every chunk, so this never allocates
+				freeBlocks.push_back(block);
+			}
+		}
+
+		/// @brief Returns the number of chunks that have been allocated
+		/// @returns The number of times the storage had to allocate memory for more sessions
+		std::size_t get_number_of_chunks() const
+		{
+			LOCK_GUARD(Mutex, storageMutex);
+			return chunks.size();
+		}
+
+	private:
+		/// @brief Allocates another chunk and adds its blocks to the free list
+		void add_chunk()
+		{
+			freeBlocks.reserve((chunks.size() + 1) * blocksPerChunk);
+			chunks.reserve(chunks.size() + 1);
+
+			auto chunk = static_cast<std::uint8_t *>(::operator new(blockSize * blocksPerChunk));
+			chunks.push_back(chunk);
+			for (std::size_t i = blocksPerChunk; i > 0; i--)
+			{
+				// Handed out from the start of the chunk first
+				freeBlocks.push_back(chunk + ((i - 1) * blockSize));
+			}
+		}
+
+		std::vector<void *> chunks; ///< The memory blocks are carved out of
+		std::vector<void *> freeBlocks; ///< Blocks that are not in use
+		const std::size_t blocksPerChunk; ///< The number of blocks in each chunk
+		std::size_t blockSize = 0; ///< The size of each block, set by the first allocation
+		mutable Mutex storageMutex; ///< Synchronizes access to the free list
+	};
+
+	/// @brief An allocator that constructs sessions in a TransportProtocolSessionStorage, for use with `std::allocate_shared`
+	/// @tparam T The type to allocate
+	template<typename T>
+	class TransportProtocolSessionAllocator
+	{
+	public:
+		using value_type = T; ///< The type to allocate
+
+		/// @brief Constructs an allocator that uses a storage
+		/// @param[in] storage The storage to allocate from
+		explicit TransportProtocolSessionAllocator(std::shared_ptr<TransportProtocolSessionStorage> storage) :
+		  storage(std::move(storage))
+		{
+		}
+
+		/// @brief Constructs an allocator for another type that uses the same storage
+		/// @param[in] other The allocator to copy the storage from
+		template<typename U>
+		TransportProtocolSessionAllocator(const TransportProtocolSessionAllocator<U> &other) :
+		  storage(other.storage)
+		{
+		}
+
+		/// @brief Allocates memory for objects
+		/// @param[in] count The number of objects
+		/// @returns Memory for `count` objects
+		T *allocate(std::size_t count)
+		{
+			return static_cast<T *>(storage->allocate(count * sizeof(T)));
+		}
+
+		/// @brief Frees memory allocated by this allocator
+		/// @param[in] pointer The memory to free
+		/// @param[in] count The number of objects the memory was allocated for
+		void deallocate(T *pointer, std::size_t count)
+		{
+			storage->deallocate(pointer, count * sizeof(T));
+		}
+
+		/// @brief Compares two allocators, which are equal if they use the same storage
+		/// @param[in] other The allocator to compare to
+		/// @returns true if memory from one allocator can be freed by the other
+		template<typename U>
+		bool operator==(const TransportProtocolSessionAllocator<U> &other) const
+		{
+			return storage == other.storage;
+		}
+
+		/// @brief Compares two allocators, which are equal if they use the same storage
+		/// @param[in] other The allocator to compare to
+		/// @returns true if memory from one allocator can't be freed by the other
+		template<typename U>
+		bool operator!=(const TransportProtocolSessionAllocator<U> &other) const
+		{
+			return storage != other.storage;
+		}
+
+	private:
+		template<typename U>
+		friend class TransportProtocolSessionAllocator;
+
+		std::shared_ptr<TransportProtocolSessionStorage> storage; ///< The storage to allocate from
+	};
+
+	/// @brief A table of transport protocol sessions, indexed by the session's source and destination
+	/// @details The standard only allows one session per source and destination pair, so the pair
+	/// (optionally combined with the PGN, for protocols like NMEA2000 fast packet which allow one
+	/// session per PGN) is used as the key of an open addressing hash table.
+	/// This way each received CM or DT frame can find its session without searching all active sessions.
+	///
+	/// Sessions are keyed by the identity of their control functions rather than by address,
+	/// which matches `TransportProtocolSessionBase::matches` and keeps a session reachable
+	/// if one of its control functions changes address.
+	///
+	/// The table and the list of sessions are allocated up front for the expected number of sessions,
+	/// and sessions made with `create` are constructed in a TransportProtocolSessionStorage,
+	/// so adding and removing sessions does not touch the heap unless that number is exceeded.
+	///
+	/// @note This class is not thread safe, the owning protocol is responsible for locking.
+	/// @tparam SessionType The type of session to store, derived from `TransportProtocolSessionBase`
+	template<typename SessionType>
+	class TransportProtocolSessionTable
+	{
+	public:
+		/// @brief Constructs a table and preallocates it for a number of sessions
+		/// @param[in] expectedNumberOfSessions The number of sessions the table can hold without allocating
+		/// @param[in] keyIncludesParameterGroupNumber If true, sessions with the same source and destination but different PGNs are distinct
+		explicit TransportProtocolSessionTable(std::size_t expectedNumberOfSessions, bool keyIncludesParameterGroupNumber = false) :
+		  storage(std::make_shared<TransportProtocolSessionStorage>(expectedNumberOfSessions)),
+		  keyIncludesParameterGroupNumber(keyIncludesParameterGroupNumber)
+		{
+			sessions.reserve(expectedNumberOfSessions);
+			slots.resize(get_slot_count_for(expectedNumberOfSessions));
+		}
+
+		/// @brief Constructs a session in the table's session storage, without adding it to the table
+		/// @param[in] args The arguments to pass to the session's constructor
+		/// @returns The new session
+		template<typename... Args>
+		std::shared_ptr<SessionType> create(Args &&...args) const
+		{
+			return std::allocate_shared<SessionType>(TransportProtocolSessionAllocator<SessionType>(storage), std::forward<Args>(args)...);
+		}
+
+		/// @brief Returns the storage sessions made with `create` are constructed in
+		/// @returns The storage sessions made with `create` are constructed in
+		const TransportProtocolSessionStorage &get_storage() const
+		{
+			return *storage;
+		}
+
+		/// @brief Adds a session to the table
+		/// @param[in] session The session to add
+		/// @returns true if the session was added, false if a session with the same key already exists
+		bool insert(const std::shared_ptr<SessionType> &session)
+		{
+			bool retVal = false;
+
+			if ((nullptr != session) && (nullptr == find(session->get_source(), session->get_destination(), session->get_parameter_group_number())))
+			{
+				if (get_slot_count_for(sessions.size() + 1) > slots.size())
+				{
+					rehash(get_slot_count_for(sessions.size() + 1));
+				}
+				place(session);
+				sessions.push_back(session);
+				retVal = true;
+			}
+			return retVal;
+		}
+
+		/// @brief Looks up a session by its source and destination
+		/// @param[in] source The source control function of the session
+		/// @param[in] destination The destination control function of the session, or nullptr for broadcast sessions
+		/// @param[in] parameterGroupNumber The PGN of the session, only used if the table is keyed by PGN
+		/// @returns The matching session, or nullptr if no session matched
+		std::shared_ptr<SessionType> find(const std::shared_ptr<ControlFunction> &source,
+		                                  const std::shared_ptr<ControlFunction> &destination,
+		                                  std::uint32_t parameterGroupNumber = 0) const
+		{
+			std::shared_ptr<SessionType> retVal;
+			std::size_t index = find_slot(source.get(), destination.get(), get_key_parameter_group_number(parameterGroupNumber));
+
+			if (index < slots.size())
+			{
+				retVal = slots[index].session;
+			}
+			return retVal;
+		}
+
+		/// @brief Removes a session from the table
+		/// @param[in] session The session to remove
+		/// @returns true if the session was in the table and was removed, otherwise false
+		bool erase(const std::shared_ptr<SessionType> &session)
+		{
+			bool retVal = false;
+
+			if (nullptr != session)
+			{
+				std::size_t index = find_slot(session->get_source().get(),
+				                              session->get_destination().get(),
+				                              get_key_parameter_group_number(session->get_parameter_group_number()));
+
+				if ((index < slots.size()) && (slots[index].session == session))
+				{
+					remove_slot(index);
+					sessions.erase(std::find(sessions.begin(), sessions.end(), session));
+					retVal = true;
+				}
+			}
+			return retVal;
+		}
+
+		/// @brief Removes all sessions from the table, keeping its storage
+		void clear()
+		{
+			std::fill(slots.begin(), slots.end(), Slot());
+			sessions.clear();
+		}
+
+		/// @brief Returns the number of sessions in the table
+		/// @returns The number of sessions in the table
+		std::size_t size() const
+		{
+			return sessions.size();
+		}
+
+		/// @brief Returns if the table has no sessions in it
+		/// @returns true if there are no sessions in the table, otherwise false
+		bool empty() const
+		{
+			return sessions.empty();
+		}
+
+		/// @brief Returns all sessions in the table, in the order they were added
+		/// @returns All sessions in the table, in the order they were added
+		const std::vector<std::shared_ptr<SessionType>> &get_sessions() const
+		{
+			return sessions;
+		}
+
+	private:
+		/// @brief A single entry in the hash table, which is empty if it has no session
+		struct Slot
+		{
+			const ControlFunction *source = nullptr; ///< The source control function of the session
+			const ControlFunction *destination = nullptr; ///< The destination control function of the session
+			std::uint32_t parameterGroupNumber = 0; ///< The PGN of the session, if the table is keyed by PGN
+			std::shared_ptr<SessionType> session; ///< The session stored in this slot
+		};
+
+		/// @brief Returns the number of slots needed to hold a number of sessions at no more than half load
+		/// @param[in] numberOfSessions The number of sessions to hold
+		/// @returns The number of slots to use, always a power of two
+		static std::size_t get_slot_count_for(std::size_t numberOfSessions)
+		{
+			std::size_t retVal = MINIMUM_NUMBER_OF_SLOTS;
+			while (retVal < (2 * numberOfSessions))
+			{
+				retVal *= 2;
+			}
+			return retVal;
+		}
+
+		/// @brief Combines the parts of a key into a hash
+		/// @param[in] source The source control function of the key
+		/// @param[in] destination The destination control function of the key
+		/// @param[in] parameterGroupNumber The PGN of the key
+		/// @returns The hash of the key
+		static std::size_t hash(const ControlFunction *source, const ControlFunction *destination, std::uint32_t parameterGroupNumber)
+		{
+			// Control functions are heap allocated, so the low bits of the pointers carry no information.
+			// Mix everything together so that the low bits used to index the table are well distributed.
+			std::uint64_t retVal = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(source));
+			retVal = (retVal * 0x9E3779B97F4A7C15ULL) ^ static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(destination));
+			retVal = (retVal * 0x9E3779B97F4A7C15ULL) ^ parameterGroupNumber;
+			retVal = (retVal ^ (retVal >> 32)) * 0x9E3779B97F4A7C15ULL;
+			return static_cast<std::size_t>(retVal ^ (retVal >> 29));
+		}
+
+		/// @brief Returns the PGN to use in keys, which is 0 if the table is not keyed by PGN
+		/// @param[in] parameterGroupNumber The PGN of the session
+		/// @returns The PGN to use in keys
+		std::uint32_t get_key_parameter_group_number(std::uint32_t parameterGroupNumber) const
+		{
+			return keyIncludesParameterGroupNumber ? parameterGroupNumber : 0;
+		}
+
+		/// @brief Finds the slot that holds the session with a key
+		/// @param[in] source The source control function of the key
+		/// @param[in] destination The destination control function of the key
+		/// @param[in] parameterGroupNumber The PGN of the key
+		/// @returns The index of the slot, or the number of slots if there is no session with the key
+		std::size_t find_slot(const ControlFunction *source, const ControlFunction *destination, std::uint32_t parameterGroupNumber) const
+		{
+			const std::size_t mask = slots.size() - 1;
+			std::size_t index = hash(source, destination, parameterGroupNumber) & mask;
+
+			while (nullptr != slots[index].session)
+			{
+				if ((slots[index].source == source) &&
+				    (slots[index].destination == destination) &&
+				    (slots[index].parameterGroupNumber == parameterGroupNumber))
+				{
+					return index;
+				}
+				index = (index + 1) & mask;
+			}
+			return slots.size();
+		}
+
+		/// @brief Stores a session in the first free slot for its key
+		/// @param[in] session The session to store
+		void place(const std::shared_ptr<SessionType> &session)
+		{
+			const std::size_t mask = slots.size() - 1;
+			Slot newSlot;
+			newSlot.source = session->get_source().get();
+			newSlot.destination = session->get_destination().get();
+			newSlot.parameterGroupNumber = get_key_parameter_group_number(session->get_parameter_group_number());
+			newSlot.session = session;
+
+			std::size_t index = hash(newSlot.source, newSlot.destination, newSlot.parameterGroupNumber) & mask;
+			while (nullptr != slots[index].session)
+			{
+				index = (index + 1) & mask;
+			}
+			slots[index] = std::move(newSlot);
+		}
+
+		/// @brief Empties a slot, and moves later entries of the same probe sequence back to close the gap
+		/// @param[in] index The index of the slot to empty
+		void remove_slot(std::size_t index)
+		{
+			const std::size_t mask = slots.size() - 1;
+			slots[index] = Slot();
+
+			std::size_t next = (index + 1) & mask;
+			while (nullptr != slots[next].session)
+			{
+				std::size_t desired = hash(slots[next].source, slots[next].destination, slots[next].parameterGroupNumber) & mask;
+
+				// The entry can fill the gap if the gap lies between its desired slot and where it is now
+				if (((next - desired) & mask) >= ((next - index) & mask))
+				{
+					slots[index] = std::move(slots[next]);
+					slots[next] = Slot();
+					index = next;
+				}
+				next = (next + 1) & mask;
+			}
+		}
+
+		/// @brief Resizes the hash table and places every session again
+		/// @param[in] numberOfSlots The new number of slots, which must be a power of two
+		void rehash(std::size_t numberOfSlots)
+		{
+			slots.assign(numberOfSlots, Slot());
+			for (const auto &session : sessions)
+			{
+				place(session);
+			}
+		}
+
+		static constexpr std::size_t MINIMUM_NUMBER_OF_SLOTS = 8; ///< The smallest hash table to use, must be a power of two
+
+		std::shared_ptr<TransportProtocolSessionStorage> storage; ///< Memory for sessions, shared with every session made by `create`
+		std::vector<Slot> slots; ///< The hash table, its size is always a power of two
+		std::vector<std::shared_ptr<SessionType>> sessions; ///< All sessions in the order they were added, for iteration
+		const bool keyIncludesParameterGroupNumber; ///< Denotes if the PGN is part of the key
+	};
+} // namespace isobus
+
+#endif // CAN_TRANSPORT_PROTOCOL_SESSION_TABLE_HPP
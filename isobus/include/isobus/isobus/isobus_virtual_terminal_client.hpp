@@ -10,14 +10,20 @@
 #define ISOBUS_VIRTUAL_TERMINAL_CLIENT_HPP
 
 #include "isobus/isobus/can_internal_control_function.hpp"
+#include "isobus/isobus/can_message_data.hpp"
 #include "isobus/isobus/can_partnered_control_function.hpp"
 #include "isobus/isobus/isobus_language_command_interface.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_command_queue.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
 #include "isobus/utility/event_dispatcher.hpp"
+#include "isobus/utility/memory_mapped_file.hpp"
 #include "isobus/utility/processing_flags.hpp"
 #include "isobus/utility/thread_synchronization.hpp"
 
+#include <array>
+#include <deque>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -517,6 +523,15 @@ namespace isobus
 			std::uint16_t value2; ///< The second value
 		};
 
+		/// @brief A struct for storing information of a completed command transaction
+		struct VTTransactionCompletedEvent
+		{
+			VirtualTerminalClient *parentPointer; ///< A pointer to the parent VT client
+			std::uint32_t transactionID; ///< The ID returned by end_transaction
+			std::size_t numberOfCommands; ///< The number of commands sent for the transaction, after coalescing
+			std::size_t numberOfTimedOutCommands; ///< The number of commands the VT did not respond to in time
+		};
+
 		/// @brief The event dispatcher for when a soft key is pressed or released
 		/// @returns A reference to the event dispatcher, used to add listeners
 		EventDispatcher<VTKeyEvent> &get_vt_soft_key_event_dispatcher();
@@ -568,6 +583,12 @@ namespace isobus
 		/// @returns A reference to the event dispatcher, used to add listeners
 		EventDispatcher<AuxiliaryFunctionEvent> &get_auxiliary_function_event_dispatcher();
 
+		/// @brief The event dispatcher for when the VT has responded to every command of a transaction
+		/// @details Transactions complete in the order they were ended.
+		/// The event is dispatched from the thread that processes the command queue, after the queue is unlocked.
+		/// @returns A reference to the event dispatcher, used to add listeners
+		EventDispatcher<VTTransactionCompletedEvent> &get_transaction_completed_event_dispatcher();
+
 		/// @brief Set the model identification code of our auxiliary input device.
 		/// @details The model identification code is used to allow other devices identify
 		/// whether our device differs from a previous versions. If the model identification code
@@ -597,6 +618,30 @@ namespace isobus
 		/// @param[in] controlLocked Whether the auxiliary input is locked
 		void update_auxiliary_input(const std::uint16_t auxiliaryInputID, const std::uint16_t value1, const std::uint16_t value2, const bool controlLocked = false);
 
+		// Command Transactions
+
+		/// @brief Starts collecting the following commands into a transaction
+		/// @details Until end_transaction is called, commands are not sent but queued, and commands of the transaction that change the
+		/// same thing (for example the value of the same numeric object) are coalesced, so only the latest value is sent.
+		/// Commands that are not replaceable, such as executing a macro or locking a mask, are all sent in the order they were queued.
+		/// This allows a frame of updates, such as all values of a dashboard, to be built up and then sent as one burst.
+		///
+		/// The VT protocol carries one command per message, and the VT must respond to each command before the
+		/// next one is sent, so the burst is paced by the VT: each command is sent as soon as the previous one is acknowledged.
+		/// To change many objects with a single command, upload a macro with the object pool and use send_execute_extended_macro
+		/// as part of the transaction.
+		/// @note Calling this while a transaction is already open has no effect.
+		void begin_transaction();
+
+		/// @brief Ends the current transaction and starts sending its commands
+		/// @details When the VT has responded to every command of the transaction, the transaction completed event is dispatched.
+		/// @returns The ID of the transaction, as used in the completed event, or 0 if no transaction was open
+		std::uint32_t end_transaction();
+
+		/// @brief Returns if a transaction is open, see begin_transaction
+		/// @returns true if commands are currently collected into a transaction
+		bool get_is_transaction_open() const;
+
 		// Command Messages
 
 		/// @brief Sends a hide/show object command
@@ -1234,6 +1279,19 @@ namespace isobus
 		                     const std::vector<std::uint8_t> *pool,
 		                     const std::string &version = "");
 
+		/// @brief Assigns an object pool to the client that is streamed from an IOP file during upload
+		/// @details The file is memory mapped instead of read into RAM, so the operating system only pages in the
+		/// parts that are being uploaded. If the pool is auto-scaled, each object is scaled as it is uploaded,
+		/// so no scaled copy of the pool is kept either. This is the best option for large pools on RAM constrained devices.
+		/// On platforms without memory mapping support the file is read into memory when it is opened.
+		/// @param[in] poolIndex The index of the pool you are assigning
+		/// @param[in] filePath The path of the IOP file. The file must not be modified while the client uses it.
+		/// @param[in] version An optional version string. The stack will automatically store/load your pool from the VT if this is provided.
+		/// @returns true if the file was opened, false if it does not exist or is empty
+		bool set_object_pool_from_file(std::uint8_t poolIndex,
+		                               const std::string &filePath,
+		                               const std::string &version = "");
+
 		/// @brief Configures an object pool to be automatically scaled to match the target VT server
 		/// @param[in] poolIndex The index of the pool you want to auto-scale
 		/// @param[in] originalDataMaskDimensions_px The data mask width that your object pool was originally designed for
@@ -1242,6 +1300,26 @@ namespace isobus
 		                             std::uint32_t originalDataMaskDimensions_px,
 		                             std::uint32_t originalSoftKyeDesignatorHeight_px);
 
+		/// @brief Sets a directory in which scaled object pools are stored as IOP files, so they can be reused
+		/// @details With a cache directory, a pool that was scaled for a VT is also written to the directory, and
+		/// read back instead of being scaled again when the client connects to a VT with the same
+		/// data mask size, soft key size and fonts, even after a restart.
+		/// Variants can be precomputed offline by connecting to each type of VT once, and shipping the files
+		/// with the application. The files are named after a hash of the pool and the VT's properties that affect scaling.
+		///
+		/// A cached pool is identified by its hash, which is computed once per assigned pool, so a pool that is
+		/// changed in place must be assigned again. Pools provided through a data chunk callback are only cached
+		/// if they have a version label, which must change whenever the pool changes.
+		/// @param[in] directory The directory to use, or an empty string to not cache scaled pools on disk
+		void set_object_pool_scaling_cache_directory(const std::string &directory);
+
+		/// @brief Sets if scaled object pools are kept in memory after they are uploaded
+		/// @details By default the scaled copy of each pool is freed once the VT accepted the pool.
+		/// Keeping it costs as much RAM as the pools themselves, but reconnecting to the same VT then skips scaling.
+		/// Pools provided through a data chunk callback are only kept if they have a version label.
+		/// @param[in] keep true to keep scaled pools in memory, false to free them after the upload
+		void set_keep_scaled_object_pools(bool keep);
+
 		/// @brief Assigns an object pool to the client where the client will get data in chunks during upload.
 		/// @details This is probably better for huge pools if you are RAM constrained, or if your
 		/// pool is stored on some external device that you need to get data from in pages.
@@ -1305,6 +1383,28 @@ namespace isobus
 			Failed ///< The pool upload has failed
 		};
 
+		/// @brief Identifies a scaled variant of an object pool: the pool, and everything about the VT that affects the scaling
+		struct ObjectPoolScalingKey
+		{
+			/// @brief Compares two keys
+			/// @param[in] other The key to compare to
+			/// @returns true if both keys identify the same scaled variant
+			bool operator==(const ObjectPoolScalingKey &other) const;
+
+			std::uint64_t poolHash; ///< A hash of the pool, or of its version label for pools provided through a callback
+			std::uint32_t poolSize; ///< The size of the pool
+			std::uint32_t originalDataMaskDimension; ///< The data mask size the pool was designed for
+			std::uint32_t originalSoftKeyDesignatorHeight; ///< The soft key designator size the pool was designed for
+			std::uint16_t dataMaskWidth; ///< The data mask width of the VT
+			std::uint16_t dataMaskHeight; ///< The data mask height of the VT
+			std::uint8_t softKeyDesignatorWidth; ///< The soft key designator width of the VT
+			std::uint8_t softKeyDesignatorHeight; ///< The soft key designator height of the VT
+			std::uint8_t smallFontSizes; ///< The small font sizes supported by the VT
+			std::uint8_t largeFontSizes; ///< The large font sizes supported by the VT
+		};
+
+		static constexpr std::size_t NO_STREAMED_OBJECT = std::numeric_limits<std::size_t>::max(); ///< Indicates that no object of a streamed pool is scaled yet
+
 		/// @brief An object for storing information regarding an object pool upload
 		struct ObjectPoolDataStruct
 		{
@@ -1318,6 +1418,14 @@ namespace isobus
 			std::uint32_t autoScaleSoftKeyDesignatorOriginalHeight; ///< The original height of a soft key designator as designed in the pool (in pixels)
 			bool useDataCallback; ///< Determines if the client will use callbacks to get the data in chunks.
 			bool uploaded; ///< The upload state of this pool
+			std::vector<std::uint32_t> objectOffsets; ///< The offset of each object in the pool, found the first time the pool is scaled
+			ObjectPoolScalingKey scalingKey = {}; ///< What scaledObjectPool was scaled for
+			std::uint64_t poolHash = 0; ///< The hash of the pool, once poolHashValid is set
+			bool poolHashValid = false; ///< Whether the pool was hashed yet
+			bool scaledObjectPoolValid = false; ///< Whether scaledObjectPool holds the pool scaled for scalingKey
+			std::shared_ptr<MemoryMappedFile> objectPoolFile; ///< The file the pool is streamed from, objectPoolDataPointer points into it
+			std::vector<std::uint8_t> streamedObject; ///< The last object of a pool streamed from a file, scaled for the connected VT
+			std::size_t streamedObjectIndex = NO_STREAMED_OBJECT; ///< The index of the object in streamedObject
 		};
 
 		/// @brief A struct for storing information about an auxiliary input device
@@ -1349,6 +1457,12 @@ namespace isobus
 		/// @returns true if the message was sent successfully, false otherwise
 		bool send_message_to_vt(const std::uint8_t *dataBuffer, std::uint32_t dataLength, CANIdentifier::CANPriority priority = CANIdentifier::CANPriority::Priority5) const;
 
+		/// @brief Sends a message to the VT server, handing the data to the transport protocol without copying it
+		/// @param[in,out] data The data to send. Ownership is only taken if the message was sent.
+		/// @param[in] priority The priority of the message (default is Priority5)
+		/// @returns true if the message was sent successfully, false otherwise
+		bool send_message_to_vt(std::unique_ptr<CANMessageData> &data, CANIdentifier::CANPriority priority = CANIdentifier::CANPriority::Priority5) const;
+
 		// Object Pool Managment
 		/// @brief Sends the delete object pool message
 		/// @returns true if the message was sent
@@ -1513,9 +1627,51 @@ namespace isobus
 		bool get_any_pool_needs_scaling() const;
 
 		/// @brief Iterates through each object pool and scales each object in the pool automatically
+		/// @details Pools that were already scaled for the same VT, in memory or in the cache directory, are not scaled again.
 		/// @returns true if all object pools scaled with no error
 		bool scale_object_pools();
 
+		/// @brief Builds the key that identifies the scaled variant of a pool for the connected VT
+		/// @details The pool is only hashed the first time a key is built for it, since it is replaced
+		/// rather than modified when the application assigns a new pool.
+		/// @param[in] objectPool The pool to build the key for
+		/// @returns The key of the scaled variant
+		ObjectPoolScalingKey get_object_pool_scaling_key(ObjectPoolDataStruct &objectPool) const;
+
+		/// @brief Copies an object pool into its scaling buffer
+		/// @param[in] objectPool The pool to copy
+		/// @returns true if the whole pool was copied
+		bool copy_object_pool_for_scaling(ObjectPoolDataStruct &objectPool);
+
+		/// @brief Returns the factor by which an object in a pool is scaled for the connected VT
+		/// @param[in] objectPool The pool the object is in
+		/// @param[in] type The type of the object
+		/// @returns The scale factor
+		float get_object_scale_factor(const ObjectPoolDataStruct &objectPool, VirtualTerminalObjectType type) const;
+
+		/// @brief Scales every object in a pool's scaling buffer
+		/// @details The first time a pool is scaled, the offset of each object is recorded, so scaling the pool
+		/// again for another VT does not have to parse the length of every object.
+		/// @param[in] objectPool The pool to scale, which must have been copied into its scaling buffer
+		/// @returns true if every object was scaled
+		bool scale_object_pool(ObjectPoolDataStruct &objectPool);
+
+		/// @brief Copies part of a pool that is streamed from a file, scaling the objects in it on the fly
+		/// @details Only one object is scaled at a time, and it is kept until a chunk needs another object,
+		/// since chunks usually end in the middle of an object.
+		/// @param[in] objectPool The pool, whose object offsets must have been found
+		/// @param[in] offset The offset in the pool of the first byte to copy
+		/// @param[in] length The number of bytes to copy
+		/// @param[out] destination The buffer to copy the scaled bytes to
+		/// @returns true if the bytes were copied
+		bool read_streamed_object_pool(ObjectPoolDataStruct &objectPool, std::uint32_t offset, std::uint32_t length, std::uint8_t *destination);
+
+		/// @brief Returns the name of the file a scaled variant of an object pool is cached in
+		/// @param[in] directory The cache directory
+		/// @param[in] key The key of the scaled variant
+		/// @returns The path of the file
+		static std::string get_scaled_object_pool_file_name(const std::string &directory, const ObjectPoolScalingKey &key);
+
 		/// @brief Returns if the specified object type can be scaled
 		/// @param[in] type The object type to check
 		/// @returns true if the object is inherently scalable
@@ -1565,32 +1721,77 @@ namespace isobus
 		/// @returns true if the VT doesn't support the function
 		bool is_function_unsupported(std::uint8_t functionCode) const;
 
+		/// @brief Checks if a command can be sent to the VT server
+		/// @details A command can be sent once the VT responded to the last one, or the response timed out.
+		/// @returns true if the client is connected and not waiting for a response
+		bool get_is_ready_for_command();
+
+		/// @brief Records that a command was sent, so the next one waits for the VT's response
+		void on_command_sent();
+
 		/// @brief Sends a command to the VT server
 		/// @param[in] data The data to send, including the function-code
+		/// @param[in] length The number of bytes to send
 		/// @returns true if the message was sent successfully
-		bool send_command(const std::vector<std::uint8_t> &data);
+		bool send_command(const std::uint8_t *data, std::uint32_t length);
+
+		/// @brief Sends a command to the VT server
+		/// @details Commands that need a transport protocol are moved into the transport session
+		/// instead of being copied, in which case `data` is left empty.
+		/// @param[in,out] data The data to send, including the function-code. Only moved from if the command was sent.
+		/// @returns true if the message was sent successfully
+		bool send_command(std::vector<std::uint8_t> &data);
 
 		/// @brief Tries to send a command to the VT server, and queues it if it fails
 		/// @param[in] data The data to send, including the function-code
-		/// @param[in] replace If true, the message will replace any existing message with the same priority and function-code
+		/// @param[in] length The number of bytes to send
+		/// @param[in] replace If true, the command replaces a queued command that changes the same thing, see get_command_key
 		/// @returns true if the message was sent/queued successfully
-		bool queue_command(const std::vector<std::uint8_t> &data, bool replace = false);
+		bool queue_command(const std::uint8_t *data, std::uint32_t length, bool replace = false);
 
-		/// @brief Replaces the first message in the queue with the same function-code and priority, and removes the rest
-		/// @note This will not queue a message if one does not already exist.
+		/// @brief Tries to send a command to the VT server, and queues it if it fails
 		/// @param[in] data The data to send, including the function-code
-		/// @returns true if the message was replaced successfully
-		bool replace_command(const std::vector<std::uint8_t> &data);
+		/// @param[in] replace If true, the command replaces a queued command that changes the same thing, see get_command_key
+		/// @returns true if the message was sent/queued successfully
+		template<std::size_t N>
+		bool queue_command(const std::array<std::uint8_t, N> &data, bool replace = false)
+		{
+			return queue_command(data.data(), static_cast<std::uint32_t>(N), replace);
+		}
 
-		/// @brief Tests whether two VT commands focus on changing/requesting the same thing
-		/// @param[in] first The first command to compare
-		/// @param[in] second The second command to compare
-		/// @returns true if the two commands are similar
-		static bool are_commands_similar(const std::vector<std::uint8_t> &first, const std::vector<std::uint8_t> &second);
+		/// @brief Tries to send a command to the VT server, and queues it if it fails
+		/// @param[in] data The data to send, including the function-code
+		/// @param[in] replace If true, the command replaces a queued command that changes the same thing, see get_command_key
+		/// @returns true if the message was sent/queued successfully
+		bool queue_command(std::vector<std::uint8_t> data, bool replace = false);
+
+		/// @brief Builds the key that identifies what a VT command changes or requests
+		/// @details The key is made of the function code, the object, attribute or sub-command bytes that are
+		/// relevant for that function code, and the length of the command. Queued commands with the same key
+		/// are coalesced, so only the latest one is sent.
+		/// @param[in] data The command, including the function-code
+		/// @param[in] length The number of bytes in the command
+		/// @returns The key of the command
+		static std::uint64_t get_command_key(const std::uint8_t *data, std::uint32_t length);
 
 		/// @brief Tries to send all messages in the queue
 		void process_command_queue();
 
+		/// @brief Called when the VT responded to the command that is awaiting a response
+		void on_command_response();
+
+		/// @brief Counts the command that was awaiting a response as completed for its transaction
+		/// @attention The command queue mutex must be locked
+		/// @param[in] timedOut true if the VT did not respond in time
+		void complete_transaction_command(bool timedOut);
+
+		/// @brief Moves the transactions that have ended and of which all commands completed to the completed list
+		/// @attention The command queue mutex must be locked
+		void collect_completed_transactions();
+
+		/// @brief Dispatches the completed event for all transactions that completed, in order
+		void dispatch_completed_transactions();
+
 		/// @brief The worker thread will execute this function when it runs, if applicable
 		void worker_thread_function();
 
@@ -1642,6 +1843,8 @@ namespace isobus
 		std::uint32_t lastWorkingSetMaintenanceTimestamp_ms = 0; ///< The timestamp from the last time we sent the maintenance message
 		std::uint32_t lastAuxiliaryMaintenanceTimestamp_ms = 0; ///< The timestamp from the last time we sent the maintenance message
 		std::vector<ObjectPoolDataStruct> objectPools; ///< A container to hold all object pools that have been assigned to the interface
+		std::string objectPoolScalingCacheDirectory; ///< A directory in which scaled object pools are cached, or empty to not cache them on disk
+		bool keepScaledObjectPools = false; ///< Whether scaled object pools are kept in memory after they are uploaded
 		std::vector<std::uint8_t> unsupportedFunctions; ///< Holds the functions unsupported by the server.
 		std::vector<AssignedAuxiliaryInputDevice> assignedAuxiliaryInputDevices; ///< A container to hold all auxiliary input devices known
 		std::uint16_t ourModelIdentificationCode = 1; ///< The model identification code of this input device
@@ -1656,10 +1859,25 @@ namespace isobus
 		bool shouldTerminate = false; ///< Used to determine if the client should exit and join the worker thread
 
 		// Command queue
-		std::vector<std::vector<std::uint8_t>> commandQueue; ///< A queue of commands to send to the VT server
+		VirtualTerminalCommandQueue commandQueue; ///< A queue of commands to send to the VT server
 		bool commandAwaitingResponse = false; ///< Determines if we are currently waiting for a response to a command
 		std::uint32_t lastCommandTimestamp_ms = 0; ///< The timestamp of the last command sent
-		Mutex commandQueueMutex; ///< A mutex to protect the command queue
+		Mutex commandQueueMutex; ///< A mutex to protect the command queue and the transactions
+
+		/// @brief Tracks the commands of a transaction that have not been responded to yet
+		struct TransactionStatus
+		{
+			std::uint32_t transactionID; ///< The ID of the transaction
+			std::size_t numberOfCommands; ///< The number of commands queued for the transaction
+			std::size_t numberOfCompletedCommands; ///< The number of commands the VT responded to, or that timed out
+			std::size_t numberOfTimedOutCommands; ///< The number of commands that timed out
+			bool ended; ///< Whether end_transaction was called for the transaction
+		};
+		std::deque<TransactionStatus> transactions; ///< Transactions that have not completed yet, in order
+		std::vector<VTTransactionCompletedEvent> completedTransactions; ///< Completed transactions waiting to be dispatched
+		std::uint32_t nextTransactionID = 1; ///< The ID of the next transaction
+		std::uint32_t commandAwaitingResponseTransactionID = 0; ///< The transaction of the command awaiting a response, or 0 for none
+		bool transactionOpen = false; ///< Whether commands are currently collected into a transaction
 
 		// Activation event callbacks
 		EventDispatcher<VTKeyEvent> softKeyEventDispatcher; ///< A list of all soft key event callbacks
@@ -1674,6 +1892,7 @@ namespace isobus
 		EventDispatcher<VTUserLayoutHideShowEvent> userLayoutHideShowEventDispatcher; ///< A list of all user layout hide/show callbacks
 		EventDispatcher<VTAudioSignalTerminationEvent> audioSignalTerminationEventDispatcher; ///< A list of all control audio signal termination callbacks
 		EventDispatcher<AuxiliaryFunctionEvent> auxiliaryFunctionEventDispatcher; ///< A list of all auxiliary function callbacks
+		EventDispatcher<VTTransactionCompletedEvent> transactionCompletedEventDispatcher; ///< A list of all transaction completed callbacks
 
 		// Object Pool info
 		DataChunkCallback objectPoolDataCallback = nullptr; ///< The callback to use to get pool data
@@ -0,0 +1,162 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_command_queue.hpp
+///
+/// @brief A queue of VT commands waiting to be sent, which coalesces commands that change the
+/// same thing so that only the latest value is sent.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+
+#ifndef ISOBUS_VIRTUAL_TERMINAL_COMMAND_QUEUE_HPP
+#define ISOBUS_VIRTUAL_TERMINAL_COMMAND_QUEUE_HPP
+
+#include "isobus/isobus/can_constants.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isobus
+{
+	/// @brief A FIFO queue of VT commands that coalesces commands with the same key
+	/// @details Commands are stored in a ring of preallocated slots. Commands of up to CAN_DATA_LENGTH bytes
+	/// are stored inline in their slot, so queueing them does not touch the heap. Longer commands keep
+	/// their payload in a buffer owned by the slot, which is reused when the slot is overwritten.
+	///
+	/// A coalescable command is indexed by its key in an open addressing hash table. If a command with
+	/// the same key and group is still waiting, the new payload overwrites it in place, keeping its position in the queue,
+	/// so pushing is O(1) no matter how many commands are waiting. Commands that cannot be coalesced are
+	/// appended in FIFO order.
+	///
+	/// The ring doubles in size if it fills up, so no command is ever dropped.
+	/// This class is not thread safe, the owner must serialize access to it.
+	class VirtualTerminalCommandQueue
+	{
+	public:
+		/// @brief A command waiting in the queue
+		class Command
+		{
+		public:
+			/// @brief Returns the payload of the command, including the function code
+			/// @returns A pointer to the first byte of the payload
+			const std::uint8_t *data() const;
+
+			/// @brief Returns the number of bytes in the payload
+			/// @returns The number of bytes in the payload
+			std::uint32_t size() const;
+
+			/// @brief Returns if the payload is stored inline in the slot
+			/// @returns true if the command is CAN_DATA_LENGTH bytes or shorter
+			bool is_inline() const;
+
+			/// @brief Returns the buffer that holds the payload of a command longer than CAN_DATA_LENGTH
+			/// @details The buffer may be moved from, for example into a transport session, before the command is popped.
+			/// @returns The buffer that holds the payload of a long command
+			std::vector<std::uint8_t> &get_long_payload();
+
+			/// @brief Returns the group the command was queued in
+			/// @details Commands only replace waiting commands of the same group.
+			/// @returns The group the command was queued in
+			std::uint32_t get_group() const;
+
+		private:
+			friend class VirtualTerminalCommandQueue;
+
+			std::array<std::uint8_t, CAN_DATA_LENGTH> inlinePayload; ///< The payload of a short command
+			std::vector<std::uint8_t> longPayload; ///< The payload of a command longer than CAN_DATA_LENGTH
+			std::uint64_t key = 0; ///< The key the command is indexed by, if it is coalescable
+			std::uint32_t length = 0; ///< The number of bytes in the payload
+			std::uint32_t group = 0; ///< The group the command was queued in
+			bool coalescable = false; ///< Whether the command is indexed by its key
+		};
+
+		/// @brief The number of slots a queue starts with
+		static constexpr std::size_t DEFAULT_CAPACITY = 32;
+
+		/// @brief Constructs a queue and preallocates its slots
+		/// @param[in] capacity The number of slots to preallocate, rounded up to a power of two
+		explicit VirtualTerminalCommandQueue(std::size_t capacity = DEFAULT_CAPACITY);
+
+		/// @brief Queues a command by copying it into a slot
+		/// @param[in] data The command, including the function code
+		/// @param[in] length The number of bytes in the command
+		/// @param[in] key The key of the command, commands with the same key replace each other
+		/// @param[in] coalesce If true, the command replaces a waiting command with the same key and group, otherwise it is always appended
+		/// @param[in] group An identifier the owner can use to track a set of commands, for example a transaction
+		/// @returns true if the command replaced a waiting command, false if it was appended
+		bool push(const std::uint8_t *data, std::uint32_t length, std::uint64_t key, bool coalesce, std::uint32_t group = 0);
+
+		/// @brief Queues a command by moving it into a slot
+		/// @param[in] data The command, including the function code. Moved from if it is longer than CAN_DATA_LENGTH.
+		/// @param[in] key The key of the command, commands with the same key replace each other
+		/// @param[in] coalesce If true, the command replaces a waiting command with the same key and group, otherwise it is always appended
+		/// @param[in] group An identifier the owner can use to track a set of commands, for example a transaction
+		/// @returns true if the command replaced a waiting command, false if it was appended
+		bool push(std::vector<std::uint8_t> &&data, std::uint64_t key, bool coalesce, std::uint32_t group = 0);
+
+		/// @brief Returns the oldest command in the queue
+		/// @attention The queue must not be empty
+		/// @returns The oldest command in the queue, which stays valid until the next push, pop or clear
+		Command &front();
+
+		/// @brief Removes the oldest command from the queue
+		void pop();
+
+		/// @brief Removes all commands from the queue
+		void clear();
+
+		/// @brief Returns if there are no commands in the queue
+		/// @returns true if there are no commands in the queue
+		bool empty() const;
+
+		/// @brief Returns the number of commands in the queue
+		/// @returns The number of commands in the queue
+		std::size_t size() const;
+
+		/// @brief Returns the number of slots in the ring
+		/// @returns The number of commands the queue can hold before it has to grow
+		std::size_t get_capacity() const;
+
+	private:
+		/// @brief A value in the index that does not refer to a slot
+		static constexpr std::uint32_t EMPTY_INDEX_ENTRY = 0xFFFFFFFF;
+
+		/// @brief Finds the slot of a waiting coalescable command
+		/// @param[in] key The key of the command
+		/// @param[in] group The group of the command
+		/// @returns The slot of the command, or EMPTY_INDEX_ENTRY if none is waiting
+		std::uint32_t find(std::uint64_t key, std::uint32_t group) const;
+
+		/// @brief Reserves the slot at the back of the queue, growing the ring if it is full
+		/// @param[in] key The key of the command that will be stored in the slot
+		/// @param[in] coalesce Whether the command should be indexed by its key
+		/// @param[in] group The group the command is queued in
+		/// @returns The reserved slot
+		Command &append(std::uint64_t key, bool coalesce, std::uint32_t group);
+
+		/// @brief Adds a slot to the index
+		/// @param[in] slot The slot, which holds a coalescable command
+		void insert_index_entry(std::uint32_t slot);
+
+		/// @brief Removes a slot from the index, shifting back the entries after it so lookups stay correct
+		/// @param[in] slot The slot, which holds a coalescable command
+		void remove_index_entry(std::uint32_t slot);
+
+		/// @brief Returns the position in the index a key hashes to
+		/// @param[in] key The key to hash
+		/// @returns The position in the index
+		std::size_t get_home_position(std::uint64_t key) const;
+
+		/// @brief Doubles the number of slots, keeping the waiting commands in order
+		void grow();
+
+		std::vector<Command> slots; ///< The ring of commands, the size is always a power of two
+		std::vector<std::uint32_t> index; ///< Maps keys to slots using linear probing, twice the size of the ring
+		std::size_t head = 0; ///< The slot of the oldest command
+		std::size_t count = 0; ///< The number of commands in the queue
+	};
+} // namespace isobus
+
+#endif // ISOBUS_VIRTUAL_TERMINAL_COMMAND_QUEUE_HPP
@@ -4539,6 +4539,25 @@ namespace isobus
 		std::uint8_t pointerType = 0; ///< The pointer type, defines how this should be rendered
 	};
 
+	/// @brief Returns the minimum length that the specified object could possibly require in bytes
+	/// @param[in] type The VT object type to check
+	/// @returns The minimum number of bytes that the specified object might use, or 0 if the type is unknown
+	std::uint32_t get_minimum_object_length(VirtualTerminalObjectType type);
+
+	/// @brief Returns the total number of bytes in the serialized VT object at the specified memory location
+	/// @details Only the counts of the object's variable length parts are read, which is much faster than parsing the object.
+	/// @param[in] buffer A pointer to the start of the VT object
+	/// @param[in] bufferLength The number of bytes available at buffer, nothing past them is read
+	/// @returns The total number of bytes in the VT object, or 0 if the type is unknown or the object doesn't fit in the buffer
+	std::uint32_t get_number_bytes_in_object(const std::uint8_t *buffer, std::uint32_t bufferLength);
+
+	/// @brief Finds where each object in a serialized object pool starts, without parsing the objects
+	/// @param[in] pool The object pool
+	/// @param[in] size The size of the object pool in bytes
+	/// @param[out] offsets The offset of each object in the pool
+	/// @returns true if the pool consists of whole objects of known types
+	bool find_object_offsets(const std::uint8_t *pool, std::uint32_t size, std::vector<std::uint32_t> &offsets);
+
 	template<typename T>
 	/// @brief A specialized replacement for std::to_string
 	/// @param object_id An ID of an IsoBus object
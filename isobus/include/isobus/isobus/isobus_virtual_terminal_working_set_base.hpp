@@ -21,12 +21,38 @@ namespace isobus
 	class VirtualTerminalWorkingSetBase
 	{
 	public:
+		/// @brief The most threads used to parse an object pool when the number of threads is chosen automatically
+		static constexpr std::size_t DEFAULT_MAX_PARSING_THREADS = 4;
+
+		/// @brief The fewest objects each thread parses, smaller pools are parsed on fewer threads
+		static constexpr std::size_t MIN_OBJECTS_PER_PARSING_THREAD = 64;
+
 		/// @brief Takes a raw block of IOP data and parses it into VT objects
+		/// @details The data is pre-scanned to find where each object starts, then the objects are constructed
+		/// on several threads, and finally added to the object tree in the order they appear in the data.
+		/// If the pre-scan can't determine the length of an object, or an object can't be parsed on its own,
+		/// the data is parsed one object after another instead.
 		/// @param[in] iopData A pointer to the raw IOP data
 		/// @param[in] iopLength The length of the raw IOP data
 		/// @returns true if the IOP data was parsed successfully, otherwise false
 		bool parse_iop_into_objects(std::uint8_t *iopData, std::uint32_t iopLength);
 
+		/// @brief Sets the number of threads used to parse an object pool
+		/// @param[in] numberOfThreads The number of threads, 1 to parse on the calling thread only, or 0 to use up to
+		/// DEFAULT_MAX_PARSING_THREADS depending on the number of cores
+		void set_object_pool_parsing_threads(std::size_t numberOfThreads);
+
+		/// @brief Returns the number of threads used to parse an object pool
+		/// @details Always 1 if the stack is built without thread support.
+		/// @returns The number of threads used to parse an object pool
+		std::size_t get_object_pool_parsing_threads() const;
+
+		/// @brief Returns the number of threads the most recently parsed object pool was actually parsed on
+		/// @details Small pools, pools that can't be pre-scanned, and pools where starting a thread failed
+		/// are parsed on fewer threads than get_object_pool_parsing_threads returns.
+		/// @returns The number of threads the last object pool was parsed on, or 0 if no pool was parsed yet
+		std::size_t get_last_object_pool_parsing_threads() const;
+
 		/// @brief Returns a colour from this working set's current colour table, by index
 		/// @param[in] colourIndex The index into the VT's colour table to retrieve
 		/// @returns A colour from this working set's current colour table, by index
@@ -69,12 +95,39 @@ namespace isobus
 		/// @returns true if the object was added or replaced, otherwise false
 		bool add_or_replace_object(std::shared_ptr<VTObject> objectToAdd);
 
-		/// @brief Parses one object in the remaining object pool data
+		/// @brief Parses one object in the remaining object pool data and adds it to the object tree
 		/// @param[in,out] iopData A pointer to some object pool data
 		/// @param[in,out] iopLength The number of bytes remaining in the object pool
 		/// @returns true if an object was parsed
 		bool parse_next_object(std::uint8_t *&iopData, std::uint32_t &iopLength);
 
+		/// @brief Constructs one object from the remaining object pool data, without touching the object tree
+		/// @details This does not modify the working set, so several objects can be parsed at the same time.
+		/// @param[in,out] iopData A pointer to some object pool data
+		/// @param[in,out] iopLength The number of bytes remaining in the object pool
+		/// @param[out] parsedObject The object that was parsed
+		/// @returns true if an object was parsed
+		bool parse_object(std::uint8_t *&iopData, std::uint32_t &iopLength, std::shared_ptr<VTObject> &parsedObject) const;
+
+		/// @brief Adds a parsed object to the object tree, checking that there is only one working set object
+		/// @param[in] parsedObject The object to add
+		/// @returns true if the object was added
+		bool add_parsed_object(std::shared_ptr<VTObject> parsedObject);
+
+		/// @brief Constructs the objects of a pre-scanned object pool on several threads, then adds them to the object tree
+		/// @param[in] iopData A pointer to the raw IOP data
+		/// @param[in] iopLength The length of the raw IOP data
+		/// @param[in] objectOffsets The offset of each object in the IOP data
+		/// @param[in] numberOfThreads The number of threads to use, including the calling thread
+		/// @param[out] success Whether the objects were added to the object tree, if this function returns true
+		/// @returns true if the pool was handled, false if an object could not be parsed on its own and
+		/// nothing was added, so the pool must be parsed in order instead
+		bool parse_objects_in_parallel(std::uint8_t *iopData,
+		                               std::uint32_t iopLength,
+		                               const std::vector<std::uint32_t> &objectOffsets,
+		                               std::size_t numberOfThreads,
+		                               bool &success);
+
 		/// @brief Checks if the object pool contains an object with the supplied object ID
 		/// @param[in] objectID The object ID to check for in the object pool
 		/// @returns true if an object with the specified ID exists in the object pool
@@ -109,6 +162,8 @@ namespace isobus
 		std::vector<std::vector<std::uint8_t>> iopFilesRawData; ///< Raw IOP File data from the client
 		std::uint16_t workingSetID = NULL_OBJECT_ID; ///< Stores the object ID of the working set object itself
 		std::uint16_t faultingObjectID = NULL_OBJECT_ID; ///< Stores the faulting object ID to send to a client when parsing the pool fails
+		std::size_t objectPoolParsingThreads = 0; ///< The number of threads used to parse an object pool, or 0 to choose automatically
+		std::size_t lastObjectPoolParsingThreads = 0; ///< The number of threads the last object pool was actually parsed on
 	};
 } // namespace isobus
 #endif // ISOBUS_VIRTUAL_TERMINAL_WORKING_SET_BASE_HPP
@@ -27,7 +27,9 @@
 #ifndef NMEA2000_FAST_PACKET_PROTOCOL_HPP
 #define NMEA2000_FAST_PACKET_PROTOCOL_HPP
 
+#include "isobus/isobus/can_message_buffer_pool.hpp"
 #include "isobus/isobus/can_transport_protocol_base.hpp"
+#include "isobus/isobus/can_transport_protocol_session_table.hpp"
 #include "isobus/utility/event_dispatcher.hpp"
 #include "isobus/utility/thread_synchronization.hpp"
 
@@ -164,6 +166,11 @@ namespace isobus
 		/// @brief Updates all sessions managed by this protocol manager instance.
 		void update();
 
+		/// @brief Returns the pool that reassembly buffers for received messages are borrowed from
+		/// @details Useful for checking how often receive buffers are reused rather than allocated.
+		/// @returns The pool of receive buffers
+		const CANMessageBufferPool &get_receive_buffer_pool() const;
+
 		/// @brief A generic way for a protocol to process a received message
 		/// @param[in] message A received CAN message
 		void process_message(const CANMessage &message);
@@ -194,7 +201,7 @@ namespace isobus
 		/// @param[in] source The source control function for the session
 		/// @param[in] destination The destination control function for the session
 		/// @returns a matching session, or nullptr if no session matched the supplied parameters
-		std::shared_ptr<FastPacketProtocolSession> get_session(std::uint32_t parameterGroupNumber, std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination);
+		std::shared_ptr<FastPacketProtocolSession> get_session(std::uint32_t parameterGroupNumber, const std::shared_ptr<ControlFunction> &source, const std::shared_ptr<ControlFunction> &destination);
 
 		/// @brief Checks if a session by the passed in source and destination and PGN combination exists
 		/// @param[in] parameterGroupNumber The PGN of the session
@@ -215,8 +222,10 @@ namespace isobus
 		static constexpr std::uint8_t SEQUENCE_NUMBER_BIT_MASK = 0x07; ///< Bit mask for masking out the sequence number bits
 		static constexpr std::uint8_t SEQUENCE_NUMBER_BIT_OFFSET = 5; ///< The bit offset into the first byte of data to get the seq number
 		static constexpr std::uint8_t PROTOCOL_BYTES_PER_FRAME = 7; ///< The number of payload bytes per frame for all but the first message, which has 6
+		static constexpr std::size_t EXPECTED_NUMBER_OF_SESSIONS = 16; ///< The number of sessions to preallocate storage for, more are allowed but will allocate
 
-		std::vector<std::shared_ptr<FastPacketProtocolSession>> activeSessions; ///< A list of all active TP sessions
+		TransportProtocolSessionTable<FastPacketProtocolSession> activeSessions; ///< All active FP sessions, indexed by source, destination and PGN
+		CANMessageBufferPool receiveBufferPool; ///< Reassembly buffers for received messages, each large enough for any FP message
 		Mutex sessionMutex; ///< A mutex to lock the sessions list in case someone starts a Tx while the stack is processing sessions
 		std::vector<FastPacketHistory> sessionHistory; ///< Used to keep track of sequence numbers for future sessions
 		std::vector<ParameterGroupNumberCallbackData> parameterGroupNumberCallbacks; ///< A list of all parameter group number callbacks that will be parsed as fast packet messages
@@ -29,71 +29,100 @@ namespace isobus
 
 	bool NAMEFilter::check_name_matches_filter(const NAME &nameToCompare) const
 	{
-		bool retVal = false;
+		std::uint64_t mask;
+		std::uint64_t maskedValue;
+
+		return get_NAME_mask_and_value(mask, maskedValue) && ((nameToCompare.get_full_name() & mask) == maskedValue);
+	}
+
+	bool NAMEFilter::get_NAME_mask_and_value(std::uint64_t &mask, std::uint64_t &maskedValue) const
+	{
+		std::uint32_t componentMask = 0;
+		std::uint8_t componentPosition = 0;
+		std::uint32_t componentValue = value;
+		bool retVal = true;
 
 		switch (parameter)
 		{
 			case NAME::NAMEParameters::IdentityNumber:
 			{
-				retVal = (nameToCompare.get_identity_number() == value);
+				componentMask = 0x1FFFFF;
+				componentPosition = 0;
 			}
 			break;
 
 			case NAME::NAMEParameters::ManufacturerCode:
 			{
-				retVal = (nameToCompare.get_manufacturer_code() == value);
+				componentMask = 0x07FF;
+				componentPosition = 21;
 			}
 			break;
 
 			case NAME::NAMEParameters::EcuInstance:
 			{
-				retVal = (nameToCompare.get_ecu_instance() == value);
+				componentMask = 0x07;
+				componentPosition = 32;
 			}
 			break;
 
 			case NAME::NAMEParameters::FunctionInstance:
 			{
-				retVal = (nameToCompare.get_function_instance() == value);
+				componentMask = 0x1F;
+				componentPosition = 35;
 			}
 			break;
 
 			case NAME::NAMEParameters::FunctionCode:
 			{
-				retVal = (nameToCompare.get_function_code() == value);
+				componentMask = 0xFF;
+				componentPosition = 40;
 			}
 			break;
 
 			case NAME::NAMEParameters::DeviceClass:
 			{
-				retVal = (nameToCompare.get_device_class() == value);
+				componentMask = 0x7F;
+				componentPosition = 49;
 			}
 			break;
 
 			case NAME::NAMEParameters::DeviceClassInstance:
 			{
-				retVal = (nameToCompare.get_device_class_instance() == value);
+				componentMask = 0x0F;
+				componentPosition = 56;
 			}
 			break;
 
 			case NAME::NAMEParameters::IndustryGroup:
 			{
-				retVal = (nameToCompare.get_industry_group() == value);
+				componentMask = 0x07;
+				componentPosition = 60;
 			}
 			break;
 
 			case NAME::NAMEParameters::ArbitraryAddressCapable:
 			{
-				retVal = (nameToCompare.get_arbitrary_address_capable() == (0 != value));
+				componentMask = 0x01;
+				componentPosition = 63;
+				componentValue = (0 != value) ? 1 : 0;
 			}
 			break;
 
 			default:
 			{
 				// Shouldn't be possible, filter will not match.
+				retVal = false;
 			}
 			break;
 		}
+
+		if (componentValue > componentMask)
+		{
+			// The NAME component can never hold this value
+			retVal = false;
+		}
+		mask = static_cast<std::uint64_t>(componentMask) << componentPosition;
+		maskedValue = static_cast<std::uint64_t>(componentValue & componentMask) << componentPosition;
 		return retVal;
 	}
-
 } // namespace isobus
@@ -0,0 +1,91 @@
+//================================================================================================
+/// @file can_async_stack_logger.cpp
+///
+/// @brief A log sink that hands log text to a background thread, so that writing the log
+/// does not slow down the thread that logged it.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_async_stack_logger.hpp"
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+
+#include <chrono>
+#include <cstring>
+
+namespace isobus
+{
+	constexpr std::size_t AsyncCANStackLogger::DEFAULT_QUEUE_SIZE;
+	constexpr std::size_t AsyncCANStackLogger::MAX_RECORD_LENGTH;
+
+	AsyncCANStackLogger::AsyncCANStackLogger(CANStackLogger &targetSink, std::size_t queueSize, std::uint32_t writerPeriod_ms) :
+	  targetSink(targetSink),
+	  records(queueSize),
+	  writerPeriod_ms(writerPeriod_ms),
+	  writerThread([this]() { writer_thread_function(); })
+	{
+	}
+
+	AsyncCANStackLogger::~AsyncCANStackLogger()
+	{
+		{
+			std::lock_guard<std::mutex> lock(writerMutex);
+			stopWriter = true;
+		}
+		writerWakeUp.notify_one();
+		writerThread.join();
+		write_records();
+	}
+
+	void AsyncCANStackLogger::sink_CAN_stack_log(LoggingLevel level, const std::string &logText)
+	{
+		sink_CAN_stack_log_text(level, logText.c_str(), logText.size());
+	}
+
+	void AsyncCANStackLogger::sink_CAN_stack_log_text(LoggingLevel level, const char *logText, std::size_t length)
+	{
+		if (records.is_full())
+		{
+			droppedRecords++;
+			return;
+		}
+
+		LogRecord record;
+		record.level = level;
+		record.length = static_cast<std::uint16_t>((length < MAX_RECORD_LENGTH) ? length : MAX_RECORD_LENGTH);
+		std::memcpy(record.text, logText, record.length);
+		record.text[record.length] = '\0';
+
+		if (!records.push(record))
+		{
+			droppedRecords++;
+		}
+	}
+
+	std::size_t AsyncCANStackLogger::get_number_of_dropped_records() const
+	{
+		return droppedRecords;
+	}
+
+	void AsyncCANStackLogger::writer_thread_function()
+	{
+		std::unique_lock<std::mutex> lock(writerMutex);
+		while (!stopWriter)
+		{
+			writerWakeUp.wait_for(lock, std::chrono::milliseconds(writerPeriod_ms), [this]() { return stopWriter.load(); });
+			write_records();
+		}
+	}
+
+	void AsyncCANStackLogger::write_records()
+	{
+		LogRecord record;
+		while (records.try_pop(record))
+		{
+			targetSink.sink_CAN_stack_log_text(record.level, record.text, record.length);
+		}
+	}
+} // namespace isobus
+
+#endif
@@ -0,0 +1,231 @@
+//================================================================================================
+/// @file can_bus_statistics.cpp
+///
+/// @brief Keeps a breakdown of the traffic on a CAN channel by source address and by PGN,
+/// which can be used to find out what is causing a high busload.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_bus_statistics.hpp"
+#include "isobus/isobus/can_identifier.hpp"
+
+#include <algorithm>
+
+namespace isobus
+{
+	constexpr std::size_t CANBusStatistics::NUMBER_OF_SUB_WINDOWS;
+	constexpr std::size_t CANBusStatistics::MAX_NUMBER_OF_PARAMETER_GROUP_NUMBERS;
+	constexpr std::uint32_t CANBusStatistics::UNTRACKED_PARAMETER_GROUP_NUMBER;
+	constexpr std::uint8_t CANBusStatistics::EMPTY_INDEX_SLOT;
+
+	CANBusStatistics::CANBusStatistics()
+	{
+		clear();
+	}
+
+	void CANBusStatistics::process_frame(const CANMessageFrame &frame, std::uint32_t numberOfBits)
+	{
+		if (frame.isExtendedFrame)
+		{
+			CANIdentifier identifier(frame.identifier);
+			add_frame(sourceAddressHistories[identifier.get_source_address()], numberOfBits);
+			add_frame(find_or_add_parameter_group_number(identifier.get_parameter_group_number()), numberOfBits);
+		}
+		else
+		{
+			// Standard frames have no source address or PGN
+			add_frame(untrackedParameterGroupNumberHistory, numberOfBits);
+		}
+	}
+
+	void CANBusStatistics::advance_window()
+	{
+		currentSubWindow = (currentSubWindow + 1) % NUMBER_OF_SUB_WINDOWS;
+
+		auto drop_oldest_sub_window = [this](History &history) {
+			history.total.numberOfFrames -= history.subWindows[currentSubWindow].numberOfFrames;
+			history.total.numberOfBits -= history.subWindows[currentSubWindow].numberOfBits;
+			history.subWindows[currentSubWindow] = Counters();
+		};
+
+		for (auto &history : sourceAddressHistories)
+		{
+			drop_oldest_sub_window(history);
+		}
+		for (std::size_t i = 0; i < numberOfParameterGroupNumbers; i++)
+		{
+			drop_oldest_sub_window(parameterGroupNumberHistories[i].history);
+		}
+		drop_oldest_sub_window(untrackedParameterGroupNumberHistory);
+		remove_idle_parameter_group_numbers();
+	}
+
+	CANBusStatistics::TalkerStatistics CANBusStatistics::get_source_address_statistics(std::uint8_t sourceAddress) const
+	{
+		return to_talker_statistics(sourceAddress, sourceAddressHistories[sourceAddress]);
+	}
+
+	CANBusStatistics::TalkerStatistics CANBusStatistics::get_parameter_group_number_statistics(std::uint32_t parameterGroupNumber) const
+	{
+		TalkerStatistics retVal = to_talker_statistics(parameterGroupNumber, History());
+
+		if (UNTRACKED_PARAMETER_GROUP_NUMBER == parameterGroupNumber)
+		{
+			retVal = to_talker_statistics(parameterGroupNumber, untrackedParameterGroupNumberHistory);
+		}
+		else
+		{
+			std::uint8_t position = parameterGroupNumberIndex[find_index_slot(parameterGroupNumber)];
+
+			if (EMPTY_INDEX_SLOT != position)
+			{
+				retVal = to_talker_statistics(parameterGroupNumber, parameterGroupNumberHistories[position].history);
+			}
+		}
+		return retVal;
+	}
+
+	std::vector<CANBusStatistics::TalkerStatistics> CANBusStatistics::get_top_source_addresses(std::size_t count) const
+	{
+		std::vector<TalkerStatistics> retVal;
+
+		for (std::size_t i = 0; i < sourceAddressHistories.size(); i++)
+		{
+			if (0 != sourceAddressHistories[i].total.numberOfFrames)
+			{
+				retVal.push_back(to_talker_statistics(static_cast<std::uint32_t>(i), sourceAddressHistories[i]));
+			}
+		}
+		keep_top(retVal, count);
+		return retVal;
+	}
+
+	std::vector<CANBusStatistics::TalkerStatistics> CANBusStatistics::get_top_parameter_group_numbers(std::size_t count) const
+	{
+		std::vector<TalkerStatistics> retVal;
+
+		for (std::size_t i = 0; i < numberOfParameterGroupNumbers; i++)
+		{
+			if (0 != parameterGroupNumberHistories[i].history.total.numberOfFrames)
+			{
+				retVal.push_back(to_talker_statistics(parameterGroupNumberHistories[i].parameterGroupNumber, parameterGroupNumberHistories[i].history));
+			}
+		}
+		if (0 != untrackedParameterGroupNumberHistory.total.numberOfFrames)
+		{
+			retVal.push_back(to_talker_statistics(UNTRACKED_PARAMETER_GROUP_NUMBER, untrackedParameterGroupNumberHistory));
+		}
+		keep_top(retVal, count);
+		return retVal;
+	}
+
+	void CANBusStatistics::clear()
+	{
+		sourceAddressHistories.fill(History());
+		parameterGroupNumberHistories.fill(ParameterGroupNumberHistory());
+		parameterGroupNumberIndex.fill(EMPTY_INDEX_SLOT);
+		untrackedParameterGroupNumberHistory = History();
+		numberOfParameterGroupNumbers = 0;
+		currentSubWindow = 0;
+	}
+
+	void CANBusStatistics::add_frame(History &history, std::uint32_t numberOfBits)
+	{
+		history.subWindows[currentSubWindow].numberOfFrames++;
+		history.subWindows[currentSubWindow].numberOfBits += numberOfBits;
+		history.total.numberOfFrames++;
+		history.total.numberOfBits += numberOfBits;
+	}
+
+	CANBusStatistics::History &CANBusStatistics::find_or_add_parameter_group_number(std::uint32_t parameterGroupNumber)
+	{
+		std::size_t slot = find_index_slot(parameterGroupNumber);
+
+		if (EMPTY_INDEX_SLOT != parameterGroupNumberIndex[slot])
+		{
+			return parameterGroupNumberHistories[parameterGroupNumberIndex[slot]].history;
+		}
+		else if ((UNTRACKED_PARAMETER_GROUP_NUMBER != parameterGroupNumber) &&
+		         (numberOfParameterGroupNumbers < MAX_NUMBER_OF_PARAMETER_GROUP_NUMBERS))
+		{
+			parameterGroupNumberIndex[slot] = static_cast<std::uint8_t>(numberOfParameterGroupNumbers);
+			parameterGroupNumberHistories[numberOfParameterGroupNumbers].parameterGroupNumber = parameterGroupNumber;
+			numberOfParameterGroupNumbers++;
+			return parameterGroupNumberHistories[parameterGroupNumberIndex[slot]].history;
+		}
+		return untrackedParameterGroupNumberHistory;
+	}
+
+	std::size_t CANBusStatistics::find_index_slot(std::uint32_t parameterGroupNumber) const
+	{
+		// The index is never more than half full, so there is always an empty slot to stop at
+		std::size_t retVal = (parameterGroupNumber * 0x9E3779B1u) >> 24;
+		retVal &= (PARAMETER_GROUP_NUMBER_INDEX_SIZE - 1);
+
+		while ((EMPTY_INDEX_SLOT != parameterGroupNumberIndex[retVal]) &&
+		       (parameterGroupNumberHistories[parameterGroupNumberIndex[retVal]].parameterGroupNumber != parameterGroupNumber))
+		{
+			retVal = (retVal + 1) & (PARAMETER_GROUP_NUMBER_INDEX_SIZE - 1);
+		}
+		return retVal;
+	}
+
+	void CANBusStatistics::remove_idle_parameter_group_numbers()
+	{
+		std::size_t numberOfActiveParameterGroupNumbers = 0;
+
+		for (std::size_t i = 0; i < numberOfParameterGroupNumbers; i++)
+		{
+			if (0 != parameterGroupNumberHistories[i].history.total.numberOfFrames)
+			{
+				if (numberOfActiveParameterGroupNumbers != i)
+				{
+					parameterGroupNumberHistories[numberOfActiveParameterGroupNumbers] = parameterGroupNumberHistories[i];
+				}
+				numberOfActiveParameterGroupNumbers++;
+			}
+		}
+
+		if (numberOfActiveParameterGroupNumbers != numberOfParameterGroupNumbers)
+		{
+			for (std::size_t i = numberOfActiveParameterGroupNumbers; i < numberOfParameterGroupNumbers; i++)
+			{
+				parameterGroupNumberHistories[i] = ParameterGroupNumberHistory();
+			}
+			numberOfParameterGroupNumbers = numberOfActiveParameterGroupNumbers;
+
+			parameterGroupNumberIndex.fill(EMPTY_INDEX_SLOT);
+			for (std::size_t i = 0; i < numberOfParameterGroupNumbers; i++)
+			{
+				parameterGroupNumberIndex[find_index_slot(parameterGroupNumberHistories[i].parameterGroupNumber)] = static_cast<std::uint8_t>(i);
+			}
+		}
+	}
+
+	CANBusStatistics::TalkerStatistics CANBusStatistics::to_talker_statistics(std::uint32_t key, const History &history)
+	{
+		TalkerStatistics retVal;
+		retVal.key = key;
+		retVal.numberOfFrames = history.total.numberOfFrames;
+		retVal.numberOfBits = history.total.numberOfBits;
+		return retVal;
+	}
+
+	void CANBusStatistics::keep_top(std::vector<TalkerStatistics> &statistics, std::size_t count)
+	{
+		if (count < statistics.size())
+		{
+			std::partial_sort(statistics.begin(), statistics.begin() + count, statistics.end(), [](const TalkerStatistics &first, const TalkerStatistics &second) {
+				return first.numberOfBits > second.numberOfBits;
+			});
+			statistics.resize(count);
+		}
+		else
+		{
+			std::sort(statistics.begin(), statistics.end(), [](const TalkerStatistics &first, const TalkerStatistics &second) {
+				return first.numberOfBits > second.numberOfBits;
+			});
+		}
+	}
+} // namespace isobus
@@ -8,6 +8,8 @@
 //================================================================================================
 #include "isobus/isobus/can_callbacks.hpp"
 
+#include <algorithm>
+
 namespace isobus
 {
 	ParameterGroupNumberCallbackData::ParameterGroupNumberCallbackData(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer, std::shared_ptr<InternalControlFunction> internalControlFunction) :
@@ -45,4 +47,88 @@ namespace isobus
 	{
 		return internalControlFunctionFilter;
 	}
+
+	bool ParameterGroupNumberCallbackTable::add_callback(const ParameterGroupNumberCallbackData &callbackData, bool allowDuplicates)
+	{
+		bool retVal = false;
+		LOCK_GUARD(Mutex, tableMutex);
+
+		if (allowDuplicates ||
+		    (callbacksInOrder.end() == std::find(callbacksInOrder.begin(), callbacksInOrder.end(), callbackData)))
+		{
+			CallbackList &bucket = callbacksByParameterGroupNumber[callbackData.get_parameter_group_number()];
+			auto newBucket = (nullptr != bucket) ? std::make_shared<std::vector<ParameterGroupNumberCallbackData>>(*bucket) : std::make_shared<std::vector<ParameterGroupNumberCallbackData>>();
+			newBucket->push_back(callbackData);
+			bucket = newBucket;
+			callbacksInOrder.push_back(callbackData);
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	bool ParameterGroupNumberCallbackTable::remove_callback(const ParameterGroupNumberCallbackData &callbackData)
+	{
+		bool retVal = false;
+		LOCK_GUARD(Mutex, tableMutex);
+
+		auto orderedLocation = std::find(callbacksInOrder.begin(), callbacksInOrder.end(), callbackData);
+		if (callbacksInOrder.end() != orderedLocation)
+		{
+			callbacksInOrder.erase(orderedLocation);
+
+			auto bucketLocation = callbacksByParameterGroupNumber.find(callbackData.get_parameter_group_number());
+			if ((callbacksByParameterGroupNumber.end() != bucketLocation) &&
+			    (nullptr != bucketLocation->second))
+			{
+				auto newBucket = std::make_shared<std::vector<ParameterGroupNumberCallbackData>>(*bucketLocation->second);
+				auto callbackLocation = std::find(newBucket->begin(), newBucket->end(), callbackData);
+				if (newBucket->end() != callbackLocation)
+				{
+					newBucket->erase(callbackLocation);
+				}
+
+				if (newBucket->empty())
+				{
+					callbacksByParameterGroupNumber.erase(bucketLocation);
+				}
+				else
+				{
+					bucketLocation->second = newBucket;
+				}
+			}
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	ParameterGroupNumberCallbackTable::CallbackList ParameterGroupNumberCallbackTable::get_callbacks(std::uint32_t parameterGroupNumber) const
+	{
+		CallbackList retVal = nullptr;
+		LOCK_GUARD(Mutex, tableMutex);
+
+		auto bucketLocation = callbacksByParameterGroupNumber.find(parameterGroupNumber);
+		if (callbacksByParameterGroupNumber.end() != bucketLocation)
+		{
+			retVal = bucketLocation->second;
+		}
+		return retVal;
+	}
+
+	ParameterGroupNumberCallbackData ParameterGroupNumberCallbackTable::get_callback(std::size_t index) const
+	{
+		ParameterGroupNumberCallbackData retVal(0, nullptr, nullptr, nullptr);
+		LOCK_GUARD(Mutex, tableMutex);
+
+		if (index < callbacksInOrder.size())
+		{
+			retVal = callbacksInOrder[index];
+		}
+		return retVal;
+	}
+
+	std::size_t ParameterGroupNumberCallbackTable::size() const
+	{
+		LOCK_GUARD(Mutex, tableMutex);
+		return callbacksInOrder.size();
+	}
 } // namespace isobus
@@ -122,10 +122,13 @@ namespace isobus
 	ExtendedTransportProtocolManager::ExtendedTransportProtocolManager(const CANMessageFrameCallback &sendCANFrameCallback,
 	                                                                   const CANMessageCallback &canMessageReceivedCallback,
 	                                                                   const CANNetworkConfiguration *configuration) :
+	  activeSessions(configuration->get_max_number_transport_protocol_sessions()),
+	  receiveBufferPool(RECEIVE_BUFFER_CHUNK_SIZE, configuration->get_max_number_transport_protocol_sessions(), MAX_POOLED_RECEIVE_BUFFER_SIZE),
 	  sendCANFrameCallback(sendCANFrameCallback),
 	  canMessageReceivedCallback(canMessageReceivedCallback),
 	  configuration(configuration)
 	{
+		dataTransferSchedule.reserve(configuration->get_max_number_transport_protocol_sessions());
 	}
 
 	void ExtendedTransportProtocolManager::process_request_to_send(const std::shared_ptr<ControlFunction> source,
@@ -159,22 +162,29 @@ namespace isobus
 				}
 			}
 
-			auto newSession = std::make_shared<ExtendedTransportProtocolSession>(ExtendedTransportProtocolSession::Direction::Receive,
-			                                                                     std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
-			                                                                     parameterGroupNumber,
-			                                                                     totalMessageSize,
-			                                                                     source,
-			                                                                     destination,
-			                                                                     nullptr, // No callback
-			                                                                     nullptr);
+			auto newSession = activeSessions.create(ExtendedTransportProtocolSession::Direction::Receive,
+			                                        std::unique_ptr<CANMessageData>(new CANMessageDataVector(receiveBufferPool.acquire(totalMessageSize))),
+			                                        parameterGroupNumber,
+			                                        totalMessageSize,
+			                                        source,
+			                                        destination,
+			                                        nullptr, // No callback
+			                                        nullptr);
 
 			// Request the maximum number of packets per DPO via the CTS message
 			newSession->set_cts_number_of_packet_limit(configuration->get_number_of_packets_per_dpo_message());
 
 			newSession->set_state(StateMachineState::SendClearToSend);
-			activeSessions.push_back(newSession);
-			LOG_DEBUG("[ETP]: New rx session for 0x%05X. Source: %hu, destination: %hu", parameterGroupNumber, source->get_address(), destination->get_address());
-			update_state_machine(newSession);
+			if (activeSessions.insert(newSession))
+			{
+				LOG_DEBUG("[ETP]: New rx session for 0x%05X. Source: %hu, destination: %hu", parameterGroupNumber, source->get_address(), destination->get_address());
+				update_state_machine(newSession);
+			}
+			else
+			{
+				LOG_ERROR("[ETP]: Received Request To Send (RTS) for 0x%05X while a session for this source and destination still exists, aborting...", parameterGroupNumber);
+				abort_session(newSession, ConnectionAbortReason::AlreadyInCMSession);
+			}
 		}
 	}
 
@@ -413,8 +423,8 @@ namespace isobus
 			return;
 		}
 
-		auto source = message.get_source_control_function();
-		auto destination = message.get_destination_control_function();
+		const auto &source = message.get_source_control_function();
+		const auto &destination = message.get_destination_control_function();
 
 		auto sequenceNumber = message.get_uint8_at(SEQUENCE_NUMBER_DATA_INDEX);
 
@@ -463,14 +473,18 @@ namespace isobus
 					                         CANIdentifier::CANPriority::PriorityDefault6,
 					                         destination->get_address(),
 					                         source->get_address());
-					CANMessage completedMessage(CANMessage::Type::Receive,
-					                            identifier,
-					                            std::move(data),
-					                            source,
-					                            destination,
-					                            0);
+					// A payload that fits inline is copied straight out of the session buffer, which stays in the session
+					// and goes back to the pool when it's closed. A larger message takes over the buffer instead.
+					const bool storedInline = (data.size() <= CAN_MESSAGE_INLINE_DATA_LENGTH);
+					CANMessage completedMessage = storedInline ?
+					  CANMessage(CANMessage::Type::Receive, identifier, data.data().begin(), static_cast<std::uint32_t>(data.size()), source, destination, 0) :
+					  CANMessage(CANMessage::Type::Receive, identifier, std::move(data), source, destination, 0);
 
 					canMessageReceivedCallback(completedMessage);
+					if (!storedInline)
+					{
+						receiveBufferPool.release(completedMessage.release_data());
+					}
 					close_session(session, true);
 					LOG_DEBUG("[ETP]: Completed rx session for 0x%05X from %hu", session->get_parameter_group_number(), source->get_address());
 				}
@@ -539,31 +553,37 @@ namespace isobus
 		data = data->copy_if_not_owned(std::move(data));
 		auto dataLength = static_cast<std::uint32_t>(data->size());
 
-		auto session = std::make_shared<ExtendedTransportProtocolSession>(ExtendedTransportProtocolSession::Direction::Transmit,
-		                                                                  std::move(data),
-		                                                                  parameterGroupNumber,
-		                                                                  dataLength,
-		                                                                  source,
-		                                                                  destination,
-		                                                                  sessionCompleteCallback,
-		                                                                  parentPointer);
+		auto session = activeSessions.create(ExtendedTransportProtocolSession::Direction::Transmit,
+		                                     std::move(data),
+		                                     parameterGroupNumber,
+		                                     dataLength,
+		                                     source,
+		                                     destination,
+		                                     sessionCompleteCallback,
+		                                     parentPointer);
 		session->set_state(StateMachineState::SendRequestToSend);
 		LOG_DEBUG("[ETP]: New tx session for 0x%05X. Source: %hu, destination: %hu",
 		          parameterGroupNumber,
 		          source->get_address(),
 		          destination->get_address());
 
-		activeSessions.push_back(session);
+		if (!activeSessions.insert(session))
+		{
+			LOG_ERROR("[ETP]: Unable to send 0x%05X, a session for this source and destination already exists.", parameterGroupNumber);
+			return false;
+		}
 		update_state_machine(session);
 		return true;
 	}
 
 	void ExtendedTransportProtocolManager::update()
 	{
+		dataTransferSchedule.clear();
+
 		// We use a fancy for loop here to allow us to remove sessions from the list while iterating
 		for (std::size_t i = activeSessions.size(); i > 0; i--)
 		{
-			auto session = activeSessions.at(i - 1);
+			auto session = activeSessions.get_sessions().at(i - 1);
 			if (!session->get_source()->get_address_valid())
 			{
 				LOG_WARNING("[ETP]: Closing active session as the source control function is no longer valid");
@@ -577,53 +597,47 @@ namespace isobus
 			else if (StateMachineState::None != session->state)
 			{
 				update_state_machine(session);
+
+				if (is_ready_to_send_data_transfer_packet(session))
+				{
+					dataTransferSchedule.push_back(session);
+				}
 			}
 		}
+		send_scheduled_data_transfer_packets();
 	}
 
-	void ExtendedTransportProtocolManager::send_data_transfer_packets(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const
+	bool ExtendedTransportProtocolManager::send_data_transfer_packet(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const
 	{
 		std::array<std::uint8_t, CAN_DATA_LENGTH> buffer;
-		std::uint8_t framesToSend = session->get_dpo_number_of_packets_remaining();
-		if (framesToSend > configuration->get_max_number_of_network_manager_protocol_frames_per_update())
-		{
-			framesToSend = configuration->get_max_number_of_network_manager_protocol_frames_per_update();
-		}
+		bool retVal = false;
 
-		// Try and send packets
-		for (std::uint8_t i = 0; i < framesToSend; i++)
-		{
-			buffer[0] = session->get_last_sequence_number() + 1;
+		buffer[0] = session->get_last_sequence_number() + 1;
 
-			std::uint32_t dataOffset = session->get_last_packet_number() * PROTOCOL_BYTES_PER_FRAME;
-			for (std::uint8_t j = 0; j < PROTOCOL_BYTES_PER_FRAME; j++)
-			{
-				std::uint32_t index = dataOffset + j;
-				if (index < session->get_message_length())
-				{
-					buffer[1 + j] = session->get_data().get_byte(index);
-				}
-				else
-				{
-					buffer[1 + j] = 0xFF;
-				}
-			}
-
-			if (sendCANFrameCallback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::ExtendedTransportProtocolDataTransfer),
-			                         CANDataSpan(buffer.data(), buffer.size()),
-			                         std::static_pointer_cast<InternalControlFunction>(session->get_source()),
-			                         session->get_destination(),
-			                         CANIdentifier::CANPriority::PriorityLowest7))
+		std::uint32_t dataOffset = session->get_last_packet_number() * PROTOCOL_BYTES_PER_FRAME;
+		for (std::uint8_t j = 0; j < PROTOCOL_BYTES_PER_FRAME; j++)
+		{
+			std::uint32_t index = dataOffset + j;
+			if (index < session->get_message_length())
 			{
-				session->set_last_sequency_number(session->get_last_sequence_number() + 1);
+				buffer[1 + j] = session->get_data().get_byte(index);
 			}
 			else
 			{
-				// Process more next time protocol is updated
-				break;
+				buffer[1 + j] = 0xFF;
 			}
 		}
 
+		if (sendCANFrameCallback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::ExtendedTransportProtocolDataTransfer),
+		                         CANDataSpan(buffer.data(), buffer.size()),
+		                         std::static_pointer_cast<InternalControlFunction>(session->get_source()),
+		                         session->get_destination(),
+		                         CANIdentifier::CANPriority::PriorityLowest7))
+		{
+			session->set_last_sequency_number(session->get_last_sequence_number() + 1);
+			retVal = true;
+		}
+
 		if (session->get_number_of_remaining_packets() == 0)
 		{
 			session->set_state(StateMachineState::WaitForEndOfMessageAcknowledge);
@@ -632,6 +646,52 @@ namespace isobus
 		{
 			session->set_state(StateMachineState::WaitForClearToSend);
 		}
+		return retVal;
+	}
+
+	bool ExtendedTransportProtocolManager::is_ready_to_send_data_transfer_packet(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const
+	{
+		return (StateMachineState::SendDataTransferPackets == session->state) &&
+		  (session->get_time_since_last_update() >= configuration->get_minimum_time_between_transport_protocol_data_frames());
+	}
+
+	void ExtendedTransportProtocolManager::send_scheduled_data_transfer_packets()
+	{
+		std::uint8_t framesRemaining = configuration->get_max_number_of_network_manager_protocol_frames_per_update();
+
+		if (!dataTransferSchedule.empty())
+		{
+			dataTransferRoundRobinOffset = (dataTransferRoundRobinOffset + 1) % dataTransferSchedule.size();
+			std::rotate(dataTransferSchedule.begin(), dataTransferSchedule.begin() + dataTransferRoundRobinOffset, dataTransferSchedule.end());
+		}
+
+		while ((framesRemaining > 0) && (!dataTransferSchedule.empty()))
+		{
+			// Each session sends one packet per round, and stays in the schedule only if it can send another one right away
+			std::size_t numberOfScheduledSessions = 0;
+			for (std::size_t i = 0; (i < dataTransferSchedule.size()) && (framesRemaining > 0); i++)
+			{
+				const auto &session = dataTransferSchedule[i];
+				bool keepScheduled = false;
+
+				if (send_data_transfer_packet(session))
+				{
+					framesRemaining--;
+					keepScheduled = (StateMachineState::SendDataTransferPackets == session->state) &&
+					  (0 == configuration->get_minimum_time_between_transport_protocol_data_frames());
+				}
+
+				if (keepScheduled)
+				{
+					if (numberOfScheduledSessions != i)
+					{
+						dataTransferSchedule[numberOfScheduledSessions] = session;
+					}
+					numberOfScheduledSessions++;
+				}
+			}
+			dataTransferSchedule.resize(numberOfScheduledSessions);
+		}
 	}
 
 	void ExtendedTransportProtocolManager::update_state_machine(std::shared_ptr<ExtendedTransportProtocolSession> &session)
@@ -692,6 +752,7 @@ namespace isobus
 			{
 				if (send_data_packet_offset(session))
 				{
+					// The data follows in this same update, so the link doesn't sit idle for a whole update period per window
 					session->set_state(StateMachineState::SendDataTransferPackets);
 				}
 			}
@@ -699,7 +760,7 @@ namespace isobus
 
 			case StateMachineState::SendDataTransferPackets:
 			{
-				send_data_transfer_packets(session);
+				// Data transfer packets are sent at the end of each update, interleaved with other sessions
 			}
 			break;
 
@@ -774,10 +835,14 @@ namespace isobus
 	void ExtendedTransportProtocolManager::close_session(const std::shared_ptr<ExtendedTransportProtocolSession> &session, bool successful)
 	{
 		session->complete(successful);
-		auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
-		if (activeSessions.end() != sessionLocation)
+
+		if (ExtendedTransportProtocolSession::Direction::Receive == session->get_direction())
+		{
+			// Receive sessions always reassemble into a buffer from the pool. If the message was not completed it's still here.
+			receiveBufferPool.release(std::move(static_cast<CANMessageDataVector &>(session->get_data())));
+		}
+		if (activeSessions.erase(session))
 		{
-			activeSessions.erase(sessionLocation);
 			LOG_DEBUG("[ETP]: Session Closed");
 		}
 	}
@@ -902,22 +967,22 @@ namespace isobus
 
 	bool ExtendedTransportProtocolManager::has_session(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<ExtendedTransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
+		return (nullptr != activeSessions.find(source, destination));
+	}
+
+	std::shared_ptr<ExtendedTransportProtocolManager::ExtendedTransportProtocolSession> ExtendedTransportProtocolManager::get_session(const std::shared_ptr<ControlFunction> &source,
+	                                                                                                                                  const std::shared_ptr<ControlFunction> &destination)
+	{
+		return activeSessions.find(source, destination);
 	}
 
-	std::shared_ptr<ExtendedTransportProtocolManager::ExtendedTransportProtocolSession> ExtendedTransportProtocolManager::get_session(std::shared_ptr<ControlFunction> source,
-	                                                                                                                                  std::shared_ptr<ControlFunction> destination)
+	const CANMessageBufferPool &ExtendedTransportProtocolManager::get_receive_buffer_pool() const
 	{
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<ExtendedTransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		return receiveBufferPool;
 	}
 
 	const std::vector<std::shared_ptr<ExtendedTransportProtocolManager::ExtendedTransportProtocolSession>> &ExtendedTransportProtocolManager::get_sessions() const
 	{
-		return activeSessions;
+		return activeSessions.get_sessions();
 	}
 }
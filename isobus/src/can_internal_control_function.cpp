@@ -157,7 +157,7 @@ namespace isobus
 						// Can't claim because we cannot tolerate an arbitrary address, and the CF at that spot wins contention
 						set_current_state(State::UnableToClaim);
 						LOG_ERROR("[AC]: Internal control function %016llx failed to claim its preferred address %u on channel %u, as it cannot tolerate for an arbitrary address and there is already a CF at the preferred address that wins contention.",
-						          get_NAME().get_full_name(),
+						          static_cast<unsigned long long>(get_NAME().get_full_name()),
 						          preferredAddress,
 						          get_can_port());
 						send_cannot_claim_source_address();
@@ -171,7 +171,7 @@ namespace isobus
 				if (send_address_claim(preferredAddress))
 				{
 					LOG_DEBUG("[AC]: Internal control function %016llx has claimed address %u on channel %u",
-					          get_NAME().get_full_name(),
+					          static_cast<unsigned long long>(get_NAME().get_full_name()),
 					          get_preferred_address(),
 					          get_can_port());
 					hasClaimedAddress = true;
@@ -221,14 +221,14 @@ namespace isobus
 						{
 							preferredAddress = i;
 							LOG_DEBUG("[AC]: Internal control function %016llx has arbitrarily claimed address %u on channel %u",
-							          get_NAME().get_full_name(),
+							          static_cast<unsigned long long>(get_NAME().get_full_name()),
 							          i,
 							          get_can_port());
 						}
 						else
 						{
 							LOG_DEBUG("[AC]: Internal control function %016llx could not use the preferred address, but has arbitrarily claimed address %u on channel %u",
-							          get_NAME().get_full_name(),
+							          static_cast<unsigned long long>(get_NAME().get_full_name()),
 							          i,
 							          get_can_port());
 						}
@@ -240,7 +240,7 @@ namespace isobus
 				if (!hasClaimedAddress)
 				{
 					LOG_CRITICAL("[AC]: Internal control function %016llx failed to claim an address on channel %u",
-					             get_NAME().get_full_name(),
+					             static_cast<unsigned long long>(get_NAME().get_full_name()),
 					             get_can_port());
 
 					set_current_state(State::UnableToClaim);
@@ -264,7 +264,7 @@ namespace isobus
 				if (send_address_claim(preferredAddress))
 				{
 					LOG_DEBUG("[AC]: Internal control function %016llx has won address contention and claimed address %u on channel %u",
-					          get_NAME().get_full_name(),
+					          static_cast<unsigned long long>(get_NAME().get_full_name()),
 					          get_preferred_address(),
 					          get_can_port());
 					hasClaimedAddress = true;
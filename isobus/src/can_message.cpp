@@ -23,7 +23,7 @@ namespace isobus
 	                       std::uint8_t CANPort) :
 	  messageType(type),
 	  identifier(identifier),
-	  data(dataBuffer, dataBuffer + length),
+	  data(dataBuffer, length),
 	  source(source),
 	  destination(destination),
 	  CANPortIndex(CANPort)
@@ -55,17 +55,22 @@ namespace isobus
 		return messageType;
 	}
 
-	const std::vector<std::uint8_t> &CANMessage::get_data() const
+	const CANMessagePayload &CANMessage::get_data() const
 	{
 		return data;
 	}
 
+	std::vector<std::uint8_t> CANMessage::release_data()
+	{
+		return data.release();
+	}
+
 	std::uint32_t CANMessage::get_data_length() const
 	{
 		return static_cast<std::uint32_t>(data.size());
 	}
 
-	std::shared_ptr<ControlFunction> CANMessage::get_source_control_function() const
+	const std::shared_ptr<ControlFunction> &CANMessage::get_source_control_function() const
 	{
 		return source;
 	}
@@ -75,7 +80,7 @@ namespace isobus
 		return (nullptr != source) && source->get_address_valid();
 	}
 
-	std::shared_ptr<ControlFunction> CANMessage::get_destination_control_function() const
+	const std::shared_ptr<ControlFunction> &CANMessage::get_destination_control_function() const
 	{
 		return destination;
 	}
@@ -95,12 +100,12 @@ namespace isobus
 		return has_valid_destination_control_function() && destination->get_type() == ControlFunction::Type::Internal;
 	}
 
-	bool CANMessage::is_destination(std::shared_ptr<ControlFunction> controlFunction) const
+	bool CANMessage::is_destination(const std::shared_ptr<ControlFunction> &controlFunction) const
 	{
 		return has_valid_destination_control_function() && destination == controlFunction;
 	}
 
-	bool CANMessage::is_source(std::shared_ptr<ControlFunction> controlFunction) const
+	bool CANMessage::is_source(const std::shared_ptr<ControlFunction> &controlFunction) const
 	{
 		return has_valid_source_control_function() && source == controlFunction;
 	}
@@ -125,7 +130,7 @@ namespace isobus
 		assert(length <= ABSOLUTE_MAX_MESSAGE_LENGTH && "CANMessage::set_data() called with length greater than maximum supported");
 		assert(nullptr != dataBuffer && "CANMessage::set_data() called with nullptr dataBuffer");
 
-		data.insert(data.end(), dataBuffer, dataBuffer + length);
+		data.append(dataBuffer, length);
 	}
 
 	void CANMessage::set_data(std::uint8_t dataByte, const std::uint32_t insertPosition)
@@ -0,0 +1,88 @@
+//================================================================================================
+/// @file can_message_buffer_pool.cpp
+///
+/// @brief A pool of reusable data buffers, used by the transport protocols to avoid
+/// allocating a new reassembly buffer for every received multi-frame message.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_message_buffer_pool.hpp"
+
+#include <cassert>
+#include <utility>
+
+namespace isobus
+{
+	CANMessageBufferPool::CANMessageBufferPool(std::size_t chunkSize, std::size_t maximumPooledBuffers, std::size_t maximumPooledBufferSize) :
+	  chunkSize(chunkSize),
+	  maximumPooledBuffers(maximumPooledBuffers),
+	  maximumPooledBufferSize(maximumPooledBufferSize)
+	{
+		assert(0 != chunkSize && "CANMessageBufferPool chunk size must not be 0");
+		idleBuffers.reserve(maximumPooledBuffers);
+	}
+
+	std::vector<std::uint8_t> CANMessageBufferPool::acquire(std::size_t size)
+	{
+		std::vector<std::uint8_t> retVal;
+
+		// Take the smallest idle buffer that fits, so large buffers stay available for large messages
+		std::size_t bestIndex = idleBuffers.size();
+		for (std::size_t i = 0; i < idleBuffers.size(); i++)
+		{
+			if ((idleBuffers[i].capacity() >= size) &&
+			    ((bestIndex == idleBuffers.size()) || (idleBuffers[i].capacity() < idleBuffers[bestIndex].capacity())))
+			{
+				bestIndex = i;
+			}
+		}
+
+		if (bestIndex < idleBuffers.size())
+		{
+			retVal.swap(idleBuffers[bestIndex]);
+			idleBuffers[bestIndex].swap(idleBuffers.back());
+			idleBuffers.pop_back();
+			numberOfReuses++;
+		}
+		else
+		{
+			std::size_t numberOfChunks = (size + chunkSize - 1) / chunkSize;
+			retVal.reserve((0 != numberOfChunks) ? (numberOfChunks * chunkSize) : chunkSize);
+			numberOfAllocations++;
+		}
+		retVal.assign(size, 0);
+		return retVal;
+	}
+
+	void CANMessageBufferPool::release(std::vector<std::uint8_t> &&buffer)
+	{
+		if ((buffer.capacity() >= chunkSize) &&
+		    (buffer.capacity() <= maximumPooledBufferSize) &&
+		    (idleBuffers.size() < maximumPooledBuffers))
+		{
+			idleBuffers.push_back(std::move(buffer));
+		}
+		buffer = std::vector<std::uint8_t>();
+	}
+
+	void CANMessageBufferPool::clear()
+	{
+		idleBuffers.clear();
+	}
+
+	std::size_t CANMessageBufferPool::get_number_of_allocations() const
+	{
+		return numberOfAllocations;
+	}
+
+	std::size_t CANMessageBufferPool::get_number_of_reuses() const
+	{
+		return numberOfReuses;
+	}
+
+	std::size_t CANMessageBufferPool::get_number_of_idle_buffers() const
+	{
+		return idleBuffers.size();
+	}
+} // namespace isobus
@@ -10,6 +10,7 @@
 #include "isobus/isobus/can_message_data.hpp"
 
 #include <algorithm>
+#include <utility>
 
 namespace isobus
 {
@@ -23,6 +24,11 @@ namespace isobus
 		vector::assign(data.begin(), data.end());
 	}
 
+	CANMessageDataVector::CANMessageDataVector(std::vector<std::uint8_t> &&data) :
+	  vector(std::move(data))
+	{
+	}
+
 	CANMessageDataVector::CANMessageDataVector(const std::uint8_t *data, std::size_t size)
 	{
 		vector::assign(data, data + size);
@@ -32,4 +32,75 @@ namespace isobus
 		}
 		return retVal / 2;
 	}
+
+	std::uint32_t CANMessageFrame::get_exact_number_bits_in_message() const
+	{
+		constexpr std::uint32_t MAX_CONSECUTIVE_SAME_BITS = 5; // After 5 consecutive bits, 6th will be opposite
+		constexpr std::uint16_t CRC15_POLYNOMIAL = 0x4599;
+		constexpr std::uint16_t CRC15_MASK = 0x7FFF;
+		constexpr std::uint32_t NON_STUFFED_TRAILER_LENGTH = 13; // CRC delimiter, ACK, ACK delimiter, EOF, and interframe space
+		const std::uint8_t length = (dataLength < CAN_DATA_LENGTH) ? dataLength : CAN_DATA_LENGTH;
+		std::uint32_t numberOfBits = 0;
+		std::uint32_t runLength = 0;
+		std::uint16_t crc = 0;
+		bool lastBit = false;
+
+		// Feeds bits MSB first through the bit stuffing, and optionally through the CRC
+		auto add_bits = [&](std::uint32_t value, std::uint8_t numberOfValueBits, bool includeInCRC) {
+			for (std::uint8_t i = numberOfValueBits; i > 0; i--)
+			{
+				bool bit = (0 != ((value >> (i - 1)) & 0x01));
+
+				if (includeInCRC)
+				{
+					bool crcNext = bit != (0 != (crc & 0x4000));
+					crc = static_cast<std::uint16_t>((crc << 1) & CRC15_MASK);
+					if (crcNext)
+					{
+						crc ^= CRC15_POLYNOMIAL;
+					}
+				}
+
+				numberOfBits++;
+				if ((0 != runLength) && (bit == lastBit))
+				{
+					runLength++;
+				}
+				else
+				{
+					lastBit = bit;
+					runLength = 1;
+				}
+
+				if (MAX_CONSECUTIVE_SAME_BITS == runLength)
+				{
+					// The stuff bit is the opposite value, and counts towards the next run
+					numberOfBits++;
+					lastBit = !bit;
+					runLength = 1;
+				}
+			}
+		};
+
+		add_bits(0, 1, true); // SOF
+		if (isExtendedFrame)
+		{
+			add_bits((identifier >> 18) & 0x7FF, 11, true); // Base ID
+			add_bits(0x03, 2, true); // SRR and IDE
+			add_bits(identifier & 0x3FFFF, 18, true); // Extended ID
+			add_bits(0, 3, true); // RTR, r1 and r0
+		}
+		else
+		{
+			add_bits(identifier & 0x7FF, 11, true);
+			add_bits(0, 3, true); // RTR, IDE and r0
+		}
+		add_bits(length, 4, true); // DLC
+		for (std::uint8_t i = 0; i < length; i++)
+		{
+			add_bits(data[i], 8, true);
+		}
+		add_bits(crc, 15, false);
+		return numberOfBits + NON_STUFFED_TRAILER_LENGTH;
+	}
 } // namespace isobus
@@ -0,0 +1,136 @@
+//================================================================================================
+/// @file can_message_ring.cpp
+///
+/// @brief A bounded, preallocated queue of CAN messages used by the network manager to hand
+/// received and transmitted frames from the hardware layer to the stack's update thread.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_message_ring.hpp"
+
+#include <cassert>
+
+namespace isobus
+{
+	CANMessageRing::CANMessageRing(std::size_t capacity) :
+	  slots(capacity, CANMessage::create_invalid_message())
+	{
+		assert(0 != capacity && "CANMessageRing must have at least one slot");
+	}
+
+	void CANMessageRing::push(CANMessage::Type type,
+	                          const CANMessageFrame &frame,
+	                          const std::shared_ptr<ControlFunction> &source,
+	                          const std::shared_ptr<ControlFunction> &destination)
+	{
+		LOCK_GUARD(Mutex, ringMutex);
+
+		if ((count < slots.size()) && overflowMessages.empty())
+		{
+			write_slot(slots[(readIndex + count) % slots.size()], type, frame, source, destination);
+			count++;
+		}
+		else
+		{
+			// Once anything is in the overflow queue, everything after it has to go there too to keep the order
+			overflowMessages.emplace_back(type,
+			                              CANIdentifier(frame.identifier),
+			                              frame.data,
+			                              frame.dataLength,
+			                              source,
+			                              destination,
+			                              frame.channel);
+			overflowedMessageCount++;
+		}
+	}
+
+	const CANMessage *CANMessageRing::front()
+	{
+		const CANMessage *retVal = nullptr;
+		LOCK_GUARD(Mutex, ringMutex);
+
+		if (0 != count)
+		{
+			retVal = &slots[readIndex];
+		}
+		return retVal;
+	}
+
+	void CANMessageRing::pop()
+	{
+		LOCK_GUARD(Mutex, ringMutex);
+
+		if (0 != count)
+		{
+			release_slot(slots[readIndex]);
+			readIndex = (readIndex + 1) % slots.size();
+			count--;
+
+			if (!overflowMessages.empty())
+			{
+				// Everything in the overflow queue is newer than what's in the ring, so the oldest overflowed message takes the freed slot.
+				// This way the ring stays full until the overflow queue is drained, and new messages go back into the ring after that.
+				slots[(readIndex + count) % slots.size()] = std::move(overflowMessages.front());
+				overflowMessages.pop_front();
+				count++;
+			}
+		}
+	}
+
+	void CANMessageRing::clear()
+	{
+		LOCK_GUARD(Mutex, ringMutex);
+
+		while (0 != count)
+		{
+			release_slot(slots[readIndex]);
+			readIndex = (readIndex + 1) % slots.size();
+			count--;
+		}
+		overflowMessages.clear();
+	}
+
+	bool CANMessageRing::empty() const
+	{
+		LOCK_GUARD(Mutex, ringMutex);
+		return ((0 == count) && overflowMessages.empty());
+	}
+
+	std::size_t CANMessageRing::size() const
+	{
+		LOCK_GUARD(Mutex, ringMutex);
+		return count + overflowMessages.size();
+	}
+
+	std::size_t CANMessageRing::get_capacity() const
+	{
+		return slots.size();
+	}
+
+	std::size_t CANMessageRing::get_number_of_overflowed_messages() const
+	{
+		LOCK_GUARD(Mutex, ringMutex);
+		return overflowedMessageCount;
+	}
+
+	void CANMessageRing::write_slot(CANMessage &slot,
+	                                CANMessage::Type type,
+	                                const CANMessageFrame &frame,
+	                                const std::shared_ptr<ControlFunction> &source,
+	                                const std::shared_ptr<ControlFunction> &destination)
+	{
+		slot.messageType = type;
+		slot.identifier = CANIdentifier(frame.identifier);
+		slot.data.assign(frame.data, frame.dataLength); // A single frame always fits inline, so this does not allocate
+		slot.source = source;
+		slot.destination = destination;
+		slot.CANPortIndex = frame.channel;
+	}
+
+	void CANMessageRing::release_slot(CANMessage &slot)
+	{
+		slot.source.reset();
+		slot.destination.reset();
+	}
+} // namespace isobus
@@ -38,6 +38,21 @@ namespace isobus
 		return minimumTimeBetweenTransportProtocolBAMFrames;
 	}
 
+	void CANNetworkConfiguration::set_minimum_time_between_transport_protocol_data_frames(std::uint32_t value)
+	{
+		constexpr std::uint32_t MAX_DATA_FRAME_DELAY_MS = 200;
+
+		if (value <= MAX_DATA_FRAME_DELAY_MS)
+		{
+			minimumTimeBetweenTransportProtocolDataFrames = value;
+		}
+	}
+
+	std::uint32_t CANNetworkConfiguration::get_minimum_time_between_transport_protocol_data_frames() const
+	{
+		return minimumTimeBetweenTransportProtocolDataFrames;
+	}
+
 	void CANNetworkConfiguration::set_number_of_packets_per_dpo_message(std::uint8_t numberFrames)
 	{
 		numberOfPacketsPerDPOMessage = numberFrames;
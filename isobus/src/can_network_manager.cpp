@@ -32,14 +32,8 @@ namespace isobus
 	void CANNetworkManager::initialize()
 	{
 		// Clear queues
-		while (!receivedMessageQueue.empty())
-		{
-			get_next_can_message_from_rx_queue();
-		}
-		while (!transmittedMessageQueue.empty())
-		{
-			get_next_can_message_from_tx_queue();
-		}
+		receivedMessageQueue.clear();
+		transmittedMessageQueue.clear();
 		initialized = true;
 	}
 
@@ -57,6 +51,7 @@ namespace isobus
 	{
 		auto controlFunction = std::make_shared<PartneredControlFunction>(CANPort, NAMEFilters);
 		partneredControlFunctions.push_back(controlFunction);
+		newPartneredControlFunctions.push_back(controlFunction);
 		return controlFunction;
 	}
 
@@ -72,22 +67,18 @@ namespace isobus
 	void CANNetworkManager::deactivate_control_function(std::shared_ptr<PartneredControlFunction> controlFunction)
 	{
 		partneredControlFunctions.erase(std::remove(partneredControlFunctions.begin(), partneredControlFunctions.end(), controlFunction), partneredControlFunctions.end());
+		newPartneredControlFunctions.erase(std::remove(newPartneredControlFunctions.begin(), newPartneredControlFunctions.end(), controlFunction), newPartneredControlFunctions.end());
 		deactivate_control_function(std::static_pointer_cast<ControlFunction>(controlFunction));
 	}
 
 	void CANNetworkManager::add_global_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
-		globalParameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, nullptr);
+		globalParameterGroupNumberCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr));
 	}
 
 	void CANNetworkManager::remove_global_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
-		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, callback, parent, nullptr);
-		auto callbackLocation = std::find(globalParameterGroupNumberCallbacks.begin(), globalParameterGroupNumberCallbacks.end(), tempObject);
-		if (globalParameterGroupNumberCallbacks.end() != callbackLocation)
-		{
-			globalParameterGroupNumberCallbacks.erase(callbackLocation);
-		}
+		globalParameterGroupNumberCallbacks.remove_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr));
 	}
 
 	std::size_t CANNetworkManager::get_number_global_parameter_group_number_callbacks() const
@@ -97,19 +88,12 @@ namespace isobus
 
 	void CANNetworkManager::add_any_control_function_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
-		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		anyControlFunctionParameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, nullptr);
+		anyControlFunctionParameterGroupNumberCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr));
 	}
 
 	void CANNetworkManager::remove_any_control_function_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
-		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, callback, parent, nullptr);
-		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		auto callbackLocation = std::find(anyControlFunctionParameterGroupNumberCallbacks.begin(), anyControlFunctionParameterGroupNumberCallbacks.end(), tempObject);
-		if (anyControlFunctionParameterGroupNumberCallbacks.end() != callbackLocation)
-		{
-			anyControlFunctionParameterGroupNumberCallbacks.erase(callbackLocation);
-		}
+		anyControlFunctionParameterGroupNumberCallbacks.remove_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr));
 	}
 
 	EventDispatcher<CANMessage> &CANNetworkManager::get_transmitted_message_event_dispatcher()
@@ -144,6 +128,50 @@ namespace isobus
 		return retVal;
 	}
 
+	bool CANNetworkManager::set_bus_statistics_enabled(std::uint8_t canChannel, bool enabled)
+	{
+		bool retVal = false;
+
+		if (canChannel < CAN_PORT_MAXIMUM)
+		{
+			LOCK_GUARD(Mutex, busloadUpdateMutex);
+			if (!enabled)
+			{
+				busStatistics.at(canChannel).reset();
+			}
+			else if (nullptr == busStatistics.at(canChannel))
+			{
+				busStatistics.at(canChannel).reset(new CANBusStatistics());
+			}
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	std::vector<CANBusStatistics::TalkerStatistics> CANNetworkManager::get_top_talkers_by_source_address(std::uint8_t canChannel, std::size_t count)
+	{
+		LOCK_GUARD(Mutex, busloadUpdateMutex);
+		std::vector<CANBusStatistics::TalkerStatistics> retVal;
+
+		if ((canChannel < CAN_PORT_MAXIMUM) && (nullptr != busStatistics.at(canChannel)))
+		{
+			retVal = busStatistics.at(canChannel)->get_top_source_addresses(count);
+		}
+		return retVal;
+	}
+
+	std::vector<CANBusStatistics::TalkerStatistics> CANNetworkManager::get_top_talkers_by_parameter_group_number(std::uint8_t canChannel, std::size_t count)
+	{
+		LOCK_GUARD(Mutex, busloadUpdateMutex);
+		std::vector<CANBusStatistics::TalkerStatistics> retVal;
+
+		if ((canChannel < CAN_PORT_MAXIMUM) && (nullptr != busStatistics.at(canChannel)))
+		{
+			retVal = busStatistics.at(canChannel)->get_top_parameter_group_numbers(count);
+		}
+		return retVal;
+	}
+
 	bool CANNetworkManager::send_can_message(std::uint32_t parameterGroupNumber,
 	                                         const std::uint8_t *dataBuffer,
 	                                         std::uint32_t dataLength,
@@ -164,27 +192,93 @@ namespace isobus
 		    ((parameterGroupNumber == static_cast<std::uint32_t>(CANLibParameterGroupNumber::AddressClaim)) ||
 		     (sourceControlFunction->get_address_valid())))
 		{
-			std::unique_ptr<CANMessageData> messageData;
-			if (nullptr != frameChunkCallback)
+			if ((nullptr != dataBuffer) &&
+			    (dataLength <= CAN_DATA_LENGTH))
 			{
-				messageData.reset(new CANMessageDataCallback(dataLength, frameChunkCallback, parentPointer));
+				// No protocol needed, so skip wrapping the data
+				retVal = send_single_frame_message(parameterGroupNumber,
+				                                   dataBuffer,
+				                                   dataLength,
+				                                   sourceControlFunction,
+				                                   destinationControlFunction,
+				                                   priority,
+				                                   transmitCompleteCallback,
+				                                   parentPointer);
 			}
 			else
 			{
-				messageData.reset(new CANMessageDataView(dataBuffer, dataLength));
+				std::unique_ptr<CANMessageData> messageData;
+				if (nullptr != frameChunkCallback)
+				{
+					messageData.reset(new CANMessageDataCallback(dataLength, frameChunkCallback, parentPointer));
+				}
+				else
+				{
+					messageData.reset(new CANMessageDataView(dataBuffer, dataLength));
+				}
+				retVal = send_can_message(parameterGroupNumber,
+				                          messageData,
+				                          sourceControlFunction,
+				                          destinationControlFunction,
+				                          priority,
+				                          transmitCompleteCallback,
+				                          parentPointer);
+			}
+		}
+		return retVal;
+	}
+
+	bool CANNetworkManager::send_can_message(std::uint32_t parameterGroupNumber,
+	                                         std::unique_ptr<CANMessageData> &data,
+	                                         std::shared_ptr<InternalControlFunction> sourceControlFunction,
+	                                         std::shared_ptr<ControlFunction> destinationControlFunction,
+	                                         CANIdentifier::CANPriority priority,
+	                                         TransmitCompleteCallback transmitCompleteCallback,
+	                                         void *parentPointer)
+	{
+		bool retVal = false;
+
+		if ((nullptr != data) &&
+		    (data->size() > 0) &&
+		    (data->size() <= CANMessage::ABSOLUTE_MAX_MESSAGE_LENGTH) &&
+		    (nullptr != sourceControlFunction) &&
+		    ((parameterGroupNumber == static_cast<std::uint32_t>(CANLibParameterGroupNumber::AddressClaim)) ||
+		     (sourceControlFunction->get_address_valid())))
+		{
+			if (data->size() <= CAN_DATA_LENGTH)
+			{
+				std::array<std::uint8_t, CAN_DATA_LENGTH> buffer;
+				const auto dataLength = static_cast<std::uint32_t>(data->size());
+				for (std::uint32_t i = 0; i < dataLength; i++)
+				{
+					buffer[i] = data->get_byte(i);
+				}
+
+				retVal = send_single_frame_message(parameterGroupNumber,
+				                                   buffer.data(),
+				                                   dataLength,
+				                                   sourceControlFunction,
+				                                   destinationControlFunction,
+				                                   priority,
+				                                   transmitCompleteCallback,
+				                                   parentPointer);
+				if (retVal)
+				{
+					data.reset();
+				}
 			}
-			if (transportProtocols[sourceControlFunction->get_can_port()]->protocol_transmit_message(parameterGroupNumber,
-			                                                                                         messageData,
-			                                                                                         sourceControlFunction,
-			                                                                                         destinationControlFunction,
-			                                                                                         transmitCompleteCallback,
-			                                                                                         parentPointer))
+			else if (transportProtocols[sourceControlFunction->get_can_port()]->protocol_transmit_message(parameterGroupNumber,
+			                                                                                              data,
+			                                                                                              sourceControlFunction,
+			                                                                                              destinationControlFunction,
+			                                                                                              transmitCompleteCallback,
+			                                                                                              parentPointer))
 			{
 				// Successfully sent via the transport protocol
 				retVal = true;
 			}
 			else if (extendedTransportProtocols[sourceControlFunction->get_can_port()]->protocol_transmit_message(parameterGroupNumber,
-			                                                                                                      messageData,
+			                                                                                                      data,
 			                                                                                                      sourceControlFunction,
 			                                                                                                      destinationControlFunction,
 			                                                                                                      transmitCompleteCallback,
@@ -193,28 +287,36 @@ namespace isobus
 				// Successfully sent via the extended transport protocol
 				retVal = true;
 			}
+		}
+		return retVal;
+	}
 
-			//! @todo Allow sending 8 byte message with the frameChunkCallback
-			if ((!retVal) &&
-			    (nullptr != dataBuffer))
-			{
-				if (nullptr == destinationControlFunction)
-				{
-					// Todo move binding of dest address to hardware layer
-					retVal = send_can_message_raw(sourceControlFunction->get_can_port(), sourceControlFunction->get_address(), 0xFF, parameterGroupNumber, static_cast<std::uint8_t>(priority), dataBuffer, dataLength);
-				}
-				else if (destinationControlFunction->get_address_valid())
-				{
-					retVal = send_can_message_raw(sourceControlFunction->get_can_port(), sourceControlFunction->get_address(), destinationControlFunction->get_address(), parameterGroupNumber, static_cast<std::uint8_t>(priority), dataBuffer, dataLength);
-				}
+	bool CANNetworkManager::send_single_frame_message(std::uint32_t parameterGroupNumber,
+	                                                  const std::uint8_t *dataBuffer,
+	                                                  std::uint32_t dataLength,
+	                                                  std::shared_ptr<InternalControlFunction> sourceControlFunction,
+	                                                  std::shared_ptr<ControlFunction> destinationControlFunction,
+	                                                  CANIdentifier::CANPriority priority,
+	                                                  TransmitCompleteCallback transmitCompleteCallback,
+	                                                  void *parentPointer) const
+	{
+		bool retVal = false;
 
-				if (retVal &&
-				    (nullptr != transmitCompleteCallback))
-				{
-					// Message was not sent via a protocol, so handle the tx callback now
-					transmitCompleteCallback(parameterGroupNumber, dataLength, sourceControlFunction, destinationControlFunction, retVal, parentPointer);
-				}
-			}
+		if (nullptr == destinationControlFunction)
+		{
+			// Todo move binding of dest address to hardware layer
+			retVal = send_can_message_raw(sourceControlFunction->get_can_port(), sourceControlFunction->get_address(), 0xFF, parameterGroupNumber, static_cast<std::uint8_t>(priority), dataBuffer, dataLength);
+		}
+		else if (destinationControlFunction->get_address_valid())
+		{
+			retVal = send_can_message_raw(sourceControlFunction->get_can_port(), sourceControlFunction->get_address(), destinationControlFunction->get_address(), parameterGroupNumber, static_cast<std::uint8_t>(priority), dataBuffer, dataLength);
+		}
+
+		if (retVal &&
+		    (nullptr != transmitCompleteCallback))
+		{
+			// Message was not sent via a protocol, so handle the tx callback now
+			transmitCompleteCallback(parameterGroupNumber, dataLength, sourceControlFunction, destinationControlFunction, retVal, parentPointer);
 		}
 		return retVal;
 	}
@@ -271,13 +373,7 @@ namespace isobus
 
 	ParameterGroupNumberCallbackData CANNetworkManager::get_global_parameter_group_number_callback(std::size_t index) const
 	{
-		ParameterGroupNumberCallbackData retVal(0, nullptr, nullptr, nullptr);
-
-		if (index < get_number_global_parameter_group_number_callbacks())
-		{
-			retVal = globalParameterGroupNumberCallbacks[index];
-		}
-		return retVal;
+		return globalParameterGroupNumberCallbacks.get_callback(index);
 	}
 
 	void receive_can_message_frame_from_hardware(const CANMessageFrame &rxFrame)
@@ -299,52 +395,39 @@ namespace isobus
 	{
 		update_control_functions(rxFrame);
 
-		CANIdentifier identifier(rxFrame.identifier);
-		CANMessage message(CANMessage::Type::Receive,
-		                   identifier,
-		                   rxFrame.data,
-		                   rxFrame.dataLength,
-		                   get_control_function(rxFrame.channel, identifier.get_source_address()),
-		                   get_control_function(rxFrame.channel, identifier.get_destination_address()),
-		                   rxFrame.channel);
-
-		update_busload(rxFrame.channel, rxFrame.get_number_bits_in_message());
+		update_busload(rxFrame);
 
 		if (initialized)
 		{
-			LOCK_GUARD(Mutex, receivedMessageQueueMutex);
-			receivedMessageQueue.push(std::move(message));
+			CANIdentifier identifier(rxFrame.identifier);
+			receivedMessageQueue.push(CANMessage::Type::Receive,
+			                          rxFrame,
+			                          get_control_function_for_frame(rxFrame.channel, identifier.get_source_address()),
+			                          get_control_function_for_frame(rxFrame.channel, identifier.get_destination_address()));
 		}
 	}
 
 	void CANNetworkManager::process_transmitted_can_message_frame(const CANMessageFrame &txFrame)
 	{
-		update_busload(txFrame.channel, txFrame.get_number_bits_in_message());
-
-		CANIdentifier identifier(txFrame.identifier);
-		CANMessage message(CANMessage::Type::Transmit,
-		                   identifier,
-		                   txFrame.data,
-		                   txFrame.dataLength,
-		                   get_control_function(txFrame.channel, identifier.get_source_address()),
-		                   get_control_function(txFrame.channel, identifier.get_destination_address()),
-		                   txFrame.channel);
+		update_busload(txFrame);
 
 		if (initialized)
 		{
-			{
-				LOCK_GUARD(Mutex, transmittedMessageQueueMutex);
-				transmittedMessageQueue.push(message);
-			}
+			CANIdentifier identifier(txFrame.identifier);
+			const auto &source = get_control_function_for_frame(txFrame.channel, identifier.get_source_address());
+			const auto &destination = get_control_function_for_frame(txFrame.channel, identifier.get_destination_address());
+
+			transmittedMessageQueue.push(CANMessage::Type::Transmit, txFrame, source, destination);
 
 			// We need to receive manual requests for the address claim PGN.
-			if ((CANIdentifier::Type::Extended == message.get_identifier().get_identifier_type()) &&
-			    (static_cast<std::uint32_t>(CANLibParameterGroupNumber::ParameterGroupNumberRequest) == message.get_identifier().get_parameter_group_number()) &&
-			    (3 == message.get_data_length()) &&
-			    (static_cast<std::uint32_t>(CANLibParameterGroupNumber::AddressClaim) == message.get_data_custom_length(0, 24)))
+			if ((CANIdentifier::Type::Extended == identifier.get_identifier_type()) &&
+			    (static_cast<std::uint32_t>(CANLibParameterGroupNumber::ParameterGroupNumberRequest) == identifier.get_parameter_group_number()) &&
+			    (3 == txFrame.dataLength) &&
+			    (static_cast<std::uint32_t>(CANLibParameterGroupNumber::AddressClaim) == (static_cast<std::uint32_t>(txFrame.data[0]) |
+			                                                                               (static_cast<std::uint32_t>(txFrame.data[1]) << 8) |
+			                                                                               (static_cast<std::uint32_t>(txFrame.data[2]) << 16))))
 			{
-				LOCK_GUARD(Mutex, receivedMessageQueueMutex);
-				receivedMessageQueue.push(std::move(message));
+				receivedMessageQueue.push(CANMessage::Type::Transmit, txFrame, source, destination);
 			}
 		}
 	}
@@ -499,12 +582,10 @@ namespace isobus
 	bool CANNetworkManager::add_protocol_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer)
 	{
 		bool retVal = false;
-		ParameterGroupNumberCallbackData callbackInfo(parameterGroupNumber, callback, parentPointer, nullptr);
-		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
-		if ((nullptr != callback) && (protocolPGNCallbacks.end() == find(protocolPGNCallbacks.begin(), protocolPGNCallbacks.end(), callbackInfo)))
+
+		if (nullptr != callback)
 		{
-			protocolPGNCallbacks.push_back(callbackInfo);
-			retVal = true;
+			retVal = protocolPGNCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parentPointer, nullptr), false);
 		}
 		return retVal;
 	}
@@ -512,18 +593,10 @@ namespace isobus
 	bool CANNetworkManager::remove_protocol_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer)
 	{
 		bool retVal = false;
-		ParameterGroupNumberCallbackData callbackInfo(parameterGroupNumber, callback, parentPointer, nullptr);
-		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
+
 		if (nullptr != callback)
 		{
-			std::list<ParameterGroupNumberCallbackData>::iterator callbackLocation;
-			callbackLocation = find(protocolPGNCallbacks.begin(), protocolPGNCallbacks.end(), callbackInfo);
-
-			if (protocolPGNCallbacks.end() != callbackLocation)
-			{
-				protocolPGNCallbacks.erase(callbackLocation);
-				retVal = true;
-			}
+			retVal = protocolPGNCallbacks.remove_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parentPointer, nullptr));
 		}
 		return retVal;
 	}
@@ -587,7 +660,7 @@ namespace isobus
 				inactiveControlFunctions.push_back(targetControlFunction);
 				LOG_INFO("[NM]: %s CF '%016llx' is evicted from address '%d' on channel '%d', as their address is probably stolen.",
 				         targetControlFunction->get_type_string().c_str(),
-				         targetControlFunction->get_NAME().get_full_name(),
+				         static_cast<unsigned long long>(targetControlFunction->get_NAME().get_full_name()),
 				         claimedAddress,
 				         channelIndex);
 				targetControlFunction = nullptr;
@@ -608,7 +681,7 @@ namespace isobus
 						controlFunctionTable[channelIndex][claimedAddress] = currentControlFunction;
 						LOG_DEBUG("[NM]: %s CF '%016llx' is now active at address '%d' on channel '%d'.",
 						          currentControlFunction->get_type_string().c_str(),
-						          currentControlFunction->get_NAME().get_full_name(),
+						          static_cast<unsigned long long>(currentControlFunction->get_NAME().get_full_name()),
 						          claimedAddress,
 						          channelIndex);
 						process_control_function_state_change_callback(currentControlFunction, ControlFunctionState::Online);
@@ -687,14 +760,22 @@ namespace isobus
 		}
 	}
 
-	void CANNetworkManager::update_busload(std::uint8_t channelIndex, std::uint32_t numberOfBitsProcessed)
+	void CANNetworkManager::update_busload(const CANMessageFrame &frame)
 	{
+		const std::uint32_t numberOfBits = frame.get_exact_number_bits_in_message();
+
 		LOCK_GUARD(Mutex, busloadUpdateMutex);
-		currentBusloadBitAccumulator.at(channelIndex) += numberOfBitsProcessed;
+		currentBusloadBitAccumulator.at(frame.channel) += numberOfBits;
+
+		if (nullptr != busStatistics.at(frame.channel))
+		{
+			busStatistics.at(frame.channel)->process_frame(frame, numberOfBits);
+		}
 	}
 
 	void CANNetworkManager::update_busload_history()
 	{
+		static_assert((BUSLOAD_SAMPLE_WINDOW_MS / BUSLOAD_UPDATE_FREQUENCY_MS) == CANBusStatistics::NUMBER_OF_SUB_WINDOWS, "Bus statistics must use the same window as the busload");
 		LOCK_GUARD(Mutex, busloadUpdateMutex);
 		if (SystemTiming::time_expired_ms(busloadUpdateTimestamp_ms, BUSLOAD_UPDATE_FREQUENCY_MS))
 		{
@@ -707,6 +788,11 @@ namespace isobus
 					busloadMessageBitsHistory.at(i).pop_front();
 				}
 				currentBusloadBitAccumulator.at(i) = 0;
+
+				if (nullptr != busStatistics.at(i))
+				{
+					busStatistics.at(i)->advance_window();
+				}
 			}
 			busloadUpdateTimestamp_ms = SystemTiming::get_timestamp_ms();
 		}
@@ -801,18 +887,18 @@ namespace isobus
 								                  (InternalControlFunction::State::AddressClaimingComplete == std::static_pointer_cast<InternalControlFunction>(cf)->get_current_state()))
 								              {
 									              LOG_DEBUG("[AC]: Internal control function %016llx on channel %u won address contention against an ECU with NAME %016llx.",
-									                        cf->get_NAME().get_full_name(),
+									                        static_cast<unsigned long long>(cf->get_NAME().get_full_name()),
 									                        cf->get_can_port(),
-									                        claimedNAME);
+									                        static_cast<unsigned long long>(claimedNAME));
 									              std::static_pointer_cast<InternalControlFunction>(cf)->set_current_state(InternalControlFunction::State::SendReclaimAddressOnRequest);
 									              wonContention = true;
 								              }
 								              else
 								              {
 									              LOG_WARNING("[AC]: Internal control function %016llx on channel %u must re-arbitrate its address because it was stolen by another ECU with NAME %016llx.",
-									                          cf->get_NAME().get_full_name(),
+									                          static_cast<unsigned long long>(cf->get_NAME().get_full_name()),
 									                          cf->get_can_port(),
-									                          claimedNAME);
+									                          static_cast<unsigned long long>(claimedNAME));
 
 									              // This check is not strictly needed, but sanity check the state of the address claim state machine
 									              // to ensure we're not advancing it. We don't want to go from an unclaimed state to the contention state.
@@ -864,7 +950,7 @@ namespace isobus
 				{
 					LOG_INFO("[NM]: %s control function with name %016llx has claimed address %u on channel %u.",
 					         foundControlFunction->get_type_string().c_str(),
-					         foundControlFunction->get_NAME().get_full_name(),
+					         static_cast<unsigned long long>(foundControlFunction->get_NAME().get_full_name()),
 					         claimedAddress,
 					         foundControlFunction->get_can_port());
 					foundControlFunction->address = claimedAddress;
@@ -876,44 +962,48 @@ namespace isobus
 
 	void CANNetworkManager::update_new_partners()
 	{
-		for (const auto &partner : partneredControlFunctions)
+		if (newPartneredControlFunctions.empty())
+		{
+			return;
+		}
+
+		// Swap the list out, in case a state change callback creates another partner
+		std::vector<std::shared_ptr<PartneredControlFunction>> partnersToMatch;
+		partnersToMatch.swap(newPartneredControlFunctions);
+
+		for (const auto &partner : partnersToMatch)
 		{
-			if (!partner->initialized)
+			// Remove any inactive CF that matches the partner's name
+			for (auto currentInactiveControlFunction = inactiveControlFunctions.begin(); currentInactiveControlFunction != inactiveControlFunctions.end(); currentInactiveControlFunction++)
 			{
-				// Remove any inactive CF that matches the partner's name
-				for (auto currentInactiveControlFunction = inactiveControlFunctions.begin(); currentInactiveControlFunction != inactiveControlFunctions.end(); currentInactiveControlFunction++)
+				if ((partner->check_matches_name((*currentInactiveControlFunction)->get_NAME())) &&
+				    (partner->get_can_port() == (*currentInactiveControlFunction)->get_can_port()) &&
+				    (ControlFunction::Type::External == (*currentInactiveControlFunction)->get_type()))
 				{
-					if ((partner->check_matches_name((*currentInactiveControlFunction)->get_NAME())) &&
-					    (partner->get_can_port() == (*currentInactiveControlFunction)->get_can_port()) &&
-					    (ControlFunction::Type::External == (*currentInactiveControlFunction)->get_type()))
-					{
-						inactiveControlFunctions.erase(currentInactiveControlFunction);
-						break;
-					}
+					inactiveControlFunctions.erase(currentInactiveControlFunction);
+					break;
 				}
+			}
 
-				for (const auto &currentActiveControlFunction : controlFunctionTable[partner->get_can_port()])
+			for (const auto &currentActiveControlFunction : controlFunctionTable[partner->get_can_port()])
+			{
+				if ((nullptr != currentActiveControlFunction) &&
+				    (partner->check_matches_name(currentActiveControlFunction->get_NAME())) &&
+				    (ControlFunction::Type::External == currentActiveControlFunction->get_type()))
 				{
-					if ((nullptr != currentActiveControlFunction) &&
-					    (partner->check_matches_name(currentActiveControlFunction->get_NAME())) &&
-					    (ControlFunction::Type::External == currentActiveControlFunction->get_type()))
-					{
-						// This CF matches the filter and is not an internal or already partnered CF
-						// Populate the partner's data
-						partner->address = currentActiveControlFunction->get_address();
-						partner->controlFunctionNAME = currentActiveControlFunction->get_NAME();
-						partner->initialized = true;
-						controlFunctionTable[partner->get_can_port()][partner->address] = std::shared_ptr<ControlFunction>(partner);
-						process_control_function_state_change_callback(partner, ControlFunctionState::Online);
-
-						LOG_INFO("[NM]: A partner with name %016llx has claimed address %u on channel %u.",
-						         partner->get_NAME().get_full_name(),
-						         partner->get_address(),
-						         partner->get_can_port());
-						break;
-					}
+					// This CF matches the filter and is not an internal or already partnered CF
+					// Populate the partner's data
+					partner->address = currentActiveControlFunction->get_address();
+					partner->controlFunctionNAME = currentActiveControlFunction->get_NAME();
+					controlFunctionTable[partner->get_can_port()][partner->address] = std::shared_ptr<ControlFunction>(partner);
+					process_control_function_state_change_callback(partner, ControlFunctionState::Online);
+
+					LOG_INFO("[NM]: A partner with name %016llx has claimed address %u on channel %u.",
+					         static_cast<unsigned long long>(partner->get_NAME().get_full_name()),
+					         partner->get_address(),
+					         partner->get_can_port());
+					break;
 				}
-				partner->initialized = true;
 			}
 		}
 	}
@@ -989,40 +1079,29 @@ namespace isobus
 		return retVal;
 	}
 
-	CANMessage CANNetworkManager::get_next_can_message_from_rx_queue()
+	const std::shared_ptr<ControlFunction> &CANNetworkManager::get_control_function_for_frame(std::uint8_t channelIndex, std::uint8_t address) const
 	{
-		LOCK_GUARD(Mutex, receivedMessageQueueMutex);
-		if (!receivedMessageQueue.empty())
-		{
-			CANMessage retVal = std::move(receivedMessageQueue.front());
-			receivedMessageQueue.pop();
-			return retVal;
-		}
-		return CANMessage::create_invalid_message();
-	}
+		static const std::shared_ptr<ControlFunction> NO_CONTROL_FUNCTION;
 
-	CANMessage CANNetworkManager::get_next_can_message_from_tx_queue()
-	{
-		LOCK_GUARD(Mutex, transmittedMessageQueueMutex);
-		if (!transmittedMessageQueue.empty())
+		if ((address < NULL_CAN_ADDRESS) && (channelIndex < CAN_PORT_MAXIMUM))
 		{
-			CANMessage retVal = std::move(transmittedMessageQueue.front());
-			transmittedMessageQueue.pop();
-			return retVal;
+			return controlFunctionTable[channelIndex][address];
 		}
-		return CANMessage::create_invalid_message();
+		return NO_CONTROL_FUNCTION;
 	}
 
 	void CANNetworkManager::process_any_control_function_pgn_callbacks(const CANMessage &currentMessage)
 	{
-		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		for (const auto &currentCallback : anyControlFunctionParameterGroupNumberCallbacks)
+		if ((nullptr == currentMessage.get_destination_control_function()) ||
+		    (ControlFunction::Type::Internal == currentMessage.get_destination_control_function()->get_type()))
 		{
-			if ((currentCallback.get_parameter_group_number() == currentMessage.get_identifier().get_parameter_group_number()) &&
-			    ((nullptr == currentMessage.get_destination_control_function()) ||
-			     (ControlFunction::Type::Internal == currentMessage.get_destination_control_function()->get_type())))
+			auto callbacks = anyControlFunctionParameterGroupNumberCallbacks.get_callbacks(currentMessage.get_identifier().get_parameter_group_number());
+			if (nullptr != callbacks)
 			{
-				currentCallback.get_callback()(currentMessage, currentCallback.get_parent());
+				for (const auto &currentCallback : *callbacks)
+				{
+					currentCallback.get_callback()(currentMessage, currentCallback.get_parent());
+				}
 			}
 		}
 	}
@@ -1050,10 +1129,10 @@ namespace isobus
 
 	void CANNetworkManager::process_protocol_pgn_callbacks(const CANMessage &currentMessage)
 	{
-		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
-		for (const auto &currentCallback : protocolPGNCallbacks)
+		auto callbacks = protocolPGNCallbacks.get_callbacks(currentMessage.get_identifier().get_parameter_group_number());
+		if (nullptr != callbacks)
 		{
-			if (currentCallback.get_parameter_group_number() == currentMessage.get_identifier().get_parameter_group_number())
+			for (const auto &currentCallback : *callbacks)
 			{
 				currentCallback.get_callback()(currentMessage, currentCallback.get_parent());
 			}
@@ -1062,8 +1141,8 @@ namespace isobus
 
 	void CANNetworkManager::process_can_message_for_global_and_partner_callbacks(const CANMessage &message) const
 	{
-		std::shared_ptr<ControlFunction> messageDestination = message.get_destination_control_function();
-		std::shared_ptr<ControlFunction> messageSource = message.get_source_control_function();
+		const auto &messageDestination = message.get_destination_control_function();
+		const auto &messageSource = message.get_source_control_function();
 
 		if ((nullptr == messageDestination) &&
 		    ((nullptr != messageSource) ||
@@ -1071,13 +1150,16 @@ namespace isobus
 		      (NULL_CAN_ADDRESS == message.get_identifier().get_source_address()))))
 		{
 			// Message destined to global
-			for (std::size_t i = 0; i < get_number_global_parameter_group_number_callbacks(); i++)
+			auto callbacks = globalParameterGroupNumberCallbacks.get_callbacks(message.get_identifier().get_parameter_group_number());
+			if (nullptr != callbacks)
 			{
-				if ((message.get_identifier().get_parameter_group_number() == get_global_parameter_group_number_callback(i).get_parameter_group_number()) &&
-				    (nullptr != get_global_parameter_group_number_callback(i).get_callback()))
+				for (const auto &currentCallback : *callbacks)
 				{
-					// We have a callback that matches this PGN
-					get_global_parameter_group_number_callback(i).get_callback()(message, get_global_parameter_group_number_callback(i).get_parent());
+					if (nullptr != currentCallback.get_callback())
+					{
+						// We have a callback that matches this PGN
+						currentCallback.get_callback()(message, currentCallback.get_parent());
+					}
 				}
 			}
 		}
@@ -1091,15 +1173,18 @@ namespace isobus
 				    (partner == messageSource))
 				{
 					// Message matches CAN port for a partnered control function
-					for (std::size_t k = 0; k < partner->get_number_parameter_group_number_callbacks(); k++)
+					auto callbacks = partner->parameterGroupNumberCallbacks.get_callbacks(message.get_identifier().get_parameter_group_number());
+					if (nullptr != callbacks)
 					{
-						if ((message.get_identifier().get_parameter_group_number() == partner->get_parameter_group_number_callback(k).get_parameter_group_number()) &&
-						    (nullptr != partner->get_parameter_group_number_callback(k).get_callback()) &&
-						    ((nullptr == partner->get_parameter_group_number_callback(k).get_internal_control_function()) ||
-						     (partner->get_parameter_group_number_callback(k).get_internal_control_function()->get_address() == message.get_identifier().get_destination_address())))
+						for (const auto &currentCallback : *callbacks)
 						{
-							// We have a callback matching this message
-							partner->get_parameter_group_number_callback(k).get_callback()(message, partner->get_parameter_group_number_callback(k).get_parent());
+							if ((nullptr != currentCallback.get_callback()) &&
+							    ((nullptr == currentCallback.get_internal_control_function()) ||
+							     (currentCallback.get_internal_control_function()->get_address() == message.get_identifier().get_destination_address())))
+							{
+								// We have a callback matching this message
+								currentCallback.get_callback()(message, currentCallback.get_parent());
+							}
 						}
 					}
 				}
@@ -1109,10 +1194,11 @@ namespace isobus
 
 	void CANNetworkManager::process_rx_messages()
 	{
-		// We may miss a message without locking the mutex when checking if empty, but that's okay. It will be picked up on the next iteration
-		while (!receivedMessageQueue.empty())
+		// Messages are processed in place in the queue, and only released once all of the callbacks are done with them
+		const CANMessage *nextMessage = receivedMessageQueue.front();
+		while (nullptr != nextMessage)
 		{
-			CANMessage currentMessage = get_next_can_message_from_rx_queue();
+			const CANMessage &currentMessage = *nextMessage;
 
 			update_address_table(currentMessage);
 			process_can_message_for_address_violations(currentMessage);
@@ -1128,18 +1214,22 @@ namespace isobus
 
 			// Update Others
 			process_can_message_for_global_and_partner_callbacks(currentMessage);
+
+			receivedMessageQueue.pop();
+			nextMessage = receivedMessageQueue.front();
 		}
 	}
 
 	void CANNetworkManager::process_tx_messages()
 	{
-		// We may miss a message without locking the mutex when checking if empty, but that's okay. It will be picked up on the next iteration
-		while (!transmittedMessageQueue.empty())
+		const CANMessage *nextMessage = transmittedMessageQueue.front();
+		while (nullptr != nextMessage)
 		{
-			CANMessage currentMessage = get_next_can_message_from_tx_queue();
-
 			// Update listen-only callbacks
-			messageTransmittedEventDispatcher.call(currentMessage);
+			messageTransmittedEventDispatcher.call(*nextMessage);
+
+			transmittedMessageQueue.pop();
+			nextMessage = transmittedMessageQueue.front();
 		}
 	}
 
@@ -1159,7 +1249,7 @@ namespace isobus
 					    (ControlFunction::Type::Internal != controlFunction->get_type()))
 					{
 						inactiveControlFunctions.push_back(controlFunction);
-						LOG_INFO("[NM]: Control function with address %u and NAME %016llx is now offline on channel %u.", controlFunction->get_address(), controlFunction->get_NAME(), channelIndex);
+						LOG_INFO("[NM]: Control function with address %u and NAME %016llx is now offline on channel %u.", controlFunction->get_address(), static_cast<unsigned long long>(controlFunction->get_NAME().get_full_name()), channelIndex);
 						controlFunctionTable[channelIndex][i] = nullptr;
 						controlFunction->address = NULL_CAN_ADDRESS;
 						process_control_function_state_change_callback(controlFunction, ControlFunctionState::Offline);
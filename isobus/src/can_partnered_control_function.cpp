@@ -23,21 +23,17 @@ namespace isobus
 	{
 		auto &processingMutex = ControlFunction::controlFunctionProcessingMutex;
 		LOCK_GUARD(Mutex, processingMutex);
+		compile_name_filters();
 	}
 
 	void PartneredControlFunction::add_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
 	{
-		parameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, internalControlFunction);
+		parameterGroupNumberCallbacks.add_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, internalControlFunction));
 	}
 
 	void PartneredControlFunction::remove_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
 	{
-		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, callback, parent, internalControlFunction);
-		auto callbackLocation = std::find(parameterGroupNumberCallbacks.begin(), parameterGroupNumberCallbacks.end(), tempObject);
-		if (parameterGroupNumberCallbacks.end() != callbackLocation)
-		{
-			parameterGroupNumberCallbacks.erase(callbackLocation);
-		}
+		parameterGroupNumberCallbacks.remove_callback(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, internalControlFunction));
 	}
 
 	std::size_t PartneredControlFunction::get_number_parameter_group_number_callbacks() const
@@ -79,94 +75,35 @@ namespace isobus
 
 	bool PartneredControlFunction::check_matches_name(NAME NAMEToCheck) const
 	{
-		std::uint32_t currentFilterValue;
-		NAME::NAMEParameters currentFilterParameter;
-		bool retVal = true;
+		return NAMEFiltersCanMatch && ((NAMEToCheck.get_full_name() & NAMEFilterMask) == NAMEFilterValue);
+	}
 
-		if (0 == get_number_name_filters())
-		{
-			retVal = false;
-		}
+	ParameterGroupNumberCallbackData PartneredControlFunction::get_parameter_group_number_callback(std::size_t index) const
+	{
+		assert(index < get_number_parameter_group_number_callbacks());
+		return parameterGroupNumberCallbacks.get_callback(index);
+	}
 
-		for (std::uint32_t i = 0; i < get_number_name_filters(); i++)
-		{
-			get_name_filter_parameter(i, currentFilterParameter, currentFilterValue);
+	void PartneredControlFunction::compile_name_filters()
+	{
+		NAMEFilterMask = 0;
+		NAMEFilterValue = 0;
+		NAMEFiltersCanMatch = !NAMEFilterList.empty();
 
-			switch (currentFilterParameter)
-			{
-				case NAME::NAMEParameters::IdentityNumber:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_identity_number());
-				}
-				break;
-
-				case NAME::NAMEParameters::ManufacturerCode:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_manufacturer_code());
-				}
-				break;
-
-				case NAME::NAMEParameters::EcuInstance:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_ecu_instance());
-				}
-				break;
-
-				case NAME::NAMEParameters::FunctionInstance:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_function_instance());
-				}
-				break;
-
-				case NAME::NAMEParameters::FunctionCode:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_function_code());
-				}
-				break;
-
-				case NAME::NAMEParameters::DeviceClass:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_device_class());
-				}
-				break;
-
-				case NAME::NAMEParameters::DeviceClassInstance:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_device_class_instance());
-				}
-				break;
-
-				case NAME::NAMEParameters::IndustryGroup:
-				{
-					retVal = (currentFilterValue == NAMEToCheck.get_industry_group());
-				}
-				break;
-
-				case NAME::NAMEParameters::ArbitraryAddressCapable:
-				{
-					retVal = ((0 != currentFilterValue) == NAMEToCheck.get_arbitrary_address_capable());
-				}
-				break;
-
-				default:
-				{
-					retVal = false;
-				}
-				break;
-			}
+		for (const auto &filter : NAMEFilterList)
+		{
+			std::uint64_t filterMask;
+			std::uint64_t filterValue;
 
-			if (false == retVal)
+			if ((!filter.get_NAME_mask_and_value(filterMask, filterValue)) ||
+			    (0 != ((NAMEFilterValue ^ filterValue) & NAMEFilterMask & filterMask)))
 			{
-				break;
+				// Either the filter can't match anything, or it contradicts an earlier filter
+				NAMEFiltersCanMatch = false;
 			}
+			NAMEFilterMask |= filterMask;
+			NAMEFilterValue |= filterValue;
 		}
-		return retVal;
-	}
-
-	ParameterGroupNumberCallbackData &PartneredControlFunction::get_parameter_group_number_callback(std::size_t index)
-	{
-		assert(index < get_number_parameter_group_number_callbacks());
-		return parameterGroupNumberCallbacks[index];
 	}
 
 } // namespace isobus
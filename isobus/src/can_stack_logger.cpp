@@ -9,7 +9,7 @@
 //================================================================================================
 #include "isobus/isobus/can_stack_logger.hpp"
 
-#include <iostream>
+#include <cstring>
 
 namespace isobus
 {
@@ -18,15 +18,21 @@ namespace isobus
 	Mutex CANStackLogger::loggerMutex;
 
 #ifndef DISABLE_CAN_STACK_LOGGER
+	constexpr std::size_t CANStackLogger::FORMAT_BUFFER_SIZE;
+
 	void CANStackLogger::CAN_stack_log(LoggingLevel level, const std::string &logText)
 	{
-		LOCK_GUARD(Mutex, loggerMutex);
-		CANStackLogger *canStackLogger = nullptr;
+		if (is_log_level_enabled(level))
+		{
+			log_text(level, logText.c_str(), logText.size());
+		}
+	}
 
-		if ((get_can_stack_logger(canStackLogger)) &&
-		    (level >= get_log_level()))
+	void CANStackLogger::CAN_stack_log(LoggingLevel level, const char *logText)
+	{
+		if (is_log_level_enabled(level))
 		{
-			canStackLogger->sink_CAN_stack_log(level, logText);
+			log_text(level, logText, std::strlen(logText));
 		}
 	}
 
@@ -55,6 +61,28 @@ namespace isobus
 		CAN_stack_log(LoggingLevel::Critical, logText);
 	}
 
+	void CANStackLogger::log_text(LoggingLevel level, const char *logText, std::size_t length)
+	{
+		LOCK_GUARD(Mutex, loggerMutex);
+		CANStackLogger *canStackLogger = nullptr;
+
+		if ((get_can_stack_logger(canStackLogger)) &&
+		    (level >= get_log_level()))
+		{
+			canStackLogger->sink_CAN_stack_log_text(level, logText, length);
+		}
+	}
+
+	char *CANStackLogger::get_format_buffer()
+	{
+#if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
+		static char formatBuffer[FORMAT_BUFFER_SIZE];
+#else
+		thread_local char formatBuffer[FORMAT_BUFFER_SIZE];
+#endif
+		return formatBuffer;
+	}
+
 #endif // DISABLE_CAN_STACK_LOGGER
 
 	void CANStackLogger::set_can_stack_logger_sink(CANStackLogger *logSink)
@@ -77,6 +105,11 @@ namespace isobus
 		// Override this function to use the log sink
 	}
 
+	void CANStackLogger::sink_CAN_stack_log_text(LoggingLevel level, const char *logText, std::size_t length)
+	{
+		sink_CAN_stack_log(level, std::string(logText, length));
+	}
+
 	bool CANStackLogger::get_can_stack_logger(CANStackLogger *&canStackLogger)
 	{
 		canStackLogger = logger;
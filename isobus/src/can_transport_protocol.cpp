@@ -123,10 +123,13 @@ namespace isobus
 	TransportProtocolManager::TransportProtocolManager(const CANMessageFrameCallback &sendCANFrameCallback,
 	                                                   const CANMessageCallback &canMessageReceivedCallback,
 	                                                   const CANNetworkConfiguration *configuration) :
+	  activeSessions(configuration->get_max_number_transport_protocol_sessions()),
+	  receiveBufferPool(MAX_PROTOCOL_DATA_LENGTH, configuration->get_max_number_transport_protocol_sessions(), MAX_PROTOCOL_DATA_LENGTH),
 	  sendCANFrameCallback(sendCANFrameCallback),
 	  canMessageReceivedCallback(canMessageReceivedCallback),
 	  configuration(configuration)
 	{
+		dataTransferSchedule.reserve(configuration->get_max_number_transport_protocol_sessions());
 	}
 
 	void TransportProtocolManager::process_broadcast_announce_message(const std::shared_ptr<ControlFunction> source,
@@ -159,15 +162,15 @@ namespace isobus
 				close_session(oldSession, false);
 			}
 
-			auto newSession = std::make_shared<TransportProtocolSession>(TransportProtocolSession::Direction::Receive,
-			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
-			                                                             parameterGroupNumber,
-			                                                             totalMessageSize,
-			                                                             0xFF, // Arbitrary - unused for broadcast
-			                                                             source,
-			                                                             nullptr, // Global destination
-			                                                             nullptr, // No callback
-			                                                             nullptr);
+			auto newSession = activeSessions.create(TransportProtocolSession::Direction::Receive,
+			                                        std::unique_ptr<CANMessageData>(new CANMessageDataVector(receiveBufferPool.acquire(totalMessageSize))),
+			                                        parameterGroupNumber,
+			                                        totalMessageSize,
+			                                        0xFF, // Arbitrary - unused for broadcast
+			                                        source,
+			                                        nullptr, // Global destination
+			                                        nullptr, // No callback
+			                                        nullptr);
 
 			if (newSession->get_total_number_of_packets() != totalNumberOfPackets)
 			{
@@ -177,13 +180,22 @@ namespace isobus
 			{
 				newSession->set_state(StateMachineState::WaitForDataTransferPacket);
 
+				bool added;
 				{
 					std::lock_guard<std::mutex> lock(activeSessionsMutex);
-					activeSessions.push_back(newSession);
+					added = activeSessions.insert(newSession);
 				}
 
-				update_state_machine(newSession);
-				LOG_DEBUG("[TP]: New rx broadcast message session for 0x%05X. Source: %hu", parameterGroupNumber, source->get_address());
+				if (added)
+				{
+					update_state_machine(newSession);
+					LOG_DEBUG("[TP]: New rx broadcast message session for 0x%05X. Source: %hu", parameterGroupNumber, source->get_address());
+				}
+				else
+				{
+					LOG_ERROR("[TP]: Ignoring Broadcast Announcement Message (BAM) for 0x%05X, a session for this source was started at the same time.", parameterGroupNumber);
+					close_session(newSession, false);
+				}
 			}
 		}
 	}
@@ -220,8 +232,6 @@ namespace isobus
 				}
 			}
 
-			auto data = std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize));
-
 			if (clearToSendPacketMax > configuration->get_number_of_packets_per_cts_message())
 			{
 				LOG_DEBUG("[TP]: Received Request To Send (RTS) with a CTS packet count of %hu, which is greater than the configured maximum of %hu, using the configured maximum instead.",
@@ -230,15 +240,15 @@ namespace isobus
 				clearToSendPacketMax = configuration->get_number_of_packets_per_cts_message();
 			}
 
-			auto newSession = std::make_shared<TransportProtocolSession>(TransportProtocolSession::Direction::Receive,
-			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
-			                                                             parameterGroupNumber,
-			                                                             totalMessageSize,
-			                                                             clearToSendPacketMax,
-			                                                             source,
-			                                                             destination,
-			                                                             nullptr, // No callback
-			                                                             nullptr);
+			auto newSession = activeSessions.create(TransportProtocolSession::Direction::Receive,
+			                                        std::unique_ptr<CANMessageData>(new CANMessageDataVector(receiveBufferPool.acquire(totalMessageSize))),
+			                                        parameterGroupNumber,
+			                                        totalMessageSize,
+			                                        clearToSendPacketMax,
+			                                        source,
+			                                        destination,
+			                                        nullptr, // No callback
+			                                        nullptr);
 
 			if (newSession->get_total_number_of_packets() != totalNumberOfPackets)
 			{
@@ -249,13 +259,22 @@ namespace isobus
 			{
 				newSession->set_state(StateMachineState::SendClearToSend);
 
+				bool added;
 				{
 					std::lock_guard<std::mutex> lock(activeSessionsMutex);
-					activeSessions.push_back(newSession);
+					added = activeSessions.insert(newSession);
 				}
 
-				LOG_DEBUG("[TP]: New rx session for 0x%05X. Source: %hu, destination: %hu", parameterGroupNumber, source->get_address(), destination->get_address());
-				update_state_machine(newSession);
+				if (added)
+				{
+					LOG_DEBUG("[TP]: New rx session for 0x%05X. Source: %hu, destination: %hu", parameterGroupNumber, source->get_address(), destination->get_address());
+					update_state_machine(newSession);
+				}
+				else
+				{
+					LOG_ERROR("[TP]: Received Request To Send (RTS) for 0x%05X while a session for this source and destination was started at the same time, aborting...", parameterGroupNumber);
+					abort_session(newSession, ConnectionAbortReason::AlreadyInCMSession);
+				}
 			}
 		}
 	}
@@ -483,7 +502,7 @@ namespace isobus
 			return;
 		}
 
-		auto source = message.get_source_control_function();
+		const auto &source = message.get_source_control_function();
 		auto destination = message.is_broadcast() ? nullptr : message.get_destination_control_function();
 
 		auto sequenceNumber = message.get_uint8_at(SEQUENCE_NUMBER_DATA_INDEX);
@@ -536,14 +555,18 @@ namespace isobus
 					                         CANIdentifier::CANPriority::PriorityDefault6,
 					                         session->is_broadcast() ? CANIdentifier::GLOBAL_ADDRESS : destination->get_address(),
 					                         source->get_address());
-					CANMessage completedMessage(CANMessage::Type::Receive,
-					                            identifier,
-					                            std::move(data),
-					                            source,
-					                            destination,
-					                            0);
+					// A payload that fits inline is copied straight out of the session buffer, which stays in the session
+					// and goes back to the pool when it's closed. A larger message takes over the buffer instead.
+					const bool storedInline = (data.size() <= CAN_MESSAGE_INLINE_DATA_LENGTH);
+					CANMessage completedMessage = storedInline ?
+					  CANMessage(CANMessage::Type::Receive, identifier, data.data().begin(), static_cast<std::uint32_t>(data.size()), source, destination, 0) :
+					  CANMessage(CANMessage::Type::Receive, identifier, std::move(data), source, destination, 0);
 
 					canMessageReceivedCallback(completedMessage);
+					if (!storedInline)
+					{
+						receiveBufferPool.release(completedMessage.release_data());
+					}
 					close_session(session, true);
 					LOG_DEBUG("[TP]: Completed rx session for 0x%05X from %hu", session->get_parameter_group_number(), source->get_address());
 				}
@@ -612,15 +635,15 @@ namespace isobus
 		data = data->copy_if_not_owned(std::move(data));
 		auto dataLength = static_cast<std::uint16_t>(data->size());
 
-		auto session = std::make_shared<TransportProtocolSession>(TransportProtocolSession::Direction::Transmit,
-		                                                          std::move(data),
-		                                                          parameterGroupNumber,
-		                                                          dataLength,
-		                                                          configuration->get_number_of_packets_per_cts_message(),
-		                                                          source,
-		                                                          destination,
-		                                                          sessionCompleteCallback,
-		                                                          parentPointer);
+		auto session = activeSessions.create(TransportProtocolSession::Direction::Transmit,
+		                                     std::move(data),
+		                                     parameterGroupNumber,
+		                                     dataLength,
+		                                     configuration->get_number_of_packets_per_cts_message(),
+		                                     source,
+		                                     destination,
+		                                     sessionCompleteCallback,
+		                                     parentPointer);
 
 		if (session->is_broadcast())
 		{
@@ -642,7 +665,11 @@ namespace isobus
 
 		{
 			std::lock_guard<std::mutex> lock(activeSessionsMutex);
-			activeSessions.push_back(session);
+			if (!activeSessions.insert(session))
+			{
+				LOG_ERROR("[TP]: Unable to send 0x%05X, a session for this source and destination was started at the same time.", parameterGroupNumber);
+				return false;
+			}
 		}
 
 		update_state_machine(session);
@@ -651,6 +678,7 @@ namespace isobus
 
 	void TransportProtocolManager::update()
 	{
+		dataTransferSchedule.clear();
 		for (auto &session : get_sessions())
 		{
 			if (!session->get_source()->get_address_valid())
@@ -666,57 +694,47 @@ namespace isobus
 			else if (StateMachineState::None != session->state)
 			{
 				update_state_machine(session);
+
+				if (is_ready_to_send_data_transfer_packet(session))
+				{
+					dataTransferSchedule.push_back(session);
+				}
 			}
 		}
+		send_scheduled_data_transfer_packets();
 	}
 
-	void TransportProtocolManager::send_data_transfer_packets(const std::shared_ptr<TransportProtocolSession> &session)
+	bool TransportProtocolManager::send_data_transfer_packet(const std::shared_ptr<TransportProtocolSession> &session)
 	{
 		std::array<std::uint8_t, CAN_DATA_LENGTH> buffer;
-		std::uint8_t framesToSend = session->get_cts_number_of_packets_remaining();
-		if (session->is_broadcast())
-		{
-			framesToSend = 1;
-		}
-		else if (framesToSend > configuration->get_max_number_of_network_manager_protocol_frames_per_update())
-		{
-			framesToSend = configuration->get_max_number_of_network_manager_protocol_frames_per_update();
-		}
+		bool retVal = false;
 
-		// Try and send packets
-		for (std::uint8_t i = 0; i < framesToSend; i++)
-		{
-			buffer[0] = session->get_last_sequence_number() + 1;
+		buffer[0] = session->get_last_sequence_number() + 1;
 
-			std::uint16_t dataOffset = session->get_last_packet_number() * PROTOCOL_BYTES_PER_FRAME;
-			for (std::uint8_t j = 0; j < PROTOCOL_BYTES_PER_FRAME; j++)
-			{
-				std::uint16_t index = dataOffset + j;
-				if (index < session->get_message_length())
-				{
-					buffer[1 + j] = session->get_data().get_byte(index);
-				}
-				else
-				{
-					buffer[1 + j] = 0xFF;
-				}
-			}
-
-			if (sendCANFrameCallback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::TransportProtocolDataTransfer),
-			                         CANDataSpan(buffer.data(), buffer.size()),
-			                         std::static_pointer_cast<InternalControlFunction>(session->get_source()),
-			                         session->get_destination(),
-			                         CANIdentifier::CANPriority::PriorityLowest7))
+		std::uint16_t dataOffset = session->get_last_packet_number() * PROTOCOL_BYTES_PER_FRAME;
+		for (std::uint8_t j = 0; j < PROTOCOL_BYTES_PER_FRAME; j++)
+		{
+			std::uint16_t index = dataOffset + j;
+			if (index < session->get_message_length())
 			{
-				session->set_last_sequency_number(session->get_last_sequence_number() + 1);
+				buffer[1 + j] = session->get_data().get_byte(index);
 			}
 			else
 			{
-				// Process more next time protocol is updated
-				break;
+				buffer[1 + j] = 0xFF;
 			}
 		}
 
+		if (sendCANFrameCallback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::TransportProtocolDataTransfer),
+		                         CANDataSpan(buffer.data(), buffer.size()),
+		                         std::static_pointer_cast<InternalControlFunction>(session->get_source()),
+		                         session->get_destination(),
+		                         CANIdentifier::CANPriority::PriorityLowest7))
+		{
+			session->set_last_sequency_number(session->get_last_sequence_number() + 1);
+			retVal = true;
+		}
+
 		if (session->get_number_of_remaining_packets() == 0)
 		{
 			if (session->is_broadcast())
@@ -733,6 +751,65 @@ namespace isobus
 		{
 			session->set_state(StateMachineState::WaitForClearToSend);
 		}
+		return retVal;
+	}
+
+	bool TransportProtocolManager::is_ready_to_send_data_transfer_packet(const std::shared_ptr<TransportProtocolSession> &session) const
+	{
+		bool retVal = false;
+
+		if (StateMachineState::SendDataTransferPackets == session->state)
+		{
+			if (session->is_broadcast())
+			{
+				retVal = (session->get_time_since_last_update() >= configuration->get_minimum_time_between_transport_protocol_bam_frames());
+			}
+			else
+			{
+				retVal = (session->get_time_since_last_update() >= configuration->get_minimum_time_between_transport_protocol_data_frames());
+			}
+		}
+		return retVal;
+	}
+
+	void TransportProtocolManager::send_scheduled_data_transfer_packets()
+	{
+		std::uint8_t framesRemaining = configuration->get_max_number_of_network_manager_protocol_frames_per_update();
+
+		if (!dataTransferSchedule.empty())
+		{
+			dataTransferRoundRobinOffset = (dataTransferRoundRobinOffset + 1) % dataTransferSchedule.size();
+			std::rotate(dataTransferSchedule.begin(), dataTransferSchedule.begin() + dataTransferRoundRobinOffset, dataTransferSchedule.end());
+		}
+
+		while ((framesRemaining > 0) && (!dataTransferSchedule.empty()))
+		{
+			// Each session sends one packet per round, and stays in the schedule only if it can send another one right away
+			std::size_t numberOfScheduledSessions = 0;
+			for (std::size_t i = 0; (i < dataTransferSchedule.size()) && (framesRemaining > 0); i++)
+			{
+				const auto &session = dataTransferSchedule[i];
+				bool keepScheduled = false;
+
+				if (send_data_transfer_packet(session))
+				{
+					framesRemaining--;
+					keepScheduled = (StateMachineState::SendDataTransferPackets == session->state) &&
+					  !session->is_broadcast() &&
+					  (0 == configuration->get_minimum_time_between_transport_protocol_data_frames());
+				}
+
+				if (keepScheduled)
+				{
+					if (numberOfScheduledSessions != i)
+					{
+						dataTransferSchedule[numberOfScheduledSessions] = session;
+					}
+					numberOfScheduledSessions++;
+				}
+			}
+			dataTransferSchedule.resize(numberOfScheduledSessions);
+		}
 	}
 
 	void TransportProtocolManager::update_state_machine(std::shared_ptr<TransportProtocolSession> &session)
@@ -790,14 +867,7 @@ namespace isobus
 
 			case StateMachineState::SendDataTransferPackets:
 			{
-				if (session->is_broadcast() && (session->get_time_since_last_update() < configuration->get_minimum_time_between_transport_protocol_bam_frames()))
-				{
-					// Need to wait before sending the next data frame of the broadcast session
-				}
-				else
-				{
-					send_data_transfer_packets(session);
-				}
+				// Data transfer packets are sent at the end of each update, interleaved with other sessions
 			}
 			break;
 
@@ -895,11 +965,15 @@ namespace isobus
 	{
 		session->complete(successful);
 
+		if (TransportProtocolSession::Direction::Receive == session->get_direction())
+		{
+			// Receive sessions always reassemble into a buffer from the pool. If the message was not completed it's still here.
+			receiveBufferPool.release(std::move(static_cast<CANMessageDataVector &>(session->get_data())));
+		}
+
 		std::lock_guard<std::mutex> lock(activeSessionsMutex);
-		auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
-		if (activeSessions.end() != sessionLocation)
+		if (activeSessions.erase(session))
 		{
-			activeSessions.erase(sessionLocation);
 			LOG_DEBUG("[TP]: Session Closed");
 		}
 	}
@@ -1007,19 +1081,14 @@ namespace isobus
 	bool TransportProtocolManager::has_session(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
 		std::lock_guard<std::mutex> lock(activeSessionsMutex);
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<TransportProtocolManager::TransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
+		return (nullptr != activeSessions.find(source, destination));
 	}
 
-	std::shared_ptr<TransportProtocolManager::TransportProtocolSession> TransportProtocolManager::get_session(std::shared_ptr<ControlFunction> source,
-	                                                                                                          std::shared_ptr<ControlFunction> destination)
+	std::shared_ptr<TransportProtocolManager::TransportProtocolSession> TransportProtocolManager::get_session(const std::shared_ptr<ControlFunction> &source,
+	                                                                                                          const std::shared_ptr<ControlFunction> &destination)
 	{
 		std::lock_guard<std::mutex> lock(activeSessionsMutex);
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<TransportProtocolManager::TransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		return activeSessions.find(source, destination);
 	}
 
 	std::size_t TransportProtocolManager::get_sessions_count() const
@@ -1028,9 +1097,14 @@ namespace isobus
 		return activeSessions.size();
 	}
 
+	const CANMessageBufferPool &TransportProtocolManager::get_receive_buffer_pool() const
+	{
+		return receiveBufferPool;
+	}
+
 	std::list<std::shared_ptr<TransportProtocolManager::TransportProtocolSession>> TransportProtocolManager::get_sessions() const
 	{
 		std::lock_guard<std::mutex> lock(activeSessionsMutex);
-		return activeSessions;
+		return std::list<std::shared_ptr<TransportProtocolSession>>(activeSessions.get_sessions().begin(), activeSessions.get_sessions().end());
 	}
 }
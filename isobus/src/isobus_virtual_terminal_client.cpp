@@ -11,17 +11,20 @@
 #include "isobus/isobus/can_general_parameter_group_numbers.hpp"
 #include "isobus/isobus/can_network_manager.hpp"
 #include "isobus/isobus/can_stack_logger.hpp"
+#include "isobus/utility/iop_file_interface.hpp"
 #include "isobus/utility/platform_endianness.hpp"
 #include "isobus/utility/system_timing.hpp"
 #include "isobus/utility/to_string.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
 #include <cstring>
 #include <functional>
 #include <limits>
 #include <map>
 #include <unordered_map>
+#include <utility>
 
 namespace isobus
 {
@@ -265,66 +268,66 @@ namespace isobus
 
 	bool VirtualTerminalClient::send_hide_show_object(std::uint16_t objectID, HideShowObjectCommand command)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::HideShowObjectCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(command),
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::HideShowObjectCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(command),
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_enable_disable_object(std::uint16_t objectID, EnableDisableObjectCommand command)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::EnableDisableObjectCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(command),
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::EnableDisableObjectCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(command),
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_select_input_object(std::uint16_t objectID, SelectInputObjectOptions option)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::SelectInputObjectCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(option),
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::SelectInputObjectCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(option),
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_ESC()
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ESCCommand),
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ESCCommand),
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_control_audio_signal(std::uint8_t activations, std::uint16_t frequency_hz, std::uint16_t duration_ms, std::uint16_t offTimeDuration_ms)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ControlAudioSignalCommand),
-			                                         activations,
-			                                         static_cast<std::uint8_t>(frequency_hz & 0xFF),
-			                                         static_cast<std::uint8_t>(frequency_hz >> 8),
-			                                         static_cast<std::uint8_t>(duration_ms & 0xFF),
-			                                         static_cast<std::uint8_t>(duration_ms >> 8),
-			                                         static_cast<std::uint8_t>(offTimeDuration_ms & 0xFF),
-			                                         static_cast<std::uint8_t>(offTimeDuration_ms >> 8) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ControlAudioSignalCommand),
+			                                                         activations,
+			                                                         static_cast<std::uint8_t>(frequency_hz & 0xFF),
+			                                                         static_cast<std::uint8_t>(frequency_hz >> 8),
+			                                                         static_cast<std::uint8_t>(duration_ms & 0xFF),
+			                                                         static_cast<std::uint8_t>(duration_ms >> 8),
+			                                                         static_cast<std::uint8_t>(offTimeDuration_ms & 0xFF),
+			                                                         static_cast<std::uint8_t>(offTimeDuration_ms >> 8) };
 		return queue_command(buffer, true);
 	}
 
@@ -338,33 +341,33 @@ namespace isobus
 			LOG_WARNING("[VT]: Cannot try to set audio volume greater than 100 percent. Value will be capped at 100.");
 		}
 
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::SetAudioVolumeCommand),
-			                                         volume_percent,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::SetAudioVolumeCommand),
+			                                                         volume_percent,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_child_location(std::uint16_t objectID, std::uint16_t parentObjectID, std::uint8_t relativeXPositionChange, std::uint8_t relativeYPositionChange)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeChildLocationCommand),
-			                                         static_cast<std::uint8_t>(parentObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(parentObjectID >> 8),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         relativeXPositionChange,
-			                                         relativeYPositionChange,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeChildLocationCommand),
+			                                                         static_cast<std::uint8_t>(parentObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(parentObjectID >> 8),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         relativeXPositionChange,
+			                                                         relativeYPositionChange,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_child_position(std::uint16_t objectID, std::uint16_t parentObjectID, std::uint16_t xPosition, std::uint16_t yPosition)
 	{
-		const std::vector<std::uint8_t> buffer = {
+		const std::array<std::uint8_t, 9> buffer = {
 			static_cast<std::uint8_t>(Function::ChangeChildPositionCommand),
 			static_cast<std::uint8_t>(parentObjectID & 0xFF),
 			static_cast<std::uint8_t>(parentObjectID >> 8),
@@ -380,33 +383,33 @@ namespace isobus
 
 	bool VirtualTerminalClient::send_change_size_command(std::uint16_t objectID, std::uint16_t newWidth, std::uint16_t newHeight)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeSizeCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(newWidth & 0xFF),
-			                                         static_cast<std::uint8_t>(newWidth >> 8),
-			                                         static_cast<std::uint8_t>(newHeight & 0xFF),
-			                                         static_cast<std::uint8_t>(newHeight >> 8),
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeSizeCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(newWidth & 0xFF),
+			                                                         static_cast<std::uint8_t>(newWidth >> 8),
+			                                                         static_cast<std::uint8_t>(newHeight & 0xFF),
+			                                                         static_cast<std::uint8_t>(newHeight >> 8),
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_background_colour(std::uint16_t objectID, std::uint8_t colour)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeBackgroundColourCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         colour,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeBackgroundColourCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         colour,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_numeric_value(std::uint16_t objectID, std::uint32_t value)
 	{
-		const std::vector<std::uint8_t> buffer = {
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = {
 			static_cast<std::uint8_t>(Function::ChangeNumericValueCommand),
 			static_cast<std::uint8_t>(objectID & 0xFF),
 			static_cast<std::uint8_t>(objectID >> 8),
@@ -441,7 +444,7 @@ namespace isobus
 			{
 				buffer.push_back(0xFF); // Pad to minimum length
 			}
-			retVal = queue_command(buffer, true);
+			retVal = queue_command(std::move(buffer), true);
 		}
 		return retVal;
 	}
@@ -454,92 +457,92 @@ namespace isobus
 
 	bool VirtualTerminalClient::send_change_endpoint(std::uint16_t objectID, std::uint16_t width_px, std::uint16_t height_px, LineDirection direction)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeEndPointCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(width_px & 0xFF),
-			                                         static_cast<std::uint8_t>(width_px >> 8),
-			                                         static_cast<std::uint8_t>(height_px & 0xFF),
-			                                         static_cast<std::uint8_t>(height_px >> 8),
-			                                         static_cast<std::uint8_t>(direction) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeEndPointCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(width_px & 0xFF),
+			                                                         static_cast<std::uint8_t>(width_px >> 8),
+			                                                         static_cast<std::uint8_t>(height_px & 0xFF),
+			                                                         static_cast<std::uint8_t>(height_px >> 8),
+			                                                         static_cast<std::uint8_t>(direction) };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_font_attributes(std::uint16_t objectID, std::uint8_t colour, FontSize size, std::uint8_t type, std::uint8_t styleBitfield)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeFontAttributesCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         colour,
-			                                         static_cast<std::uint8_t>(size),
-			                                         type,
-			                                         styleBitfield,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeFontAttributesCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         colour,
+			                                                         static_cast<std::uint8_t>(size),
+			                                                         type,
+			                                                         styleBitfield,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_line_attributes(std::uint16_t objectID, std::uint8_t colour, std::uint8_t width, std::uint16_t lineArtBitmask)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeLineAttributesCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         colour,
-			                                         static_cast<std::uint8_t>(width),
-			                                         static_cast<std::uint8_t>(lineArtBitmask & 0xFF),
-			                                         static_cast<std::uint8_t>(lineArtBitmask >> 8),
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeLineAttributesCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         colour,
+			                                                         static_cast<std::uint8_t>(width),
+			                                                         static_cast<std::uint8_t>(lineArtBitmask & 0xFF),
+			                                                         static_cast<std::uint8_t>(lineArtBitmask >> 8),
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_fill_attributes(std::uint16_t objectID, FillType fillType, std::uint8_t colour, std::uint16_t fillPatternObjectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeFillAttributesCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(fillType),
-			                                         colour,
-			                                         static_cast<std::uint8_t>(fillPatternObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(fillPatternObjectID >> 8),
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeFillAttributesCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(fillType),
+			                                                         colour,
+			                                                         static_cast<std::uint8_t>(fillPatternObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(fillPatternObjectID >> 8),
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_active_mask(std::uint16_t workingSetObjectID, std::uint16_t newActiveMaskObjectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeActiveMaskCommand),
-			                                         static_cast<std::uint8_t>(workingSetObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(workingSetObjectID >> 8),
-			                                         static_cast<std::uint8_t>(newActiveMaskObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(newActiveMaskObjectID >> 8),
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeActiveMaskCommand),
+			                                                         static_cast<std::uint8_t>(workingSetObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(workingSetObjectID >> 8),
+			                                                         static_cast<std::uint8_t>(newActiveMaskObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(newActiveMaskObjectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_softkey_mask(MaskType type, std::uint16_t dataOrAlarmMaskObjectID, std::uint16_t newSoftKeyMaskObjectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeSoftKeyMaskCommand),
-			                                         static_cast<std::uint8_t>(type),
-			                                         static_cast<std::uint8_t>(dataOrAlarmMaskObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(dataOrAlarmMaskObjectID >> 8),
-			                                         static_cast<std::uint8_t>(newSoftKeyMaskObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(newSoftKeyMaskObjectID >> 8),
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeSoftKeyMaskCommand),
+			                                                         static_cast<std::uint8_t>(type),
+			                                                         static_cast<std::uint8_t>(dataOrAlarmMaskObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(dataOrAlarmMaskObjectID >> 8),
+			                                                         static_cast<std::uint8_t>(newSoftKeyMaskObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(newSoftKeyMaskObjectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_attribute(std::uint16_t objectID, std::uint8_t attributeID, std::uint32_t value)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeAttributeCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         attributeID,
-			                                         static_cast<std::uint8_t>(value & 0xFF),
-			                                         static_cast<std::uint8_t>((value >> 8) & 0xFF),
-			                                         static_cast<std::uint8_t>((value >> 16) & 0xFF),
-			                                         static_cast<std::uint8_t>((value >> 24) & 0xFF) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeAttributeCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         attributeID,
+			                                                         static_cast<std::uint8_t>(value & 0xFF),
+			                                                         static_cast<std::uint8_t>((value >> 8) & 0xFF),
+			                                                         static_cast<std::uint8_t>((value >> 16) & 0xFF),
+			                                                         static_cast<std::uint8_t>((value >> 24) & 0xFF) };
 		return queue_command(buffer, true);
 	}
 
@@ -550,288 +553,288 @@ namespace isobus
 
 	bool VirtualTerminalClient::send_change_priority(std::uint16_t alarmMaskObjectID, AlarmMaskPriority priority)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangePriorityCommand),
-			                                         static_cast<std::uint8_t>(alarmMaskObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(alarmMaskObjectID >> 8),
-			                                         static_cast<std::uint8_t>(priority),
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangePriorityCommand),
+			                                                         static_cast<std::uint8_t>(alarmMaskObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(alarmMaskObjectID >> 8),
+			                                                         static_cast<std::uint8_t>(priority),
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_list_item(std::uint16_t objectID, std::uint8_t listIndex, std::uint16_t newObjectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeListItemCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         listIndex,
-			                                         static_cast<std::uint8_t>(newObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(newObjectID >> 8),
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeListItemCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         listIndex,
+			                                                         static_cast<std::uint8_t>(newObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(newObjectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_lock_unlock_mask(MaskLockState state, std::uint16_t objectID, std::uint16_t timeout_ms)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::LockUnlockMaskCommand),
-			                                         static_cast<std::uint8_t>(state),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(timeout_ms & 0xFF),
-			                                         static_cast<std::uint8_t>(timeout_ms >> 8),
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::LockUnlockMaskCommand),
+			                                                         static_cast<std::uint8_t>(state),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(timeout_ms & 0xFF),
+			                                                         static_cast<std::uint8_t>(timeout_ms >> 8),
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer);
 	}
 
 	bool VirtualTerminalClient::send_execute_macro(std::uint16_t objectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ExecuteMacroCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ExecuteMacroCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer);
 	}
 
 	bool VirtualTerminalClient::send_change_object_label(std::uint16_t objectID, std::uint16_t labelStringObjectID, std::uint8_t fontType, std::uint16_t graphicalDesignatorObjectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangeObjectLabelCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(labelStringObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(labelStringObjectID >> 8),
-			                                         fontType,
-			                                         static_cast<std::uint8_t>(graphicalDesignatorObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(graphicalDesignatorObjectID >> 8) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangeObjectLabelCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(labelStringObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(labelStringObjectID >> 8),
+			                                                         fontType,
+			                                                         static_cast<std::uint8_t>(graphicalDesignatorObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(graphicalDesignatorObjectID >> 8) };
 		return queue_command(buffer);
 	}
 
 	bool VirtualTerminalClient::send_change_polygon_point(std::uint16_t objectID, std::uint8_t pointIndex, std::uint16_t newXValue, std::uint16_t newYValue)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangePolygonPointCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         pointIndex,
-			                                         static_cast<std::uint8_t>(newXValue & 0xFF),
-			                                         static_cast<std::uint8_t>(newXValue >> 8),
-			                                         static_cast<std::uint8_t>(newYValue & 0xFF),
-			                                         static_cast<std::uint8_t>(newYValue >> 8) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangePolygonPointCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         pointIndex,
+			                                                         static_cast<std::uint8_t>(newXValue & 0xFF),
+			                                                         static_cast<std::uint8_t>(newXValue >> 8),
+			                                                         static_cast<std::uint8_t>(newYValue & 0xFF),
+			                                                         static_cast<std::uint8_t>(newYValue >> 8) };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_change_polygon_scale(std::uint16_t objectID, std::uint16_t widthAttribute, std::uint16_t heightAttribute)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ChangePolygonScaleCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(widthAttribute & 0xFF),
-			                                         static_cast<std::uint8_t>(widthAttribute >> 8),
-			                                         static_cast<std::uint8_t>(heightAttribute & 0xFF),
-			                                         static_cast<std::uint8_t>(heightAttribute >> 8),
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ChangePolygonScaleCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(widthAttribute & 0xFF),
+			                                                         static_cast<std::uint8_t>(widthAttribute >> 8),
+			                                                         static_cast<std::uint8_t>(heightAttribute & 0xFF),
+			                                                         static_cast<std::uint8_t>(heightAttribute >> 8),
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_select_colour_map_or_palette(std::uint16_t objectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::SelectColourMapCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::SelectColourMapCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_execute_extended_macro(std::uint16_t objectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::ExecuteExtendedMacroCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::ExecuteExtendedMacroCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer);
 	}
 
 	bool VirtualTerminalClient::send_select_active_working_set(std::uint64_t NAMEofWorkingSetMasterForDesiredWorkingSet)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::SelectActiveWorkingSet),
-			                                         static_cast<std::uint8_t>(NAMEofWorkingSetMasterForDesiredWorkingSet & 0xFF),
-			                                         static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 8) & 0xFF),
-			                                         static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 16) & 0xFF),
-			                                         static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 24) & 0xFF),
-			                                         static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 32) & 0xFF),
-			                                         static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 40) & 0xFF),
-			                                         static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 48) & 0xFF),
-			                                         static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 56) & 0xFF) };
+		const std::array<std::uint8_t, 9> buffer = { static_cast<std::uint8_t>(Function::SelectActiveWorkingSet),
+			                                           static_cast<std::uint8_t>(NAMEofWorkingSetMasterForDesiredWorkingSet & 0xFF),
+			                                           static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 8) & 0xFF),
+			                                           static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 16) & 0xFF),
+			                                           static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 24) & 0xFF),
+			                                           static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 32) & 0xFF),
+			                                           static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 40) & 0xFF),
+			                                           static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 48) & 0xFF),
+			                                           static_cast<std::uint8_t>((NAMEofWorkingSetMasterForDesiredWorkingSet >> 56) & 0xFF) };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_set_graphics_cursor(std::uint16_t objectID, std::int16_t xPosition, std::int16_t yPosition)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetGraphicsCursor),
-			                                         static_cast<std::uint8_t>(xPosition & 0xFF),
-			                                         static_cast<std::uint8_t>(xPosition >> 8),
-			                                         static_cast<std::uint8_t>(yPosition & 0xFF),
-			                                         static_cast<std::uint8_t>(yPosition >> 8) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetGraphicsCursor),
+			                                                         static_cast<std::uint8_t>(xPosition & 0xFF),
+			                                                         static_cast<std::uint8_t>(xPosition >> 8),
+			                                                         static_cast<std::uint8_t>(yPosition & 0xFF),
+			                                                         static_cast<std::uint8_t>(yPosition >> 8) };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_move_graphics_cursor(std::uint16_t objectID, std::int16_t xOffset, std::int16_t yOffset)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::MoveGraphicsCursor),
-			                                         static_cast<std::uint8_t>(xOffset & 0xFF),
-			                                         static_cast<std::uint8_t>(xOffset >> 8),
-			                                         static_cast<std::uint8_t>(yOffset & 0xFF),
-			                                         static_cast<std::uint8_t>(yOffset >> 8) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::MoveGraphicsCursor),
+			                                                         static_cast<std::uint8_t>(xOffset & 0xFF),
+			                                                         static_cast<std::uint8_t>(xOffset >> 8),
+			                                                         static_cast<std::uint8_t>(yOffset & 0xFF),
+			                                                         static_cast<std::uint8_t>(yOffset >> 8) };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_set_foreground_colour(std::uint16_t objectID, std::uint8_t colour)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetForegroundColour),
-			                                         colour,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetForegroundColour),
+			                                                         colour,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_set_background_colour(std::uint16_t objectID, std::uint8_t colour)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetBackgroundColour),
-			                                         colour,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetBackgroundColour),
+			                                                         colour,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_set_line_attributes_object_id(std::uint16_t objectID, std::uint16_t lineAttributesObjectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetLineAttributesObjectID),
-			                                         static_cast<std::uint8_t>(lineAttributesObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(lineAttributesObjectID >> 8),
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetLineAttributesObjectID),
+			                                                         static_cast<std::uint8_t>(lineAttributesObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(lineAttributesObjectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_set_fill_attributes_object_id(std::uint16_t objectID, std::uint16_t fillAttributesObjectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetFillAttributesObjectID),
-			                                         static_cast<std::uint8_t>(fillAttributesObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(fillAttributesObjectID >> 8),
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetFillAttributesObjectID),
+			                                                         static_cast<std::uint8_t>(fillAttributesObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(fillAttributesObjectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_set_font_attributes_object_id(std::uint16_t objectID, std::uint16_t fontAttributesObjectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetFontAttributesObjectID),
-			                                         static_cast<std::uint8_t>(fontAttributesObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(fontAttributesObjectID >> 8),
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::SetFontAttributesObjectID),
+			                                                         static_cast<std::uint8_t>(fontAttributesObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(fontAttributesObjectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_erase_rectangle(std::uint16_t objectID, std::uint16_t width, std::uint16_t height)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::EraseRectangle),
-			                                         static_cast<std::uint8_t>(width & 0xFF),
-			                                         static_cast<std::uint8_t>(width >> 8),
-			                                         static_cast<std::uint8_t>(height & 0xFF),
-			                                         static_cast<std::uint8_t>(height >> 8) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::EraseRectangle),
+			                                                         static_cast<std::uint8_t>(width & 0xFF),
+			                                                         static_cast<std::uint8_t>(width >> 8),
+			                                                         static_cast<std::uint8_t>(height & 0xFF),
+			                                                         static_cast<std::uint8_t>(height >> 8) };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_draw_point(std::uint16_t objectID, std::int16_t xOffset, std::int16_t yOffset)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::DrawPoint),
-			                                         static_cast<std::uint8_t>(xOffset & 0xFF),
-			                                         static_cast<std::uint8_t>(xOffset >> 8),
-			                                         static_cast<std::uint8_t>(yOffset & 0xFF),
-			                                         static_cast<std::uint8_t>(yOffset >> 8) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::DrawPoint),
+			                                                         static_cast<std::uint8_t>(xOffset & 0xFF),
+			                                                         static_cast<std::uint8_t>(xOffset >> 8),
+			                                                         static_cast<std::uint8_t>(yOffset & 0xFF),
+			                                                         static_cast<std::uint8_t>(yOffset >> 8) };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_draw_line(std::uint16_t objectID, std::int16_t xOffset, std::int16_t yOffset)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::DrawLine),
-			                                         static_cast<std::uint8_t>(xOffset & 0xFF),
-			                                         static_cast<std::uint8_t>(xOffset >> 8),
-			                                         static_cast<std::uint8_t>(yOffset & 0xFF),
-			                                         static_cast<std::uint8_t>(yOffset >> 8) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::DrawLine),
+			                                                         static_cast<std::uint8_t>(xOffset & 0xFF),
+			                                                         static_cast<std::uint8_t>(xOffset >> 8),
+			                                                         static_cast<std::uint8_t>(yOffset & 0xFF),
+			                                                         static_cast<std::uint8_t>(yOffset >> 8) };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_draw_rectangle(std::uint16_t objectID, std::uint16_t width, std::uint16_t height)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::DrawRectangle),
-			                                         static_cast<std::uint8_t>(width & 0xFF),
-			                                         static_cast<std::uint8_t>(width >> 8),
-			                                         static_cast<std::uint8_t>(height & 0xFF),
-			                                         static_cast<std::uint8_t>(height >> 8) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::DrawRectangle),
+			                                                         static_cast<std::uint8_t>(width & 0xFF),
+			                                                         static_cast<std::uint8_t>(width >> 8),
+			                                                         static_cast<std::uint8_t>(height & 0xFF),
+			                                                         static_cast<std::uint8_t>(height >> 8) };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_draw_closed_ellipse(std::uint16_t objectID, std::uint16_t width, std::uint16_t height)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::DrawClosedEllipse),
-			                                         static_cast<std::uint8_t>(width & 0xFF),
-			                                         static_cast<std::uint8_t>(width >> 8),
-			                                         static_cast<std::uint8_t>(height & 0xFF),
-			                                         static_cast<std::uint8_t>(height >> 8) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::DrawClosedEllipse),
+			                                                         static_cast<std::uint8_t>(width & 0xFF),
+			                                                         static_cast<std::uint8_t>(width >> 8),
+			                                                         static_cast<std::uint8_t>(height & 0xFF),
+			                                                         static_cast<std::uint8_t>(height >> 8) };
 		return queue_command(buffer, true);
 	}
 
@@ -859,7 +862,7 @@ namespace isobus
 				buffer[7 + i] = static_cast<std::uint8_t>(listOfYOffsetsRelativeToCursor[0] & 0xFF);
 				buffer[8 + i] = static_cast<std::uint8_t>((listOfYOffsetsRelativeToCursor[0] >> 8) & 0xFF);
 			}
-			retVal = queue_command(buffer, true);
+			retVal = queue_command(std::move(buffer), true);
 		}
 		return retVal;
 	}
@@ -886,21 +889,21 @@ namespace isobus
 			{
 				buffer.push_back(0xFF); // Pad short text to minimum message length
 			}
-			retVal = queue_command(buffer, true);
+			retVal = queue_command(std::move(buffer), true);
 		}
 		return retVal;
 	}
 
 	bool VirtualTerminalClient::send_pan_viewport(std::uint16_t objectID, std::int16_t xAttribute, std::int16_t yAttribute)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::PanViewport),
-			                                         static_cast<std::uint8_t>(xAttribute & 0xFF),
-			                                         static_cast<std::uint8_t>(xAttribute >> 8),
-			                                         static_cast<std::uint8_t>(yAttribute & 0xFF),
-			                                         static_cast<std::uint8_t>(yAttribute >> 8) };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::PanViewport),
+			                                                         static_cast<std::uint8_t>(xAttribute & 0xFF),
+			                                                         static_cast<std::uint8_t>(xAttribute >> 8),
+			                                                         static_cast<std::uint8_t>(yAttribute & 0xFF),
+			                                                         static_cast<std::uint8_t>(yAttribute >> 8) };
 		return queue_command(buffer, true);
 	}
 
@@ -915,14 +918,14 @@ namespace isobus
 			std::reverse(floatBytes.begin(), floatBytes.end());
 		}
 
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::ZoomViewport),
-			                                         floatBytes[0],
-			                                         floatBytes[1],
-			                                         floatBytes[2],
-			                                         floatBytes[3] };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::ZoomViewport),
+			                                                         floatBytes[0],
+			                                                         floatBytes[1],
+			                                                         floatBytes[2],
+			                                                         floatBytes[3] };
 		return queue_command(buffer, true);
 	}
 
@@ -937,18 +940,18 @@ namespace isobus
 			std::reverse(floatBytes.begin(), floatBytes.end());
 		}
 
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::PanAndZoomViewport),
-			                                         static_cast<std::uint8_t>(xAttribute & 0xFF),
-			                                         static_cast<std::uint8_t>(xAttribute >> 8),
-			                                         static_cast<std::uint8_t>(yAttribute & 0xFF),
-			                                         static_cast<std::uint8_t>(yAttribute >> 8),
-			                                         floatBytes[0],
-			                                         floatBytes[1],
-			                                         floatBytes[2],
-			                                         floatBytes[3] };
+		const std::array<std::uint8_t, 12> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                            static_cast<std::uint8_t>(objectID & 0xFF),
+			                                            static_cast<std::uint8_t>(objectID >> 8),
+			                                            static_cast<std::uint8_t>(GraphicsContextSubCommandID::PanAndZoomViewport),
+			                                            static_cast<std::uint8_t>(xAttribute & 0xFF),
+			                                            static_cast<std::uint8_t>(xAttribute >> 8),
+			                                            static_cast<std::uint8_t>(yAttribute & 0xFF),
+			                                            static_cast<std::uint8_t>(yAttribute >> 8),
+			                                            floatBytes[0],
+			                                            floatBytes[1],
+			                                            floatBytes[2],
+			                                            floatBytes[3] };
 		return queue_command(buffer, true);
 	}
 
@@ -960,14 +963,14 @@ namespace isobus
 		if ((width <= MAX_WIDTH_HEIGHT) &&
 		    (height <= MAX_WIDTH_HEIGHT))
 		{
-			const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-				                                         static_cast<std::uint8_t>(objectID & 0xFF),
-				                                         static_cast<std::uint8_t>(objectID >> 8),
-				                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::ChangeViewportSize),
-				                                         static_cast<std::uint8_t>(width & 0xFF),
-				                                         static_cast<std::uint8_t>(width >> 8),
-				                                         static_cast<std::uint8_t>(height & 0xFF),
-				                                         static_cast<std::uint8_t>(height >> 8) };
+			const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+				                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+				                                                         static_cast<std::uint8_t>(objectID >> 8),
+				                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::ChangeViewportSize),
+				                                                         static_cast<std::uint8_t>(width & 0xFF),
+				                                                         static_cast<std::uint8_t>(width >> 8),
+				                                                         static_cast<std::uint8_t>(height & 0xFF),
+				                                                         static_cast<std::uint8_t>(height >> 8) };
 			retVal = queue_command(buffer, true);
 		}
 		return retVal;
@@ -975,53 +978,53 @@ namespace isobus
 
 	bool VirtualTerminalClient::send_draw_vt_object(std::uint16_t graphicsContextObjectID, std::uint16_t objectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(graphicsContextObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(graphicsContextObjectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::DrawVTObject),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(graphicsContextObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(graphicsContextObjectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::DrawVTObject),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_copy_canvas_to_picture_graphic(std::uint16_t graphicsContextObjectID, std::uint16_t objectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(graphicsContextObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(graphicsContextObjectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::CopyCanvasToPictureGraphic),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(graphicsContextObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(graphicsContextObjectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::CopyCanvasToPictureGraphic),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_copy_viewport_to_picture_graphic(std::uint16_t graphicsContextObjectID, std::uint16_t objectID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
-			                                         static_cast<std::uint8_t>(graphicsContextObjectID & 0xFF),
-			                                         static_cast<std::uint8_t>(graphicsContextObjectID >> 8),
-			                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::CopyViewportToPictureGraphic),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GraphicsContextCommand),
+			                                                         static_cast<std::uint8_t>(graphicsContextObjectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(graphicsContextObjectID >> 8),
+			                                                         static_cast<std::uint8_t>(GraphicsContextSubCommandID::CopyViewportToPictureGraphic),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
 	bool VirtualTerminalClient::send_get_attribute_value(std::uint16_t objectID, std::uint8_t attributeID)
 	{
-		const std::vector<std::uint8_t> buffer = { static_cast<std::uint8_t>(Function::GetAttributeValueMessage),
-			                                         static_cast<std::uint8_t>(objectID & 0xFF),
-			                                         static_cast<std::uint8_t>(objectID >> 8),
-			                                         attributeID,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF,
-			                                         0xFF };
+		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::GetAttributeValueMessage),
+			                                                         static_cast<std::uint8_t>(objectID & 0xFF),
+			                                                         static_cast<std::uint8_t>(objectID >> 8),
+			                                                         attributeID,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF,
+			                                                         0xFF };
 		return queue_command(buffer, true);
 	}
 
@@ -1264,6 +1267,23 @@ namespace isobus
 		}
 	}
 
+	bool VirtualTerminalClient::set_object_pool_from_file(std::uint8_t poolIndex, const std::string &filePath, const std::string &version)
+	{
+		auto file = std::make_shared<MemoryMappedFile>();
+
+		if ((!file->open(filePath, MemoryMappedFile::Mode::ReadOnly)) ||
+		    (0 == file->size()) ||
+		    (file->size() > std::numeric_limits<std::uint32_t>::max()))
+		{
+			LOG_ERROR("[VT]: Failed to open object pool file %s", filePath.c_str());
+			return false;
+		}
+
+		set_object_pool(poolIndex, file->data(), static_cast<std::uint32_t>(file->size()), version);
+		objectPools[poolIndex].objectPoolFile = file;
+		return true;
+	}
+
 	void VirtualTerminalClient::set_object_pool_scaling(std::uint8_t poolIndex,
 	                                                    std::uint32_t originalDataMaskDimensions_px,
 	                                                    std::uint32_t originalSoftKyeDesignatorHeight_px)
@@ -1274,6 +1294,16 @@ namespace isobus
 		objectPools[poolIndex].autoScaleSoftKeyDesignatorOriginalHeight = originalSoftKyeDesignatorHeight_px;
 	}
 
+	void VirtualTerminalClient::set_object_pool_scaling_cache_directory(const std::string &directory)
+	{
+		objectPoolScalingCacheDirectory = directory;
+	}
+
+	void VirtualTerminalClient::set_keep_scaled_object_pools(bool keep)
+	{
+		keepScaledObjectPools = keep;
+	}
+
 	void VirtualTerminalClient::register_object_pool_data_chunk_callback(std::uint8_t poolIndex, std::uint32_t poolTotalSize, DataChunkCallback value, std::string version)
 	{
 		if ((nullptr != value) &&
@@ -1736,6 +1766,15 @@ namespace isobus
 		                                                      priority);
 	}
 
+	bool VirtualTerminalClient::send_message_to_vt(std::unique_ptr<CANMessageData> &data, CANIdentifier::CANPriority priority) const
+	{
+		return CANNetworkManager::CANNetwork.send_can_message(static_cast<std::uint32_t>(CANLibParameterGroupNumber::ECUtoVirtualTerminal),
+		                                                      data,
+		                                                      myControlFunction,
+		                                                      partnerControlFunction,
+		                                                      priority);
+	}
+
 	bool VirtualTerminalClient::send_delete_object_pool() const
 	{
 		constexpr std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(Function::DeleteObjectPoolCommand),
@@ -3051,10 +3090,15 @@ namespace isobus
 								if ((0 == errorCodes) &&
 								    (0 == objectPoolErrorBitmask))
 								{
-									// Clear scaling buffers
-									for (auto &objectPool : parentVT->objectPools)
+									if (!parentVT->keepScaledObjectPools)
 									{
-										objectPool.scaledObjectPool.clear();
+										// Clear scaling buffers
+										for (auto &objectPool : parentVT->objectPools)
+										{
+											objectPool.scaledObjectPool.clear();
+											objectPool.scaledObjectPool.shrink_to_fit();
+											objectPool.scaledObjectPoolValid = false;
+										}
 									}
 
 									// Check if we need to store this pool
@@ -3132,8 +3176,7 @@ namespace isobus
 							if ((parentVT->myControlFunction == message.get_destination_control_function()) &&
 							    (parentVT->partnerControlFunction == message.get_source_control_function()))
 							{
-								parentVT->commandAwaitingResponse = false;
-								parentVT->process_command_queue();
+								parentVT->on_command_response();
 							}
 						}
 						break;
@@ -3316,17 +3359,34 @@ namespace isobus
 				// We've got more data to transfer
 				if ((0 != parentVTClient->objectPools[poolIndex].autoScaleDataMaskOriginalDimension) && (0 != parentVTClient->objectPools[poolIndex].autoScaleSoftKeyDesignatorOriginalHeight))
 				{
-					// Object pool has been pre-scaled. Use the scaling buffer instead
-					retVal = true;
-					if (0 == bytesOffset)
+					if (nullptr != parentVTClient->objectPools[poolIndex].objectPoolFile)
 					{
-						chunkBuffer[0] = static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage);
-						memcpy(&chunkBuffer[1], &parentVTClient->objectPools[poolIndex].scaledObjectPool[bytesOffset], numberOfBytesNeeded - 1);
+						// Pools streamed from a file are scaled one object at a time
+						if (0 == bytesOffset)
+						{
+							chunkBuffer[0] = static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage);
+							retVal = parentVTClient->read_streamed_object_pool(parentVTClient->objectPools[poolIndex], 0, numberOfBytesNeeded - 1, &chunkBuffer[1]);
+						}
+						else
+						{
+							// Subtract off 1 to account for the mux in the first byte of the message
+							retVal = parentVTClient->read_streamed_object_pool(parentVTClient->objectPools[poolIndex], bytesOffset - 1, numberOfBytesNeeded, chunkBuffer);
+						}
 					}
 					else
 					{
-						// Subtract off 1 to account for the mux in the first byte of the message
-						memcpy(chunkBuffer, &parentVTClient->objectPools[poolIndex].scaledObjectPool[bytesOffset - 1], numberOfBytesNeeded);
+						// Object pool has been pre-scaled. Use the scaling buffer instead
+						retVal = true;
+						if (0 == bytesOffset)
+						{
+							chunkBuffer[0] = static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage);
+							memcpy(&chunkBuffer[1], &parentVTClient->objectPools[poolIndex].scaledObjectPool[bytesOffset], numberOfBytesNeeded - 1);
+						}
+						else
+						{
+							// Subtract off 1 to account for the mux in the first byte of the message
+							memcpy(chunkBuffer, &parentVTClient->objectPools[poolIndex].scaledObjectPool[bytesOffset - 1], numberOfBytesNeeded);
+						}
 					}
 				}
 				else
@@ -3388,152 +3448,343 @@ namespace isobus
 
 		for (auto &objectPool : objectPools)
 		{
-			// Step 1: Make a read/write copy of the pool
-			if (nullptr != objectPool.objectPoolDataPointer)
-			{
-				objectPool.scaledObjectPool.resize(objectPool.objectPoolSize);
-				memcpy(&objectPool.scaledObjectPool[0], objectPool.objectPoolDataPointer, objectPool.objectPoolSize);
-			}
-			else if (nullptr != objectPool.objectPoolVectorPointer)
+			if ((0 == objectPool.autoScaleDataMaskOriginalDimension) ||
+			    (0 == objectPool.autoScaleSoftKeyDesignatorOriginalHeight))
 			{
-				objectPool.scaledObjectPool.resize(objectPool.objectPoolVectorPointer->size());
-				std::copy(objectPool.objectPoolVectorPointer->begin(), objectPool.objectPoolVectorPointer->end(), objectPool.scaledObjectPool.begin());
+				// This pool is uploaded as it is
+				continue;
 			}
-			else if (objectPool.useDataCallback)
-			{
-				objectPool.scaledObjectPool.resize(objectPool.objectPoolSize);
-
-				for (std::uint32_t i = 0; i < objectPool.objectPoolSize; i++)
-				{
-					retVal &= objectPool.dataCallback(i, i, 1, &objectPool.scaledObjectPool[i], this);
-				}
 
-				if (!retVal)
+			if (nullptr != objectPool.objectPoolFile)
+			{
+				// Pools streamed from a file are scaled while they are uploaded, only the offsets of their objects are needed now
+				if ((objectPool.objectOffsets.empty()) &&
+				    (!find_object_offsets(objectPool.objectPoolDataPointer, objectPool.objectPoolSize, objectPool.objectOffsets)))
 				{
+					LOG_ERROR("[VT]: Object pool is malformed, the length of an object could not be determined");
+					retVal = false;
 					break;
 				}
+				objectPool.streamedObjectIndex = NO_STREAMED_OBJECT;
+				continue;
 			}
 
-			// Step 2, Parse the pool and resize each object as we iterate through it
-			auto poolIterator = objectPool.scaledObjectPool.begin();
+			// Pools from a callback can only be told apart by their version label, so without one they are always scaled again
+			const bool cacheable = (((!objectPool.useDataCallback) || (!objectPool.versionLabel.empty())) &&
+			                        (keepScaledObjectPools || (!objectPoolScalingCacheDirectory.empty())));
+			ObjectPoolScalingKey key = {};
+			std::string cacheFileName;
 
-			while ((poolIterator != objectPool.scaledObjectPool.end()) &&
-			       retVal)
+			objectPool.scaledObjectPoolValid = (objectPool.scaledObjectPoolValid && cacheable);
+			if (!cacheable)
 			{
-				if (VirtualTerminalObjectType::Key == static_cast<VirtualTerminalObjectType>(poolIterator[2]))
-				{
-					retVal &= resize_object(&poolIterator[0],
-					                        static_cast<float>(get_softkey_x_axis_pixels()) / static_cast<float>(objectPool.autoScaleSoftKeyDesignatorOriginalHeight),
-					                        static_cast<VirtualTerminalObjectType>(poolIterator[2]));
-				}
-				else
+				// Nothing identifies the pool, so it may have changed since its objects were found
+				objectPool.objectOffsets.clear();
+			}
+			else
+			{
+				key = get_object_pool_scaling_key(objectPool);
+				if (objectPool.scaledObjectPoolValid && (key == objectPool.scalingKey))
 				{
-					retVal &= resize_object(&poolIterator[0],
-					                        static_cast<float>(get_number_x_pixels()) / static_cast<float>(objectPool.autoScaleDataMaskOriginalDimension),
-					                        static_cast<VirtualTerminalObjectType>(poolIterator[2]));
+					LOG_DEBUG("[VT]: Reusing the pool that was scaled for this VT before");
+					continue;
 				}
+				objectPool.scaledObjectPoolValid = false;
 
-				std::uint32_t objectSize = get_number_bytes_in_object(&poolIterator[0]);
-				if (retVal)
+				if (!objectPoolScalingCacheDirectory.empty())
 				{
-					if (get_is_object_scalable(static_cast<VirtualTerminalObjectType>(*(poolIterator + 2))))
+					cacheFileName = get_scaled_object_pool_file_name(objectPoolScalingCacheDirectory, key);
+
+					std::vector<std::uint8_t> cachedPool = IOPFileInterface::read_iop_file(cacheFileName);
+					if (cachedPool.size() == objectPool.objectPoolSize)
 					{
-						LOG_DEBUG("[VT]: Resized an object: " +
-						          isobus::to_string(static_cast<int>((*poolIterator)) | (static_cast<int>((*poolIterator + 1))) << 8) +
-						          " with type " +
-						          isobus::to_string(static_cast<int>((*(poolIterator + 2)))) +
-						          " with size " +
-						          isobus::to_string(static_cast<int>(objectSize)));
+						LOG_DEBUG("[VT]: Loaded a pool that was scaled for this VT from %s", cacheFileName.c_str());
+						objectPool.scaledObjectPool.swap(cachedPool);
+						objectPool.scalingKey = key;
+						objectPool.scaledObjectPoolValid = true;
+						continue;
 					}
 				}
-				else
-				{
-					LOG_ERROR("[VT]: Failed to resize an object: " +
-					          isobus::to_string(static_cast<int>((*poolIterator)) | (static_cast<int>((*poolIterator + 1))) << 8) +
-					          " with type " +
-					          isobus::to_string(static_cast<int>((*poolIterator + 2))) +
-					          " with size " +
-					          isobus::to_string(static_cast<int>(objectSize)));
-				}
-				poolIterator += objectSize;
+			}
+
+			if ((!copy_object_pool_for_scaling(objectPool)) ||
+			    (!scale_object_pool(objectPool)))
+			{
+				retVal = false;
+				break;
+			}
+			objectPool.scalingKey = key;
+			objectPool.scaledObjectPoolValid = cacheable;
+
+			if ((!cacheFileName.empty()) &&
+			    (!IOPFileInterface::write_iop_file(cacheFileName, objectPool.scaledObjectPool)))
+			{
+				LOG_WARNING("[VT]: Failed to write the scaled pool to %s", cacheFileName.c_str());
 			}
 		}
 		return retVal;
 	}
 
-	bool VirtualTerminalClient::get_is_object_scalable(VirtualTerminalObjectType type)
+	bool VirtualTerminalClient::ObjectPoolScalingKey::operator==(const ObjectPoolScalingKey &other) const
 	{
-		bool retVal = false;
+		return (poolHash == other.poolHash) &&
+		  (poolSize == other.poolSize) &&
+		  (originalDataMaskDimension == other.originalDataMaskDimension) &&
+		  (originalSoftKeyDesignatorHeight == other.originalSoftKeyDesignatorHeight) &&
+		  (dataMaskWidth == other.dataMaskWidth) &&
+		  (dataMaskHeight == other.dataMaskHeight) &&
+		  (softKeyDesignatorWidth == other.softKeyDesignatorWidth) &&
+		  (softKeyDesignatorHeight == other.softKeyDesignatorHeight) &&
+		  (smallFontSizes == other.smallFontSizes) &&
+		  (largeFontSizes == other.largeFontSizes);
+	}
 
-		switch (type)
+	VirtualTerminalClient::ObjectPoolScalingKey VirtualTerminalClient::get_object_pool_scaling_key(ObjectPoolDataStruct &objectPool) const
+	{
+		ObjectPoolScalingKey retVal;
+
+		if (!objectPool.poolHashValid)
 		{
-			case VirtualTerminalObjectType::WorkingSet:
+			if (nullptr != objectPool.objectPoolDataPointer)
 			{
-				retVal = false;
+				objectPool.poolHash = IOPFileInterface::hash_object_pool(objectPool.objectPoolDataPointer, objectPool.objectPoolSize);
 			}
-			break;
-
-			case VirtualTerminalObjectType::DataMask:
-			case VirtualTerminalObjectType::AlarmMask:
-			case VirtualTerminalObjectType::Container:
-			case VirtualTerminalObjectType::Key:
-			case VirtualTerminalObjectType::Button:
-			case VirtualTerminalObjectType::InputBoolean:
-			case VirtualTerminalObjectType::InputString:
-			case VirtualTerminalObjectType::InputNumber:
-			case VirtualTerminalObjectType::InputList:
-			case VirtualTerminalObjectType::OutputString:
-			case VirtualTerminalObjectType::OutputNumber:
-			case VirtualTerminalObjectType::OutputList:
-			case VirtualTerminalObjectType::OutputLine:
-			case VirtualTerminalObjectType::OutputRectangle:
-			case VirtualTerminalObjectType::OutputEllipse:
-			case VirtualTerminalObjectType::OutputPolygon:
-			case VirtualTerminalObjectType::OutputMeter:
-			case VirtualTerminalObjectType::OutputLinearBarGraph:
-			case VirtualTerminalObjectType::OutputArchedBarGraph:
-			case VirtualTerminalObjectType::PictureGraphic:
-			case VirtualTerminalObjectType::AuxiliaryFunctionType1:
-			case VirtualTerminalObjectType::AuxiliaryInputType1:
-			case VirtualTerminalObjectType::AuxiliaryFunctionType2:
-			case VirtualTerminalObjectType::AuxiliaryInputType2:
-			case VirtualTerminalObjectType::FontAttributes:
+			else if (nullptr != objectPool.objectPoolVectorPointer)
 			{
-				retVal = true;
+				objectPool.poolHash = IOPFileInterface::hash_object_pool(objectPool.objectPoolVectorPointer->data(), objectPool.objectPoolVectorPointer->size());
 			}
-			break;
-
-			default:
+			else
 			{
-				retVal = false;
+				// Reading the whole pool through the callback just to hash it would cost as much as the upload itself
+				objectPool.poolHash = IOPFileInterface::hash_object_pool(reinterpret_cast<const std::uint8_t *>(objectPool.versionLabel.data()), objectPool.versionLabel.size());
 			}
-			break;
+			objectPool.poolHashValid = true;
 		}
+		retVal.poolHash = objectPool.poolHash;
+		retVal.poolSize = objectPool.objectPoolSize;
+		retVal.originalDataMaskDimension = objectPool.autoScaleDataMaskOriginalDimension;
+		retVal.originalSoftKeyDesignatorHeight = objectPool.autoScaleSoftKeyDesignatorOriginalHeight;
+		retVal.dataMaskWidth = get_number_x_pixels();
+		retVal.dataMaskHeight = get_number_y_pixels();
+		retVal.softKeyDesignatorWidth = get_softkey_x_axis_pixels();
+		retVal.softKeyDesignatorHeight = get_softkey_y_axis_pixels();
+		retVal.smallFontSizes = smallFontSizesBitfield;
+		retVal.largeFontSizes = largeFontSizesBitfield;
 		return retVal;
 	}
 
-	VirtualTerminalClient::FontSize VirtualTerminalClient::get_font_or_next_smallest_font(FontSize originalFont) const
-	{
-		FontSize retVal = originalFont;
-
-		while ((!get_font_size_supported(retVal)) && (FontSize::Size6x8 != retVal))
+	std::string VirtualTerminalClient::get_scaled_object_pool_file_name(const std::string &directory, const ObjectPoolScalingKey &key)
+	{
+		char fileName[128];
+		std::snprintf(fileName,
+		              sizeof(fileName),
+		              "%016llx_%u_%u_%ux%u_%ux%u_%02x%02x_%u.iop",
+		              static_cast<unsigned long long>(key.poolHash),
+		              static_cast<unsigned int>(key.originalDataMaskDimension),
+		              static_cast<unsigned int>(key.originalSoftKeyDesignatorHeight),
+		              static_cast<unsigned int>(key.dataMaskWidth),
+		              static_cast<unsigned int>(key.dataMaskHeight),
+		              static_cast<unsigned int>(key.softKeyDesignatorWidth),
+		              static_cast<unsigned int>(key.softKeyDesignatorHeight),
+		              static_cast<unsigned int>(key.smallFontSizes),
+		              static_cast<unsigned int>(key.largeFontSizes),
+		              static_cast<unsigned int>(key.poolSize));
+
+		std::string retVal = directory;
+		if ((!retVal.empty()) && ('/' != retVal.back()) && ('\\' != retVal.back()))
 		{
-			retVal = static_cast<FontSize>(static_cast<std::uint8_t>(originalFont) - 1);
+			retVal += '/';
 		}
-		return retVal;
+		return retVal + fileName;
 	}
 
-	VirtualTerminalClient::FontSize VirtualTerminalClient::remap_font_to_scale(FontSize originalFont, float scaleFactor)
+	bool VirtualTerminalClient::copy_object_pool_for_scaling(ObjectPoolDataStruct &objectPool)
 	{
-		static constexpr float SCALE_FACTOR_POSITIVE_FUDGE = 1.05f;
-		static constexpr float SCALE_FACTOR_NEGATIVE_FUDGE = 0.95f;
-		FontSize retVal = originalFont;
+		bool retVal = true;
 
-		if (scaleFactor > SCALE_FACTOR_POSITIVE_FUDGE || scaleFactor < SCALE_FACTOR_NEGATIVE_FUDGE)
+		if (nullptr != objectPool.objectPoolDataPointer)
 		{
-			const std::unordered_map<FontSize, std::map<float, FontSize, std::greater<float>>> FONT_SCALING_MAPPER{
-				{ FontSize::Size6x8,
-				  { { 23.95f, FontSize::Size128x192 },
+			objectPool.scaledObjectPool.assign(objectPool.objectPoolDataPointer, objectPool.objectPoolDataPointer + objectPool.objectPoolSize);
+		}
+		else if (nullptr != objectPool.objectPoolVectorPointer)
+		{
+			objectPool.scaledObjectPool.assign(objectPool.objectPoolVectorPointer->begin(), objectPool.objectPoolVectorPointer->end());
+		}
+		else if (objectPool.useDataCallback)
+		{
+			constexpr std::uint32_t CHUNK_SIZE = 1024;
+			objectPool.scaledObjectPool.resize(objectPool.objectPoolSize);
+
+			// Read the pool in chunks, rather than calling back for every byte
+			std::uint32_t callbackIndex = 0;
+			for (std::uint32_t offset = 0; (offset < objectPool.objectPoolSize) && retVal; offset += CHUNK_SIZE)
+			{
+				std::uint32_t chunkSize = std::min(CHUNK_SIZE, objectPool.objectPoolSize - offset);
+				retVal = objectPool.dataCallback(callbackIndex, offset, chunkSize, &objectPool.scaledObjectPool[offset], this);
+				callbackIndex++;
+			}
+		}
+		else
+		{
+			retVal = false;
+		}
+		return retVal;
+	}
+
+	float VirtualTerminalClient::get_object_scale_factor(const ObjectPoolDataStruct &objectPool, VirtualTerminalObjectType type) const
+	{
+		if (VirtualTerminalObjectType::Key == type)
+		{
+			return static_cast<float>(get_softkey_x_axis_pixels()) / static_cast<float>(objectPool.autoScaleSoftKeyDesignatorOriginalHeight);
+		}
+		return static_cast<float>(get_number_x_pixels()) / static_cast<float>(objectPool.autoScaleDataMaskOriginalDimension);
+	}
+
+	bool VirtualTerminalClient::scale_object_pool(ObjectPoolDataStruct &objectPool)
+	{
+		std::vector<std::uint8_t> &pool = objectPool.scaledObjectPool;
+
+		if ((objectPool.objectOffsets.empty()) &&
+		    (!find_object_offsets(pool.data(), static_cast<std::uint32_t>(pool.size()), objectPool.objectOffsets)))
+		{
+			LOG_ERROR("[VT]: Object pool is malformed, the length of an object could not be determined");
+			return false;
+		}
+
+		for (std::size_t i = 0; i < objectPool.objectOffsets.size(); i++)
+		{
+			std::uint8_t *object = &pool[objectPool.objectOffsets[i]];
+			VirtualTerminalObjectType type = static_cast<VirtualTerminalObjectType>(object[2]);
+
+			if (!resize_object(object, get_object_scale_factor(objectPool, type), type))
+			{
+				LOG_ERROR("[VT]: Failed to resize an object: %u with type %u",
+				          static_cast<unsigned int>(object[0] | (object[1] << 8)),
+				          static_cast<unsigned int>(object[2]));
+				return false;
+			}
+		}
+		LOG_DEBUG("[VT]: Scaled %u objects", static_cast<unsigned int>(objectPool.objectOffsets.size()));
+		return true;
+	}
+
+	bool VirtualTerminalClient::read_streamed_object_pool(ObjectPoolDataStruct &objectPool, std::uint32_t offset, std::uint32_t length, std::uint8_t *destination)
+	{
+		const std::vector<std::uint32_t> &offsets = objectPool.objectOffsets;
+
+		if (offsets.empty() ||
+		    (static_cast<std::uint64_t>(offset) + length > objectPool.objectPoolSize))
+		{
+			return false;
+		}
+
+		// Find the object the chunk starts in
+		std::size_t objectIndex = static_cast<std::size_t>(std::upper_bound(offsets.begin(), offsets.end(), offset) - offsets.begin()) - 1;
+
+		while (0 != length)
+		{
+			const std::uint32_t objectStart = offsets[objectIndex];
+			const std::uint32_t objectEnd = ((objectIndex + 1) < offsets.size()) ? offsets[objectIndex + 1] : objectPool.objectPoolSize;
+
+			if (objectIndex != objectPool.streamedObjectIndex)
+			{
+				objectPool.streamedObject.assign(objectPool.objectPoolDataPointer + objectStart, objectPool.objectPoolDataPointer + objectEnd);
+				objectPool.streamedObjectIndex = objectIndex;
+
+				VirtualTerminalObjectType type = static_cast<VirtualTerminalObjectType>(objectPool.streamedObject[2]);
+				if (!resize_object(objectPool.streamedObject.data(), get_object_scale_factor(objectPool, type), type))
+				{
+					LOG_ERROR("[VT]: Failed to resize an object: %u with type %u",
+					          static_cast<unsigned int>(objectPool.streamedObject[0] | (objectPool.streamedObject[1] << 8)),
+					          static_cast<unsigned int>(objectPool.streamedObject[2]));
+					objectPool.streamedObjectIndex = NO_STREAMED_OBJECT;
+					return false;
+				}
+			}
+
+			std::uint32_t bytesToCopy = std::min(length, objectEnd - offset);
+			memcpy(destination, &objectPool.streamedObject[offset - objectStart], bytesToCopy);
+			destination += bytesToCopy;
+			offset += bytesToCopy;
+			length -= bytesToCopy;
+			objectIndex++;
+		}
+		return true;
+	}
+
+	bool VirtualTerminalClient::get_is_object_scalable(VirtualTerminalObjectType type)
+	{
+		bool retVal = false;
+
+		switch (type)
+		{
+			case VirtualTerminalObjectType::WorkingSet:
+			{
+				retVal = false;
+			}
+			break;
+
+			case VirtualTerminalObjectType::DataMask:
+			case VirtualTerminalObjectType::AlarmMask:
+			case VirtualTerminalObjectType::Container:
+			case VirtualTerminalObjectType::Key:
+			case VirtualTerminalObjectType::Button:
+			case VirtualTerminalObjectType::InputBoolean:
+			case VirtualTerminalObjectType::InputString:
+			case VirtualTerminalObjectType::InputNumber:
+			case VirtualTerminalObjectType::InputList:
+			case VirtualTerminalObjectType::OutputString:
+			case VirtualTerminalObjectType::OutputNumber:
+			case VirtualTerminalObjectType::OutputList:
+			case VirtualTerminalObjectType::OutputLine:
+			case VirtualTerminalObjectType::OutputRectangle:
+			case VirtualTerminalObjectType::OutputEllipse:
+			case VirtualTerminalObjectType::OutputPolygon:
+			case VirtualTerminalObjectType::OutputMeter:
+			case VirtualTerminalObjectType::OutputLinearBarGraph:
+			case VirtualTerminalObjectType::OutputArchedBarGraph:
+			case VirtualTerminalObjectType::PictureGraphic:
+			case VirtualTerminalObjectType::AuxiliaryFunctionType1:
+			case VirtualTerminalObjectType::AuxiliaryInputType1:
+			case VirtualTerminalObjectType::AuxiliaryFunctionType2:
+			case VirtualTerminalObjectType::AuxiliaryInputType2:
+			case VirtualTerminalObjectType::FontAttributes:
+			{
+				retVal = true;
+			}
+			break;
+
+			default:
+			{
+				retVal = false;
+			}
+			break;
+		}
+		return retVal;
+	}
+
+	VirtualTerminalClient::FontSize VirtualTerminalClient::get_font_or_next_smallest_font(FontSize originalFont) const
+	{
+		FontSize retVal = originalFont;
+
+		while ((!get_font_size_supported(retVal)) && (FontSize::Size6x8 != retVal))
+		{
+			retVal = static_cast<FontSize>(static_cast<std::uint8_t>(originalFont) - 1);
+		}
+		return retVal;
+	}
+
+	VirtualTerminalClient::FontSize VirtualTerminalClient::remap_font_to_scale(FontSize originalFont, float scaleFactor)
+	{
+		static constexpr float SCALE_FACTOR_POSITIVE_FUDGE = 1.05f;
+		static constexpr float SCALE_FACTOR_NEGATIVE_FUDGE = 0.95f;
+		FontSize retVal = originalFont;
+
+		if (scaleFactor > SCALE_FACTOR_POSITIVE_FUDGE || scaleFactor < SCALE_FACTOR_NEGATIVE_FUDGE)
+		{
+			const std::unordered_map<FontSize, std::map<float, FontSize, std::greater<float>>> FONT_SCALING_MAPPER{
+				{ FontSize::Size6x8,
+				  { { 23.95f, FontSize::Size128x192 },
 				    { 21.30f, FontSize::Size128x128 },
 				    { 15.95f, FontSize::Size96x128 },
 				    { 11.95f, FontSize::Size64x96 },
@@ -3639,565 +3890,122 @@ namespace isobus
 				    { 0.50f, FontSize::Size16x24 },
 				    { 0.37f, FontSize::Size12x16 },
 				    { 0.20f, FontSize::Size8x12 },
-				    { 0.0f, FontSize::Size6x8 } } },
-				{ FontSize::Size48x64,
-				  { { 2.95f, FontSize::Size128x192 },
-				    { 2.60f, FontSize::Size128x128 },
-				    { 1.95f, FontSize::Size96x128 },
-				    { 1.45f, FontSize::Size64x96 },
-				    { 1.30f, FontSize::Size64x64 },
-				    { 0.75f, FontSize::Size32x48 },
-				    { 0.60f, FontSize::Size32x32 },
-				    { 0.50f, FontSize::Size24x32 },
-				    { 0.37f, FontSize::Size16x24 },
-				    { 0.33f, FontSize::Size16x16 },
-				    { 0.25f, FontSize::Size12x16 },
-				    { 0.18f, FontSize::Size8x12 },
-				    { 0.16f, FontSize::Size8x8 },
-				    { 0.0f, FontSize::Size6x8 } } },
-				{ FontSize::Size64x64,
-				  { { 2.95f, FontSize::Size128x192 },
-				    { 1.95f, FontSize::Size128x128 },
-				    { 1.45f, FontSize::Size64x96 },
-				    { 0.75f, FontSize::Size32x48 },
-				    { 0.50f, FontSize::Size32x32 },
-				    { 0.37f, FontSize::Size16x24 },
-				    { 0.25f, FontSize::Size16x16 },
-				    { 0.18f, FontSize::Size8x12 },
-				    { 0.12f, FontSize::Size8x8 },
-				    { 0.0f, FontSize::Size6x8 } } },
-				{ FontSize::Size64x96,
-				  { { 1.95f, FontSize::Size128x192 },
-				    { 1.45f, FontSize::Size96x128 },
-				    { 0.75f, FontSize::Size48x64 },
-				    { 0.50f, FontSize::Size32x48 },
-				    { 0.37f, FontSize::Size24x32 },
-				    { 0.25f, FontSize::Size16x24 },
-				    { 0.18f, FontSize::Size12x16 },
-				    { 0.12f, FontSize::Size8x12 },
-				    { 0.0f, FontSize::Size6x8 } } },
-				{ FontSize::Size96x128,
-				  { { 1.45f, FontSize::Size128x192 },
-				    { 1.30f, FontSize::Size128x128 },
-				    { 0.75f, FontSize::Size64x96 },
-				    { 0.60f, FontSize::Size64x64 },
-				    { 0.50f, FontSize::Size48x64 },
-				    { 0.37f, FontSize::Size32x48 },
-				    { 0.33f, FontSize::Size32x32 },
-				    { 0.25f, FontSize::Size24x32 },
-				    { 0.18f, FontSize::Size16x24 },
-				    { 0.16f, FontSize::Size16x16 },
-				    { 0.125f, FontSize::Size12x16 },
-				    { 0.09f, FontSize::Size8x12 },
-				    { 0.08f, FontSize::Size8x8 },
-				    { 0.0f, FontSize::Size6x8 } } },
-				{ FontSize::Size128x128,
-				  { { 1.45f, FontSize::Size128x192 },
-				    { 0.75f, FontSize::Size64x96 },
-				    { 0.50f, FontSize::Size64x64 },
-				    { 0.37f, FontSize::Size32x48 },
-				    { 0.25f, FontSize::Size32x32 },
-				    { 0.18f, FontSize::Size16x24 },
-				    { 0.125f, FontSize::Size16x16 },
-				    { 0.09f, FontSize::Size8x12 },
-				    { 0.06f, FontSize::Size8x8 },
-				    { 0.0f, FontSize::Size6x8 } } },
-				{ FontSize::Size128x192,
-				  { { 0.75f, FontSize::Size96x128 },
-				    { 0.50f, FontSize::Size64x96 },
-				    { 0.37f, FontSize::Size48x64 },
-				    { 0.25f, FontSize::Size32x48 },
-				    { 0.18f, FontSize::Size24x32 },
-				    { 0.125f, FontSize::Size16x24 },
-				    { 0.09f, FontSize::Size12x16 },
-				    { 0.06f, FontSize::Size8x12 },
-				    { 0.0f, FontSize::Size6x8 } } }
-			};
-
-			auto iterator = FONT_SCALING_MAPPER.find(originalFont);
-			if (iterator != FONT_SCALING_MAPPER.end())
-			{
-				for (auto &pair : iterator->second)
-				{
-					if (scaleFactor >= pair.first)
-					{
-						retVal = pair.second;
-						break;
-					}
-				}
-			}
-
-			if (retVal == originalFont)
-			{
-				// Unknown font? Newer version than we support of the ISO standard? Or scaling factor out of range?
-				LOG_ERROR("[VT]: Unable to scale font type " + isobus::to_string(static_cast<int>(originalFont)) +
-				          " with scale factor " + isobus::to_string(scaleFactor) + ". Returning original font.");
-			}
-		}
-		return retVal;
-	}
-
-	std::uint32_t VirtualTerminalClient::get_minimum_object_length(VirtualTerminalObjectType type)
-	{
-		std::uint32_t retVal = 0;
-
-		switch (type)
-		{
-			case VirtualTerminalObjectType::WorkingSet:
-			{
-				retVal = 10;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputList:
-			case VirtualTerminalObjectType::ExternalReferenceNAME:
-			case VirtualTerminalObjectType::ObjectLabelRefrenceList:
-			{
-				retVal = 12;
-			}
-			break;
-
-			case VirtualTerminalObjectType::AlarmMask:
-			case VirtualTerminalObjectType::Container:
-			case VirtualTerminalObjectType::KeyGroup:
-			{
-				retVal = 10;
-			}
-			break;
-
-			case VirtualTerminalObjectType::ExternalObjectPointer:
-			{
-				retVal = 9;
-			}
-			break;
-
-			case VirtualTerminalObjectType::SoftKeyMask:
-			case VirtualTerminalObjectType::ColourMap:
-			{
-				retVal = 6;
-			}
-			break;
-
-			case VirtualTerminalObjectType::Key:
-			case VirtualTerminalObjectType::NumberVariable:
-			case VirtualTerminalObjectType::InputAttributes:
-			{
-				retVal = 7;
-			}
-			break;
-
-			case VirtualTerminalObjectType::Button:
-			case VirtualTerminalObjectType::InputBoolean:
-			case VirtualTerminalObjectType::OutputRectangle:
-			case VirtualTerminalObjectType::InputList:
-			case VirtualTerminalObjectType::ExternalObjectDefinition:
-			{
-				retVal = 13;
-			}
-			break;
-
-			case VirtualTerminalObjectType::InputString:
-			{
-				retVal = 19;
-			}
-			break;
-
-			case VirtualTerminalObjectType::InputNumber:
-			{
-				retVal = 38;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputString:
-			{
-				retVal = 17;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputNumber:
-			{
-				retVal = 29;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputLine:
-			{
-				retVal = 11;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputEllipse:
-			{
-				retVal = 15;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputPolygon:
-			{
-				retVal = 14;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputMeter:
-			{
-				retVal = 21;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputLinearBarGraph:
-			{
-				retVal = 24;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputArchedBarGraph:
-			{
-				retVal = 27;
-			}
-			break;
-
-			case VirtualTerminalObjectType::PictureGraphic:
-			case VirtualTerminalObjectType::Animation:
-			case VirtualTerminalObjectType::WindowMask:
-			{
-				retVal = 17;
-			}
-			break;
-
-			case VirtualTerminalObjectType::StringVariable:
-			case VirtualTerminalObjectType::ExtendedInputAttributes:
-			case VirtualTerminalObjectType::ObjectPointer:
-			case VirtualTerminalObjectType::Macro:
-			{
-				retVal = 5;
-			}
-			break;
-
-			case VirtualTerminalObjectType::FontAttributes:
-			case VirtualTerminalObjectType::LineAttributes:
-			case VirtualTerminalObjectType::FillAttributes:
-			case VirtualTerminalObjectType::DataMask:
-			{
-				retVal = 8;
-			}
-			break;
-
-			case VirtualTerminalObjectType::GraphicsContext:
-			{
-				retVal = 34;
-			}
-			break;
-
-			case VirtualTerminalObjectType::AuxiliaryFunctionType1:
-			case VirtualTerminalObjectType::AuxiliaryFunctionType2:
-			case VirtualTerminalObjectType::AuxiliaryInputType2:
-			{
-				retVal = 6;
-			}
-			break;
-
-			case VirtualTerminalObjectType::AuxiliaryInputType1:
-			{
-				retVal = 7;
-			}
-			break;
-
-			default:
-			{
-				LOG_ERROR("[VT]: Cannot autoscale object pool due to unknown object minimum length - type " + isobus::to_string(static_cast<int>(type)));
-			}
-			break;
-		}
-		return retVal;
-	}
-
-	std::uint32_t VirtualTerminalClient::get_number_bytes_in_object(std::uint8_t *buffer)
-	{
-		auto currentObjectType = static_cast<VirtualTerminalObjectType>(buffer[2]);
-		std::uint32_t retVal = get_minimum_object_length(currentObjectType);
-
-		switch (currentObjectType)
-		{
-			case VirtualTerminalObjectType::WorkingSet:
-			{
-				const std::uint32_t sizeOfChildObjects = (buffer[7] * 6);
-				const std::uint32_t sizeOfMacros = (buffer[8] * 2);
-				const std::uint32_t sizeOfLanguageCodes = (buffer[9] * 2);
-				retVal += (sizeOfLanguageCodes + sizeOfChildObjects + sizeOfMacros);
-			}
-			break;
-
-			case VirtualTerminalObjectType::DataMask:
-			{
-				const std::uint32_t sizeOfChildObjects = (buffer[6] * 6);
-				const std::uint32_t sizeOfMacros = (buffer[7] * 2);
-				retVal += (sizeOfChildObjects + sizeOfMacros);
-			}
-			break;
-
-			case VirtualTerminalObjectType::AlarmMask:
-			case VirtualTerminalObjectType::Container:
-			{
-				const std::uint32_t sizeOfChildObjects = (buffer[8] * 6);
-				const std::uint32_t sizeOfMacros = (buffer[9] * 2);
-				retVal += (sizeOfChildObjects + sizeOfMacros);
-			}
-			break;
-
-			case VirtualTerminalObjectType::SoftKeyMask:
-			{
-				const std::uint32_t sizeOfChildObjects = (buffer[4] * 2);
-				const std::uint32_t sizeOfMacros = (buffer[5] * 2);
-				retVal += (sizeOfChildObjects + sizeOfMacros);
-			}
-			break;
-
-			case VirtualTerminalObjectType::Key:
-			{
-				const std::uint32_t sizeOfChildObjects = (buffer[5] * 6);
-				const std::uint32_t sizeOfMacros = (buffer[6] * 2);
-				retVal += (sizeOfChildObjects + sizeOfMacros);
-			}
-			break;
-
-			case VirtualTerminalObjectType::Button:
-			{
-				const std::uint32_t sizeOfChildObjects = (buffer[11] * 6);
-				const std::uint32_t sizeOfMacros = (buffer[12] * 2);
-				retVal += (sizeOfChildObjects + sizeOfMacros);
-			}
-			break;
-
-			case VirtualTerminalObjectType::InputBoolean:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[12] * 2);
-				retVal += sizeOfMacros;
-			}
-			break;
-
-			case VirtualTerminalObjectType::InputString:
-			{
-				const std::uint32_t sizeOfValue = buffer[16];
-				const std::uint32_t sizeOfMacros = (buffer[18 + sizeOfValue] * 2);
-				retVal += (sizeOfValue + sizeOfMacros);
-			}
-			break;
-
-			case VirtualTerminalObjectType::InputNumber:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[37] * 2);
-				retVal += sizeOfMacros;
-			}
-			break;
-
-			case VirtualTerminalObjectType::InputList:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[12] * 2);
-				const std::uint32_t sizeOfListObjectIDs = (buffer[10] * 2);
-				retVal += (sizeOfMacros + sizeOfListObjectIDs);
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputString:
-			{
-				const std::uint32_t sizeOfValue = (static_cast<uint16_t>(buffer[14]) | static_cast<uint16_t>(buffer[15] << 8));
-				const std::uint32_t sizeOfMacros = (buffer[16 + sizeOfValue] * 2);
-				retVal += (sizeOfMacros + sizeOfValue);
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputNumber:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[28] * 2);
-				retVal += sizeOfMacros;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputList:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[11] * 2);
-				const std::uint32_t sizeOfListObjectIDs = (buffer[10] * 2);
-				retVal += (sizeOfMacros + sizeOfListObjectIDs);
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputLine:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[10] * 2);
-				retVal += sizeOfMacros;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputRectangle:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[12] * 2);
-				retVal += sizeOfMacros;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputEllipse:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[14] * 2);
-				retVal += sizeOfMacros;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputPolygon:
-			{
-				const std::uint32_t sizeOfPoints = (buffer[12] * 4);
-				const std::uint32_t sizeOfMacros = (buffer[13] * 2);
-				retVal += (sizeOfMacros + sizeOfPoints);
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputMeter:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[20] * 2);
-				retVal += sizeOfMacros;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputLinearBarGraph:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[23] * 2);
-				retVal += sizeOfMacros;
-			}
-			break;
-
-			case VirtualTerminalObjectType::OutputArchedBarGraph:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[26] * 2);
-				retVal += sizeOfMacros;
-			}
-			break;
-
-			case VirtualTerminalObjectType::PictureGraphic:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[16] * 2);
-				const std::uint32_t sizeOfRawData = (static_cast<std::uint32_t>(buffer[12]) |
-				                                     (static_cast<std::uint32_t>(buffer[13]) << 8) |
-				                                     (static_cast<std::uint32_t>(buffer[14]) << 16) |
-				                                     (static_cast<std::uint32_t>(buffer[15]) << 24));
-				retVal += (sizeOfRawData + sizeOfMacros);
-			}
-			break;
-
-			case VirtualTerminalObjectType::ObjectPointer:
-			case VirtualTerminalObjectType::NumberVariable:
-			case VirtualTerminalObjectType::GraphicsContext:
-			case VirtualTerminalObjectType::ExternalReferenceNAME:
-			case VirtualTerminalObjectType::ExternalObjectPointer:
-			case VirtualTerminalObjectType::AuxiliaryControlDesignatorType2:
-			{
-				// No additional length
-			}
-			break;
-
-			case VirtualTerminalObjectType::StringVariable:
-			{
-				const std::uint32_t sizeOfValue = (static_cast<uint16_t>(buffer[3]) | static_cast<uint16_t>(buffer[4]) << 8);
-				retVal += sizeOfValue;
-			}
-			break;
-
-			case VirtualTerminalObjectType::FontAttributes:
-			case VirtualTerminalObjectType::LineAttributes:
-			case VirtualTerminalObjectType::FillAttributes:
-			{
-				const std::uint32_t sizeOfMacros = (buffer[7] * 2);
-				retVal += sizeOfMacros;
-			}
-			break;
-
-			case VirtualTerminalObjectType::InputAttributes:
-			{
-				const std::uint32_t sizeOfValidationString = buffer[4];
-				const std::uint32_t sizeOfMacros = (buffer[5 + sizeOfValidationString] * 2);
-				retVal += (sizeOfMacros + sizeOfValidationString);
-			}
-			break;
-
-			case VirtualTerminalObjectType::ExtendedInputAttributes:
-			{
-				const std::uint32_t numberOfCodePlanes = buffer[5];
-				retVal += (numberOfCodePlanes * 2); // Doesn't include the character ranges, need to handle those externally
-			}
-			break;
-
-			case VirtualTerminalObjectType::Macro:
-			{
-				const std::uint32_t numberOfMacroBytes = (static_cast<std::uint16_t>(buffer[3]) | (static_cast<std::uint16_t>(buffer[4]) << 8));
-				retVal += numberOfMacroBytes;
-			}
-			break;
-
-			case VirtualTerminalObjectType::ColourMap:
-			{
-				const std::uint32_t numberIndexes = (static_cast<std::uint16_t>(buffer[3]) | (static_cast<std::uint16_t>(buffer[4]) << 8));
-				retVal += numberIndexes;
-			}
-			break;
-
-			case VirtualTerminalObjectType::WindowMask:
-			{
-				const std::uint32_t sizeOfReferences = (buffer[14] * 2);
-				const std::uint32_t numberObjects = (buffer[15] * 6);
-				const std::uint32_t sizeOfMacros = (buffer[16] * 2);
-				retVal += (sizeOfMacros + numberObjects + sizeOfReferences);
-			}
-			break;
-
-			case VirtualTerminalObjectType::KeyGroup:
-			{
-				const std::uint32_t numberObjects = (buffer[8] * 2);
-				const std::uint32_t sizeOfMacros = (buffer[9] * 2);
-				retVal += (sizeOfMacros + numberObjects);
-			}
-			break;
+				    { 0.0f, FontSize::Size6x8 } } },
+				{ FontSize::Size48x64,
+				  { { 2.95f, FontSize::Size128x192 },
+				    { 2.60f, FontSize::Size128x128 },
+				    { 1.95f, FontSize::Size96x128 },
+				    { 1.45f, FontSize::Size64x96 },
+				    { 1.30f, FontSize::Size64x64 },
+				    { 0.75f, FontSize::Size32x48 },
+				    { 0.60f, FontSize::Size32x32 },
+				    { 0.50f, FontSize::Size24x32 },
+				    { 0.37f, FontSize::Size16x24 },
+				    { 0.33f, FontSize::Size16x16 },
+				    { 0.25f, FontSize::Size12x16 },
+				    { 0.18f, FontSize::Size8x12 },
+				    { 0.16f, FontSize::Size8x8 },
+				    { 0.0f, FontSize::Size6x8 } } },
+				{ FontSize::Size64x64,
+				  { { 2.95f, FontSize::Size128x192 },
+				    { 1.95f, FontSize::Size128x128 },
+				    { 1.45f, FontSize::Size64x96 },
+				    { 0.75f, FontSize::Size32x48 },
+				    { 0.50f, FontSize::Size32x32 },
+				    { 0.37f, FontSize::Size16x24 },
+				    { 0.25f, FontSize::Size16x16 },
+				    { 0.18f, FontSize::Size8x12 },
+				    { 0.12f, FontSize::Size8x8 },
+				    { 0.0f, FontSize::Size6x8 } } },
+				{ FontSize::Size64x96,
+				  { { 1.95f, FontSize::Size128x192 },
+				    { 1.45f, FontSize::Size96x128 },
+				    { 0.75f, FontSize::Size48x64 },
+				    { 0.50f, FontSize::Size32x48 },
+				    { 0.37f, FontSize::Size24x32 },
+				    { 0.25f, FontSize::Size16x24 },
+				    { 0.18f, FontSize::Size12x16 },
+				    { 0.12f, FontSize::Size8x12 },
+				    { 0.0f, FontSize::Size6x8 } } },
+				{ FontSize::Size96x128,
+				  { { 1.45f, FontSize::Size128x192 },
+				    { 1.30f, FontSize::Size128x128 },
+				    { 0.75f, FontSize::Size64x96 },
+				    { 0.60f, FontSize::Size64x64 },
+				    { 0.50f, FontSize::Size48x64 },
+				    { 0.37f, FontSize::Size32x48 },
+				    { 0.33f, FontSize::Size32x32 },
+				    { 0.25f, FontSize::Size24x32 },
+				    { 0.18f, FontSize::Size16x24 },
+				    { 0.16f, FontSize::Size16x16 },
+				    { 0.125f, FontSize::Size12x16 },
+				    { 0.09f, FontSize::Size8x12 },
+				    { 0.08f, FontSize::Size8x8 },
+				    { 0.0f, FontSize::Size6x8 } } },
+				{ FontSize::Size128x128,
+				  { { 1.45f, FontSize::Size128x192 },
+				    { 0.75f, FontSize::Size64x96 },
+				    { 0.50f, FontSize::Size64x64 },
+				    { 0.37f, FontSize::Size32x48 },
+				    { 0.25f, FontSize::Size32x32 },
+				    { 0.18f, FontSize::Size16x24 },
+				    { 0.125f, FontSize::Size16x16 },
+				    { 0.09f, FontSize::Size8x12 },
+				    { 0.06f, FontSize::Size8x8 },
+				    { 0.0f, FontSize::Size6x8 } } },
+				{ FontSize::Size128x192,
+				  { { 0.75f, FontSize::Size96x128 },
+				    { 0.50f, FontSize::Size64x96 },
+				    { 0.37f, FontSize::Size48x64 },
+				    { 0.25f, FontSize::Size32x48 },
+				    { 0.18f, FontSize::Size24x32 },
+				    { 0.125f, FontSize::Size16x24 },
+				    { 0.09f, FontSize::Size12x16 },
+				    { 0.06f, FontSize::Size8x12 },
+				    { 0.0f, FontSize::Size6x8 } } }
+			};
 
-			case VirtualTerminalObjectType::ObjectLabelRefrenceList:
+			auto iterator = FONT_SCALING_MAPPER.find(originalFont);
+			if (iterator != FONT_SCALING_MAPPER.end())
 			{
-				const std::uint32_t sizeOfLabeledObjects = ((static_cast<uint16_t>(buffer[4]) | static_cast<uint16_t>(buffer[5]) << 8) * 7);
-				retVal += sizeOfLabeledObjects;
+				for (auto &pair : iterator->second)
+				{
+					if (scaleFactor >= pair.first)
+					{
+						retVal = pair.second;
+						break;
+					}
+				}
 			}
-			break;
 
-			case VirtualTerminalObjectType::ExternalObjectDefinition:
+			if (retVal == originalFont)
 			{
-				const std::uint32_t sizeOfObjects = (buffer[12] * 2);
-				retVal += sizeOfObjects;
+				// Unknown font? Newer version than we support of the ISO standard? Or scaling factor out of range?
+				LOG_ERROR("[VT]: Unable to scale font type " + isobus::to_string(static_cast<int>(originalFont)) +
+				          " with scale factor " + isobus::to_string(scaleFactor) + ". Returning original font.");
 			}
-			break;
+		}
+		return retVal;
+	}
 
-			case VirtualTerminalObjectType::Animation:
-			{
-				const std::uint32_t sizeOfObjects = (buffer[15] * 6);
-				const std::uint32_t sizeOfMacros = (buffer[16] * 2);
-				retVal += (sizeOfMacros + sizeOfObjects);
-			}
-			break;
+	std::uint32_t VirtualTerminalClient::get_minimum_object_length(VirtualTerminalObjectType type)
+	{
+		std::uint32_t retVal = isobus::get_minimum_object_length(type);
 
-			case VirtualTerminalObjectType::AuxiliaryFunctionType1:
-			case VirtualTerminalObjectType::AuxiliaryFunctionType2:
-			{
-				const std::uint32_t sizeOfObjects = (buffer[5] * 6);
-				retVal += sizeOfObjects;
-			}
-			break;
+		if (0 == retVal)
+		{
+			LOG_ERROR("[VT]: Cannot autoscale object pool due to unknown object minimum length - type " + isobus::to_string(static_cast<int>(type)));
+		}
+		return retVal;
+	}
 
-			case VirtualTerminalObjectType::AuxiliaryInputType1:
-			case VirtualTerminalObjectType::AuxiliaryInputType2:
-			{
-				const std::uint32_t sizeOfObjects = (buffer[6] * 6);
-				retVal += sizeOfObjects;
-			}
-			break;
+	std::uint32_t VirtualTerminalClient::get_number_bytes_in_object(std::uint8_t *buffer)
+	{
+		std::uint32_t retVal = isobus::get_number_bytes_in_object(buffer, std::numeric_limits<std::uint32_t>::max());
 
-			default:
-			{
-				LOG_ERROR("[VT]: Cannot autoscale object pool due to unknown object total length - type " + isobus::to_string(static_cast<int>(buffer[2])));
-			}
-			break;
+		if (0 == retVal)
+		{
+			LOG_ERROR("[VT]: Cannot autoscale object pool due to unknown object total length - type " + isobus::to_string(static_cast<int>(buffer[2])));
 		}
 		return retVal;
 	}
@@ -4490,7 +4298,7 @@ namespace isobus
 		return is_function_unsupported(static_cast<std::uint8_t>(function));
 	}
 
-	bool VirtualTerminalClient::send_command(const std::vector<std::uint8_t> &data)
+	bool VirtualTerminalClient::get_is_ready_for_command()
 	{
 		if (commandAwaitingResponse)
 		{
@@ -4498,6 +4306,7 @@ namespace isobus
 			{
 				LOG_WARNING("[VT]: Server response to a command timed out");
 				commandAwaitingResponse = false;
+				complete_transaction_command(true);
 			}
 			else
 			{
@@ -4511,80 +4320,119 @@ namespace isobus
 			LOG_ERROR("[VT]: Cannot send command, not connected");
 			return false;
 		}
+		return true;
+	}
+
+	void VirtualTerminalClient::on_command_sent()
+	{
+		commandAwaitingResponse = true;
+		lastCommandTimestamp_ms = SystemTiming::get_timestamp_ms();
+	}
 
-		bool success = send_message_to_vt(data.data(), data.size());
+	bool VirtualTerminalClient::send_command(const std::uint8_t *data, std::uint32_t length)
+	{
+		if (!get_is_ready_for_command())
+		{
+			return false;
+		}
 
+		bool success = send_message_to_vt(data, length);
 		if (success)
 		{
-			commandAwaitingResponse = true;
-			lastCommandTimestamp_ms = SystemTiming::get_timestamp_ms();
+			on_command_sent();
 		}
 		return success;
 	}
 
-	bool VirtualTerminalClient::queue_command(const std::vector<std::uint8_t> &data, bool replace)
+	bool VirtualTerminalClient::send_command(std::vector<std::uint8_t> &data)
 	{
-		std::uint8_t functionCode = data[0];
-		if (is_function_unsupported(functionCode))
+		if (data.size() <= CAN_DATA_LENGTH)
 		{
-			return false;
+			return send_command(data.data(), static_cast<std::uint32_t>(data.size()));
 		}
 
-		if (get_is_connected() && send_command(data))
+		if (!get_is_ready_for_command())
 		{
-			return true;
+			return false;
 		}
 
-		LOCK_GUARD(Mutex, commandQueueMutex);
-		if (replace && replace_command(data))
+		// Let the transport protocol take over the buffer rather than copying it
+		std::unique_ptr<CANMessageData> messageData(new CANMessageDataVector(std::move(data)));
+		bool success = send_message_to_vt(messageData);
+		if (success)
 		{
-			return true;
+			on_command_sent();
 		}
-		commandQueue.emplace_back(data);
-		return true;
+		else
+		{
+			// Not sent, so give the data back to the caller to retry later
+			data.swap(static_cast<CANMessageDataVector &>(*messageData));
+		}
+		return success;
 	}
 
-	bool VirtualTerminalClient::replace_command(const std::vector<std::uint8_t> &data)
+	bool VirtualTerminalClient::queue_command(const std::uint8_t *data, std::uint32_t length, bool replace)
 	{
-		bool alreadyReplaced = false;
-		for (auto it = commandQueue.begin(); it != commandQueue.end();)
+		if (is_function_unsupported(data[0]))
 		{
-			if (are_commands_similar(*it, data))
-			{
-				if (!alreadyReplaced)
-				{
-					*it = data;
-					alreadyReplaced = true;
-					it++;
-				}
-				else
-				{
-					it = commandQueue.erase(it);
-				}
-			}
-			else
+			return false;
+		}
+
+		LOCK_GUARD(Mutex, commandQueueMutex);
+		if (transactionOpen)
+		{
+			// Commands only coalesce with commands of the same transaction, so every appended command is counted for it
+			if (!commandQueue.push(data, length, get_command_key(data, length), replace, transactions.back().transactionID))
 			{
-				it++;
+				transactions.back().numberOfCommands++;
 			}
 		}
-		return alreadyReplaced;
+		else if (commandQueue.empty() && get_is_connected() && send_command(data, length))
+		{
+			commandAwaitingResponseTransactionID = 0;
+		}
+		else
+		{
+			commandQueue.push(data, length, get_command_key(data, length), replace);
+		}
+		return true;
 	}
 
-	bool VirtualTerminalClient::are_commands_similar(const std::vector<std::uint8_t> &first, const std::vector<std::uint8_t> &second)
+	bool VirtualTerminalClient::queue_command(std::vector<std::uint8_t> data, bool replace)
 	{
-		if (first.size() != second.size())
+		if (is_function_unsupported(data[0]))
 		{
 			return false;
 		}
 
-		// Check if function codes match
-		if (first[0] != second[0])
+		std::uint64_t key = get_command_key(data.data(), static_cast<std::uint32_t>(data.size()));
+		LOCK_GUARD(Mutex, commandQueueMutex);
+		if (transactionOpen)
 		{
-			return false;
+			// Commands only coalesce with commands of the same transaction, so every appended command is counted for it
+			if (!commandQueue.push(std::move(data), key, replace, transactions.back().transactionID))
+			{
+				transactions.back().numberOfCommands++;
+			}
 		}
+		else if (commandQueue.empty() && get_is_connected() && send_command(data))
+		{
+			commandAwaitingResponseTransactionID = 0;
+		}
+		else
+		{
+			commandQueue.push(std::move(data), key, replace);
+		}
+		return true;
+	}
+
+	std::uint64_t VirtualTerminalClient::get_command_key(const std::uint8_t *data, std::uint32_t length)
+	{
+		// The function code, the bytes that identify what the command changes, and the length
+		std::uint64_t key = static_cast<std::uint64_t>(data[0]) | (static_cast<std::uint64_t>(length & 0xFFFFFF) << 40);
+		std::uint32_t identifyingBytes = 0;
 
-		// Perform other checks based on function code
-		Function function = static_cast<Function>(first[0]);
+		Function function = static_cast<Function>(data[0]);
 		switch (function)
 		{
 			case Function::HideShowObjectCommand:
@@ -4601,28 +4449,16 @@ namespace isobus
 			case Function::ChangePriorityCommand:
 			case Function::ChangePolygonScaleCommand:
 			{
-				// Check if the target object IDs match
-				if ((first[1] != second[1]) || (first[2] != second[2]))
-				{
-					return false;
-				}
+				// The target object ID
+				identifyingBytes = 2;
 			}
 			break;
 
 			case Function::ChangeChildLocationCommand:
 			case Function::ChangeChildPositionCommand:
 			{
-				// Check if the parent IDs match
-				if ((first[1] != second[1]) || (first[2] != second[2]))
-				{
-					return false;
-				}
-
-				// Check if the target object IDs match
-				if ((first[3] != second[3]) || (first[4] != second[4]))
-				{
-					return false;
-				}
+				// The parent object ID and the target object ID
+				identifyingBytes = 4;
 			}
 			break;
 
@@ -4634,50 +4470,171 @@ namespace isobus
 			case Function::GraphicsContextCommand:
 			case Function::GetAttributeValueMessage:
 			{
-				// Check if the first 3 bytes match
-				if ((first[1] != second[1]) || (first[2] != second[2]) || (first[3] != second[3]))
-				{
-					return false;
-				}
+				// The object ID and the attribute ID, list index, point index or sub-command
+				identifyingBytes = 3;
 			}
 			break;
 
 			case Function::ExecuteMacroCommand:
 			{
-				// Check if the macro IDs match
-				if (first[1] != second[1])
-				{
-					return false;
-				}
+				// The macro ID
+				identifyingBytes = 1;
+			}
+			break;
+
+			case Function::ExecuteExtendedMacroCommand:
+			case Function::ChangeObjectLabelCommand:
+			{
+				// The extended macro ID or the target object ID
+				identifyingBytes = 2;
 			}
 			break;
 
 			default:
 			{
-				// No additional checks
+				// Only one command per function code and length
 			}
 		}
 
-		return true;
+		for (std::uint32_t i = 1; (i <= identifyingBytes) && (i < length); i++)
+		{
+			key |= (static_cast<std::uint64_t>(data[i]) << (8 * i));
+		}
+		return key;
 	}
 
 	void VirtualTerminalClient::process_command_queue()
 	{
-		if (!get_is_connected())
+		if (get_is_connected())
 		{
-			return;
+			LOCK_GUARD(Mutex, commandQueueMutex);
+			while (!commandQueue.empty())
+			{
+				VirtualTerminalCommandQueue::Command &command = commandQueue.front();
+
+				if (transactionOpen && (command.get_group() == transactions.back().transactionID))
+				{
+					// The transaction is still being built up
+					break;
+				}
+
+				bool sent = command.is_inline() ? send_command(command.data(), command.size()) : send_command(command.get_long_payload());
+				if (!sent)
+				{
+					// Keep the order, the commands behind it have to wait for the VT
+					break;
+				}
+				commandAwaitingResponseTransactionID = command.get_group();
+				commandQueue.pop();
+			}
+		}
+		dispatch_completed_transactions();
+	}
+
+	void VirtualTerminalClient::on_command_response()
+	{
+		{
+			LOCK_GUARD(Mutex, commandQueueMutex);
+			commandAwaitingResponse = false;
+			complete_transaction_command(false);
 		}
+		process_command_queue();
+	}
+
+	void VirtualTerminalClient::begin_transaction()
+	{
 		LOCK_GUARD(Mutex, commandQueueMutex);
-		for (auto it = commandQueue.begin(); it != commandQueue.end();)
+		if (!transactionOpen)
 		{
-			if (send_command(*it))
+			TransactionStatus transaction = { nextTransactionID, 0, 0, 0, false };
+			transactions.push_back(transaction);
+			transactionOpen = true;
+
+			nextTransactionID++;
+			if (0 == nextTransactionID)
 			{
-				it = commandQueue.erase(it);
+				nextTransactionID = 1; // 0 is used for commands outside of a transaction
 			}
-			else
+		}
+	}
+
+	std::uint32_t VirtualTerminalClient::end_transaction()
+	{
+		std::uint32_t retVal = 0;
+		{
+			LOCK_GUARD(Mutex, commandQueueMutex);
+			if (transactionOpen)
+			{
+				transactionOpen = false;
+				transactions.back().ended = true;
+				retVal = transactions.back().transactionID;
+
+				// A transaction of which every command was coalesced into an earlier one may be complete already
+				collect_completed_transactions();
+			}
+		}
+		process_command_queue();
+		return retVal;
+	}
+
+	bool VirtualTerminalClient::get_is_transaction_open() const
+	{
+		return transactionOpen;
+	}
+
+	EventDispatcher<VirtualTerminalClient::VTTransactionCompletedEvent> &VirtualTerminalClient::get_transaction_completed_event_dispatcher()
+	{
+		return transactionCompletedEventDispatcher;
+	}
+
+	void VirtualTerminalClient::complete_transaction_command(bool timedOut)
+	{
+		if (0 != commandAwaitingResponseTransactionID)
+		{
+			for (auto &transaction : transactions)
 			{
-				it++;
+				if (commandAwaitingResponseTransactionID == transaction.transactionID)
+				{
+					transaction.numberOfCompletedCommands++;
+					if (timedOut)
+					{
+						transaction.numberOfTimedOutCommands++;
+					}
+					break;
+				}
 			}
+			commandAwaitingResponseTransactionID = 0;
+		}
+		collect_completed_transactions();
+	}
+
+	void VirtualTerminalClient::collect_completed_transactions()
+	{
+		// Transactions complete in order, so a later one is never reported before the commands of an earlier one are done
+		while ((!transactions.empty()) &&
+		       (transactions.front().ended) &&
+		       (transactions.front().numberOfCompletedCommands >= transactions.front().numberOfCommands))
+		{
+			VTTransactionCompletedEvent event = { this,
+				                                    transactions.front().transactionID,
+				                                    transactions.front().numberOfCommands,
+				                                    transactions.front().numberOfTimedOutCommands };
+			completedTransactions.push_back(event);
+			transactions.pop_front();
+		}
+	}
+
+	void VirtualTerminalClient::dispatch_completed_transactions()
+	{
+		std::vector<VTTransactionCompletedEvent> eventsToDispatch;
+		{
+			LOCK_GUARD(Mutex, commandQueueMutex);
+			eventsToDispatch.swap(completedTransactions);
+		}
+
+		for (const auto &event : eventsToDispatch)
+		{
+			transactionCompletedEventDispatcher.call(event);
 		}
 	}
 
@@ -46,7 +46,7 @@ namespace isobus
 	{
 		if (numericValueStates.find(objectId) != numericValueStates.end())
 		{
-			LOG_WARNING("[VTStateHelper] add_tracked_numeric_value: objectId '%lu' already tracked", objectId);
+			LOG_WARNING("[VTStateHelper] add_tracked_numeric_value: objectId '%u' already tracked", objectId);
 			return;
 		}
 
@@ -57,7 +57,7 @@ namespace isobus
 	{
 		if (numericValueStates.find(objectId) == numericValueStates.end())
 		{
-			LOG_WARNING("[VTStateHelper] remove_tracked_numeric_value: objectId '%lu' was not tracked", objectId);
+			LOG_WARNING("[VTStateHelper] remove_tracked_numeric_value: objectId '%u' was not tracked", objectId);
 			return;
 		}
 
@@ -68,7 +68,7 @@ namespace isobus
 	{
 		if (numericValueStates.find(objectId) == numericValueStates.end())
 		{
-			LOG_WARNING("[VTStateHelper] get_numeric_value: objectId '%lu' not tracked", objectId);
+			LOG_WARNING("[VTStateHelper] get_numeric_value: objectId '%u' not tracked", objectId);
 			return 0;
 		}
 
@@ -99,7 +99,7 @@ namespace isobus
 	{
 		if (softKeyMasks.find(dataOrAlarmMaskId) != softKeyMasks.end())
 		{
-			LOG_WARNING("[VTStateHelper] add_tracked_soft_key_mask: data/alarm mask '%lu' already tracked", dataOrAlarmMaskId);
+			LOG_WARNING("[VTStateHelper] add_tracked_soft_key_mask: data/alarm mask '%u' already tracked", dataOrAlarmMaskId);
 			return;
 		}
 
@@ -110,7 +110,7 @@ namespace isobus
 	{
 		if (softKeyMasks.find(dataOrAlarmMaskId) == softKeyMasks.end())
 		{
-			LOG_WARNING("[VTStateHelper] remove_tracked_soft_key_mask: data/alarm mask '%lu' was not tracked", dataOrAlarmMaskId);
+			LOG_WARNING("[VTStateHelper] remove_tracked_soft_key_mask: data/alarm mask '%u' was not tracked", dataOrAlarmMaskId);
 			return;
 		}
 
@@ -121,7 +121,7 @@ namespace isobus
 	{
 		if (softKeyMasks.find(activeDataOrAlarmMask) == softKeyMasks.end())
 		{
-			LOG_WARNING("[VTStateHelper] get_active_soft_key_mask: the currently active data/alarm mask '%lu' is not tracked", activeDataOrAlarmMask);
+			LOG_WARNING("[VTStateHelper] get_active_soft_key_mask: the currently active data/alarm mask '%u' is not tracked", activeDataOrAlarmMask);
 			return NULL_OBJECT_ID;
 		}
 
@@ -132,7 +132,7 @@ namespace isobus
 	{
 		if (softKeyMasks.find(dataOrAlarmMaskId) == softKeyMasks.end())
 		{
-			LOG_WARNING("[VTStateHelper] get_soft_key_mask: data/alarm mask '%lu' is not tracked", activeDataOrAlarmMask);
+			LOG_WARNING("[VTStateHelper] get_soft_key_mask: data/alarm mask '%u' is not tracked", activeDataOrAlarmMask);
 			return NULL_OBJECT_ID;
 		}
 
@@ -154,7 +154,7 @@ namespace isobus
 		auto &attributeMap = attributeStates.at(objectId);
 		if (attributeMap.find(attribute) != attributeMap.end())
 		{
-			LOG_WARNING("[VTStateHelper] add_tracked_attribute: attribute '%lu' of objectId '%lu' already tracked", attribute, objectId);
+			LOG_WARNING("[VTStateHelper] add_tracked_attribute: attribute '%u' of objectId '%u' already tracked", attribute, objectId);
 			return;
 		}
 
@@ -170,14 +170,14 @@ namespace isobus
 	{
 		if (attributeStates.find(objectId) == attributeStates.end())
 		{
-			LOG_WARNING("[VTStateHelper] remove_tracked_attribute: objectId '%lu' was not tracked", objectId);
+			LOG_WARNING("[VTStateHelper] remove_tracked_attribute: objectId '%u' was not tracked", objectId);
 			return;
 		}
 
 		auto &attributeMap = attributeStates.at(objectId);
 		if (attributeMap.find(attribute) == attributeMap.end())
 		{
-			LOG_WARNING("[VTStateHelper] remove_tracked_attribute: attribute '%lu' of objectId '%lu' was not tracked", attribute, objectId);
+			LOG_WARNING("[VTStateHelper] remove_tracked_attribute: attribute '%u' of objectId '%u' was not tracked", attribute, objectId);
 			return;
 		}
 
@@ -188,14 +188,14 @@ namespace isobus
 	{
 		if (attributeStates.find(objectId) == attributeStates.end())
 		{
-			LOG_WARNING("[VTStateHelper] get_attribute: objectId '%lu' not tracked", objectId);
+			LOG_WARNING("[VTStateHelper] get_attribute: objectId '%u' not tracked", objectId);
 			return 0;
 		}
 
 		const auto &attributeMap = attributeStates.at(objectId);
 		if (attributeMap.find(attribute) == attributeMap.end())
 		{
-			LOG_WARNING("[VTStateHelper] get_attribute: attribute '%lu' of objectId '%lu' not tracked", attribute, objectId);
+			LOG_WARNING("[VTStateHelper] get_attribute: attribute '%u' of objectId '%u' not tracked", attribute, objectId);
 			return 0;
 		}
 
@@ -0,0 +1,245 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_command_queue.cpp
+///
+/// @brief A queue of VT commands waiting to be sent, which coalesces commands that change the
+/// same thing so that only the latest value is sent.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+
+#include "isobus/isobus/isobus_virtual_terminal_command_queue.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace isobus
+{
+	constexpr std::size_t VirtualTerminalCommandQueue::DEFAULT_CAPACITY;
+	constexpr std::uint32_t VirtualTerminalCommandQueue::EMPTY_INDEX_ENTRY;
+
+	const std::uint8_t *VirtualTerminalCommandQueue::Command::data() const
+	{
+		return is_inline() ? inlinePayload.data() : longPayload.data();
+	}
+
+	std::uint32_t VirtualTerminalCommandQueue::Command::size() const
+	{
+		return length;
+	}
+
+	bool VirtualTerminalCommandQueue::Command::is_inline() const
+	{
+		return length <= CAN_DATA_LENGTH;
+	}
+
+	std::vector<std::uint8_t> &VirtualTerminalCommandQueue::Command::get_long_payload()
+	{
+		return longPayload;
+	}
+
+	std::uint32_t VirtualTerminalCommandQueue::Command::get_group() const
+	{
+		return group;
+	}
+
+	VirtualTerminalCommandQueue::VirtualTerminalCommandQueue(std::size_t capacity)
+	{
+		std::size_t roundedCapacity = 1;
+		while (roundedCapacity < capacity)
+		{
+			roundedCapacity <<= 1;
+		}
+		slots.resize(roundedCapacity);
+		index.assign(roundedCapacity * 2, EMPTY_INDEX_ENTRY);
+	}
+
+	bool VirtualTerminalCommandQueue::push(const std::uint8_t *data, std::uint32_t length, std::uint64_t key, bool coalesce, std::uint32_t group)
+	{
+		std::uint32_t existingSlot = coalesce ? find(key, group) : EMPTY_INDEX_ENTRY;
+		Command &command = (EMPTY_INDEX_ENTRY != existingSlot) ? slots[existingSlot] : append(key, coalesce, group);
+
+		command.length = length;
+		if (length <= CAN_DATA_LENGTH)
+		{
+			std::memcpy(command.inlinePayload.data(), data, length);
+		}
+		else
+		{
+			// Reuses the capacity of the slot's buffer if a long command was stored in it before
+			command.longPayload.assign(data, data + length);
+		}
+		return (EMPTY_INDEX_ENTRY != existingSlot);
+	}
+
+	bool VirtualTerminalCommandQueue::push(std::vector<std::uint8_t> &&data, std::uint64_t key, bool coalesce, std::uint32_t group)
+	{
+		if (data.size() <= CAN_DATA_LENGTH)
+		{
+			return push(data.data(), static_cast<std::uint32_t>(data.size()), key, coalesce, group);
+		}
+
+		std::uint32_t existingSlot = coalesce ? find(key, group) : EMPTY_INDEX_ENTRY;
+		Command &command = (EMPTY_INDEX_ENTRY != existingSlot) ? slots[existingSlot] : append(key, coalesce, group);
+
+		command.length = static_cast<std::uint32_t>(data.size());
+		command.longPayload = std::move(data);
+		return (EMPTY_INDEX_ENTRY != existingSlot);
+	}
+
+	VirtualTerminalCommandQueue::Command &VirtualTerminalCommandQueue::front()
+	{
+		return slots[head];
+	}
+
+	void VirtualTerminalCommandQueue::pop()
+	{
+		if (0 != count)
+		{
+			if (slots[head].coalescable)
+			{
+				remove_index_entry(static_cast<std::uint32_t>(head));
+				slots[head].coalescable = false;
+			}
+			head = (head + 1) & (slots.size() - 1);
+			count--;
+		}
+	}
+
+	void VirtualTerminalCommandQueue::clear()
+	{
+		while (0 != count)
+		{
+			slots[head].coalescable = false;
+			head = (head + 1) & (slots.size() - 1);
+			count--;
+		}
+		std::fill(index.begin(), index.end(), EMPTY_INDEX_ENTRY);
+		head = 0;
+	}
+
+	bool VirtualTerminalCommandQueue::empty() const
+	{
+		return (0 == count);
+	}
+
+	std::size_t VirtualTerminalCommandQueue::size() const
+	{
+		return count;
+	}
+
+	std::size_t VirtualTerminalCommandQueue::get_capacity() const
+	{
+		return slots.size();
+	}
+
+	std::uint32_t VirtualTerminalCommandQueue::find(std::uint64_t key, std::uint32_t group) const
+	{
+		const std::size_t mask = index.size() - 1;
+
+		for (std::size_t position = get_home_position(key); EMPTY_INDEX_ENTRY != index[position]; position = (position + 1) & mask)
+		{
+			if ((key == slots[index[position]].key) && (group == slots[index[position]].group))
+			{
+				return index[position];
+			}
+		}
+		return EMPTY_INDEX_ENTRY;
+	}
+
+	VirtualTerminalCommandQueue::Command &VirtualTerminalCommandQueue::append(std::uint64_t key, bool coalesce, std::uint32_t group)
+	{
+		if (count == slots.size())
+		{
+			grow();
+		}
+
+		std::uint32_t slot = static_cast<std::uint32_t>((head + count) & (slots.size() - 1));
+		Command &command = slots[slot];
+		command.key = key;
+		command.coalescable = coalesce;
+		command.group = group;
+		count++;
+
+		if (coalesce)
+		{
+			insert_index_entry(slot);
+		}
+		return command;
+	}
+
+	void VirtualTerminalCommandQueue::insert_index_entry(std::uint32_t slot)
+	{
+		const std::size_t mask = index.size() - 1;
+		std::size_t position = get_home_position(slots[slot].key);
+
+		// The index is twice the size of the ring, so there is always a free position
+		while (EMPTY_INDEX_ENTRY != index[position])
+		{
+			position = (position + 1) & mask;
+		}
+		index[position] = slot;
+	}
+
+	void VirtualTerminalCommandQueue::remove_index_entry(std::uint32_t slot)
+	{
+		const std::size_t mask = index.size() - 1;
+		std::size_t position = get_home_position(slots[slot].key);
+
+		while (slot != index[position])
+		{
+			if (EMPTY_INDEX_ENTRY == index[position])
+			{
+				return;
+			}
+			position = (position + 1) & mask;
+		}
+
+		// Shift back any entry in the same run that would otherwise become unreachable from its home position
+		std::size_t next = position;
+		for (;;)
+		{
+			next = (next + 1) & mask;
+			if (EMPTY_INDEX_ENTRY == index[next])
+			{
+				break;
+			}
+
+			std::size_t home = get_home_position(slots[index[next]].key);
+			bool reachableWithoutHole = (position <= next) ? ((position < home) && (home <= next)) : ((position < home) || (home <= next));
+			if (!reachableWithoutHole)
+			{
+				index[position] = index[next];
+				position = next;
+			}
+		}
+		index[position] = EMPTY_INDEX_ENTRY;
+	}
+
+	std::size_t VirtualTerminalCommandQueue::get_home_position(std::uint64_t key) const
+	{
+		// Fibonacci hashing spreads keys that only differ in a few bytes over the whole index
+		return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & (index.size() - 1);
+	}
+
+	void VirtualTerminalCommandQueue::grow()
+	{
+		std::vector<Command> grownSlots(slots.size() * 2);
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			grownSlots[i] = std::move(slots[(head + i) & (slots.size() - 1)]);
+		}
+		slots.swap(grownSlots);
+		head = 0;
+
+		index.assign(slots.size() * 2, EMPTY_INDEX_ENTRY);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			if (slots[i].coalescable)
+			{
+				insert_index_entry(static_cast<std::uint32_t>(i));
+			}
+		}
+	}
+} // namespace isobus
@@ -9,6 +9,8 @@
 #include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_server_managed_working_set.hpp"
 
+#include <cstring>
+
 namespace isobus
 {
 	VTColourTable::VTColourTable()
@@ -8623,4 +8625,511 @@ namespace isobus
 		pointerType = type;
 	}
 
+	std::uint32_t get_minimum_object_length(VirtualTerminalObjectType type)
+	{
+		std::uint32_t retVal = 0;
+
+		switch (type)
+		{
+			case VirtualTerminalObjectType::WorkingSet:
+			{
+				retVal = 10;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputList:
+			case VirtualTerminalObjectType::ExternalReferenceNAME:
+			case VirtualTerminalObjectType::ObjectLabelRefrenceList:
+			{
+				retVal = 12;
+			}
+			break;
+
+			case VirtualTerminalObjectType::AlarmMask:
+			case VirtualTerminalObjectType::Container:
+			case VirtualTerminalObjectType::KeyGroup:
+			{
+				retVal = 10;
+			}
+			break;
+
+			case VirtualTerminalObjectType::ExternalObjectPointer:
+			{
+				retVal = 9;
+			}
+			break;
+
+			case VirtualTerminalObjectType::SoftKeyMask:
+			case VirtualTerminalObjectType::ColourMap:
+			{
+				retVal = 6;
+			}
+			break;
+
+			case VirtualTerminalObjectType::Key:
+			case VirtualTerminalObjectType::NumberVariable:
+			case VirtualTerminalObjectType::InputAttributes:
+			{
+				retVal = 7;
+			}
+			break;
+
+			case VirtualTerminalObjectType::Button:
+			case VirtualTerminalObjectType::InputBoolean:
+			case VirtualTerminalObjectType::OutputRectangle:
+			case VirtualTerminalObjectType::InputList:
+			case VirtualTerminalObjectType::ExternalObjectDefinition:
+			{
+				retVal = 13;
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputString:
+			{
+				retVal = 19;
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputNumber:
+			{
+				retVal = 38;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputString:
+			{
+				retVal = 17;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputNumber:
+			{
+				retVal = 29;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputLine:
+			{
+				retVal = 11;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputEllipse:
+			{
+				retVal = 15;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputPolygon:
+			{
+				retVal = 14;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputMeter:
+			{
+				retVal = 21;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputLinearBarGraph:
+			{
+				retVal = 24;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputArchedBarGraph:
+			{
+				retVal = 27;
+			}
+			break;
+
+			case VirtualTerminalObjectType::PictureGraphic:
+			case VirtualTerminalObjectType::Animation:
+			case VirtualTerminalObjectType::WindowMask:
+			{
+				retVal = 17;
+			}
+			break;
+
+			case VirtualTerminalObjectType::StringVariable:
+			case VirtualTerminalObjectType::ExtendedInputAttributes:
+			case VirtualTerminalObjectType::ObjectPointer:
+			case VirtualTerminalObjectType::Macro:
+			{
+				retVal = 5;
+			}
+			break;
+
+			case VirtualTerminalObjectType::FontAttributes:
+			case VirtualTerminalObjectType::LineAttributes:
+			case VirtualTerminalObjectType::FillAttributes:
+			case VirtualTerminalObjectType::DataMask:
+			{
+				retVal = 8;
+			}
+			break;
+
+			case VirtualTerminalObjectType::GraphicsContext:
+			{
+				retVal = 34;
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryFunctionType1:
+			case VirtualTerminalObjectType::AuxiliaryFunctionType2:
+			case VirtualTerminalObjectType::AuxiliaryInputType2:
+			{
+				retVal = 6;
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryInputType1:
+			{
+				retVal = 7;
+			}
+			break;
+
+			default:
+			{
+				// Unknown object type
+			}
+			break;
+		}
+		return retVal;
+	}
+
+	std::uint32_t get_number_bytes_in_object(const std::uint8_t *buffer, std::uint32_t bufferLength)
+	{
+		constexpr std::uint32_t PADDED_HEADER_LENGTH = 64; // Longer than the fixed part of any object
+		std::uint8_t paddedHeader[PADDED_HEADER_LENGTH] = { 0 };
+
+		if (bufferLength < 3)
+		{
+			return 0;
+		}
+		else if (bufferLength < PADDED_HEADER_LENGTH)
+		{
+			// Read the header of a short object from a zero padded copy, so nothing past the end of the buffer is read
+			memcpy(paddedHeader, buffer, bufferLength);
+			buffer = paddedHeader;
+		}
+
+		auto currentObjectType = static_cast<VirtualTerminalObjectType>(buffer[2]);
+		std::uint32_t retVal = get_minimum_object_length(currentObjectType);
+
+		switch (currentObjectType)
+		{
+			case VirtualTerminalObjectType::WorkingSet:
+			{
+				const std::uint32_t sizeOfChildObjects = (buffer[7] * 6);
+				const std::uint32_t sizeOfMacros = (buffer[8] * 2);
+				const std::uint32_t sizeOfLanguageCodes = (buffer[9] * 2);
+				retVal += (sizeOfLanguageCodes + sizeOfChildObjects + sizeOfMacros);
+			}
+			break;
+
+			case VirtualTerminalObjectType::DataMask:
+			{
+				const std::uint32_t sizeOfChildObjects = (buffer[6] * 6);
+				const std::uint32_t sizeOfMacros = (buffer[7] * 2);
+				retVal += (sizeOfChildObjects + sizeOfMacros);
+			}
+			break;
+
+			case VirtualTerminalObjectType::AlarmMask:
+			case VirtualTerminalObjectType::Container:
+			{
+				const std::uint32_t sizeOfChildObjects = (buffer[8] * 6);
+				const std::uint32_t sizeOfMacros = (buffer[9] * 2);
+				retVal += (sizeOfChildObjects + sizeOfMacros);
+			}
+			break;
+
+			case VirtualTerminalObjectType::SoftKeyMask:
+			{
+				const std::uint32_t sizeOfChildObjects = (buffer[4] * 2);
+				const std::uint32_t sizeOfMacros = (buffer[5] * 2);
+				retVal += (sizeOfChildObjects + sizeOfMacros);
+			}
+			break;
+
+			case VirtualTerminalObjectType::Key:
+			{
+				const std::uint32_t sizeOfChildObjects = (buffer[5] * 6);
+				const std::uint32_t sizeOfMacros = (buffer[6] * 2);
+				retVal += (sizeOfChildObjects + sizeOfMacros);
+			}
+			break;
+
+			case VirtualTerminalObjectType::Button:
+			{
+				const std::uint32_t sizeOfChildObjects = (buffer[11] * 6);
+				const std::uint32_t sizeOfMacros = (buffer[12] * 2);
+				retVal += (sizeOfChildObjects + sizeOfMacros);
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputBoolean:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[12] * 2);
+				retVal += sizeOfMacros;
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputString:
+			{
+				const std::uint32_t sizeOfValue = buffer[16];
+				const std::uint32_t sizeOfMacros = ((18 + sizeOfValue) < bufferLength) ? (buffer[18 + sizeOfValue] * 2) : 0;
+				retVal += (sizeOfValue + sizeOfMacros);
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputNumber:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[37] * 2);
+				retVal += sizeOfMacros;
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputList:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[12] * 2);
+				const std::uint32_t sizeOfListObjectIDs = (buffer[10] * 2);
+				retVal += (sizeOfMacros + sizeOfListObjectIDs);
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputString:
+			{
+				const std::uint32_t sizeOfValue = (static_cast<uint16_t>(buffer[14]) | static_cast<uint16_t>(buffer[15] << 8));
+				const std::uint32_t sizeOfMacros = ((16 + sizeOfValue) < bufferLength) ? (buffer[16 + sizeOfValue] * 2) : 0;
+				retVal += (sizeOfMacros + sizeOfValue);
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputNumber:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[28] * 2);
+				retVal += sizeOfMacros;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputList:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[11] * 2);
+				const std::uint32_t sizeOfListObjectIDs = (buffer[10] * 2);
+				retVal += (sizeOfMacros + sizeOfListObjectIDs);
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputLine:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[10] * 2);
+				retVal += sizeOfMacros;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputRectangle:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[12] * 2);
+				retVal += sizeOfMacros;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputEllipse:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[14] * 2);
+				retVal += sizeOfMacros;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputPolygon:
+			{
+				const std::uint32_t sizeOfPoints = (buffer[12] * 4);
+				const std::uint32_t sizeOfMacros = (buffer[13] * 2);
+				retVal += (sizeOfMacros + sizeOfPoints);
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputMeter:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[20] * 2);
+				retVal += sizeOfMacros;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputLinearBarGraph:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[23] * 2);
+				retVal += sizeOfMacros;
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputArchedBarGraph:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[26] * 2);
+				retVal += sizeOfMacros;
+			}
+			break;
+
+			case VirtualTerminalObjectType::PictureGraphic:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[16] * 2);
+				const std::uint32_t sizeOfRawData = (static_cast<std::uint32_t>(buffer[12]) |
+				                                     (static_cast<std::uint32_t>(buffer[13]) << 8) |
+				                                     (static_cast<std::uint32_t>(buffer[14]) << 16) |
+				                                     (static_cast<std::uint32_t>(buffer[15]) << 24));
+				retVal += (sizeOfRawData + sizeOfMacros);
+			}
+			break;
+
+			case VirtualTerminalObjectType::ObjectPointer:
+			case VirtualTerminalObjectType::NumberVariable:
+			case VirtualTerminalObjectType::GraphicsContext:
+			case VirtualTerminalObjectType::ExternalReferenceNAME:
+			case VirtualTerminalObjectType::ExternalObjectPointer:
+			case VirtualTerminalObjectType::AuxiliaryControlDesignatorType2:
+			{
+				// No additional length
+			}
+			break;
+
+			case VirtualTerminalObjectType::StringVariable:
+			{
+				const std::uint32_t sizeOfValue = (static_cast<uint16_t>(buffer[3]) | static_cast<uint16_t>(buffer[4]) << 8);
+				retVal += sizeOfValue;
+			}
+			break;
+
+			case VirtualTerminalObjectType::FontAttributes:
+			case VirtualTerminalObjectType::LineAttributes:
+			case VirtualTerminalObjectType::FillAttributes:
+			{
+				const std::uint32_t sizeOfMacros = (buffer[7] * 2);
+				retVal += sizeOfMacros;
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputAttributes:
+			{
+				const std::uint32_t sizeOfValidationString = buffer[4];
+				const std::uint32_t sizeOfMacros = ((5 + sizeOfValidationString) < bufferLength) ? (buffer[5 + sizeOfValidationString] * 2) : 0;
+				retVal += (sizeOfMacros + sizeOfValidationString);
+			}
+			break;
+
+			case VirtualTerminalObjectType::ExtendedInputAttributes:
+			{
+				const std::uint32_t numberOfCodePlanes = buffer[5];
+				retVal += (numberOfCodePlanes * 2); // Doesn't include the character ranges, need to handle those externally
+			}
+			break;
+
+			case VirtualTerminalObjectType::Macro:
+			{
+				const std::uint32_t numberOfMacroBytes = (static_cast<std::uint16_t>(buffer[3]) | (static_cast<std::uint16_t>(buffer[4]) << 8));
+				retVal += numberOfMacroBytes;
+			}
+			break;
+
+			case VirtualTerminalObjectType::ColourMap:
+			{
+				const std::uint32_t numberIndexes = (static_cast<std::uint16_t>(buffer[3]) | (static_cast<std::uint16_t>(buffer[4]) << 8));
+				retVal += numberIndexes;
+			}
+			break;
+
+			case VirtualTerminalObjectType::WindowMask:
+			{
+				const std::uint32_t sizeOfReferences = (buffer[14] * 2);
+				const std::uint32_t numberObjects = (buffer[15] * 6);
+				const std::uint32_t sizeOfMacros = (buffer[16] * 2);
+				retVal += (sizeOfMacros + numberObjects + sizeOfReferences);
+			}
+			break;
+
+			case VirtualTerminalObjectType::KeyGroup:
+			{
+				const std::uint32_t numberObjects = (buffer[8] * 2);
+				const std::uint32_t sizeOfMacros = (buffer[9] * 2);
+				retVal += (numberObjects + sizeOfMacros);
+				retVal += (sizeOfMacros + numberObjects);
+			}
+			break;
+
+			case VirtualTerminalObjectType::ObjectLabelRefrenceList:
+			{
+				const std::uint32_t sizeOfLabeledObjects = ((static_cast<uint16_t>(buffer[4]) | static_cast<uint16_t>(buffer[5]) << 8) * 7);
+				retVal += sizeOfLabeledObjects;
+			}
+			break;
+
+			case VirtualTerminalObjectType::ExternalObjectDefinition:
+			{
+				const std::uint32_t sizeOfObjects = (buffer[12] * 2);
+				retVal += sizeOfObjects;
+			}
+			break;
+
+			case VirtualTerminalObjectType::Animation:
+			{
+				const std::uint32_t sizeOfObjects = (buffer[15] * 6);
+				const std::uint32_t sizeOfMacros = (buffer[16] * 2);
+				retVal += (sizeOfMacros + sizeOfObjects);
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryFunctionType1:
+			case VirtualTerminalObjectType::AuxiliaryFunctionType2:
+			{
+				const std::uint32_t sizeOfObjects = (buffer[5] * 6);
+				retVal += sizeOfObjects;
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryInputType1:
+			case VirtualTerminalObjectType::AuxiliaryInputType2:
+			{
+				const std::uint32_t sizeOfObjects = (buffer[6] * 6);
+				retVal += sizeOfObjects;
+			}
+			break;
+
+			default:
+			{
+				// Unknown object type, so the length can't be known
+				retVal = 0;
+			}
+			break;
+		}
+
+		if (retVal > bufferLength)
+		{
+			// The object doesn't fit in the buffer, a variable length part may have been read from the padding
+			retVal = 0;
+		}
+		return retVal;
+	}
+
+	bool find_object_offsets(const std::uint8_t *pool, std::uint32_t size, std::vector<std::uint32_t> &offsets)
+	{
+		std::uint32_t offset = 0;
+
+		offsets.clear();
+		while (offset < size)
+		{
+			std::uint32_t objectSize = get_number_bytes_in_object(&pool[offset], size - offset);
+
+			if (0 == objectSize)
+			{
+				offsets.clear();
+				return false;
+			}
+			offsets.push_back(offset);
+			offset += objectSize;
+		}
+		return true;
+	}
+
 } // namespace isobus
@@ -292,7 +292,7 @@ namespace isobus
 							{
 								case Function::ObjectPoolTransferMessage:
 								{
-									auto tempPool = data; // Make a copy of the data (ouch)
+									std::vector<std::uint8_t> tempPool = data; // Make a copy of the data (ouch)
 									tempPool.erase(tempPool.begin()); // Strip off the mux byte (double ouch, good thing this is rare)
 									LOG_INFO("[VT Server]: An ecu at address %u transferred %u bytes of object pool data to us.", message.get_identifier().get_source_address(), static_cast<std::uint32_t>(tempPool.size()));
 									cf->add_iop_raw_data(tempPool);
@@ -307,11 +307,11 @@ namespace isobus
 
 									if (!isEnoughMemory)
 									{
-										LOG_WARNING("[VT Server]: Callback indicated there is NOT enough memory.", requiredMemory);
+										LOG_WARNING("[VT Server]: Callback indicated there is NOT enough memory for %u bytes.", requiredMemory);
 									}
 									else
 									{
-										LOG_DEBUG("[VT Server]: Callback indicated there may be enough memory, but since there is overhead associated to object storage it is impossible to be sure.", requiredMemory);
+										LOG_DEBUG("[VT Server]: Callback indicated there may be enough memory for %u bytes, but since there is overhead associated to object storage it is impossible to be sure.", requiredMemory);
 									}
 									cf->set_iop_size(requiredMemory);
 
@@ -1132,7 +1132,7 @@ namespace isobus
 									}
 									else
 									{
-										LOG_WARNING("[VT Server]: Client %u change child position error. DLC must be 9 bytes for the message to be valid.");
+										LOG_WARNING("[VT Server]: Client %u change child position error. DLC must be 9 bytes for the message to be valid.", cf->get_control_function()->get_address());
 										parentServer->send_change_child_position_response(parentObjectId, objectID, (1 << static_cast<std::uint8_t>(ChangeChildLocationorPositionErrorBit::AnyOtherError)), message.get_source_control_function());
 									}
 								}
@@ -1483,7 +1483,7 @@ namespace isobus
 											case VirtualTerminalObjectType::WindowMask:
 											{
 												targetObject->set_background_color(backgroundColour);
-												LOG_DEBUG("[VT Server]: Client %u change background colour command: colour = %u", cf->get_control_function()->get_address(), objectID, backgroundColour);
+												LOG_DEBUG("[VT Server]: Client %u change background colour command: object %u, colour = %u", cf->get_control_function()->get_address(), objectID, backgroundColour);
 												parentServer->send_change_background_colour_response(objectID, 0, backgroundColour, message.get_source_control_function());
 												parentServer->process_macro(targetObject, EventID::OnChangeBackgroundColour, targetObject->get_object_type(), cf);
 												parentServer->onRepaintEventDispatcher.call(cf);
@@ -1576,14 +1576,14 @@ namespace isobus
 													}
 													else
 													{
-														LOG_WARNING("[VT Server]: Client %u select input object command: Illegal option byte", cf->get_control_function()->get_address(), objectID);
+														LOG_WARNING("[VT Server]: Client %u select input object command: Illegal option byte for object %u", cf->get_control_function()->get_address(), objectID);
 														parentServer->send_select_input_object_response(objectID, (1 << static_cast<std::uint8_t>(SelectInputObjectErrorBit::InvalidOptionValue)), SelectInputObjectResponse::ObjectIsNotSelectedOrIsNullOrError, message.get_source_control_function());
 													}
 												}
 												else
 												{
 													parentServer->send_select_input_object_response(objectID, (1 << static_cast<std::uint8_t>(SelectInputObjectErrorBit::AnyOtherError)), SelectInputObjectResponse::ObjectIsNotSelectedOrIsNullOrError, message.get_source_control_function());
-													LOG_WARNING("[VT Server]: Client %u select input object command: buttons and keys can only be selected when the server is version 4 or higher.", cf->get_control_function()->get_address(), objectID);
+													LOG_WARNING("[VT Server]: Client %u select input object command: buttons and keys can only be selected when the server is version 4 or higher, object %u", cf->get_control_function()->get_address(), objectID);
 												}
 											}
 											break;
@@ -1612,7 +1612,7 @@ namespace isobus
 												}
 												else
 												{
-													LOG_WARNING("[VT Server]: Client %u select input object command: Illegal option byte", cf->get_control_function()->get_address(), objectID);
+													LOG_WARNING("[VT Server]: Client %u select input object command: Illegal option byte for object %u", cf->get_control_function()->get_address(), objectID);
 													parentServer->send_select_input_object_response(objectID, (1 << static_cast<std::uint8_t>(SelectInputObjectErrorBit::InvalidOptionValue)), SelectInputObjectResponse::ObjectIsNotSelectedOrIsNullOrError, message.get_source_control_function());
 												}
 											}
@@ -1620,7 +1620,7 @@ namespace isobus
 
 											default:
 											{
-												LOG_WARNING("[VT Server]: Client %u select input object command: invalid object type", cf->get_control_function()->get_address(), objectID);
+												LOG_WARNING("[VT Server]: Client %u select input object command: invalid object type for object %u", cf->get_control_function()->get_address(), objectID);
 												parentServer->send_select_input_object_response(objectID, (1 << static_cast<std::uint8_t>(SelectInputObjectErrorBit::AnyOtherError)), SelectInputObjectResponse::ObjectIsNotSelectedOrIsNullOrError, message.get_source_control_function());
 											}
 											break;
@@ -1658,7 +1658,7 @@ namespace isobus
 											}
 											else
 											{
-												LOG_ERROR("[VT Server]: Client %u execute macro command: failed. Macro probably contains invalid commands. Object pool state may now be undefined!", cf->get_control_function()->get_address(), objectID);
+												LOG_ERROR("[VT Server]: Client %u execute macro command: macro %u failed. Macro probably contains invalid commands. Object pool state may now be undefined!", cf->get_control_function()->get_address(), objectID);
 												parentServer->send_execute_macro_or_extended_macro_response(objectID, (1 << static_cast<std::uint8_t>(ExecuteMacroResponseErrorBit::AnyOtherError)), message.get_source_control_function(), false);
 											}
 										}
@@ -1692,7 +1692,7 @@ namespace isobus
 											}
 											else
 											{
-												LOG_ERROR("[VT Server]: Client %u execute extended macro command: failed. Macro probably contains invalid commands. Object pool state may now be undefined!", cf->get_control_function()->get_address(), objectID);
+												LOG_ERROR("[VT Server]: Client %u execute extended macro command: macro %u failed. Macro probably contains invalid commands. Object pool state may now be undefined!", cf->get_control_function()->get_address(), objectID);
 												parentServer->send_execute_macro_or_extended_macro_response(objectID, (1 << static_cast<std::uint8_t>(ExecuteMacroResponseErrorBit::AnyOtherError)), message.get_source_control_function(), true);
 											}
 										}
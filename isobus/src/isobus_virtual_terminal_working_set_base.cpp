@@ -12,10 +12,19 @@
 #include "isobus/isobus/can_stack_logger.hpp"
 #include "isobus/utility/to_string.hpp"
 
+#include <algorithm>
 #include <cstring>
 
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+#include <system_error>
+#include <thread>
+#endif
+
 namespace isobus
 {
+	constexpr std::size_t VirtualTerminalWorkingSetBase::DEFAULT_MAX_PARSING_THREADS;
+	constexpr std::size_t VirtualTerminalWorkingSetBase::MIN_OBJECTS_PER_PARSING_THREAD;
+
 	std::uint16_t VirtualTerminalWorkingSetBase::get_object_pool_faulting_object_id()
 	{
 		std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
@@ -60,7 +69,7 @@ namespace isobus
 		return retVal;
 	}
 
-	bool VirtualTerminalWorkingSetBase::parse_next_object(std::uint8_t *&iopData, std::uint32_t &iopLength)
+	bool VirtualTerminalWorkingSetBase::parse_object(std::uint8_t *&iopData, std::uint32_t &iopLength, std::shared_ptr<VTObject> &parsedObject) const
 	{
 		bool retVal = false;
 
@@ -74,124 +83,114 @@ namespace isobus
 			{
 				case VirtualTerminalObjectType::WorkingSet:
 				{
-					if ((NULL_OBJECT_ID == workingSetID) ||
-					    ((nullptr != get_object_by_id(workingSetID)) &&
-					     (get_object_by_id(workingSetID)->get_id() == decodedID)))
-					{
-						workingSetID = decodedID;
-						auto tempObject = std::make_shared<WorkingSet>();
+					auto tempObject = std::make_shared<WorkingSet>();
 
-						if (iopLength >= tempObject->get_minumum_object_length())
-						{
-							tempObject->set_id(decodedID);
-							tempObject->set_background_color(iopData[3]);
-							tempObject->set_selectable(iopData[4]);
-							tempObject->set_active_mask(static_cast<std::uint16_t>(iopData[5]) | (static_cast<std::uint16_t>(iopData[6]) << 8));
+					if (iopLength >= tempObject->get_minumum_object_length())
+					{
+						tempObject->set_id(decodedID);
+						tempObject->set_background_color(iopData[3]);
+						tempObject->set_selectable(iopData[4]);
+						tempObject->set_active_mask(static_cast<std::uint16_t>(iopData[5]) | (static_cast<std::uint16_t>(iopData[6]) << 8));
 
-							// Now add child objects
-							const std::uint8_t childrenToFollow = iopData[7];
-							const std::uint16_t sizeOfChildren = (childrenToFollow * 6); // ID, X, Y 2 bytes each
-							const std::uint8_t numberOfMacrosToFollow = iopData[8];
-							const std::uint16_t sizeOfMacros = (numberOfMacrosToFollow * 2);
-							const std::uint8_t numberOfLanguagesToFollow = iopData[9];
-							iopLength -= 10; // Subtract the bytes we've processed so far.
-							iopData += 10; // Move the pointer
+						// Now add child objects
+						const std::uint8_t childrenToFollow = iopData[7];
+						const std::uint16_t sizeOfChildren = (childrenToFollow * 6); // ID, X, Y 2 bytes each
+						const std::uint8_t numberOfMacrosToFollow = iopData[8];
+						const std::uint16_t sizeOfMacros = (numberOfMacrosToFollow * 2);
+						const std::uint8_t numberOfLanguagesToFollow = iopData[9];
+						iopLength -= 10; // Subtract the bytes we've processed so far.
+						iopData += 10; // Move the pointer
 
-							if (iopLength >= sizeOfChildren)
+						if (iopLength >= sizeOfChildren)
+						{
+							for (std::uint_fast8_t i = 0; i < childrenToFollow; i++)
 							{
-								for (std::uint_fast8_t i = 0; i < childrenToFollow; i++)
-								{
-									std::uint16_t childID = (static_cast<std::uint16_t>(iopData[0]) | (static_cast<std::uint16_t>(iopData[1]) << 8));
-									auto childX = static_cast<std::int16_t>(static_cast<std::int16_t>(iopData[2]) | (static_cast<std::int16_t>(iopData[3]) << 8));
-									auto childY = static_cast<std::int16_t>(static_cast<std::int16_t>(iopData[4]) | (static_cast<std::int16_t>(iopData[5]) << 8));
-									tempObject->add_child(childID, childX, childY);
-									iopLength -= 6;
-									iopData += 6;
-								}
+								std::uint16_t childID = (static_cast<std::uint16_t>(iopData[0]) | (static_cast<std::uint16_t>(iopData[1]) << 8));
+								auto childX = static_cast<std::int16_t>(static_cast<std::int16_t>(iopData[2]) | (static_cast<std::int16_t>(iopData[3]) << 8));
+								auto childY = static_cast<std::int16_t>(static_cast<std::int16_t>(iopData[4]) | (static_cast<std::int16_t>(iopData[5]) << 8));
+								tempObject->add_child(childID, childX, childY);
+								iopLength -= 6;
+								iopData += 6;
+							}
 
-								// Next, parse macro list
-								if (iopLength >= sizeOfMacros)
+							// Next, parse macro list
+							if (iopLength >= sizeOfMacros)
+							{
+								for (std::uint_fast8_t i = 0; i < numberOfMacrosToFollow; i++)
 								{
-									for (std::uint_fast8_t i = 0; i < numberOfMacrosToFollow; i++)
+									// If the first byte is 255, then more bytes are used! 4.6.22.3
+									if (iopData[0] == static_cast<std::uint8_t>(EventID::UseExtendedMacroReference))
 									{
-										// If the first byte is 255, then more bytes are used! 4.6.22.3
-										if (iopData[0] == static_cast<std::uint8_t>(EventID::UseExtendedMacroReference))
-										{
-											std::uint16_t macroID = (static_cast<std::uint16_t>(iopData[1]) | (static_cast<std::uint16_t>(iopData[3]) << 8));
+										std::uint16_t macroID = (static_cast<std::uint16_t>(iopData[1]) | (static_cast<std::uint16_t>(iopData[3]) << 8));
 
-											if (EventID::Reserved != get_event_from_byte(iopData[2]))
-											{
-												tempObject->add_macro({ get_event_from_byte(iopData[2]), macroID });
-												retVal = true;
-											}
-											else
-											{
-												LOG_ERROR("[WS]: Macro with ID %u which is listed as part of object %u has an invalid or unsupported event ID.", macroID, decodedID);
-												retVal = false;
-												break;
-											}
+										if (EventID::Reserved != get_event_from_byte(iopData[2]))
+										{
+											tempObject->add_macro({ get_event_from_byte(iopData[2]), macroID });
+											retVal = true;
 										}
 										else
 										{
-											if (EventID::Reserved != get_event_from_byte(iopData[0]))
-											{
-												tempObject->add_macro({ get_event_from_byte(iopData[0]), iopData[1] });
-												retVal = true;
-											}
-											else
-											{
-												LOG_ERROR("[WS]: Macro with ID %u which is listed as part of object %u has an invalid or unsupported event ID.", iopData[1], decodedID);
-												retVal = false;
-												break;
-											}
+											LOG_ERROR("[WS]: Macro with ID %u which is listed as part of object %u has an invalid or unsupported event ID.", macroID, decodedID);
+											retVal = false;
+											break;
 										}
-
-										iopLength -= 2;
-										iopData += 2;
 									}
-
-									// Next, parse language list
-									if (iopLength >= static_cast<uint16_t>(numberOfLanguagesToFollow * 2))
+									else
 									{
-										for (std::uint_fast8_t i = 0; i < numberOfLanguagesToFollow; i++)
+										if (EventID::Reserved != get_event_from_byte(iopData[0]))
 										{
-											std::string langCode;
-											langCode.push_back(static_cast<char>(iopData[0]));
-											langCode.push_back(static_cast<char>(iopData[1]));
-											iopLength -= 2;
-											iopData += 2;
-											LOG_DEBUG("[WS]: IOP Language parsed: " + langCode);
+											tempObject->add_macro({ get_event_from_byte(iopData[0]), iopData[1] });
+											retVal = true;
+										}
+										else
+										{
+											LOG_ERROR("[WS]: Macro with ID %u which is listed as part of object %u has an invalid or unsupported event ID.", iopData[1], decodedID);
+											retVal = false;
+											break;
 										}
 									}
-									else
+
+									iopLength -= 2;
+									iopData += 2;
+								}
+
+								// Next, parse language list
+								if (iopLength >= static_cast<uint16_t>(numberOfLanguagesToFollow * 2))
+								{
+									for (std::uint_fast8_t i = 0; i < numberOfLanguagesToFollow; i++)
 									{
-										LOG_ERROR("[WS]: Not enough IOP data to parse working set language codes for object " + isobus::to_string(static_cast<int>(decodedID)));
+										std::string langCode;
+										langCode.push_back(static_cast<char>(iopData[0]));
+										langCode.push_back(static_cast<char>(iopData[1]));
+										iopLength -= 2;
+										iopData += 2;
+										LOG_DEBUG("[WS]: IOP Language parsed: " + langCode);
 									}
-									retVal = true;
 								}
 								else
 								{
-									LOG_ERROR("[WS]: Not enough IOP data to parse working set macros for object " + isobus::to_string(static_cast<int>(decodedID)));
+									LOG_ERROR("[WS]: Not enough IOP data to parse working set language codes for object " + isobus::to_string(static_cast<int>(decodedID)));
 								}
+								retVal = true;
 							}
 							else
 							{
-								LOG_ERROR("[WS]: Not enough IOP data to parse working set children for object " + isobus::to_string(static_cast<int>(decodedID)));
+								LOG_ERROR("[WS]: Not enough IOP data to parse working set macros for object " + isobus::to_string(static_cast<int>(decodedID)));
 							}
 						}
 						else
 						{
-							LOG_ERROR("[WS]: Not enough IOP data to parse working set object " + isobus::to_string(static_cast<int>(decodedID)));
-						}
-
-						if (retVal)
-						{
-							retVal = add_or_replace_object(tempObject);
+							LOG_ERROR("[WS]: Not enough IOP data to parse working set children for object " + isobus::to_string(static_cast<int>(decodedID)));
 						}
 					}
 					else
 					{
-						LOG_ERROR("[WS]: Multiple working set objects are not allowed in the object pool. Faulting object " + isobus::to_string(static_cast<int>(decodedID)));
+						LOG_ERROR("[WS]: Not enough IOP data to parse working set object " + isobus::to_string(static_cast<int>(decodedID)));
+					}
+
+					if (retVal)
+					{
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -288,7 +287,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -408,7 +407,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -515,7 +514,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -711,7 +710,7 @@ namespace isobus
 
 							if (retVal)
 							{
-								retVal = add_or_replace_object(tempObject);
+								parsedObject = tempObject;
 							}
 						}
 					}
@@ -814,7 +813,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -913,7 +912,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -974,7 +973,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1040,7 +1039,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1084,7 +1083,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1151,7 +1150,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1228,7 +1227,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1289,7 +1288,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1353,7 +1352,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1422,7 +1421,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1478,7 +1477,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1529,7 +1528,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1572,7 +1571,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1625,7 +1624,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1693,7 +1692,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1739,7 +1738,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1784,7 +1783,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1831,7 +1830,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2055,7 +2054,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2082,7 +2081,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2125,7 +2124,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2173,7 +2172,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2210,7 +2209,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2255,7 +2254,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2322,7 +2321,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2356,7 +2355,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2376,7 +2375,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2406,7 +2405,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2530,7 +2529,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2586,7 +2585,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2641,7 +2640,7 @@ namespace isobus
 						}
 						else
 						{
-							LOG_ERROR("[WS]: Auxiliary input type 1 object %u has an invalid function type. Function type must be 2 or less.");
+							LOG_ERROR("[WS]: Auxiliary input type 1 object %u has an invalid function type. Function type must be 2 or less.", decodedID);
 						}
 					}
 					else
@@ -2651,7 +2650,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2712,7 +2711,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2776,7 +2775,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2799,7 +2798,7 @@ namespace isobus
 						}
 						else
 						{
-							LOG_ERROR("[WS]: Auxiliary control designator type 2 object %u  has an invalid pointer type. Pointer type must be 3 or less.");
+							LOG_ERROR("[WS]: Auxiliary control designator type 2 object %u has an invalid pointer type. Pointer type must be 3 or less.", decodedID);
 						}
 					}
 					else
@@ -2809,7 +2808,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2820,7 +2819,20 @@ namespace isobus
 				}
 				break;
 			}
+		}
+		return retVal;
+	}
+
+	bool VirtualTerminalWorkingSetBase::parse_next_object(std::uint8_t *&iopData, std::uint32_t &iopLength)
+	{
+		std::shared_ptr<VTObject> parsedObject;
+		bool retVal = false;
+
+		if (iopLength > 3)
+		{
+			auto decodedID = static_cast<uint16_t>(static_cast<std::uint16_t>(iopData[0]) | (static_cast<std::uint16_t>(iopData[1]) << 8));
 
+			retVal = parse_object(iopData, iopLength, parsedObject) && add_parsed_object(parsedObject);
 			if (!retVal)
 			{
 				set_object_pool_faulting_object_id(decodedID);
@@ -2829,6 +2841,32 @@ namespace isobus
 		return retVal;
 	}
 
+	bool VirtualTerminalWorkingSetBase::add_parsed_object(std::shared_ptr<VTObject> parsedObject)
+	{
+		bool retVal = false;
+
+		if ((nullptr != parsedObject) &&
+		    (VirtualTerminalObjectType::WorkingSet == parsedObject->get_object_type()))
+		{
+			if ((NULL_OBJECT_ID == workingSetID) ||
+			    ((nullptr != get_object_by_id(workingSetID)) &&
+			     (get_object_by_id(workingSetID)->get_id() == parsedObject->get_id())))
+			{
+				workingSetID = parsedObject->get_id();
+				retVal = add_or_replace_object(parsedObject);
+			}
+			else
+			{
+				LOG_ERROR("[WS]: Multiple working set objects are not allowed in the object pool. Faulting object " + isobus::to_string(static_cast<int>(parsedObject->get_id())));
+			}
+		}
+		else
+		{
+			retVal = add_or_replace_object(parsedObject);
+		}
+		return retVal;
+	}
+
 	std::shared_ptr<VTObject> VirtualTerminalWorkingSetBase::get_object_by_id(std::uint16_t objectID)
 	{
 		return vtObjectTree[objectID];
@@ -2907,6 +2945,27 @@ namespace isobus
 
 		if (iopLength > 0)
 		{
+			std::vector<std::uint32_t> objectOffsets;
+			std::size_t numberOfThreads = get_object_pool_parsing_threads();
+
+			// Only split the pool up if every thread gets enough objects to be worth starting it
+			if ((numberOfThreads > 1) &&
+			    find_object_offsets(iopData, iopLength, objectOffsets))
+			{
+				numberOfThreads = std::min(numberOfThreads, objectOffsets.size() / MIN_OBJECTS_PER_PARSING_THREAD);
+			}
+			else
+			{
+				numberOfThreads = 1;
+			}
+
+			if ((numberOfThreads > 1) &&
+			    parse_objects_in_parallel(iopData, iopLength, objectOffsets, numberOfThreads, retVal))
+			{
+				return retVal;
+			}
+			lastObjectPoolParsingThreads = 1;
+
 			while (remainingLength > 0)
 			{
 				if (!parse_next_object(currentIopPointer, remainingLength))
@@ -2924,6 +2983,115 @@ namespace isobus
 		return retVal;
 	}
 
+	void VirtualTerminalWorkingSetBase::set_object_pool_parsing_threads(std::size_t numberOfThreads)
+	{
+		objectPoolParsingThreads = numberOfThreads;
+	}
+
+	std::size_t VirtualTerminalWorkingSetBase::get_object_pool_parsing_threads() const
+	{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		if (0 == objectPoolParsingThreads)
+		{
+			// hardware_concurrency may return 0 if it is unknown
+			return std::max<std::size_t>(1, std::min<std::size_t>(std::thread::hardware_concurrency(), DEFAULT_MAX_PARSING_THREADS));
+		}
+		return objectPoolParsingThreads;
+#else
+		return 1;
+#endif
+	}
+
+	std::size_t VirtualTerminalWorkingSetBase::get_last_object_pool_parsing_threads() const
+	{
+		return lastObjectPoolParsingThreads;
+	}
+
+	bool VirtualTerminalWorkingSetBase::parse_objects_in_parallel(std::uint8_t *iopData,
+	                                                              std::uint32_t iopLength,
+	                                                              const std::vector<std::uint32_t> &objectOffsets,
+	                                                              std::size_t numberOfThreads,
+	                                                              bool &success)
+	{
+		std::vector<std::shared_ptr<VTObject>> parsedObjects(objectOffsets.size());
+
+		// Each thread constructs a contiguous range of objects. An object is only kept if parsing it consumed exactly
+		// the bytes the pre-scan found for it, so a disagreement between the two can't shift the rest of the pool.
+		auto parseRange = [this, iopData, iopLength, &objectOffsets, &parsedObjects](std::size_t first, std::size_t last) {
+			for (std::size_t i = first; i < last; i++)
+			{
+				std::uint8_t *objectData = iopData + objectOffsets[i];
+				std::uint32_t objectLength = (((i + 1) < objectOffsets.size()) ? objectOffsets[i + 1] : iopLength) - objectOffsets[i];
+				std::shared_ptr<VTObject> object;
+
+				if ((!parse_object(objectData, objectLength, object)) || (0 != objectLength))
+				{
+					break;
+				}
+				parsedObjects[i] = object;
+			}
+		};
+
+		std::size_t usedThreads = 1;
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		const std::size_t objectsPerThread = (objectOffsets.size() + numberOfThreads - 1) / numberOfThreads;
+		std::vector<std::thread> workers;
+		workers.reserve(numberOfThreads - 1);
+		for (std::size_t first = objectsPerThread; first < objectOffsets.size(); first += objectsPerThread)
+		{
+			try
+			{
+				workers.emplace_back(parseRange, first, std::min(first + objectsPerThread, objectOffsets.size()));
+			}
+			catch (const std::system_error &)
+			{
+				// No more threads could be started, the calling thread parses the ranges that are left
+				LOG_WARNING("[WS]: Could not start an object pool parsing thread, parsing the rest of the pool on the calling thread.");
+				parseRange(first, objectOffsets.size());
+				break;
+			}
+		}
+		usedThreads += workers.size();
+		parseRange(0, std::min(objectsPerThread, objectOffsets.size()));
+		for (auto &worker : workers)
+		{
+			worker.join();
+		}
+#else
+		(void)numberOfThreads;
+		parseRange(0, objectOffsets.size());
+#endif
+
+		// Validate the pool, then add the objects in the order they appear in it, so duplicate IDs replace each other as they did before
+		for (const auto &object : parsedObjects)
+		{
+			if (nullptr == object)
+			{
+				LOG_DEBUG("[WS]: An object could not be parsed on its own, parsing the object pool in order instead.");
+				return false;
+			}
+		}
+
+		success = true;
+		for (const auto &object : parsedObjects)
+		{
+			if (!add_parsed_object(object))
+			{
+				set_object_pool_faulting_object_id(object->get_id());
+				LOG_ERROR("[WS]: Parsing object pool failed.");
+				success = false;
+				break;
+			}
+		}
+
+		if (success)
+		{
+			LOG_DEBUG("[WS]: Parsed %u objects on %u threads.", static_cast<unsigned int>(parsedObjects.size()), static_cast<unsigned int>(usedThreads));
+		}
+		lastObjectPoolParsingThreads = usedThreads;
+		return true;
+	}
+
 	void VirtualTerminalWorkingSetBase::set_object_pool_faulting_object_id(std::uint16_t value)
 	{
 		const std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
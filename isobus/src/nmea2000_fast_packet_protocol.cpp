@@ -103,6 +103,8 @@ namespace isobus
 	}
 
 	FastPacketProtocol::FastPacketProtocol(const CANMessageFrameCallback &sendCANFrameCallback) :
+	  activeSessions(EXPECTED_NUMBER_OF_SESSIONS, true),
+	  receiveBufferPool(MAX_PROTOCOL_MESSAGE_LENGTH, EXPECTED_NUMBER_OF_SESSIONS, MAX_PROTOCOL_MESSAGE_LENGTH),
 	  sendCANFrameCallback(sendCANFrameCallback)
 	{
 	}
@@ -171,19 +173,23 @@ namespace isobus
 		}
 
 		std::uint8_t sequenceNumber = get_new_sequence_number(source->get_NAME(), parameterGroupNumber);
-		auto session = std::make_shared<FastPacketProtocolSession>(FastPacketProtocolSession::Direction::Transmit,
-		                                                           std::move(data),
-		                                                           parameterGroupNumber,
-		                                                           messageLength,
-		                                                           sequenceNumber,
-		                                                           priority,
-		                                                           source,
-		                                                           destination,
-		                                                           txCompleteCallback,
-		                                                           parentPointer);
+		auto session = activeSessions.create(FastPacketProtocolSession::Direction::Transmit,
+		                                     std::move(data),
+		                                     parameterGroupNumber,
+		                                     messageLength,
+		                                     sequenceNumber,
+		                                     priority,
+		                                     source,
+		                                     destination,
+		                                     txCompleteCallback,
+		                                     parentPointer);
 
 		LOCK_GUARD(Mutex, sessionMutex);
-		activeSessions.push_back(session);
+		if (!activeSessions.insert(session))
+		{
+			LOG_ERROR("[FP]: Unable to send multipacket message, a session for the PGN was started at the same time.");
+			return false;
+		}
 		return true;
 	}
 
@@ -193,7 +199,7 @@ namespace isobus
 		// We use a fancy for loop here to allow us to remove sessions from the list while iterating
 		for (std::size_t i = activeSessions.size(); i > 0; i--)
 		{
-			auto session = activeSessions.at(i - 1);
+			auto session = activeSessions.get_sessions().at(i - 1);
 			if (!session->get_source()->get_address_valid())
 			{
 				LOG_WARNING("[FP]: Closing active session as the source control function is no longer valid");
@@ -244,11 +250,13 @@ namespace isobus
 			session->complete(successful);
 			add_session_history(session);
 
-			auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
-			if (activeSessions.end() != sessionLocation)
+			if (FastPacketProtocolSession::Direction::Receive == session->get_direction())
 			{
-				activeSessions.erase(sessionLocation);
+				// Receive sessions always reassemble into a buffer from the pool. If the message was not completed it's still here.
+				receiveBufferPool.release(std::move(static_cast<CANMessageDataVector &>(session->get_data())));
 			}
+
+			activeSessions.erase(session);
 		}
 	}
 
@@ -361,6 +369,7 @@ namespace isobus
 							callback.get_callback()(completedMessage, callback.get_parent());
 						}
 					}
+					receiveBufferPool.release(completedMessage.release_data());
 					close_session(session, true);
 				}
 			}
@@ -391,16 +400,16 @@ namespace isobus
 				}
 
 				// Create a new session
-				session = std::make_shared<FastPacketProtocolSession>(FastPacketProtocolSession::Direction::Receive,
-				                                                      std::unique_ptr<CANMessageData>(new CANMessageDataVector(messageLength)),
-				                                                      message.get_identifier().get_parameter_group_number(),
-				                                                      messageLength,
-				                                                      (message.get_uint8_at(0) & SEQUENCE_NUMBER_BIT_MASK),
-				                                                      message.get_identifier().get_priority(),
-				                                                      message.get_source_control_function(),
-				                                                      message.get_destination_control_function(),
-				                                                      nullptr, // No callback
-				                                                      nullptr);
+				session = activeSessions.create(FastPacketProtocolSession::Direction::Receive,
+				                                std::unique_ptr<CANMessageData>(new CANMessageDataVector(receiveBufferPool.acquire(messageLength))),
+				                                message.get_identifier().get_parameter_group_number(),
+				                                messageLength,
+				                                (message.get_uint8_at(0) & SEQUENCE_NUMBER_BIT_MASK),
+				                                message.get_identifier().get_priority(),
+				                                message.get_source_control_function(),
+				                                message.get_destination_control_function(),
+				                                nullptr, // No callback
+				                                nullptr);
 
 				// Save the 6 bytes of payload in this first message
 				// Convert data type to a vector to allow for manipulation
@@ -412,7 +421,12 @@ namespace isobus
 				}
 
 				LOCK_GUARD(Mutex, sessionMutex);
-				activeSessions.push_back(session);
+				if (!activeSessions.insert(session))
+				{
+					LOG_WARNING("[FP]: Ignoring FP message with PGN %u, a session for it was started at the same time.",
+					            message.get_identifier().get_parameter_group_number());
+					receiveBufferPool.release(std::move(data));
+				}
 			}
 		}
 	}
@@ -491,23 +505,23 @@ namespace isobus
 		}
 	}
 
+	const CANMessageBufferPool &FastPacketProtocol::get_receive_buffer_pool() const
+	{
+		return receiveBufferPool;
+	}
+
 	bool FastPacketProtocol::has_session(std::uint32_t parameterGroupNumber, std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
 		LOCK_GUARD(Mutex, sessionMutex);
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<FastPacketProtocolSession> &session) {
-			return session->matches(source, destination) && (session->get_parameter_group_number() == parameterGroupNumber);
-		});
+		return (nullptr != activeSessions.find(source, destination, parameterGroupNumber));
 	}
 
 	std::shared_ptr<FastPacketProtocol::FastPacketProtocolSession> FastPacketProtocol::get_session(std::uint32_t parameterGroupNumber,
-	                                                                                               std::shared_ptr<ControlFunction> source,
-	                                                                                               std::shared_ptr<ControlFunction> destination)
+	                                                                                               const std::shared_ptr<ControlFunction> &source,
+	                                                                                               const std::shared_ptr<ControlFunction> &destination)
 	{
 		LOCK_GUARD(Mutex, sessionMutex);
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<FastPacketProtocolSession> &session) {
-			return session->matches(source, destination) && (session->get_parameter_group_number() == parameterGroupNumber);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		return activeSessions.find(source, destination, parameterGroupNumber);
 	}
 
 } // namespace isobus
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+
+#include "isobus/hardware_integration/can_bus_capture.hpp"
+#include "isobus/utility/system_timing.hpp"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace isobus;
+
+static CANMessageFrame create_test_frame(std::uint64_t timestamp_us, std::uint32_t identifier, std::uint8_t channel)
+{
+	CANMessageFrame retVal = {};
+	retVal.timestamp_us = timestamp_us;
+	retVal.identifier = identifier;
+	retVal.isExtendedFrame = true;
+	retVal.channel = channel;
+	retVal.dataLength = 8;
+	for (std::uint8_t i = 0; i < 8; i++)
+	{
+		retVal.data[i] = static_cast<std::uint8_t>(identifier + i);
+	}
+	return retVal;
+}
+
+TEST(CAN_BUS_CAPTURE_TESTS, WriteAndReadBack)
+{
+	const std::string fileName = "can_bus_capture_test.agcap";
+	{
+		CANBusCaptureWriter writer(fileName, false);
+		ASSERT_TRUE(writer.get_is_open());
+		EXPECT_TRUE(writer.write_frame(create_test_frame(1000, 0x18EFFF80, 0), false));
+
+		CANMessageFrame standardFrame = create_test_frame(2000, 0x123, 1);
+		standardFrame.isExtendedFrame = false;
+		standardFrame.dataLength = 3;
+		EXPECT_TRUE(writer.write_frame(standardFrame, true));
+		EXPECT_EQ(2u, writer.get_number_of_frames());
+	}
+
+	CANBusCaptureReader reader(fileName);
+	ASSERT_TRUE(reader.get_is_valid());
+	ASSERT_EQ(2u, reader.get_number_of_frames());
+	EXPECT_EQ(1000u, reader.get_first_timestamp_us());
+	EXPECT_EQ(2000u, reader.get_last_timestamp_us());
+
+	CANMessageFrame frame;
+	bool transmitted = true;
+	ASSERT_TRUE(reader.get_frame(0, frame, transmitted));
+	EXPECT_FALSE(transmitted);
+	EXPECT_EQ(1000u, frame.timestamp_us);
+	EXPECT_EQ(0x18EFFF80u, frame.identifier);
+	EXPECT_TRUE(frame.isExtendedFrame);
+	EXPECT_EQ(0u, frame.channel);
+	EXPECT_EQ(8u, frame.dataLength);
+	EXPECT_EQ(0x87u, frame.data[7]);
+
+	ASSERT_TRUE(reader.get_frame(1, frame, transmitted));
+	EXPECT_TRUE(transmitted);
+	EXPECT_EQ(0x123u, frame.identifier);
+	EXPECT_FALSE(frame.isExtendedFrame);
+	EXPECT_EQ(1u, frame.channel);
+	EXPECT_EQ(3u, frame.dataLength);
+
+	EXPECT_FALSE(reader.get_frame(2, frame, transmitted));
+	std::remove(fileName.c_str());
+}
+
+TEST(CAN_BUS_CAPTURE_TESTS, FindFrameWithIndex)
+{
+	const std::string fileName = "can_bus_capture_index_test.agcap";
+	constexpr std::uint64_t NUMBER_OF_FRAMES = 5000; // Spans several index intervals
+	{
+		CANBusCaptureWriter writer(fileName, false);
+		for (std::uint64_t i = 0; i < NUMBER_OF_FRAMES; i++)
+		{
+			writer.write_frame(create_test_frame(10 * i, 0x18FF0000, 0), false);
+		}
+	}
+
+	CANBusCaptureReader reader(fileName);
+	ASSERT_TRUE(reader.get_is_valid());
+	ASSERT_EQ(NUMBER_OF_FRAMES, reader.get_number_of_frames());
+	EXPECT_EQ(0u, reader.find_frame(0));
+	EXPECT_EQ(1u, reader.find_frame(1));
+	EXPECT_EQ(1024u, reader.find_frame(10240));
+	EXPECT_EQ(1025u, reader.find_frame(10241));
+	EXPECT_EQ(3333u, reader.find_frame(33330));
+	EXPECT_EQ(NUMBER_OF_FRAMES - 1, reader.find_frame(10 * (NUMBER_OF_FRAMES - 1)));
+	EXPECT_EQ(NUMBER_OF_FRAMES, reader.find_frame(10 * NUMBER_OF_FRAMES));
+	std::remove(fileName.c_str());
+}
+
+TEST(CAN_BUS_CAPTURE_TESTS, InvalidFile)
+{
+	CANBusCaptureReader missingReader("can_bus_capture_does_not_exist.agcap");
+	EXPECT_FALSE(missingReader.get_is_valid());
+	EXPECT_EQ(0u, missingReader.get_number_of_frames());
+
+	const std::string fileName = "can_bus_capture_invalid_test.agcap";
+	{
+		std::FILE *file = std::fopen(fileName.c_str(), "wb");
+		ASSERT_NE(nullptr, file);
+		std::vector<std::uint8_t> garbage(128, 0x55);
+		std::fwrite(garbage.data(), 1, garbage.size(), file);
+		std::fclose(file);
+	}
+	CANBusCaptureReader invalidReader(fileName);
+	EXPECT_FALSE(invalidReader.get_is_valid());
+	std::remove(fileName.c_str());
+}
+
+TEST(CAN_BUS_CAPTURE_TESTS, ReplayAsFastAsPossible)
+{
+	const std::string fileName = "can_bus_capture_replay_test.agcap";
+	{
+		CANBusCaptureWriter writer(fileName, false);
+		for (std::uint32_t i = 0; i < 100; i++)
+		{
+			// Every fourth frame was transmitted by the capturing device
+			writer.write_frame(create_test_frame(1000000 * i, 0x18FF0000 | i, 0), (0 == (i % 4)));
+		}
+	}
+
+	CANBusCaptureReader reader(fileName);
+	std::vector<std::uint32_t> replayedIdentifiers;
+	CANBusCaptureReplay replay(
+	  reader, [&replayedIdentifiers](const CANMessageFrame &frame) { replayedIdentifiers.push_back(frame.identifier); }, CANBusCaptureReplay::Timing::AsFastAsPossible);
+	replay.set_batch_size(10);
+
+	replay.start();
+	EXPECT_EQ(10u, replay.update());
+	while (!replay.get_is_finished())
+	{
+		replay.update();
+	}
+	ASSERT_EQ(75u, replayedIdentifiers.size());
+	EXPECT_EQ(0x18FF0001u, replayedIdentifiers.front());
+	EXPECT_EQ(0x18FF0063u, replayedIdentifiers.back());
+	EXPECT_EQ(75u, replay.get_number_of_replayed_frames());
+
+	// Start in the middle, with transmitted frames
+	replayedIdentifiers.clear();
+	replay.set_replay_transmitted_frames(true);
+	replay.set_batch_size(1000);
+	replay.start(50 * 1000000);
+	EXPECT_EQ(50u, replay.update());
+	EXPECT_TRUE(replay.get_is_finished());
+	EXPECT_EQ(0x18FF0032u, replayedIdentifiers.front());
+
+	// A batch size of 0 replays everything that's left in one update
+	replayedIdentifiers.clear();
+	replay.set_batch_size(0);
+	replay.start();
+	EXPECT_EQ(100u, replay.update());
+	EXPECT_TRUE(replay.get_is_finished());
+	EXPECT_EQ(100u, replayedIdentifiers.size());
+	std::remove(fileName.c_str());
+}
+
+TEST(CAN_BUS_CAPTURE_TESTS, ReplayWithOriginalTiming)
+{
+	const std::string fileName = "can_bus_capture_timing_test.agcap";
+	{
+		CANBusCaptureWriter writer(fileName, false);
+		writer.write_frame(create_test_frame(5000000, 0x18FF0001, 0), false);
+		writer.write_frame(create_test_frame(5000000, 0x18FF0002, 0), false);
+		writer.write_frame(create_test_frame(5050000, 0x18FF0003, 0), false);
+	}
+
+	CANBusCaptureReader reader(fileName);
+	std::size_t numberOfReplayedFrames = 0;
+	CANBusCaptureReplay replay(
+	  reader, [&numberOfReplayedFrames](const CANMessageFrame &) { numberOfReplayedFrames++; }, CANBusCaptureReplay::Timing::Original);
+
+	replay.start();
+	EXPECT_EQ(2u, replay.update());
+	EXPECT_EQ(0u, replay.update());
+	EXPECT_FALSE(replay.get_is_finished());
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(60));
+	EXPECT_EQ(1u, replay.update());
+	EXPECT_TRUE(replay.get_is_finished());
+	EXPECT_EQ(3u, numberOfReplayedFrames);
+	std::remove(fileName.c_str());
+}
+
+TEST(CAN_BUS_CAPTURE_TESTS, ReplayIntoNetworkManager)
+{
+	const std::string fileName = "can_bus_capture_network_test.agcap";
+	{
+		CANBusCaptureWriter writer(fileName, false);
+		writer.write_frame(create_test_frame(0, 0x18FF0081, 0), false);
+		writer.write_frame(create_test_frame(1, 0x18FF0082, 0), false);
+	}
+
+	CANBusCaptureReader reader(fileName);
+	ASSERT_TRUE(CANNetworkManager::CANNetwork.set_bus_statistics_enabled(0, true));
+	CANBusCaptureReplay replay(reader, CANNetworkManager::CANNetwork, CANBusCaptureReplay::Timing::AsFastAsPossible);
+	replay.start();
+	EXPECT_EQ(2u, replay.update());
+
+	// The frames went through the receive path, so they show up in the traffic statistics
+	auto talkers = CANNetworkManager::CANNetwork.get_top_talkers_by_source_address(0, 256);
+	std::size_t replayedTalkers = 0;
+	for (const auto &talker : talkers)
+	{
+		if ((0x81 == talker.key) || (0x82 == talker.key))
+		{
+			EXPECT_EQ(1u, talker.numberOfFrames);
+			replayedTalkers++;
+		}
+	}
+	EXPECT_EQ(2u, replayedTalkers);
+	CANNetworkManager::CANNetwork.set_bus_statistics_enabled(0, false);
+	std::remove(fileName.c_str());
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include "isobus/isobus/can_bus_statistics.hpp"
+#include "isobus/isobus/can_network_manager.hpp"
+
+#include "helpers/allocation_counter.hpp"
+
+#include <cstring>
+
+using namespace isobus;
+
+static CANMessageFrame create_test_frame(std::uint32_t identifier, bool isExtendedFrame, std::uint8_t fill)
+{
+	CANMessageFrame retVal = {};
+	retVal.identifier = identifier;
+	retVal.isExtendedFrame = isExtendedFrame;
+	retVal.dataLength = 8;
+	retVal.channel = 0;
+	memset(retVal.data, fill, sizeof(retVal.data));
+	return retVal;
+}
+
+TEST(CAN_BUS_STATISTICS_TESTS, ExactNumberOfBits)
+{
+	CANMessageFrame testFrame = create_test_frame(0x000, false, 0x00);
+	testFrame.dataLength = 0;
+	EXPECT_EQ(53, testFrame.get_exact_number_bits_in_message()); // 34 stuffed bits of zeros need 6 stuff bits
+
+	EXPECT_EQ(127, create_test_frame(0x7F, false, 0x00).get_exact_number_bits_in_message());
+	EXPECT_EQ(148, create_test_frame(0x18EFFFFE, true, 0x00).get_exact_number_bits_in_message());
+	EXPECT_EQ(149, create_test_frame(0x18EFFFFE, true, 0xFF).get_exact_number_bits_in_message());
+	EXPECT_EQ(134, create_test_frame(0x0CF00400, true, 0xAA).get_exact_number_bits_in_message());
+
+	// The exact count is always between the best and worst case
+	for (std::uint16_t i = 0; i < 256; i++)
+	{
+		CANMessageFrame frame = create_test_frame(0x18FF0000 | i, true, static_cast<std::uint8_t>(i));
+		EXPECT_GE(frame.get_exact_number_bits_in_message(), 131);
+		EXPECT_LE(frame.get_exact_number_bits_in_message(), 160);
+	}
+}
+
+TEST(CAN_BUS_STATISTICS_TESTS, CountsPerSourceAndParameterGroupNumber)
+{
+	CANBusStatistics statistics;
+
+	for (std::uint8_t i = 0; i < 3; i++)
+	{
+		statistics.process_frame(create_test_frame(0x18EFFF80, true, 0), 100);
+	}
+	statistics.process_frame(create_test_frame(0x0CFE4981, true, 0), 120);
+	statistics.process_frame(create_test_frame(0x7F, false, 0), 110);
+
+	EXPECT_EQ(3, statistics.get_source_address_statistics(0x80).numberOfFrames);
+	EXPECT_EQ(300, statistics.get_source_address_statistics(0x80).numberOfBits);
+	EXPECT_EQ(1, statistics.get_source_address_statistics(0x81).numberOfFrames);
+	EXPECT_EQ(0, statistics.get_source_address_statistics(0x82).numberOfFrames);
+	EXPECT_EQ(3, statistics.get_parameter_group_number_statistics(0xEF00).numberOfFrames);
+	EXPECT_EQ(120, statistics.get_parameter_group_number_statistics(0xFE49).numberOfBits);
+	EXPECT_EQ(0, statistics.get_parameter_group_number_statistics(0xFECA).numberOfFrames);
+	EXPECT_EQ(110, statistics.get_parameter_group_number_statistics(CANBusStatistics::UNTRACKED_PARAMETER_GROUP_NUMBER).numberOfBits);
+
+	auto topSources = statistics.get_top_source_addresses(1);
+	ASSERT_EQ(1, topSources.size());
+	EXPECT_EQ(0x80, topSources[0].key);
+
+	auto topParameterGroupNumbers = statistics.get_top_parameter_group_numbers(10);
+	ASSERT_EQ(3, topParameterGroupNumbers.size());
+	EXPECT_EQ(0xEF00, topParameterGroupNumbers[0].key);
+	EXPECT_EQ(0xFE49, topParameterGroupNumbers[1].key);
+	EXPECT_EQ(CANBusStatistics::UNTRACKED_PARAMETER_GROUP_NUMBER, topParameterGroupNumbers[2].key);
+
+	statistics.clear();
+	EXPECT_TRUE(statistics.get_top_source_addresses(10).empty());
+	EXPECT_TRUE(statistics.get_top_parameter_group_numbers(10).empty());
+}
+
+TEST(CAN_BUS_STATISTICS_TESTS, SlidingWindow)
+{
+	CANBusStatistics statistics;
+
+	statistics.process_frame(create_test_frame(0x18EFFF80, true, 0), 100);
+	for (std::size_t i = 0; i < CANBusStatistics::NUMBER_OF_SUB_WINDOWS - 1; i++)
+	{
+		statistics.advance_window();
+		statistics.process_frame(create_test_frame(0x18FECA81, true, 0), 100);
+	}
+	EXPECT_EQ(1, statistics.get_source_address_statistics(0x80).numberOfFrames);
+	EXPECT_EQ(CANBusStatistics::NUMBER_OF_SUB_WINDOWS - 1, statistics.get_source_address_statistics(0x81).numberOfFrames);
+
+	// The first sub-window drops out of the window, and its PGN is no longer tracked
+	statistics.advance_window();
+	EXPECT_EQ(0, statistics.get_source_address_statistics(0x80).numberOfFrames);
+	EXPECT_EQ(0, statistics.get_parameter_group_number_statistics(0xEF00).numberOfFrames);
+	EXPECT_EQ(CANBusStatistics::NUMBER_OF_SUB_WINDOWS - 1, statistics.get_parameter_group_number_statistics(0xFECA).numberOfFrames);
+	ASSERT_EQ(1, statistics.get_top_parameter_group_numbers(10).size());
+
+	for (std::size_t i = 0; i < CANBusStatistics::NUMBER_OF_SUB_WINDOWS; i++)
+	{
+		statistics.advance_window();
+	}
+	EXPECT_TRUE(statistics.get_top_source_addresses(10).empty());
+	EXPECT_TRUE(statistics.get_top_parameter_group_numbers(10).empty());
+}
+
+TEST(CAN_BUS_STATISTICS_TESTS, ParameterGroupNumberLimit)
+{
+	CANBusStatistics statistics;
+
+	const std::size_t allocationsBefore = test_helpers::get_number_of_allocations();
+	for (std::uint32_t i = 0; i < CANBusStatistics::MAX_NUMBER_OF_PARAMETER_GROUP_NUMBERS + 10; i++)
+	{
+		statistics.process_frame(create_test_frame(0x18FF0080 | (i << 8), true, 0), 100);
+	}
+	EXPECT_EQ(allocationsBefore, test_helpers::get_number_of_allocations());
+
+	EXPECT_EQ(1, statistics.get_parameter_group_number_statistics(0xFF00).numberOfFrames);
+	EXPECT_EQ(10, statistics.get_parameter_group_number_statistics(CANBusStatistics::UNTRACKED_PARAMETER_GROUP_NUMBER).numberOfFrames);
+	EXPECT_EQ(CANBusStatistics::MAX_NUMBER_OF_PARAMETER_GROUP_NUMBERS + 1, statistics.get_top_parameter_group_numbers(1000).size());
+
+	// Once the window has passed, new PGNs can be tracked again
+	for (std::size_t i = 0; i < CANBusStatistics::NUMBER_OF_SUB_WINDOWS; i++)
+	{
+		statistics.advance_window();
+	}
+	statistics.process_frame(create_test_frame(0x18FF5080, true, 0), 100);
+	EXPECT_EQ(1, statistics.get_parameter_group_number_statistics(0xFF50).numberOfFrames);
+	EXPECT_EQ(0, statistics.get_parameter_group_number_statistics(CANBusStatistics::UNTRACKED_PARAMETER_GROUP_NUMBER).numberOfFrames);
+}
+
+TEST(CAN_BUS_STATISTICS_TESTS, NetworkManagerTopTalkers)
+{
+	EXPECT_FALSE(CANNetworkManager::CANNetwork.set_bus_statistics_enabled(200, true));
+	EXPECT_TRUE(CANNetworkManager::CANNetwork.get_top_talkers_by_source_address(0, 5).empty());
+	ASSERT_TRUE(CANNetworkManager::CANNetwork.set_bus_statistics_enabled(0, true));
+
+	CANNetworkManager::CANNetwork.update();
+	for (std::uint8_t i = 0; i < 10; i++)
+	{
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(create_test_frame(0x18FEF1A0, true, i));
+	}
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(create_test_frame(0x18FECAA1, true, 0));
+	CANNetworkManager::CANNetwork.update();
+
+	auto topSources = CANNetworkManager::CANNetwork.get_top_talkers_by_source_address(0, 5);
+	ASSERT_LE(2, topSources.size());
+	EXPECT_EQ(0xA0, topSources[0].key);
+	EXPECT_EQ(10, topSources[0].numberOfFrames);
+
+	auto topParameterGroupNumbers = CANNetworkManager::CANNetwork.get_top_talkers_by_parameter_group_number(0, 1);
+	ASSERT_EQ(1, topParameterGroupNumbers.size());
+	EXPECT_EQ(0xFEF1, topParameterGroupNumbers[0].key);
+
+	EXPECT_TRUE(CANNetworkManager::CANNetwork.set_bus_statistics_enabled(0, false));
+	EXPECT_TRUE(CANNetworkManager::CANNetwork.get_top_talkers_by_source_address(0, 5).empty());
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "isobus/isobus/can_message_buffer_pool.hpp"
+
+using namespace isobus;
+
+TEST(CAN_MESSAGE_BUFFER_POOL_TESTS, BuffersAreReused)
+{
+	CANMessageBufferPool pool(1785, 2, 1785);
+	EXPECT_EQ(0, pool.get_number_of_idle_buffers());
+
+	auto buffer = pool.acquire(100);
+	EXPECT_EQ(100, buffer.size());
+	EXPECT_EQ(1785, buffer.capacity());
+	EXPECT_EQ(1, pool.get_number_of_allocations());
+	buffer[0] = 0xAA;
+
+	const std::uint8_t *storage = buffer.data();
+	pool.release(std::move(buffer));
+	EXPECT_EQ(1, pool.get_number_of_idle_buffers());
+
+	// The same storage comes back, cleared and resized to the new request
+	buffer = pool.acquire(1785);
+	EXPECT_EQ(storage, buffer.data());
+	EXPECT_EQ(1785, buffer.size());
+	EXPECT_EQ(0, buffer[0]);
+	EXPECT_EQ(1, pool.get_number_of_allocations());
+	EXPECT_EQ(1, pool.get_number_of_reuses());
+	EXPECT_EQ(0, pool.get_number_of_idle_buffers());
+
+	// Buffers that did not come from a pool of this size class are not kept
+	pool.release(std::vector<std::uint8_t>(10));
+	EXPECT_EQ(0, pool.get_number_of_idle_buffers());
+
+	// Only up to the maximum number of idle buffers are kept
+	auto secondBuffer = pool.acquire(10);
+	auto thirdBuffer = pool.acquire(10);
+	pool.release(std::move(buffer));
+	pool.release(std::move(secondBuffer));
+	pool.release(std::move(thirdBuffer));
+	EXPECT_EQ(2, pool.get_number_of_idle_buffers());
+	EXPECT_EQ(3, pool.get_number_of_allocations());
+
+	pool.clear();
+	EXPECT_EQ(0, pool.get_number_of_idle_buffers());
+}
+
+TEST(CAN_MESSAGE_BUFFER_POOL_TESTS, ChunkedBuffers)
+{
+	CANMessageBufferPool pool(4096, 4, 16384);
+
+	auto smallBuffer = pool.acquire(2000);
+	auto largeBuffer = pool.acquire(10000);
+	auto hugeBuffer = pool.acquire(20000);
+	EXPECT_EQ(4096, smallBuffer.capacity());
+	EXPECT_EQ(12288, largeBuffer.capacity());
+	EXPECT_EQ(20480, hugeBuffer.capacity());
+
+	pool.release(std::move(largeBuffer));
+	pool.release(std::move(smallBuffer));
+	pool.release(std::move(hugeBuffer));
+
+	// The huge buffer was too large to keep
+	EXPECT_EQ(2, pool.get_number_of_idle_buffers());
+
+	// The smallest buffer that fits is used
+	EXPECT_EQ(4096, pool.acquire(3000).capacity());
+	EXPECT_EQ(12288, pool.acquire(3000).capacity());
+	EXPECT_EQ(2, pool.get_number_of_reuses());
+	EXPECT_EQ(3, pool.get_number_of_allocations());
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include "isobus/isobus/can_message_ring.hpp"
+#include "isobus/isobus/can_network_manager.hpp"
+
+#include "helpers/allocation_counter.hpp"
+#include "helpers/control_function_helpers.hpp"
+#include "helpers/messaging_helpers.hpp"
+
+using namespace isobus;
+
+static CANMessageFrame create_test_frame(std::uint8_t sequence)
+{
+	CANMessageFrame retVal = {};
+	retVal.identifier = 0x18FF1046;
+	retVal.isExtendedFrame = true;
+	retVal.dataLength = 8;
+	retVal.channel = 0;
+	for (std::uint8_t i = 0; i < retVal.dataLength; i++)
+	{
+		retVal.data[i] = static_cast<std::uint8_t>(sequence + i);
+	}
+	return retVal;
+}
+
+TEST(CAN_MESSAGE_RING_TESTS, PushAndPopInOrder)
+{
+	CANMessageRing ring(4);
+	EXPECT_TRUE(ring.empty());
+	EXPECT_EQ(nullptr, ring.front());
+	EXPECT_EQ(4, ring.get_capacity());
+
+	for (std::uint8_t i = 0; i < 3; i++)
+	{
+		ring.push(CANMessage::Type::Receive, create_test_frame(i), nullptr, nullptr);
+	}
+	EXPECT_EQ(3, ring.size());
+
+	for (std::uint8_t i = 0; i < 3; i++)
+	{
+		const CANMessage *message = ring.front();
+		ASSERT_NE(nullptr, message);
+		EXPECT_EQ(CANMessage::Type::Receive, message->get_type());
+		EXPECT_EQ(0xFF10, message->get_identifier().get_parameter_group_number());
+		EXPECT_EQ(8, message->get_data_length());
+		EXPECT_EQ(i, message->get_uint8_at(0));
+		ring.pop();
+	}
+	EXPECT_TRUE(ring.empty());
+}
+
+TEST(CAN_MESSAGE_RING_TESTS, OverflowPreservesOrder)
+{
+	CANMessageRing ring(2);
+
+	for (std::uint8_t i = 0; i < 5; i++)
+	{
+		ring.push(CANMessage::Type::Receive, create_test_frame(i), nullptr, nullptr);
+	}
+	EXPECT_EQ(5, ring.size());
+	EXPECT_EQ(3, ring.get_number_of_overflowed_messages());
+
+	// Pop one out of the ring, then push again. The new message must still come after the overflowed ones.
+	ASSERT_NE(nullptr, ring.front());
+	EXPECT_EQ(0, ring.front()->get_uint8_at(0));
+	ring.pop();
+	ring.push(CANMessage::Type::Receive, create_test_frame(5), nullptr, nullptr);
+
+	for (std::uint8_t i = 1; i < 6; i++)
+	{
+		const CANMessage *message = ring.front();
+		ASSERT_NE(nullptr, message);
+		EXPECT_EQ(i, message->get_uint8_at(0));
+		ring.pop();
+	}
+	EXPECT_TRUE(ring.empty());
+
+	ring.push(CANMessage::Type::Receive, create_test_frame(6), nullptr, nullptr);
+	ring.push(CANMessage::Type::Receive, create_test_frame(7), nullptr, nullptr);
+	ring.push(CANMessage::Type::Receive, create_test_frame(8), nullptr, nullptr);
+	ring.clear();
+	EXPECT_TRUE(ring.empty());
+	EXPECT_EQ(nullptr, ring.front());
+}
+
+TEST(CAN_MESSAGE_RING_TESTS, ReceptionStopsAllocatingOnceAnOverflowIsDrained)
+{
+	CANMessageRing ring(4);
+
+	// A burst while nothing is consumed spills into the overflow queue
+	for (std::uint8_t i = 0; i < 8; i++)
+	{
+		ring.push(CANMessage::Type::Receive, create_test_frame(i), nullptr, nullptr);
+	}
+	EXPECT_EQ(4, ring.get_number_of_overflowed_messages());
+
+	// Each pop moves an overflowed message back into the ring, until the consumer has caught up
+	for (std::uint8_t i = 0; i < 5; i++)
+	{
+		ASSERT_NE(nullptr, ring.front());
+		EXPECT_EQ(i, ring.front()->get_uint8_at(0));
+		ring.pop();
+	}
+	EXPECT_EQ(3, ring.size());
+
+	// After that, messages go into the ring again instead of the heap
+	const std::size_t allocationsBefore = test_helpers::get_number_of_allocations();
+	for (std::uint8_t i = 8; i < 108; i++)
+	{
+		ring.push(CANMessage::Type::Receive, create_test_frame(i), nullptr, nullptr);
+		ASSERT_NE(nullptr, ring.front());
+		EXPECT_EQ(static_cast<std::uint8_t>(i - 3), ring.front()->get_uint8_at(0));
+		ring.pop();
+	}
+	EXPECT_EQ(allocationsBefore, test_helpers::get_number_of_allocations());
+	EXPECT_EQ(4, ring.get_number_of_overflowed_messages());
+}
+
+TEST(CAN_MESSAGE_RING_TESTS, ReleasesControlFunctionsOnPop)
+{
+	CANMessageRing ring(2);
+	auto source = test_helpers::create_mock_control_function(0x46);
+
+	ring.push(CANMessage::Type::Receive, create_test_frame(0), source, nullptr);
+	ASSERT_NE(nullptr, ring.front());
+	EXPECT_EQ(source, ring.front()->get_source_control_function());
+	EXPECT_EQ(2, source.use_count());
+
+	ring.pop();
+	EXPECT_EQ(1, source.use_count());
+}
+
+TEST(CAN_MESSAGE_RING_TESTS, SteadyStateReceptionDoesNotAllocate)
+{
+	CANMessageRing ring(8);
+	auto source = test_helpers::create_mock_control_function(0x46);
+
+	const std::size_t allocationsBefore = test_helpers::get_number_of_allocations();
+	for (std::uint32_t i = 0; i < 1000; i++)
+	{
+		ring.push(CANMessage::Type::Receive, create_test_frame(static_cast<std::uint8_t>(i)), source, nullptr);
+		ring.push(CANMessage::Type::Receive, create_test_frame(static_cast<std::uint8_t>(i + 1)), source, nullptr);
+
+		const CANMessage *message = ring.front();
+		ASSERT_NE(nullptr, message);
+		EXPECT_EQ(static_cast<std::uint8_t>(i), message->get_uint8_at(0));
+		ring.pop();
+		ring.pop();
+	}
+	EXPECT_EQ(allocationsBefore, test_helpers::get_number_of_allocations());
+	EXPECT_EQ(0, ring.get_number_of_overflowed_messages());
+}
+
+TEST(CAN_MESSAGE_RING_TESTS, NetworkManagerReceiveDoesNotAllocate)
+{
+	CANNetworkManager::CANNetwork.update(); // Make sure the network manager is initialized and its queues are empty
+
+	const CANMessageFrame testFrame = create_test_frame(0);
+	const std::size_t allocationsBefore = test_helpers::get_number_of_allocations();
+	for (std::uint8_t i = 0; i < 32; i++)
+	{
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(testFrame);
+	}
+	EXPECT_EQ(allocationsBefore, test_helpers::get_number_of_allocations());
+
+	CANNetworkManager::CANNetwork.update();
+}
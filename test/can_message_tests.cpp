@@ -9,6 +9,8 @@
 #include "isobus/isobus/can_message_frame.hpp"
 #include "isobus/isobus/can_network_manager.hpp"
 
+#include "helpers/allocation_counter.hpp"
+
 using namespace isobus;
 
 std::uint64_t value64;
@@ -71,3 +73,90 @@ TEST(CAN_MESSAGE_TESTS, DataCorrectnessTest)
 	CANNetworkManager::CANNetwork.remove_global_parameter_group_number_callback(0xE100, callback, nullptr);
 	CANHardwareInterface::stop();
 }
+
+TEST(CAN_MESSAGE_TESTS, SmallPayloadsAreStoredInline)
+{
+	const std::uint8_t frameData[CAN_DATA_LENGTH] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+	const std::size_t allocationsBefore = test_helpers::get_number_of_allocations();
+	CANMessage message(CANMessage::Type::Receive, CANIdentifier(0x18EF1CAA), frameData, CAN_DATA_LENGTH, nullptr, nullptr, 0);
+	CANMessage copiedMessage(message);
+	CANMessage movedMessage(std::move(copiedMessage));
+	copiedMessage = movedMessage;
+	EXPECT_EQ(allocationsBefore, test_helpers::get_number_of_allocations());
+
+	EXPECT_TRUE(movedMessage.get_data().is_stored_inline());
+	EXPECT_EQ(CAN_DATA_LENGTH, movedMessage.get_data_length());
+	EXPECT_EQ(0x0201, movedMessage.get_uint16_at(0));
+	EXPECT_TRUE(movedMessage.get_bool_at(0, 0));
+	EXPECT_EQ(0x0807060504030201, copiedMessage.get_uint64_at(0));
+	EXPECT_EQ(std::vector<std::uint8_t>(frameData, frameData + CAN_DATA_LENGTH), static_cast<std::vector<std::uint8_t>>(message.get_data()));
+}
+
+TEST(CAN_MESSAGE_TESTS, LargePayloadsGrowAndShrink)
+{
+	std::vector<std::uint8_t> largeData(100);
+	for (std::size_t i = 0; i < largeData.size(); i++)
+	{
+		largeData[i] = static_cast<std::uint8_t>(i);
+	}
+
+	CANMessage message(CANMessage::Type::Receive, CANIdentifier(0x18EF1CAA), largeData, nullptr, nullptr, 0);
+	EXPECT_FALSE(message.get_data().is_stored_inline());
+	EXPECT_EQ(100, message.get_data_length());
+	EXPECT_EQ(99, message.get_uint8_at(99));
+	EXPECT_EQ(0x5F5E5D5C, message.get_uint32_at(92));
+
+	// Shrinking back to a single frame moves the payload inline again
+	message.set_data_size(4);
+	EXPECT_TRUE(message.get_data().is_stored_inline());
+	EXPECT_EQ(0x03020100, message.get_uint32_at(0));
+
+	// Appending past the inline capacity moves the payload to the heap and keeps the existing bytes
+	const std::uint8_t moreData[CAN_MESSAGE_INLINE_DATA_LENGTH] = { 0xAA };
+	message.set_data(moreData, CAN_MESSAGE_INLINE_DATA_LENGTH);
+	EXPECT_FALSE(message.get_data().is_stored_inline());
+	EXPECT_EQ(4 + CAN_MESSAGE_INLINE_DATA_LENGTH, message.get_data_length());
+	EXPECT_EQ(0x03, message.get_uint8_at(3));
+	EXPECT_EQ(0xAA, message.get_uint8_at(4));
+	EXPECT_EQ(0x00, message.get_uint8_at(5));
+
+	message.set_data_size(0);
+	EXPECT_TRUE(message.get_data().empty());
+}
+
+TEST(CAN_MESSAGE_TESTS, PayloadWorksLikeAVector)
+{
+	const std::uint8_t frameData[CAN_DATA_LENGTH] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	CANMessage message(CANMessage::Type::Receive, CANIdentifier(0x18EF1CAA), frameData, CAN_DATA_LENGTH, nullptr, nullptr, 0);
+	const std::vector<std::uint8_t> expected(frameData, frameData + CAN_DATA_LENGTH);
+
+	// at() is bounds checked in every build, like std::vector::at
+	EXPECT_EQ(8, message.get_data().at(7));
+	EXPECT_THROW(message.get_data().at(8), std::out_of_range);
+
+	EXPECT_TRUE(message.get_data() == expected);
+	EXPECT_TRUE(std::equal(message.get_data().cbegin(), message.get_data().cend(), expected.begin()));
+	EXPECT_EQ(8, *message.get_data().rbegin());
+	EXPECT_EQ(1, message.get_data().front());
+	EXPECT_EQ(8, message.get_data().back());
+	CANMessagePayload::const_iterator position = std::find(message.get_data().begin(), message.get_data().end(), 5);
+	EXPECT_EQ(4, position - message.get_data().begin());
+
+	// A copy can be edited with the usual vector calls
+	auto copy = message.get_data();
+	copy.erase(copy.begin());
+	copy.push_back(9);
+	EXPECT_EQ(std::vector<std::uint8_t>({ 2, 3, 4, 5, 6, 7, 8, 9 }), static_cast<std::vector<std::uint8_t>>(copy));
+	copy.insert(copy.begin(), expected.data(), expected.data() + expected.size());
+	EXPECT_EQ(16, copy.size());
+	EXPECT_FALSE(copy.is_stored_inline());
+	EXPECT_EQ(1, copy[0]);
+	EXPECT_EQ(2, copy[8]);
+	copy.erase(copy.begin(), copy.begin() + 12);
+	EXPECT_TRUE(copy.is_stored_inline());
+	EXPECT_EQ(std::vector<std::uint8_t>({ 6, 7, 8, 9 }), static_cast<std::vector<std::uint8_t>>(copy));
+	copy.clear();
+	EXPECT_TRUE(copy.empty());
+	EXPECT_TRUE(message.get_data() != copy);
+}
@@ -2,6 +2,7 @@
 
 #include "isobus/isobus/can_NAME_filter.hpp"
 #include "isobus/isobus/can_constants.hpp"
+#include "isobus/isobus/can_partnered_control_function.hpp"
 
 #include <chrono>
 #include <thread>
@@ -106,3 +107,45 @@ TEST(CAN_NAME_TESTS, FilterMatches)
 	TestDeviceNAME.set_arbitrary_address_capable(true);
 	EXPECT_TRUE(filterArbitraryAddressCapable.check_name_matches_filter(TestDeviceNAME));
 }
+
+TEST(CAN_NAME_TESTS, FilterMaskAndValue)
+{
+	std::uint64_t mask = 0;
+	std::uint64_t maskedValue = 0;
+
+	EXPECT_TRUE(NAMEFilter(NAME::NAMEParameters::FunctionCode, 0x29).get_NAME_mask_and_value(mask, maskedValue));
+	EXPECT_EQ(0xFF0000000000, mask);
+	EXPECT_EQ(0x290000000000, maskedValue);
+
+	EXPECT_TRUE(NAMEFilter(NAME::NAMEParameters::ArbitraryAddressCapable, 5).get_NAME_mask_and_value(mask, maskedValue));
+	EXPECT_EQ(0x8000000000000000, mask);
+	EXPECT_EQ(0x8000000000000000, maskedValue);
+
+	// Values that don't fit in the NAME component can never match
+	NAMEFilter tooLargeFilter(NAME::NAMEParameters::EcuInstance, 8);
+	EXPECT_FALSE(tooLargeFilter.get_NAME_mask_and_value(mask, maskedValue));
+	EXPECT_FALSE(tooLargeFilter.check_name_matches_filter(NAME(0)));
+}
+
+TEST(CAN_NAME_TESTS, PartnerFiltersAreCombined)
+{
+	NAME testDeviceNAME(0);
+	testDeviceNAME.set_function_code(static_cast<std::uint8_t>(NAME::Function::VirtualTerminal));
+	testDeviceNAME.set_industry_group(2);
+	testDeviceNAME.set_manufacturer_code(1407);
+
+	PartneredControlFunction noFilters(0, {});
+	EXPECT_FALSE(noFilters.check_matches_name(testDeviceNAME));
+
+	PartneredControlFunction matchingFilters(0, { NAMEFilter(NAME::NAMEParameters::FunctionCode, static_cast<std::uint8_t>(NAME::Function::VirtualTerminal)), NAMEFilter(NAME::NAMEParameters::IndustryGroup, 2) });
+	EXPECT_TRUE(matchingFilters.check_matches_name(testDeviceNAME));
+	testDeviceNAME.set_industry_group(1);
+	EXPECT_FALSE(matchingFilters.check_matches_name(testDeviceNAME));
+
+	// All filters must match, so two different values for the same component never match
+	PartneredControlFunction contradictingFilters(0, { NAMEFilter(NAME::NAMEParameters::ManufacturerCode, 1407), NAMEFilter(NAME::NAMEParameters::ManufacturerCode, 69) });
+	EXPECT_FALSE(contradictingFilters.check_matches_name(testDeviceNAME));
+
+	PartneredControlFunction duplicateFilters(0, { NAMEFilter(NAME::NAMEParameters::ManufacturerCode, 1407), NAMEFilter(NAME::NAMEParameters::ManufacturerCode, 1407) });
+	EXPECT_TRUE(duplicateFilters.check_matches_name(testDeviceNAME));
+}
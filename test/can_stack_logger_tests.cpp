@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include "isobus/isobus/can_async_stack_logger.hpp"
+#include "isobus/isobus/can_stack_logger.hpp"
+
+#include "helpers/allocation_counter.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace isobus;
+
+class TestLogSink : public CANStackLogger
+{
+public:
+	void sink_CAN_stack_log(LoggingLevel level, const std::string &text) override
+	{
+		levels.push_back(level);
+		texts.push_back(text);
+	}
+
+	std::vector<LoggingLevel> levels;
+	std::vector<std::string> texts;
+};
+
+class TestTextLogSink : public CANStackLogger
+{
+public:
+	void sink_CAN_stack_log_text(LoggingLevel, const char *text, std::size_t length) override
+	{
+		lastLength = length;
+		lastCharacter = (length > 0) ? text[length - 1] : '\0';
+		numberOfLogs++;
+	}
+
+	std::size_t lastLength = 0;
+	char lastCharacter = '\0';
+	std::size_t numberOfLogs = 0;
+};
+
+class CANStackLoggerTests : public testing::Test
+{
+protected:
+	void TearDown() override
+	{
+		CANStackLogger::set_can_stack_logger_sink(nullptr);
+		CANStackLogger::set_log_level(CANStackLogger::LoggingLevel::Info);
+	}
+};
+
+TEST_F(CANStackLoggerTests, FormatsAndFiltersByLevel)
+{
+	TestLogSink sink;
+	CANStackLogger::set_can_stack_logger_sink(&sink);
+	CANStackLogger::set_log_level(CANStackLogger::LoggingLevel::Info);
+
+	EXPECT_FALSE(CANStackLogger::is_log_level_enabled(CANStackLogger::LoggingLevel::Debug));
+	EXPECT_TRUE(CANStackLogger::is_log_level_enabled(CANStackLogger::LoggingLevel::Info));
+
+	LOG_DEBUG("Filtered %u", 1u);
+	LOG_INFO("Address %u on channel %u", 0x81u, 2u);
+	LOG_WARNING(std::string("Plain ") + "text with 100%");
+	LOG_ERROR("Literal with no arguments");
+	CANStackLogger::critical(std::string("Runtime format %s"), "string");
+
+	ASSERT_EQ(4u, sink.texts.size());
+	EXPECT_EQ("Address 129 on channel 2", sink.texts.at(0));
+	EXPECT_EQ(CANStackLogger::LoggingLevel::Info, sink.levels.at(0));
+	EXPECT_EQ("Plain text with 100%", sink.texts.at(1));
+	EXPECT_EQ(CANStackLogger::LoggingLevel::Warning, sink.levels.at(1));
+	EXPECT_EQ("Literal with no arguments", sink.texts.at(2));
+	EXPECT_EQ("Runtime format string", sink.texts.at(3));
+	EXPECT_EQ(CANStackLogger::LoggingLevel::Critical, sink.levels.at(3));
+}
+
+TEST_F(CANStackLoggerTests, FilteredStatementsAreNotEvaluated)
+{
+	TestLogSink sink;
+	CANStackLogger::set_can_stack_logger_sink(&sink);
+	CANStackLogger::set_log_level(CANStackLogger::LoggingLevel::Warning);
+
+	int evaluations = 0;
+	auto counted_value = [&evaluations]() {
+		evaluations++;
+		return 5;
+	};
+
+	LOG_INFO("Value %d", counted_value());
+	EXPECT_EQ(0, evaluations);
+	LOG_WARNING("Value %d", counted_value());
+	EXPECT_EQ(1, evaluations);
+
+	// Without a sink nothing is evaluated either
+	CANStackLogger::set_can_stack_logger_sink(nullptr);
+	LOG_CRITICAL("Value %d", counted_value());
+	EXPECT_EQ(1, evaluations);
+	ASSERT_EQ(1u, sink.texts.size());
+	EXPECT_EQ("Value 5", sink.texts.at(0));
+}
+
+TEST_F(CANStackLoggerTests, FormattingDoesNotAllocate)
+{
+	TestTextLogSink sink;
+	CANStackLogger::set_can_stack_logger_sink(&sink);
+	CANStackLogger::set_log_level(CANStackLogger::LoggingLevel::Debug);
+
+	LOG_DEBUG("Warm up the format buffer of this thread %u", 1u);
+
+	const std::size_t allocationsBefore = test_helpers::get_number_of_allocations();
+	for (std::uint32_t i = 0; i < 100; i++)
+	{
+		LOG_DEBUG("[TP]: Session with a long enough text to not fit in a small string, sequence %u of %u", i, 100u);
+	}
+	EXPECT_EQ(allocationsBefore, test_helpers::get_number_of_allocations());
+	EXPECT_EQ(101u, sink.numberOfLogs);
+}
+
+TEST_F(CANStackLoggerTests, LongTextIsTruncated)
+{
+	TestTextLogSink sink;
+	CANStackLogger::set_can_stack_logger_sink(&sink);
+
+	std::string longText(CANStackLogger::FORMAT_BUFFER_SIZE * 2, 'a');
+	LOG_INFO("%s!", longText.c_str());
+	EXPECT_EQ(CANStackLogger::FORMAT_BUFFER_SIZE - 1, sink.lastLength);
+	EXPECT_EQ('a', sink.lastCharacter);
+
+	// Plain text is passed on as is
+	LOG_INFO(longText + "!");
+	EXPECT_EQ(longText.size() + 1, sink.lastLength);
+	EXPECT_EQ('!', sink.lastCharacter);
+}
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+TEST_F(CANStackLoggerTests, AsyncSinkPassesRecordsInOrder)
+{
+	TestLogSink targetSink;
+	{
+		AsyncCANStackLogger asyncLogger(targetSink, 64);
+		CANStackLogger::set_can_stack_logger_sink(&asyncLogger);
+
+		for (int i = 0; i < 50; i++)
+		{
+			LOG_INFO("Record %d", i);
+		}
+		LOG_ERROR(std::string(AsyncCANStackLogger::MAX_RECORD_LENGTH + 10, 'b'));
+		CANStackLogger::set_can_stack_logger_sink(nullptr);
+		EXPECT_EQ(0u, asyncLogger.get_number_of_dropped_records());
+	}
+
+	ASSERT_EQ(51u, targetSink.texts.size());
+	for (int i = 0; i < 50; i++)
+	{
+		EXPECT_EQ("Record " + std::to_string(i), targetSink.texts.at(i));
+	}
+	EXPECT_EQ(std::string(AsyncCANStackLogger::MAX_RECORD_LENGTH, 'b'), targetSink.texts.at(50));
+	EXPECT_EQ(CANStackLogger::LoggingLevel::Error, targetSink.levels.at(50));
+}
+
+TEST_F(CANStackLoggerTests, AsyncSinkDropsRecordsWhenFull)
+{
+	TestLogSink targetSink;
+	{
+		// A long writer period keeps the writer from emptying the ring buffer during the test
+		AsyncCANStackLogger asyncLogger(targetSink, 8, 10000);
+		CANStackLogger::set_can_stack_logger_sink(&asyncLogger);
+
+		for (int i = 0; i < 20; i++)
+		{
+			LOG_WARNING("Record %d", i);
+		}
+		CANStackLogger::set_can_stack_logger_sink(nullptr);
+		EXPECT_EQ(12u, asyncLogger.get_number_of_dropped_records());
+	}
+
+	ASSERT_EQ(8u, targetSink.texts.size());
+	EXPECT_EQ("Record 0", targetSink.texts.front());
+	EXPECT_EQ("Record 7", targetSink.texts.back());
+}
+#endif
@@ -8,6 +8,7 @@
 #include "isobus/isobus/can_network_manager.hpp"
 #include "isobus/isobus/can_partnered_control_function.hpp"
 
+#include <future>
 #include <memory>
 #include <thread>
 
@@ -370,3 +371,166 @@ TEST(CORE_TESTS, SimilarControlFunctions)
 	EXPECT_EQ(TestPartner->get_NAME().get_full_name(), 0xa0000F000425e9f8);
 	CANNetworkManager::CANNetwork.deactivate_control_function(TestPartner);
 }
+
+static void record_callback_a(const CANMessage &, void *parent)
+{
+	static_cast<std::vector<char> *>(parent)->push_back('a');
+}
+
+static void record_callback_b(const CANMessage &, void *parent)
+{
+	static_cast<std::vector<char> *>(parent)->push_back('b');
+}
+
+static void record_callback_c(const CANMessage &, void *parent)
+{
+	static_cast<std::vector<char> *>(parent)->push_back('c');
+}
+
+static void record_callback_and_replace_self(const CANMessage &message, void *parent)
+{
+	static_cast<std::vector<char> *>(parent)->push_back('r');
+
+	// Modifying the callbacks from inside a callback must not deadlock or disturb the dispatch in progress
+	CANNetworkManager::CANNetwork.remove_any_control_function_parameter_group_number_callback(message.get_identifier().get_parameter_group_number(), record_callback_and_replace_self, parent);
+	CANNetworkManager::CANNetwork.add_any_control_function_parameter_group_number_callback(message.get_identifier().get_parameter_group_number(), record_callback_c, parent);
+}
+
+TEST(CORE_TESTS, ParameterGroupNumberCallbackDispatch)
+{
+	constexpr std::uint32_t FIRST_PGN = 0xFF10;
+	constexpr std::uint32_t SECOND_PGN = 0xFF11;
+	std::vector<char> calls;
+	CANNetworkManager::CANNetwork.update();
+
+	CANNetworkManager::CANNetwork.add_any_control_function_parameter_group_number_callback(FIRST_PGN, record_callback_a, &calls);
+	CANNetworkManager::CANNetwork.add_any_control_function_parameter_group_number_callback(SECOND_PGN, record_callback_b, &calls);
+	CANNetworkManager::CANNetwork.add_any_control_function_parameter_group_number_callback(FIRST_PGN, record_callback_and_replace_self, &calls);
+	CANNetworkManager::CANNetwork.add_any_control_function_parameter_group_number_callback(FIRST_PGN, record_callback_b, &calls);
+
+	auto source = test_helpers::create_mock_control_function(0x46);
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(test_helpers::create_message_frame_broadcast(6, FIRST_PGN, source, { 1, 2, 3, 4, 5, 6, 7, 8 }));
+	CANNetworkManager::CANNetwork.update();
+
+	// Only the callbacks for the PGN are called, in the order they were added.
+	// The callback added during dispatch is not called until the next message.
+	EXPECT_EQ(std::vector<char>({ 'a', 'r', 'b' }), calls);
+
+	calls.clear();
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(test_helpers::create_message_frame_broadcast(6, FIRST_PGN, source, { 1, 2, 3, 4, 5, 6, 7, 8 }));
+	CANNetworkManager::CANNetwork.update();
+	EXPECT_EQ(std::vector<char>({ 'a', 'b', 'c' }), calls);
+
+	calls.clear();
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(test_helpers::create_message_frame_broadcast(6, SECOND_PGN, source, { 1, 2, 3, 4, 5, 6, 7, 8 }));
+	CANNetworkManager::CANNetwork.update();
+	EXPECT_EQ(std::vector<char>({ 'b' }), calls);
+
+	CANNetworkManager::CANNetwork.remove_any_control_function_parameter_group_number_callback(FIRST_PGN, record_callback_a, &calls);
+	CANNetworkManager::CANNetwork.remove_any_control_function_parameter_group_number_callback(SECOND_PGN, record_callback_b, &calls);
+	CANNetworkManager::CANNetwork.remove_any_control_function_parameter_group_number_callback(FIRST_PGN, record_callback_b, &calls);
+	CANNetworkManager::CANNetwork.remove_any_control_function_parameter_group_number_callback(FIRST_PGN, record_callback_c, &calls);
+
+	calls.clear();
+	CANNetworkManager::CANNetwork.process_receive_can_message_frame(test_helpers::create_message_frame_broadcast(6, FIRST_PGN, source, { 1, 2, 3, 4, 5, 6, 7, 8 }));
+	CANNetworkManager::CANNetwork.update();
+	EXPECT_TRUE(calls.empty());
+}
+
+TEST(CORE_TESTS, SendOwnedDataWithoutCopying)
+{
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, std::make_shared<VirtualCANPlugin>());
+	CANHardwareInterface::start();
+
+	auto internalECU = test_helpers::claim_internal_control_function(0x44, 0);
+
+	std::unique_ptr<CANMessageData> data(new CANMessageDataVector(std::vector<std::uint8_t>({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 })));
+	const CANMessageData *originalData = data.get();
+
+	// A send that fails must leave the data with the caller
+	EXPECT_FALSE(CANNetworkManager::CANNetwork.send_can_message(0xFF20, data, nullptr));
+	EXPECT_EQ(originalData, data.get());
+
+	// A send that succeeds hands the same buffer to the transport session
+	EXPECT_TRUE(CANNetworkManager::CANNetwork.send_can_message(0xFF20, data, internalECU));
+	EXPECT_EQ(nullptr, data);
+
+	auto sessions = CANNetworkManager::CANNetwork.get_active_transport_protocol_sessions(0);
+	ASSERT_EQ(1, sessions.size());
+	EXPECT_EQ(originalData, &sessions.front()->get_data());
+	sessions.clear();
+
+	// Single frame messages are sent right away and also consume the data
+	data.reset(new CANMessageDataVector(std::vector<std::uint8_t>({ 1, 2, 3, 4, 5, 6, 7, 8 })));
+	EXPECT_TRUE(CANNetworkManager::CANNetwork.send_can_message(0xFF20, data, internalECU));
+	EXPECT_EQ(nullptr, data);
+
+	// Let the broadcast finish so it doesn't leak into other tests
+	auto sessionFinishedFuture = std::async(std::launch::async, []() {
+		while (!CANNetworkManager::CANNetwork.get_active_transport_protocol_sessions(0).empty())
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	});
+	EXPECT_TRUE(sessionFinishedFuture.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+	CANHardwareInterface::stop();
+}
+
+TEST(CORE_TESTS, FrameProcessingDoesNotCopyControlFunctions)
+{
+	constexpr std::uint8_t TEST_CHANNEL = 2;
+	constexpr std::uint8_t FIRST_ADDRESS = 0x40;
+	constexpr std::uint8_t NUMBER_OF_ECUS = 30;
+
+	EXPECT_EQ(nullptr, CANNetworkManager::CANNetwork.get_control_function(CAN_PORT_MAXIMUM, FIRST_ADDRESS));
+	EXPECT_EQ(nullptr, CANNetworkManager::CANNetwork.get_control_function(TEST_CHANNEL, NULL_CAN_ADDRESS));
+
+	CANNetworkManager::CANNetwork.update();
+
+	// Have a bunch of ECUs claim an address
+	CANMessageFrame testFrame = {};
+	testFrame.channel = TEST_CHANNEL;
+	testFrame.isExtendedFrame = true;
+	testFrame.dataLength = 8;
+	for (std::uint8_t i = 0; i < NUMBER_OF_ECUS; i++)
+	{
+		const std::uint64_t name = 0xA000000000000000ULL | (static_cast<std::uint64_t>(i) << 21);
+		testFrame.identifier = 0x18EEFF00 | (FIRST_ADDRESS + i);
+		for (std::uint8_t byteIndex = 0; byteIndex < testFrame.dataLength; byteIndex++)
+		{
+			testFrame.data[byteIndex] = static_cast<std::uint8_t>(name >> (8 * byteIndex));
+		}
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(testFrame);
+	}
+	CANNetworkManager::CANNetwork.update();
+
+	std::vector<long> useCounts;
+	for (std::uint8_t i = 0; i < NUMBER_OF_ECUS; i++)
+	{
+		// Counts the returned copy as well, like every use count read below
+		auto controlFunction = CANNetworkManager::CANNetwork.get_control_function(TEST_CHANNEL, FIRST_ADDRESS + i);
+		ASSERT_NE(nullptr, controlFunction);
+		useCounts.push_back(controlFunction.use_count());
+	}
+
+	// Each queued frame holds on to its source until it is processed, after which all references are released again
+	testFrame.dataLength = 8;
+	for (std::uint8_t i = 0; i < NUMBER_OF_ECUS; i++)
+	{
+		testFrame.identifier = 0x18FEF100 | (FIRST_ADDRESS + i);
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(testFrame);
+		EXPECT_EQ(useCounts[i] + 1, CANNetworkManager::CANNetwork.get_control_function(TEST_CHANNEL, FIRST_ADDRESS + i).use_count());
+	}
+	CANNetworkManager::CANNetwork.update();
+	for (std::uint8_t i = 0; i < NUMBER_OF_ECUS; i++)
+	{
+		EXPECT_EQ(useCounts[i], CANNetworkManager::CANNetwork.get_control_function(TEST_CHANNEL, FIRST_ADDRESS + i).use_count());
+	}
+
+	// Looking at the source of a message doesn't copy it either
+	auto message = test_helpers::create_message_broadcast(7, 0xFEF1, CANNetworkManager::CANNetwork.get_control_function(TEST_CHANNEL, FIRST_ADDRESS), { 0 });
+	EXPECT_EQ(&message.get_source_control_function(), &message.get_source_control_function());
+	EXPECT_EQ(useCounts[0], message.get_source_control_function().use_count());
+	EXPECT_TRUE(message.is_source(CANNetworkManager::CANNetwork.get_control_function(TEST_CHANNEL, FIRST_ADDRESS)));
+}
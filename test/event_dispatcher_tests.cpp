@@ -2,6 +2,9 @@
 
 #include "isobus/utility/event_dispatcher.hpp"
 
+#include "helpers/allocation_counter.hpp"
+
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -173,3 +176,107 @@ TEST_F(EventManagerBool, RemoveCallbackWithinCallback)
 	dispatcher.invoke(true);
 	EXPECT_EQ(callbackToBeRemovedExecuted, 1); // Ensure the removed callback did not execute again
 }
+
+// Calling listeners works on a snapshot, so it never allocates, no matter how many listeners there are
+TEST_F(EventManagerBool, CallDoesNotAllocate)
+{
+	std::size_t count = 0;
+
+	for (std::size_t numberOfListeners : { 1, 4, 16 })
+	{
+		dispatcher.clear_listeners();
+		count = 0;
+		for (std::size_t i = 0; i < numberOfListeners; i++)
+		{
+			dispatcher.add_listener([&count](bool) {
+				count++;
+			});
+		}
+
+		const std::size_t allocationsBefore = test_helpers::get_number_of_allocations();
+		for (int i = 0; i < 1000; i++)
+		{
+			dispatcher.call(true);
+		}
+		EXPECT_EQ(allocationsBefore, test_helpers::get_number_of_allocations());
+		EXPECT_EQ(1000 * numberOfListeners, count);
+	}
+}
+
+// Listeners can be added and removed from another thread while events are being invoked
+TEST_F(EventManagerBool, ConcurrentCallsAndChanges)
+{
+	std::atomic<int> count = { 0 };
+	std::atomic<bool> stop = { false };
+	auto permanentListener = dispatcher.add_listener([&count](bool) {
+		count++;
+	});
+
+	std::thread caller([this, &stop]() {
+		do
+		{
+			dispatcher.call(true);
+		} while (!stop);
+	});
+
+	for (int i = 0; i < 1000; i++)
+	{
+		auto temporaryListener = dispatcher.add_listener([](bool) {});
+		dispatcher.remove_listener(temporaryListener);
+	}
+	stop = true;
+	caller.join();
+
+	EXPECT_EQ(1, dispatcher.get_listener_count());
+	EXPECT_LT(0, count);
+	dispatcher.remove_listener(permanentListener);
+	EXPECT_EQ(0, dispatcher.get_listener_count());
+}
+
+// An old snapshot is freed by a later change once the calls using it returned, even while other calls keep overlapping
+TEST_F(EventManagerBool, SnapshotsAreFreedWhileOtherCallsAreRunning)
+{
+	std::atomic<bool> firstCallInside = { false };
+	std::atomic<bool> secondCallInside = { false };
+	std::atomic<bool> releaseFirstCall = { false };
+	std::atomic<bool> releaseSecondCall = { false };
+	auto blockingListener = dispatcher.add_listener([&](bool first) {
+		(first ? firstCallInside : secondCallInside) = true;
+		while (!(first ? releaseFirstCall : releaseSecondCall))
+		{
+			std::this_thread::yield();
+		}
+	});
+
+	auto token = std::make_shared<int>(0);
+	std::weak_ptr<int> observedToken = token;
+	auto tokenListener = dispatcher.add_listener([token](bool) {});
+	token.reset();
+
+	// The first call uses the snapshot with the token listener
+	std::thread firstCaller([this]() { dispatcher.call(true); });
+	while (!firstCallInside)
+	{
+		std::this_thread::yield();
+	}
+	dispatcher.remove_listener(tokenListener);
+
+	// The second call starts before the first one returns, so there is no moment without a running call
+	std::thread secondCaller([this]() { dispatcher.call(false); });
+	while (!secondCallInside)
+	{
+		std::this_thread::yield();
+	}
+	releaseFirstCall = true;
+	firstCaller.join();
+	EXPECT_FALSE(observedToken.expired());
+
+	// No call can see the token's snapshot anymore, so the next change frees it
+	dispatcher.remove_listener(dispatcher.add_listener([](bool) {}));
+	EXPECT_TRUE(observedToken.expired());
+
+	releaseSecondCall = true;
+	secondCaller.join();
+	dispatcher.remove_listener(blockingListener);
+	EXPECT_EQ(0, dispatcher.get_listener_count());
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include "isobus/isobus/can_extended_transport_protocol.hpp"
+#include "isobus/utility/system_timing.hpp"
+
+#include "helpers/control_function_helpers.hpp"
+#include "helpers/messaging_helpers.hpp"
+
+#include <deque>
+
+using namespace isobus;
+
+/// @brief Transfers a message between two ETP managers, and returns the number of update cycles it took
+/// @details Each cycle mimics a network manager update: first all frames sent since the last cycle are received, then the protocols are updated.
+static std::uint32_t transfer_message(CANNetworkConfiguration &configuration, std::uint32_t messageLength, std::uint32_t &largestNumberOfFramesPerCycle)
+{
+	auto sender = test_helpers::create_mock_internal_control_function(0x01);
+	auto receiver = test_helpers::create_mock_internal_control_function(0x02);
+	std::deque<CANMessage> toReceiver;
+	std::deque<CANMessage> toSender;
+	std::vector<std::uint8_t> receivedData;
+
+	auto sendFrameCallback = [&](std::uint32_t parameterGroupNumber,
+	                             CANDataSpan data,
+	                             std::shared_ptr<InternalControlFunction> sourceControlFunction,
+	                             std::shared_ptr<ControlFunction> destinationControlFunction,
+	                             CANIdentifier::CANPriority priority) {
+		auto &queue = (sourceControlFunction == sender) ? toReceiver : toSender;
+		queue.push_back(test_helpers::create_message(static_cast<std::uint8_t>(priority), parameterGroupNumber, destinationControlFunction, sourceControlFunction, data.begin(), data.size()));
+		return true;
+	};
+	auto receiveMessageCallback = [&](const CANMessage &message) {
+		receivedData = message.get_data();
+	};
+
+	ExtendedTransportProtocolManager senderManager(sendFrameCallback, receiveMessageCallback, &configuration);
+	ExtendedTransportProtocolManager receiverManager(sendFrameCallback, receiveMessageCallback, &configuration);
+
+	std::vector<std::uint8_t> dataToSend(messageLength);
+	for (std::uint32_t i = 0; i < messageLength; i++)
+	{
+		dataToSend[i] = static_cast<std::uint8_t>(i);
+	}
+	std::unique_ptr<CANMessageData> data(new CANMessageDataVector(dataToSend));
+	EXPECT_TRUE(senderManager.protocol_transmit_message(0xEF00, data, sender, receiver, nullptr, nullptr));
+
+	std::uint32_t cycles = 0;
+	std::uint32_t startTime = SystemTiming::get_timestamp_ms();
+	largestNumberOfFramesPerCycle = 0;
+	while (senderManager.has_session(sender, receiver) && (SystemTiming::get_time_elapsed_ms(startTime) < 5000))
+	{
+		largestNumberOfFramesPerCycle = std::max(largestNumberOfFramesPerCycle, static_cast<std::uint32_t>(toReceiver.size()));
+		while (!toReceiver.empty())
+		{
+			receiverManager.process_message(toReceiver.front());
+			toReceiver.pop_front();
+		}
+		while (!toSender.empty())
+		{
+			senderManager.process_message(toSender.front());
+			toSender.pop_front();
+		}
+		senderManager.update();
+		receiverManager.update();
+		cycles++;
+	}
+	EXPECT_EQ(dataToSend, receivedData);
+	return cycles;
+}
+
+TEST(EXTENDED_TRANSPORT_PROTOCOL_TESTS, LargerWindowsNeedFewerCycles)
+{
+	constexpr std::uint32_t MESSAGE_LENGTH = 20000;
+	constexpr std::uint32_t NUMBER_OF_PACKETS = (MESSAGE_LENGTH + 6) / 7;
+	CANNetworkConfiguration configuration;
+	std::uint32_t largestNumberOfFramesPerCycle = 0;
+
+	// Every window takes a single cycle: the CTS is answered with the DPO and all the data in the same update
+	configuration.set_number_of_packets_per_dpo_message(16);
+	std::uint32_t smallWindowCycles = transfer_message(configuration, MESSAGE_LENGTH, largestNumberOfFramesPerCycle);
+	EXPECT_LE(smallWindowCycles, (NUMBER_OF_PACKETS + 15) / 16 + 2);
+	EXPECT_EQ(17, largestNumberOfFramesPerCycle); // DPO + 16 data frames
+
+	configuration.set_number_of_packets_per_dpo_message(255);
+	std::uint32_t largeWindowCycles = transfer_message(configuration, MESSAGE_LENGTH, largestNumberOfFramesPerCycle);
+	EXPECT_LE(largeWindowCycles, (NUMBER_OF_PACKETS + 254) / 255 + 2);
+	EXPECT_EQ(256, largestNumberOfFramesPerCycle); // DPO + 255 data frames
+	EXPECT_LT(largeWindowCycles, smallWindowCycles);
+}
+
+TEST(EXTENDED_TRANSPORT_PROTOCOL_TESTS, MinimumTimeBetweenDataFrames)
+{
+	CANNetworkConfiguration configuration;
+	EXPECT_EQ(0, configuration.get_minimum_time_between_transport_protocol_data_frames());
+	configuration.set_minimum_time_between_transport_protocol_data_frames(201);
+	EXPECT_EQ(0, configuration.get_minimum_time_between_transport_protocol_data_frames());
+	configuration.set_minimum_time_between_transport_protocol_data_frames(1);
+	EXPECT_EQ(1, configuration.get_minimum_time_between_transport_protocol_data_frames());
+
+	// With a gap, data frames are no longer sent in bursts
+	constexpr std::uint32_t MESSAGE_LENGTH = 2000;
+	std::uint32_t largestNumberOfFramesPerCycle = 0;
+	std::uint32_t startTime = SystemTiming::get_timestamp_ms();
+	std::uint32_t cycles = transfer_message(configuration, MESSAGE_LENGTH, largestNumberOfFramesPerCycle);
+	EXPECT_EQ(1, largestNumberOfFramesPerCycle);
+	EXPECT_GE(cycles, (MESSAGE_LENGTH + 6) / 7);
+	EXPECT_GE(SystemTiming::get_time_elapsed_ms(startTime), (MESSAGE_LENGTH + 6) / 7);
+}
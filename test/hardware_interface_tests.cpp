@@ -5,9 +5,15 @@
 #include "isobus/utility/system_timing.hpp"
 
 #include <chrono>
+#include <deque>
 #include <future>
 #include <thread>
 
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
 using namespace isobus;
 
 TEST(HARDWARE_INTERFACE_TESTS, SendMessageToHardware)
@@ -116,6 +122,51 @@ TEST(HARDWARE_INTERFACE_TESTS, MessageFrameSentEventListener)
 	CANHardwareInterface::stop();
 }
 
+TEST(HARDWARE_INTERFACE_TESTS, TransmitBurstOfFramesInOrder)
+{
+	auto receiver = std::make_shared<VirtualCANPlugin>();
+	auto sender = std::make_shared<VirtualCANPlugin>();
+	receiver->open();
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, sender);
+	CANHardwareInterface::start();
+
+	std::atomic<int> messageCount = { 0 };
+	std::function<void(const CANMessageFrame &)> sendCallback = [&messageCount](const CANMessageFrame &) {
+		messageCount += 1;
+	};
+	CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().add_listener(sendCallback);
+
+	CANMessageFrame fakeFrame;
+	memset(&fakeFrame, 0, sizeof(CANMessageFrame));
+	fakeFrame.isExtendedFrame = true;
+	fakeFrame.dataLength = 1;
+	fakeFrame.channel = 0;
+	for (std::uint8_t i = 0; i < 20; i++)
+	{
+		fakeFrame.identifier = 0x18EB0000 + i;
+		fakeFrame.data[0] = i;
+		EXPECT_TRUE(isobus::send_can_message_frame_to_hardware(fakeFrame));
+	}
+
+	auto future = std::async(std::launch::async, [&messageCount] { while (messageCount < 20 && CANHardwareInterface::is_running()); });
+	EXPECT_TRUE(future.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+	CANHardwareInterface::stop();
+
+	CANMessageFrame receiveFrames[20];
+	std::size_t framesReceived = 0;
+	while ((framesReceived < 20) && !receiver->get_queue_empty())
+	{
+		framesReceived += receiver->read_frames(&receiveFrames[framesReceived], 20 - framesReceived);
+	}
+	ASSERT_EQ(framesReceived, 20);
+	for (std::uint8_t i = 0; i < 20; i++)
+	{
+		EXPECT_EQ(receiveFrames[i].identifier, 0x18EB0000U + i);
+		EXPECT_EQ(receiveFrames[i].data[0], i);
+	}
+}
+
 TEST(HARDWARE_INTERFACE_TESTS, PeriodicUpdateEventListener)
 {
 	CANHardwareInterface::start();
@@ -262,3 +313,342 @@ TEST(HARDWARE_INTERFACE_TESTS, VerifyStartedFlagBehaviorInNonThreadingMode)
 	// Clean up
 	CANHardwareInterface::stop();
 }
+
+static void fill_receive_queue_while_blocked(std::shared_ptr<VirtualCANPlugin> device, std::vector<std::uint32_t> &receivedIdentifiers, std::uint64_t expectedDrops)
+{
+	std::atomic_bool listenerBlocked = { false };
+	std::atomic_bool releaseListener = { false };
+	std::atomic<std::size_t> framesReceived = { 0 };
+	std::mutex identifiersMutex;
+
+	std::function<void(const CANMessageFrame &)> receivedCallback = [&](const CANMessageFrame &frame) {
+		{
+			std::lock_guard<std::mutex> lock(identifiersMutex);
+			receivedIdentifiers.push_back(frame.identifier);
+		}
+		listenerBlocked = true;
+		while (!releaseListener)
+		{
+			std::this_thread::yield();
+		}
+		framesReceived++;
+	};
+	auto listener = CANHardwareInterface::get_can_frame_received_event_dispatcher().add_listener(receivedCallback);
+
+	CANMessageFrame fakeFrame;
+	memset(&fakeFrame, 0, sizeof(CANMessageFrame));
+	fakeFrame.isExtendedFrame = true;
+	fakeFrame.dataLength = 8;
+	fakeFrame.identifier = 0x18EF0000;
+	device->write_frame_as_if_received(fakeFrame);
+
+	// Wait until the update thread is stuck in our listener, so nothing is taken out of the receive queue
+	auto blocked = std::async(std::launch::async, [&listenerBlocked] { while (!listenerBlocked); });
+	ASSERT_TRUE(blocked.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+
+	for (std::uint32_t i = 1; i <= 10; i++)
+	{
+		fakeFrame.identifier = 0x18EF0000 + i;
+		device->write_frame_as_if_received(fakeFrame);
+	}
+
+	// The statistics can't be read yet, the blocked update thread holds the channel mutex
+	auto read = std::async(std::launch::async, [&device] { while (!device->get_queue_empty()); });
+	EXPECT_TRUE(read.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Let the receive thread queue or drop the last frames it read
+	releaseListener = true;
+
+	auto drained = std::async(std::launch::async, [&framesReceived, expectedDrops] { while (framesReceived < 11 - expectedDrops); });
+	EXPECT_TRUE(drained.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+	CANHardwareInterface::get_can_frame_received_event_dispatcher().remove_listener(listener);
+}
+
+TEST(HARDWARE_INTERFACE_TESTS, ReceiveQueueOverflowPolicies)
+{
+	auto device = std::make_shared<VirtualCANPlugin>();
+	CANHardwareInterface::set_number_of_can_channels(0);
+	CANHardwareInterface::set_number_of_can_channels(1, 4);
+	EXPECT_FALSE(CANHardwareInterface::set_queue_overflow_policy(1, CANHardwareInterface::QueueOverflowPolicy::Grow));
+
+	// Drop newest: the first frame is being processed, the next 4 fit in the queue, the other 6 are dropped
+	EXPECT_TRUE(CANHardwareInterface::set_queue_overflow_policy(0, CANHardwareInterface::QueueOverflowPolicy::DropNewest));
+	CANHardwareInterface::assign_can_channel_frame_handler(0, device);
+	CANHardwareInterface::start();
+	EXPECT_FALSE(CANHardwareInterface::set_queue_overflow_policy(0, CANHardwareInterface::QueueOverflowPolicy::Grow));
+	std::vector<std::uint32_t> receivedIdentifiers;
+	fill_receive_queue_while_blocked(device, receivedIdentifiers, 6);
+	CANHardwareInterface::stop();
+	ASSERT_EQ(5, receivedIdentifiers.size());
+	EXPECT_EQ(0x18EF0004, receivedIdentifiers.back());
+	EXPECT_EQ(6, CANHardwareInterface::get_channel_statistics(0).receiveQueueDroppedFrames);
+	EXPECT_EQ(4, CANHardwareInterface::get_channel_statistics(0).receiveQueueHighWaterMark);
+
+	// Drop oldest: the 4 newest frames are kept
+	CANHardwareInterface::reset_channel_statistics(0);
+	EXPECT_TRUE(CANHardwareInterface::set_queue_overflow_policy(0, CANHardwareInterface::QueueOverflowPolicy::DropOldest));
+	CANHardwareInterface::assign_can_channel_frame_handler(0, device);
+	CANHardwareInterface::start();
+	receivedIdentifiers.clear();
+	fill_receive_queue_while_blocked(device, receivedIdentifiers, 6);
+	CANHardwareInterface::stop();
+	ASSERT_EQ(5, receivedIdentifiers.size());
+	EXPECT_EQ(0x18EF0007, receivedIdentifiers[1]);
+	EXPECT_EQ(0x18EF000A, receivedIdentifiers.back());
+	EXPECT_EQ(6, CANHardwareInterface::get_channel_statistics(0).receiveQueueDroppedFrames);
+
+	// Grow: every frame is kept, in order
+	CANHardwareInterface::reset_channel_statistics(0);
+	EXPECT_TRUE(CANHardwareInterface::set_queue_overflow_policy(0, CANHardwareInterface::QueueOverflowPolicy::Grow));
+	CANHardwareInterface::assign_can_channel_frame_handler(0, device);
+	CANHardwareInterface::start();
+	receivedIdentifiers.clear();
+	fill_receive_queue_while_blocked(device, receivedIdentifiers, 0);
+	CANHardwareInterface::stop();
+	// Nothing was dropped, although the block timeout expired during the pause
+	ASSERT_EQ(11, receivedIdentifiers.size());
+	for (std::uint32_t i = 0; i < receivedIdentifiers.size(); i++)
+	{
+		EXPECT_EQ(0x18EF0000 + i, receivedIdentifiers[i]);
+	}
+	EXPECT_EQ(0, CANHardwareInterface::get_channel_statistics(0).receiveQueueDroppedFrames);
+	EXPECT_EQ(10, CANHardwareInterface::get_channel_statistics(0).receiveQueueHighWaterMark);
+
+	// Restore the defaults for other tests
+	EXPECT_TRUE(CANHardwareInterface::set_queue_overflow_policy(0, CANHardwareInterface::QueueOverflowPolicy::BlockWithTimeout));
+	CANHardwareInterface::set_number_of_can_channels(0);
+	CANHardwareInterface::set_number_of_can_channels(1);
+}
+
+#if !defined CAN_STACK_DISABLE_THREADS && defined __linux__
+/// @brief A driver that signals received frames through an eventfd, so it is serviced by the epoll reactor
+class PollableTestPlugin : public CANHardwarePlugin
+{
+public:
+	std::string get_name() const override
+	{
+		return "Pollable Test Plugin";
+	}
+
+	bool get_is_valid() const override
+	{
+		return -1 != eventFileDescriptor;
+	}
+
+	void open() override
+	{
+		eventFileDescriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	}
+
+	void close() override
+	{
+		if (-1 != eventFileDescriptor)
+		{
+			::close(eventFileDescriptor);
+			eventFileDescriptor = -1;
+		}
+	}
+
+	bool read_frame(CANMessageFrame &canFrame) override
+	{
+		return 1 == read_frames(&canFrame, 1);
+	}
+
+	std::size_t read_frames(CANMessageFrame *canFrames, std::size_t maxFrames) override
+	{
+		std::lock_guard<std::mutex> lock(framesMutex);
+		std::size_t numberOfFrames = 0;
+
+		readCalls++;
+		while ((numberOfFrames < maxFrames) && (!frames.empty()))
+		{
+			canFrames[numberOfFrames] = frames.front();
+			frames.pop_front();
+			numberOfFrames++;
+		}
+
+		if (frames.empty())
+		{
+			// Nothing left to read, so the descriptor should not be readable anymore
+			std::uint64_t count;
+			EXPECT_EQ(sizeof(count), static_cast<std::size_t>(read(eventFileDescriptor, &count, sizeof(count))));
+		}
+		return numberOfFrames;
+	}
+
+	bool write_frame(const CANMessageFrame &) override
+	{
+		return true;
+	}
+
+	int get_receive_file_descriptor() const override
+	{
+		return eventFileDescriptor;
+	}
+
+	/// @brief Makes a frame available for reading and signals the descriptor
+	/// @param[in] frame The frame to receive
+	void receive(const CANMessageFrame &frame)
+	{
+		std::lock_guard<std::mutex> lock(framesMutex);
+		const std::uint64_t count = 1;
+
+		frames.push_back(frame);
+		EXPECT_EQ(sizeof(count), static_cast<std::size_t>(write(eventFileDescriptor, &count, sizeof(count))));
+	}
+
+	std::atomic<std::size_t> readCalls = { 0 }; ///< The number of times the hardware interface read from the driver
+
+private:
+	std::deque<CANMessageFrame> frames;
+	std::mutex framesMutex;
+	int eventFileDescriptor = -1;
+};
+
+TEST(HARDWARE_INTERFACE_TESTS, ReactorReceivesFramesFromPollableDrivers)
+{
+	auto device = std::make_shared<PollableTestPlugin>();
+	CANHardwareInterface::set_number_of_can_channels(0);
+	CANHardwareInterface::set_number_of_can_channels(1, 4);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, device);
+	CANHardwareInterface::start();
+	ASSERT_NE(-1, device->get_receive_file_descriptor());
+
+	std::atomic_bool listenerBlocked = { false };
+	std::atomic_bool releaseListener = { false };
+	std::vector<std::uint32_t> receivedIdentifiers;
+	std::mutex identifiersMutex;
+	auto listener = CANHardwareInterface::get_can_frame_received_event_dispatcher().add_listener([&](const CANMessageFrame &frame) {
+		std::lock_guard<std::mutex> lock(identifiersMutex);
+		receivedIdentifiers.push_back(frame.identifier);
+		listenerBlocked = true;
+		while (!releaseListener)
+		{
+			std::this_thread::yield();
+		}
+	});
+
+	CANMessageFrame fakeFrame;
+	memset(&fakeFrame, 0, sizeof(CANMessageFrame));
+	fakeFrame.isExtendedFrame = true;
+	fakeFrame.dataLength = 8;
+	fakeFrame.identifier = 0x18EF0000;
+	device->receive(fakeFrame);
+
+	// The reactor thread is stuck in the listener, the other frames have to wait in the driver
+	auto blocked = std::async(std::launch::async, [&listenerBlocked] { while (!listenerBlocked); });
+	ASSERT_TRUE(blocked.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+	for (std::uint32_t i = 1; i <= 20; i++)
+	{
+		fakeFrame.identifier = 0x18EF0000 + i;
+		device->receive(fakeFrame);
+	}
+	releaseListener = true;
+
+	// The default policy blocks instead of dropping, so every frame arrives in order although the queue only holds 4
+	auto received = std::async(std::launch::async, [&] {
+		for (;;)
+		{
+			std::lock_guard<std::mutex> lock(identifiersMutex);
+			if (receivedIdentifiers.size() >= 21)
+			{
+				break;
+			}
+		}
+	});
+	ASSERT_TRUE(received.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+
+	// Without frames the descriptor isn't readable, so the reactor doesn't read from the driver while idle
+	const std::size_t readCalls = device->readCalls;
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_EQ(readCalls, device->readCalls);
+
+	CANHardwareInterface::get_can_frame_received_event_dispatcher().remove_listener(listener);
+	CANHardwareInterface::stop();
+
+	ASSERT_EQ(21, receivedIdentifiers.size());
+	for (std::uint32_t i = 0; i < receivedIdentifiers.size(); i++)
+	{
+		EXPECT_EQ(0x18EF0000 + i, receivedIdentifiers[i]);
+	}
+	EXPECT_EQ(0, CANHardwareInterface::get_channel_statistics(0).receiveQueueDroppedFrames);
+	EXPECT_GE(4, CANHardwareInterface::get_channel_statistics(0).receiveQueueHighWaterMark);
+
+	CANHardwareInterface::set_number_of_can_channels(0);
+	CANHardwareInterface::set_number_of_can_channels(1);
+}
+
+TEST(HARDWARE_INTERFACE_TESTS, ReactorPausedByBusyStackDeliversFramesAfterResuming)
+{
+	auto device = std::make_shared<PollableTestPlugin>();
+	CANHardwareInterface::set_number_of_can_channels(0);
+	CANHardwareInterface::set_number_of_can_channels(1, 4);
+	EXPECT_TRUE(CANHardwareInterface::set_queue_overflow_policy(0, CANHardwareInterface::QueueOverflowPolicy::BlockWithTimeout, 10));
+	CANHardwareInterface::assign_can_channel_frame_handler(0, device);
+	CANHardwareInterface::start();
+	ASSERT_NE(-1, device->get_receive_file_descriptor());
+
+	std::atomic_bool listenerBlocked = { false };
+	std::atomic_bool releaseListener = { false };
+	std::vector<std::uint32_t> receivedIdentifiers;
+	std::mutex identifiersMutex;
+	auto listener = CANHardwareInterface::get_can_frame_received_event_dispatcher().add_listener([&](const CANMessageFrame &frame) {
+		std::lock_guard<std::mutex> lock(identifiersMutex);
+		receivedIdentifiers.push_back(frame.identifier);
+		listenerBlocked = true;
+		while (!releaseListener)
+		{
+			std::this_thread::yield();
+		}
+	});
+
+	CANMessageFrame fakeFrame;
+	memset(&fakeFrame, 0, sizeof(CANMessageFrame));
+	fakeFrame.isExtendedFrame = true;
+	fakeFrame.dataLength = 8;
+	fakeFrame.identifier = 0x18EF0000;
+	device->receive(fakeFrame);
+
+	// Pause the reactor in the listener, then inject more frames than the queue holds
+	auto blocked = std::async(std::launch::async, [&listenerBlocked] { while (!listenerBlocked); });
+	ASSERT_TRUE(blocked.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+	const std::size_t readCallsBeforePause = device->readCalls;
+	for (std::uint32_t i = 1; i <= 10; i++)
+	{
+		fakeFrame.identifier = 0x18EF0000 + i;
+		device->receive(fakeFrame);
+	}
+
+	// While paused for longer than the block timeout, the frames wait in the driver and nothing is read
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_EQ(readCallsBeforePause, device->readCalls);
+
+	// Resuming reads the waiting frames, in order
+	releaseListener = true;
+	auto received = std::async(std::launch::async, [&] {
+		for (;;)
+		{
+			std::lock_guard<std::mutex> lock(identifiersMutex);
+			if (receivedIdentifiers.size() >= 11)
+			{
+				break;
+			}
+		}
+	});
+	ASSERT_TRUE(received.wait_for(std::chrono::seconds(5)) != std::future_status::timeout);
+	EXPECT_LT(readCallsBeforePause, device->readCalls);
+
+	CANHardwareInterface::get_can_frame_received_event_dispatcher().remove_listener(listener);
+	CANHardwareInterface::stop();
+
+	// Nothing was dropped, although the block timeout expired during the pause
+	ASSERT_EQ(11, receivedIdentifiers.size());
+	for (std::uint32_t i = 0; i < receivedIdentifiers.size(); i++)
+	{
+		EXPECT_EQ(0x18EF0000 + i, receivedIdentifiers[i]);
+	}
+	EXPECT_EQ(0, CANHardwareInterface::get_channel_statistics(0).receiveQueueDroppedFrames);
+
+	CANHardwareInterface::set_number_of_can_channels(0);
+	CANHardwareInterface::set_number_of_can_channels(1);
+}
+#endif
@@ -0,0 +1,38 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "allocation_counter.hpp"
+
+// Count every heap allocation made by the test binary, so tests can check that a code path doesn't allocate
+static std::atomic<std::size_t> numberOfAllocations{ 0 };
+
+void *operator new(std::size_t size)
+{
+	numberOfAllocations++;
+	void *retVal = std::malloc((0 != size) ? size : 1);
+	if (nullptr == retVal)
+	{
+		throw std::bad_alloc();
+	}
+	return retVal;
+}
+
+void operator delete(void *pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+namespace test_helpers
+{
+	std::size_t get_number_of_allocations()
+	{
+		return numberOfAllocations;
+	}
+
+} // namespace test_helpers
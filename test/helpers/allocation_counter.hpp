@@ -0,0 +1,13 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+namespace test_helpers
+{
+	/// Returns the number of heap allocations made through the global operator new since the test binary started
+	std::size_t get_number_of_allocations();
+
+} // namespace test_helpers
+
+#endif // ALLOCATION_COUNTER_HPP
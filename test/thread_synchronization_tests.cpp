@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include <thread>
+
+TEST(LOCK_FREE_QUEUE_TESTS, CapacityIsRoundedToPowerOfTwo)
+{
+	LockFreeQueue<int> queue(40);
+	EXPECT_EQ(64, queue.get_capacity());
+	EXPECT_EQ(64, queue.free_space());
+
+	LockFreeQueue<int> exactQueue(16);
+	EXPECT_EQ(16, exactQueue.get_capacity());
+}
+
+TEST(LOCK_FREE_QUEUE_TESTS, PushPopAndWrapAround)
+{
+	LockFreeQueue<int> queue(4);
+
+	for (int round = 0; round < 3; round++)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			EXPECT_TRUE(queue.push(round * 10 + i));
+		}
+		EXPECT_TRUE(queue.is_full());
+		EXPECT_FALSE(queue.push(99));
+
+		int item = 0;
+		EXPECT_TRUE(queue.peek(item));
+		EXPECT_EQ(round * 10, item);
+		EXPECT_TRUE(queue.pop());
+
+		for (int i = 1; i < 4; i++)
+		{
+			EXPECT_TRUE(queue.try_pop(item));
+			EXPECT_EQ(round * 10 + i, item);
+		}
+		EXPECT_FALSE(queue.try_pop(item));
+		EXPECT_FALSE(queue.pop());
+	}
+}
+
+TEST(LOCK_FREE_QUEUE_TESTS, BulkPushAndPop)
+{
+	LockFreeQueue<int> queue(8);
+	const int items[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+	EXPECT_EQ(8, queue.push_n(items, 10));
+	EXPECT_EQ(0, queue.push_n(items, 1));
+
+	int peeked[3] = { 0 };
+	EXPECT_EQ(3, queue.peek(peeked, 3));
+	EXPECT_EQ(1, peeked[0]);
+	EXPECT_EQ(3, peeked[2]);
+
+	int popped[5] = { 0 };
+	EXPECT_EQ(5, queue.pop_n(popped, 5));
+	EXPECT_EQ(1, popped[0]);
+	EXPECT_EQ(5, popped[4]);
+	EXPECT_EQ(5, queue.free_space());
+
+	EXPECT_EQ(2, queue.pop(2));
+	EXPECT_EQ(1, queue.pop_n(popped, 5));
+	EXPECT_EQ(8, popped[0]);
+
+	EXPECT_EQ(3, queue.push_n(&items[7], 3));
+	queue.clear();
+	EXPECT_EQ(0, queue.pop_n(popped, 5));
+	EXPECT_EQ(8, queue.free_space());
+
+	EXPECT_EQ(2, queue.push_n(items, 2));
+	EXPECT_EQ(2, queue.pop_n(popped, 5));
+	EXPECT_EQ(1, popped[0]);
+	EXPECT_EQ(2, popped[1]);
+}
+
+TEST(LOCK_FREE_QUEUE_TESTS, ProducerConsumerKeepsOrder)
+{
+	constexpr int NUMBER_OF_ITEMS = 10000;
+	LockFreeQueue<int> queue(64);
+
+	std::thread producer([&queue]() {
+		int next = 0;
+		int batch[16];
+		while (next < NUMBER_OF_ITEMS)
+		{
+			int count = 0;
+			while ((count < 16) && (next + count < NUMBER_OF_ITEMS))
+			{
+				batch[count] = next + count;
+				count++;
+			}
+			const std::size_t pushed = queue.push_n(batch, static_cast<std::size_t>(count));
+			if (0 == pushed)
+			{
+				std::this_thread::yield();
+			}
+			next += static_cast<int>(pushed);
+		}
+	});
+
+	int expected = 0;
+	bool inOrder = true;
+	int received[16];
+	while (expected < NUMBER_OF_ITEMS)
+	{
+		const std::size_t count = queue.pop_n(received, 16);
+		if (0 == count)
+		{
+			std::this_thread::yield();
+		}
+		for (std::size_t i = 0; i < count; i++)
+		{
+			inOrder = inOrder && (received[i] == expected);
+			expected++;
+		}
+	}
+	producer.join();
+
+	EXPECT_TRUE(inOrder);
+	EXPECT_EQ(NUMBER_OF_ITEMS, expected);
+}
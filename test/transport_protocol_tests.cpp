@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 
 #include "isobus/isobus/can_transport_protocol.hpp"
+#include "isobus/isobus/can_transport_protocol_session_table.hpp"
 #include "isobus/utility/system_timing.hpp"
 
+#include "helpers/allocation_counter.hpp"
 #include "helpers/control_function_helpers.hpp"
 #include "helpers/messaging_helpers.hpp"
 
@@ -2123,3 +2125,296 @@ TEST(TRANSPORT_PROTOCOL_TESTS, DestinationSpecificOverwriteSession)
 	// After the transmission is finished, the sessions should be removed as indication that connection is closed
 	ASSERT_FALSE(manager.has_session(originator, receiver));
 }
+
+class TestSession : public TransportProtocolSessionBase
+{
+public:
+	TestSession(std::uint32_t parameterGroupNumber, std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination) :
+	  TransportProtocolSessionBase(Direction::Receive, nullptr, parameterGroupNumber, 0, source, destination, nullptr, nullptr)
+	{
+	}
+
+	std::uint32_t get_total_bytes_transferred() const override
+	{
+		return 0;
+	}
+};
+
+TEST(TRANSPORT_PROTOCOL_TESTS, SessionTableLookup)
+{
+	TransportProtocolSessionTable<TestSession> table(4);
+	std::vector<std::shared_ptr<ControlFunction>> controlFunctions;
+	std::vector<std::shared_ptr<TestSession>> sessions;
+	for (std::uint8_t i = 0; i < 40; i++)
+	{
+		controlFunctions.push_back(test_helpers::create_mock_control_function(i));
+	}
+
+	// One broadcast and one destination specific session per source, which grows the table past its initial size
+	for (std::uint8_t i = 0; i < 20; i++)
+	{
+		sessions.push_back(std::make_shared<TestSession>(0xFEEC, controlFunctions[i], nullptr));
+		sessions.push_back(std::make_shared<TestSession>(0xFEEC, controlFunctions[i], controlFunctions[i + 20]));
+		EXPECT_TRUE(table.insert(sessions[sessions.size() - 2]));
+		EXPECT_TRUE(table.insert(sessions.back()));
+	}
+	EXPECT_EQ(40, table.size());
+
+	// Only one session is allowed per source and destination pair, regardless of PGN
+	EXPECT_FALSE(table.insert(std::make_shared<TestSession>(0xFEEB, controlFunctions[0], nullptr)));
+	EXPECT_EQ(40, table.size());
+
+	for (std::uint8_t i = 0; i < 20; i++)
+	{
+		EXPECT_EQ(sessions[2 * i], table.find(controlFunctions[i], nullptr));
+		EXPECT_EQ(sessions[2 * i + 1], table.find(controlFunctions[i], controlFunctions[i + 20]));
+		EXPECT_EQ(nullptr, table.find(controlFunctions[i + 20], controlFunctions[i]));
+	}
+
+	// Remove every other session, the rest must still be found and stay in order
+	for (std::size_t i = 0; i < sessions.size(); i += 2)
+	{
+		EXPECT_TRUE(table.erase(sessions[i]));
+		EXPECT_FALSE(table.erase(sessions[i]));
+	}
+	ASSERT_EQ(20, table.size());
+	for (std::uint8_t i = 0; i < 20; i++)
+	{
+		EXPECT_EQ(nullptr, table.find(controlFunctions[i], nullptr));
+		EXPECT_EQ(sessions[2 * i + 1], table.find(controlFunctions[i], controlFunctions[i + 20]));
+		EXPECT_EQ(sessions[2 * i + 1], table.get_sessions().at(i));
+	}
+
+	// Adding and removing sessions within the preallocated size does not allocate
+	const std::size_t allocationsBefore = test_helpers::get_number_of_allocations();
+	for (std::size_t i = 0; i < sessions.size(); i += 2)
+	{
+		EXPECT_TRUE(table.insert(sessions[i]));
+		EXPECT_TRUE(table.erase(sessions[i]));
+	}
+	EXPECT_EQ(allocationsBefore, test_helpers::get_number_of_allocations());
+
+	table.clear();
+	EXPECT_TRUE(table.empty());
+	EXPECT_EQ(nullptr, table.find(controlFunctions[0], controlFunctions[20]));
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, SessionTableKeyedByParameterGroupNumber)
+{
+	TransportProtocolSessionTable<TestSession> table(4, true);
+	auto source = test_helpers::create_mock_control_function(0x01);
+
+	auto firstSession = std::make_shared<TestSession>(0x1F001, source, nullptr);
+	auto secondSession = std::make_shared<TestSession>(0x1F002, source, nullptr);
+	EXPECT_TRUE(table.insert(firstSession));
+	EXPECT_TRUE(table.insert(secondSession));
+	EXPECT_FALSE(table.insert(std::make_shared<TestSession>(0x1F001, source, nullptr)));
+
+	EXPECT_EQ(firstSession, table.find(source, nullptr, 0x1F001));
+	EXPECT_EQ(secondSession, table.find(source, nullptr, 0x1F002));
+	EXPECT_EQ(nullptr, table.find(source, nullptr, 0x1F003));
+
+	EXPECT_TRUE(table.erase(firstSession));
+	EXPECT_EQ(nullptr, table.find(source, nullptr, 0x1F001));
+	EXPECT_EQ(secondSession, table.find(source, nullptr, 0x1F002));
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, SessionTableCreatesSessionsInItsStorage)
+{
+	auto source = test_helpers::create_mock_control_function(0x01);
+	std::vector<std::shared_ptr<ControlFunction>> destinations;
+	for (std::uint8_t i = 0; i < 5; i++)
+	{
+		destinations.push_back(test_helpers::create_mock_control_function(0x10 + i));
+	}
+
+	std::shared_ptr<TestSession> survivor;
+	{
+		TransportProtocolSessionTable<TestSession> table(4);
+		EXPECT_EQ(0, table.get_storage().get_number_of_chunks());
+
+		// The first session allocates room for the expected number of sessions
+		std::vector<std::shared_ptr<TestSession>> sessions;
+		for (std::uint8_t i = 0; i < 3; i++)
+		{
+			sessions.push_back(table.create(0xFEEC, source, destinations[i]));
+			EXPECT_TRUE(table.insert(sessions.back()));
+		}
+		EXPECT_EQ(1, table.get_storage().get_number_of_chunks());
+
+		// A session with a key that is already in use is not added, and its memory is given back
+		EXPECT_FALSE(table.insert(table.create(0xFEEB, source, destinations[0])));
+		sessions.push_back(table.create(0xFEEC, source, destinations[3]));
+		EXPECT_TRUE(table.insert(sessions.back()));
+		EXPECT_EQ(1, table.get_storage().get_number_of_chunks());
+
+		// Sessions that are closed and started again reuse the same memory
+		const std::size_t allocationsBefore = test_helpers::get_number_of_allocations();
+		for (std::uint32_t round = 0; round < 10; round++)
+		{
+			for (auto &session : sessions)
+			{
+				auto destination = session->get_destination();
+				EXPECT_TRUE(table.erase(session));
+				session.reset();
+				session = table.create(0xFEEC, source, destination);
+				EXPECT_TRUE(table.insert(session));
+			}
+		}
+		EXPECT_EQ(allocationsBefore, test_helpers::get_number_of_allocations());
+
+		// More sessions than expected still work, they just need another chunk
+		survivor = table.create(0xFEEC, source, destinations[4]);
+		EXPECT_TRUE(table.insert(survivor));
+		EXPECT_EQ(2, table.get_storage().get_number_of_chunks());
+	}
+
+	// A session can outlive its table, for example if the application kept a copy of the session list
+	EXPECT_EQ(destinations[4], survivor->get_destination());
+	survivor.reset();
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, BroadcastReceiveBuffersAreReused)
+{
+	constexpr std::uint8_t NUMBER_OF_SOURCES = 4;
+	constexpr std::uint32_t NUMBER_OF_ROUNDS = 250;
+
+	std::uint32_t messageCount = 0;
+	auto receiveMessageCallback = [&](const CANMessage &message) {
+		ASSERT_EQ(17, message.get_data_length());
+		EXPECT_EQ(message.get_source_control_function()->get_address(), message.get_uint8_at(16));
+		messageCount++;
+	};
+
+	CANNetworkConfiguration defaultConfiguration;
+	TransportProtocolManager manager(nullptr, receiveMessageCallback, &defaultConfiguration);
+
+	std::vector<std::shared_ptr<ControlFunction>> originators;
+	for (std::uint8_t i = 0; i < NUMBER_OF_SOURCES; i++)
+	{
+		originators.push_back(test_helpers::create_mock_control_function(0x10 + i));
+	}
+
+	// Simulates several ECUs periodically broadcasting BAMs at the same time, with their frames interleaved
+	for (std::uint32_t round = 0; round < NUMBER_OF_ROUNDS; round++)
+	{
+		for (const auto &originator : originators)
+		{
+			manager.process_message(test_helpers::create_message_broadcast(7, 0xEC00, originator, { 32, 17, 0, 3, 0xFF, 0xEC, 0xFE, 0x00 }));
+		}
+		for (std::uint8_t sequence = 1; sequence <= 3; sequence++)
+		{
+			for (const auto &originator : originators)
+			{
+				// The source address is put in the last byte of the message so the callback can check it
+				manager.process_message(test_helpers::create_message_broadcast(7, 0xEB00, originator, { sequence, 0, 0, originator->get_address(), 0xFF, 0xFF, 0xFF, 0xFF }));
+			}
+		}
+	}
+	EXPECT_EQ(NUMBER_OF_SOURCES * NUMBER_OF_ROUNDS, messageCount);
+
+	// Only one buffer per concurrent session was ever allocated, every other session reused one
+	EXPECT_EQ(NUMBER_OF_SOURCES, manager.get_receive_buffer_pool().get_number_of_allocations());
+	EXPECT_EQ(NUMBER_OF_SOURCES * (NUMBER_OF_ROUNDS - 1), manager.get_receive_buffer_pool().get_number_of_reuses());
+
+	// A session that is replaced before it completes also gives its buffer back
+	manager.process_message(test_helpers::create_message_broadcast(7, 0xEC00, originators[0], { 32, 17, 0, 3, 0xFF, 0xEC, 0xFE, 0x00 }));
+	manager.process_message(test_helpers::create_message_broadcast(7, 0xEC00, originators[0], { 32, 17, 0, 3, 0xFF, 0xEC, 0xFE, 0x00 }));
+	EXPECT_EQ(NUMBER_OF_SOURCES, manager.get_receive_buffer_pool().get_number_of_allocations());
+	EXPECT_EQ(NUMBER_OF_SOURCES - 1, manager.get_receive_buffer_pool().get_number_of_idle_buffers());
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, ShortBroadcastReceiveBuffersAreReused)
+{
+	constexpr std::uint32_t NUMBER_OF_ROUNDS = 10;
+
+	std::uint32_t messageCount = 0;
+	auto receiveMessageCallback = [&](const CANMessage &message) {
+		ASSERT_EQ(6, message.get_data_length());
+		EXPECT_TRUE(message.get_data().is_stored_inline());
+		EXPECT_EQ(1, message.get_uint8_at(0));
+		EXPECT_EQ(6, message.get_uint8_at(5));
+		messageCount++;
+	};
+
+	CANNetworkConfiguration defaultConfiguration;
+	TransportProtocolManager manager(nullptr, receiveMessageCallback, &defaultConfiguration);
+	auto originator = test_helpers::create_mock_control_function(0x10);
+
+	// A message that fits in a single frame is copied out of the session buffer, and the buffer stays pooled
+	for (std::uint32_t round = 0; round < NUMBER_OF_ROUNDS; round++)
+	{
+		manager.process_message(test_helpers::create_message_broadcast(7, 0xEC00, originator, { 32, 6, 0, 1, 0xFF, 0xEC, 0xFE, 0x00 }));
+		manager.process_message(test_helpers::create_message_broadcast(7, 0xEB00, originator, { 1, 1, 2, 3, 4, 5, 6, 0xFF }));
+	}
+	EXPECT_EQ(NUMBER_OF_ROUNDS, messageCount);
+	EXPECT_EQ(1, manager.get_receive_buffer_pool().get_number_of_allocations());
+	EXPECT_EQ(NUMBER_OF_ROUNDS - 1, manager.get_receive_buffer_pool().get_number_of_reuses());
+}
+
+TEST(TRANSPORT_PROTOCOL_TESTS, DataTransferPacketsAreInterleaved)
+{
+	constexpr std::uint8_t NUMBER_OF_PACKETS = 10;
+	constexpr std::uint8_t FRAMES_PER_UPDATE = 4;
+	std::array<std::uint8_t, NUMBER_OF_PACKETS * 7> dataToSend = { 0 };
+
+	auto originator = test_helpers::create_mock_internal_control_function(0x01);
+	auto firstReceiver = test_helpers::create_mock_control_function(0x02);
+	auto secondReceiver = test_helpers::create_mock_control_function(0x03);
+	std::deque<CANMessage> responseQueue;
+	std::vector<std::shared_ptr<ControlFunction>> dataTransferDestinations;
+
+	auto sendFrameCallback = [&](std::uint32_t parameterGroupNumber,
+	                             CANDataSpan data,
+	                             std::shared_ptr<InternalControlFunction> sourceControlFunction,
+	                             std::shared_ptr<ControlFunction> destinationControlFunction,
+	                             CANIdentifier::CANPriority) {
+		if (0xEB00 == parameterGroupNumber)
+		{
+			dataTransferDestinations.push_back(destinationControlFunction);
+		}
+		else if ((0xEC00 == parameterGroupNumber) && (16 == data[0]))
+		{
+			// Grant the whole message in a single CTS
+			responseQueue.push_back(test_helpers::create_message(
+			  7,
+			  0xEC00,
+			  sourceControlFunction,
+			  destinationControlFunction,
+			  { 17, NUMBER_OF_PACKETS, 1, 0xFF, 0xFF, data[5], data[6], data[7] }));
+		}
+		return true;
+	};
+
+	CANNetworkConfiguration configuration;
+	configuration.set_max_number_of_network_manager_protocol_frames_per_update(FRAMES_PER_UPDATE);
+	TransportProtocolManager manager(sendFrameCallback, nullptr, &configuration);
+
+	std::unique_ptr<CANMessageData> firstData(new CANMessageDataView(dataToSend.data(), dataToSend.size()));
+	std::unique_ptr<CANMessageData> secondData(new CANMessageDataView(dataToSend.data(), dataToSend.size()));
+	ASSERT_TRUE(manager.protocol_transmit_message(0xEF00, firstData, originator, firstReceiver, nullptr, nullptr));
+	ASSERT_TRUE(manager.protocol_transmit_message(0xEF00, secondData, originator, secondReceiver, nullptr, nullptr));
+
+	while (!responseQueue.empty())
+	{
+		manager.process_message(responseQueue.front());
+		responseQueue.pop_front();
+	}
+
+	// Both sessions share the frames of each update, instead of the first one taking all of them
+	for (std::uint8_t i = 0; i < (2 * NUMBER_OF_PACKETS) / FRAMES_PER_UPDATE; i++)
+	{
+		dataTransferDestinations.clear();
+		manager.update();
+		ASSERT_EQ(FRAMES_PER_UPDATE, dataTransferDestinations.size());
+		EXPECT_EQ(FRAMES_PER_UPDATE / 2, std::count(dataTransferDestinations.begin(), dataTransferDestinations.end(), firstReceiver));
+		EXPECT_EQ(FRAMES_PER_UPDATE / 2, std::count(dataTransferDestinations.begin(), dataTransferDestinations.end(), secondReceiver));
+		EXPECT_NE(dataTransferDestinations[0], dataTransferDestinations[1]);
+	}
+
+	// All data has been sent, so both sessions are waiting for their end of message acknowledgement
+	dataTransferDestinations.clear();
+	manager.update();
+	EXPECT_TRUE(dataTransferDestinations.empty());
+	EXPECT_EQ(2, manager.get_sessions().size());
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "isobus/hardware_integration/can_hardware_interface.hpp"
+#include "isobus/hardware_integration/vector_asc_logger.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace isobus;
+
+static std::vector<std::string> read_lines(const std::string &fileName)
+{
+	std::vector<std::string> retVal;
+	std::ifstream file(fileName);
+	std::string line;
+	while (std::getline(file, line))
+	{
+		retVal.push_back(line);
+	}
+	return retVal;
+}
+
+static CANMessageFrame create_test_frame(std::uint32_t identifier, std::uint8_t channel)
+{
+	CANMessageFrame retVal = {};
+	retVal.identifier = identifier;
+	retVal.isExtendedFrame = true;
+	retVal.channel = channel;
+	retVal.dataLength = 3;
+	retVal.data[0] = 0x01;
+	retVal.data[1] = 0xAB;
+	retVal.data[2] = 0xFF;
+	return retVal;
+}
+
+TEST(VECTOR_ASC_LOGGER_TESTS, WritesFramesOfBothDirections)
+{
+	const std::string fileName = "vector_asc_logger_test.asc";
+	{
+		VectorASCLogger logger(fileName);
+		CANHardwareInterface::get_can_frame_received_event_dispatcher().invoke(create_test_frame(0x18EFFF80, 0));
+		CANHardwareInterface::get_can_frame_transmitted_event_dispatcher().invoke(create_test_frame(0x0CF00401, 1));
+
+		CANMessageFrame standardFrame = create_test_frame(0x123, 0);
+		standardFrame.isExtendedFrame = false;
+		CANHardwareInterface::get_can_frame_received_event_dispatcher().invoke(standardFrame);
+		EXPECT_EQ(0u, logger.get_number_of_dropped_frames());
+		EXPECT_EQ(1u, logger.get_number_of_files());
+	}
+
+	auto lines = read_lines(fileName);
+	ASSERT_EQ(6u, lines.size());
+	EXPECT_EQ(0u, lines.at(0).find("date "));
+	EXPECT_EQ(std::string::npos, lines.at(0).find("date date"));
+	EXPECT_EQ("base hex timestamps absolute", lines.at(1));
+	EXPECT_EQ("no internal events logged", lines.at(2));
+	EXPECT_NE(std::string::npos, lines.at(3).find(" 1  18EFFF80x       Rx   d 3 01 AB FF"));
+	EXPECT_NE(std::string::npos, lines.at(4).find(" 2  0CF00401x       Tx   d 3 01 AB FF"));
+	EXPECT_NE(std::string::npos, lines.at(5).find(" 1  123       Rx   d 3 01 AB FF"));
+	EXPECT_EQ(0u, lines.at(3).find("   0."));
+	std::remove(fileName.c_str());
+}
+
+TEST(VECTOR_ASC_LOGGER_TESTS, RotatesOnFileSize)
+{
+	const std::string fileName = "vector_asc_logger_rotation_test.asc";
+	{
+		// Small enough that every few frames a new file is started
+		VectorASCLogger logger(fileName, 300, 0);
+		for (std::uint8_t i = 0; i < 20; i++)
+		{
+			CANHardwareInterface::get_can_frame_received_event_dispatcher().invoke(create_test_frame(0x18EF0000 | i, 0));
+		}
+		EXPECT_EQ(0u, logger.get_number_of_dropped_frames());
+	}
+
+	std::size_t numberOfFiles = 0;
+	std::size_t numberOfFrames = 0;
+	for (auto lines = read_lines(fileName); !lines.empty(); lines = read_lines("vector_asc_logger_rotation_test_" + std::to_string(numberOfFiles) + ".asc"))
+	{
+		ASSERT_GT(lines.size(), 3u);
+		EXPECT_EQ("base hex timestamps absolute", lines.at(1));
+		numberOfFrames += lines.size() - 3;
+		std::remove((0 == numberOfFiles) ? fileName.c_str() : ("vector_asc_logger_rotation_test_" + std::to_string(numberOfFiles) + ".asc").c_str());
+		numberOfFiles++;
+	}
+	EXPECT_GT(numberOfFiles, 1u);
+	EXPECT_EQ(20u, numberOfFrames);
+}
+
+TEST(VECTOR_ASC_LOGGER_TESTS, DropsFramesWhenFull)
+{
+	const std::string fileName = "vector_asc_logger_drop_test.asc";
+	{
+		// The writer thread only wakes up every period, so it can't empty the small ring buffer in time
+		VectorASCLogger logger(fileName, 0, 0, 8);
+		for (std::uint8_t i = 0; i < 20; i++)
+		{
+			CANHardwareInterface::get_can_frame_received_event_dispatcher().invoke(create_test_frame(0x18EF0000 | i, 0));
+		}
+		EXPECT_GE(logger.get_number_of_dropped_frames(), 1u);
+	}
+	std::remove(fileName.c_str());
+}
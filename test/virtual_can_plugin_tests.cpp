@@ -70,3 +70,34 @@ TEST(VIRTUAL_CAN_PLUGIN_TESTS, OtherReceivesMessage)
 	EXPECT_EQ(receiveFrame.data[7], 0x08);
 	EXPECT_EQ(receiveFrame.dataLength, 8);
 }
+
+TEST(VIRTUAL_CAN_PLUGIN_TESTS, ReadMultipleFramesInOneBatch)
+{
+	VirtualCANPlugin testPlugin;
+	VirtualCANPlugin otherPlugin;
+	testPlugin.open();
+	otherPlugin.open();
+
+	CANMessageFrame sentFrame;
+	sentFrame.isExtendedFrame = true;
+	sentFrame.dataLength = 1;
+	for (std::uint8_t i = 0; i < 5; i++)
+	{
+		sentFrame.identifier = 0x18FFA200 + i;
+		sentFrame.data[0] = i;
+		testPlugin.write_frame(sentFrame);
+	}
+
+	CANMessageFrame receiveFrames[3];
+	EXPECT_EQ(3, otherPlugin.read_frames(receiveFrames, 3));
+	for (std::uint8_t i = 0; i < 3; i++)
+	{
+		EXPECT_EQ(receiveFrames[i].identifier, 0x18FFA200U + i);
+		EXPECT_EQ(receiveFrames[i].data[0], i);
+	}
+
+	EXPECT_EQ(2, otherPlugin.read_frames(receiveFrames, 3));
+	EXPECT_EQ(receiveFrames[0].identifier, 0x18FFA203U);
+	EXPECT_EQ(receiveFrames[1].identifier, 0x18FFA204U);
+	EXPECT_TRUE(otherPlugin.get_queue_empty());
+}
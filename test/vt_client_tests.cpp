@@ -90,6 +90,31 @@ public:
 	{
 		VirtualTerminalClient::process_command_queue();
 	}
+
+	bool test_wrapper_queue_command(std::vector<std::uint8_t> data, bool replace)
+	{
+		return VirtualTerminalClient::queue_command(std::move(data), replace);
+	}
+
+	VirtualTerminalCommandQueue &test_wrapper_get_command_queue()
+	{
+		return commandQueue;
+	}
+
+	const std::vector<std::uint8_t> &test_wrapper_get_scaled_object_pool(std::uint8_t poolIndex) const
+	{
+		return objectPools.at(poolIndex).scaledObjectPool;
+	}
+
+	bool test_wrapper_get_object_pool_upload_chunk(std::uint32_t bytesOffset, std::uint32_t numberOfBytesNeeded, std::uint8_t *chunkBuffer)
+	{
+		return process_internal_object_pool_upload_callback(0, bytesOffset, numberOfBytesNeeded, chunkBuffer, this);
+	}
+
+	std::string test_wrapper_get_scaled_object_pool_file_name(const std::string &directory, std::uint8_t poolIndex)
+	{
+		return get_scaled_object_pool_file_name(directory, get_object_pool_scaling_key(objectPools.at(poolIndex)));
+	}
 };
 
 std::vector<std::uint8_t> DerivedTestVTClient::staticTestPool;
@@ -345,6 +370,237 @@ TEST(VIRTUAL_TERMINAL_TESTS, FullPoolAutoscalingWithPointer)
 	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
 }
 
+static std::uint32_t dataChunkCallbackCalls = 0;
+
+static bool counting_data_chunk_callback(std::uint32_t callbackIndex,
+                                         std::uint32_t bytesOffset,
+                                         std::uint32_t numberOfBytesNeeded,
+                                         std::uint8_t *chunkBuffer,
+                                         void *parentPointer)
+{
+	dataChunkCallbackCalls++;
+	return DerivedTestVTClient::testWrapperDataChunkCallback(callbackIndex, bytesOffset, numberOfBytesNeeded, chunkBuffer, parentPointer);
+}
+
+TEST(VIRTUAL_TERMINAL_TESTS, ScaledPoolsAreCached)
+{
+	NAME clientNAME(0);
+	clientNAME.set_arbitrary_address_capable(true);
+	clientNAME.set_industry_group(1);
+	clientNAME.set_function_code(static_cast<std::uint8_t>(isobus::NAME::Function::OilSystemMonitor));
+	clientNAME.set_identity_number(2);
+	clientNAME.set_manufacturer_code(69);
+
+	auto internalECU = CANNetworkManager::CANNetwork.create_internal_control_function(clientNAME, 0, 0x26);
+
+	std::vector<isobus::NAMEFilter> vtNameFilters;
+	const isobus::NAMEFilter testFilter(isobus::NAME::NAMEParameters::FunctionCode, static_cast<std::uint8_t>(isobus::NAME::Function::VirtualTerminal));
+	vtNameFilters.push_back(testFilter);
+
+	auto vtPartner = CANNetworkManager::CANNetwork.create_partnered_control_function(0, vtNameFilters);
+
+	std::vector<std::uint8_t> testPool = isobus::IOPFileInterface::read_iop_file("../../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+
+	if (0 == testPool.size())
+	{
+		// Try a different path to mitigate differences between how IDEs run the unit test
+		testPool = isobus::IOPFileInterface::read_iop_file("../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+	}
+	ASSERT_NE(0, testPool.size());
+
+	CANIdentifier identifier(CANIdentifier::Type::Extended, static_cast<std::uint32_t>(CANLibParameterGroupNumber::VirtualTerminalToECU), CANIdentifier::CANPriority::PriorityDefault6, 0, 0);
+	const CANMessage endOfObjectPoolResponse(CANMessage::Type::Receive,
+	                                         identifier,
+	                                         {
+	                                           0x12, // End of object pool function code
+	                                           0x00, // No errors
+	                                           0xFF, // Parent of faulty object
+	                                           0xFF, // Parent of faulty object
+	                                           0xFF, // Faulty object
+	                                           0xFF, // Faulty object
+	                                           0x00, // No object pool errors
+	                                           0xFF, // Reserved
+	                                         },
+	                                         nullptr,
+	                                         nullptr,
+	                                         0);
+
+	std::vector<std::uint8_t> firstScaledPool;
+	{
+		// By default the scaled pool is freed once the VT accepted it
+		DerivedTestVTClient clientUnderTest(vtPartner, internalECU);
+		clientUnderTest.set_object_pool(0, &testPool);
+		clientUnderTest.set_object_pool_scaling(0, 240, 240);
+
+		EXPECT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+		firstScaledPool = clientUnderTest.test_wrapper_get_scaled_object_pool(0);
+		ASSERT_EQ(testPool.size(), firstScaledPool.size());
+
+		clientUnderTest.test_wrapper_set_state(VirtualTerminalClient::StateMachineState::WaitForEndOfObjectPoolResponse);
+		clientUnderTest.test_wrapper_process_rx_message(endOfObjectPoolResponse, &clientUnderTest);
+		EXPECT_TRUE(clientUnderTest.test_wrapper_get_scaled_object_pool(0).empty());
+
+		EXPECT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+		EXPECT_EQ(firstScaledPool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+	}
+
+	{
+		DerivedTestVTClient clientUnderTest(vtPartner, internalECU);
+		clientUnderTest.set_object_pool(0, &testPool);
+		clientUnderTest.set_object_pool_scaling(0, 240, 240);
+		clientUnderTest.set_keep_scaled_object_pools(true);
+
+		EXPECT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+		EXPECT_EQ(firstScaledPool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+
+		clientUnderTest.test_wrapper_set_state(VirtualTerminalClient::StateMachineState::WaitForEndOfObjectPoolResponse);
+		clientUnderTest.test_wrapper_process_rx_message(endOfObjectPoolResponse, &clientUnderTest);
+		EXPECT_EQ(firstScaledPool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+
+		// Scaling again for the same VT reuses the scaled pool instead of scaling the scaled pool
+		EXPECT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+		EXPECT_EQ(firstScaledPool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+
+		// A VT with other fonts needs its own scaled pool
+		clientUnderTest.test_wrapper_set_supported_fonts(0x01, 0x00);
+		EXPECT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+		EXPECT_EQ(testPool.size(), clientUnderTest.test_wrapper_get_scaled_object_pool(0).size());
+	}
+
+	// Scaled pools written to the cache directory are loaded by the next client instead of scaled again
+	const std::string cacheDirectory = ".";
+	{
+		DerivedTestVTClient clientUnderTest(vtPartner, internalECU);
+		clientUnderTest.set_object_pool(0, &testPool);
+		clientUnderTest.set_object_pool_scaling(0, 240, 240);
+		clientUnderTest.set_object_pool_scaling_cache_directory(cacheDirectory);
+		EXPECT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+		EXPECT_EQ(firstScaledPool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+	}
+
+	{
+		DerivedTestVTClient clientUnderTest(vtPartner, internalECU);
+		clientUnderTest.set_object_pool(0, &testPool);
+		clientUnderTest.set_object_pool_scaling(0, 240, 240);
+		clientUnderTest.set_object_pool_scaling_cache_directory(cacheDirectory);
+
+		// Replace the cached pool with the unscaled one, so it is obvious whether it was loaded
+		const std::string cacheFileName = clientUnderTest.test_wrapper_get_scaled_object_pool_file_name(cacheDirectory, 0);
+		EXPECT_EQ(firstScaledPool, isobus::IOPFileInterface::read_iop_file(cacheFileName));
+		ASSERT_TRUE(isobus::IOPFileInterface::write_iop_file(cacheFileName, testPool));
+
+		EXPECT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+		EXPECT_EQ(testPool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+		std::remove(cacheFileName.c_str());
+	}
+
+	{
+		// A pool from a callback without a version label can't be identified, so it is read and scaled again every time
+		DerivedTestVTClient clientUnderTest(vtPartner, internalECU);
+		DerivedTestVTClient::staticTestPool = testPool;
+		clientUnderTest.register_object_pool_data_chunk_callback(0, static_cast<std::uint32_t>(testPool.size()), counting_data_chunk_callback);
+		clientUnderTest.set_object_pool_scaling(0, 240, 240);
+		clientUnderTest.set_keep_scaled_object_pools(true);
+		clientUnderTest.set_object_pool_scaling_cache_directory(cacheDirectory);
+
+		dataChunkCallbackCalls = 0;
+		EXPECT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+		EXPECT_EQ(firstScaledPool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+		const std::uint32_t callsPerScaling = dataChunkCallbackCalls;
+		EXPECT_NE(0, callsPerScaling);
+
+		EXPECT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+		EXPECT_EQ(2 * callsPerScaling, dataChunkCallbackCalls);
+		EXPECT_TRUE(isobus::IOPFileInterface::read_iop_file(clientUnderTest.test_wrapper_get_scaled_object_pool_file_name(cacheDirectory, 0)).empty());
+
+		// With a version label, the label identifies the pool
+		clientUnderTest.register_object_pool_data_chunk_callback(0, static_cast<std::uint32_t>(testPool.size()), counting_data_chunk_callback, "TEST1");
+		clientUnderTest.set_object_pool_scaling(0, 240, 240);
+		clientUnderTest.set_object_pool_scaling_cache_directory("");
+		dataChunkCallbackCalls = 0;
+		EXPECT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+		EXPECT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+		EXPECT_EQ(callsPerScaling, dataChunkCallbackCalls);
+		EXPECT_EQ(firstScaledPool, clientUnderTest.test_wrapper_get_scaled_object_pool(0));
+	}
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+}
+
+TEST(VIRTUAL_TERMINAL_TESTS, PoolsStreamedFromFileAreScaledWhileUploading)
+{
+	NAME clientNAME(0);
+	clientNAME.set_arbitrary_address_capable(true);
+	clientNAME.set_industry_group(1);
+	clientNAME.set_function_code(static_cast<std::uint8_t>(isobus::NAME::Function::OilSystemMonitor));
+	clientNAME.set_identity_number(3);
+	clientNAME.set_manufacturer_code(69);
+
+	auto internalECU = CANNetworkManager::CANNetwork.create_internal_control_function(clientNAME, 0, 0x26);
+
+	std::vector<isobus::NAMEFilter> vtNameFilters;
+	const isobus::NAMEFilter testFilter(isobus::NAME::NAMEParameters::FunctionCode, static_cast<std::uint8_t>(isobus::NAME::Function::VirtualTerminal));
+	vtNameFilters.push_back(testFilter);
+
+	auto vtPartner = CANNetworkManager::CANNetwork.create_partnered_control_function(0, vtNameFilters);
+
+	std::vector<std::uint8_t> testPool = isobus::IOPFileInterface::read_iop_file("../../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+
+	if (0 == testPool.size())
+	{
+		// Try a different path to mitigate differences between how IDEs run the unit test
+		testPool = isobus::IOPFileInterface::read_iop_file("../examples/virtual_terminal/version3_object_pool/VT3TestPool.iop");
+	}
+	ASSERT_NE(0, testPool.size());
+
+	const std::string poolFileName = "streamed_pool_test.iop";
+	ASSERT_TRUE(isobus::IOPFileInterface::write_iop_file(poolFileName, testPool));
+
+	// The pool as it is scaled in memory, to compare the streamed pool against
+	DerivedTestVTClient referenceClient(vtPartner, internalECU);
+	referenceClient.set_object_pool(0, &testPool);
+	referenceClient.set_object_pool_scaling(0, 240, 240);
+	ASSERT_TRUE(referenceClient.test_wrapper_scale_object_pools());
+	std::vector<std::uint8_t> expectedUpload = { 0x11 };
+	expectedUpload.insert(expectedUpload.end(), referenceClient.test_wrapper_get_scaled_object_pool(0).begin(), referenceClient.test_wrapper_get_scaled_object_pool(0).end());
+
+	DerivedTestVTClient clientUnderTest(vtPartner, internalECU);
+	EXPECT_FALSE(clientUnderTest.set_object_pool_from_file(0, "this_file_does_not_exist.iop"));
+	ASSERT_TRUE(clientUnderTest.set_object_pool_from_file(0, poolFileName));
+	clientUnderTest.set_object_pool_scaling(0, 240, 240);
+	ASSERT_TRUE(clientUnderTest.test_wrapper_scale_object_pools());
+
+	// Nothing is copied when scaling, objects are scaled as they are read
+	EXPECT_TRUE(clientUnderTest.test_wrapper_get_scaled_object_pool(0).empty());
+
+	// Read the pool in chunks the size of a CAN frame, which split most objects
+	std::vector<std::uint8_t> upload(expectedUpload.size());
+	for (std::uint32_t offset = 0; offset < upload.size(); offset += 7)
+	{
+		std::uint32_t length = std::min<std::uint32_t>(7, static_cast<std::uint32_t>(upload.size()) - offset);
+		ASSERT_TRUE(clientUnderTest.test_wrapper_get_object_pool_upload_chunk(offset, length, &upload[offset]));
+	}
+	EXPECT_EQ(expectedUpload, upload);
+
+	// Chunks can be read again out of order, for example when the VT asks for a retransmission
+	std::uint8_t chunk[7];
+	ASSERT_TRUE(clientUnderTest.test_wrapper_get_object_pool_upload_chunk(8, 7, chunk));
+	EXPECT_EQ(0, memcmp(chunk, &expectedUpload[8], 7));
+	EXPECT_FALSE(clientUnderTest.test_wrapper_get_object_pool_upload_chunk(static_cast<std::uint32_t>(upload.size()) - 6, 7, chunk));
+
+	// Without scaling, the file is uploaded as it is
+	ASSERT_TRUE(clientUnderTest.set_object_pool_from_file(0, poolFileName));
+	ASSERT_TRUE(clientUnderTest.test_wrapper_get_object_pool_upload_chunk(0, 7, chunk));
+	EXPECT_EQ(0x11, chunk[0]);
+	EXPECT_EQ(0, memcmp(&chunk[1], testPool.data(), 6));
+
+	std::remove(poolFileName.c_str());
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+}
+
 TEST(VIRTUAL_TERMINAL_TESTS, ObjectMetadataTests)
 {
 	NAME clientNAME(0);
@@ -975,3 +1231,238 @@ TEST(VIRTUAL_TERMINAL_TESTS, MessageConstruction)
 	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
 	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
 }
+
+TEST(VIRTUAL_TERMINAL_TESTS, ReplacingCommandOnlyReplacesReplaceableCommands)
+{
+	NAME clientNAME(0);
+	auto internalECU = CANNetworkManager::CANNetwork.create_internal_control_function(clientNAME, 0, 0x26);
+
+	std::vector<isobus::NAMEFilter> vtNameFilters;
+	const isobus::NAMEFilter testFilter(isobus::NAME::NAMEParameters::FunctionCode, static_cast<std::uint8_t>(isobus::NAME::Function::VirtualTerminal));
+	vtNameFilters.push_back(testFilter);
+
+	auto vtPartner = CANNetworkManager::CANNetwork.create_partnered_control_function(0, vtNameFilters);
+
+	DerivedTestVTClient clientUnderTest(vtPartner, internalECU);
+
+	// Change numeric value commands for object 1000, the client is not connected so they are all queued
+	auto make_command = [](std::uint8_t value) {
+		return std::vector<std::uint8_t>{ 0xA8, 0xE8, 0x03, 0xFF, value, 0x00, 0x00, 0x00 };
+	};
+	EXPECT_TRUE(clientUnderTest.test_wrapper_queue_command(make_command(1), false));
+	EXPECT_TRUE(clientUnderTest.test_wrapper_queue_command(make_command(2), false));
+	EXPECT_TRUE(clientUnderTest.test_wrapper_queue_command({ 0xA8, 0xE9, 0x03, 0xFF, 0x05, 0x00, 0x00, 0x00 }, false));
+	ASSERT_EQ(3, clientUnderTest.test_wrapper_get_command_queue().size());
+
+	// Commands queued without replace are always sent, the first replaceable one is added behind them
+	EXPECT_TRUE(clientUnderTest.test_wrapper_queue_command(make_command(3), true));
+	ASSERT_EQ(4, clientUnderTest.test_wrapper_get_command_queue().size());
+
+	// Later replaceable commands replace it in place
+	EXPECT_TRUE(clientUnderTest.test_wrapper_queue_command(make_command(4), true));
+	ASSERT_EQ(4, clientUnderTest.test_wrapper_get_command_queue().size());
+
+	const std::uint8_t expectedValues[] = { 1, 2, 5, 4 };
+	for (std::uint8_t expectedValue : expectedValues)
+	{
+		ASSERT_FALSE(clientUnderTest.test_wrapper_get_command_queue().empty());
+		EXPECT_EQ(expectedValue, clientUnderTest.test_wrapper_get_command_queue().front().data()[4]);
+		clientUnderTest.test_wrapper_get_command_queue().pop();
+	}
+	EXPECT_TRUE(clientUnderTest.test_wrapper_get_command_queue().empty());
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+}
+
+TEST(VIRTUAL_TERMINAL_TESTS, QueuedCommandsAreCoalesced)
+{
+	VirtualCANPlugin serverVT;
+	serverVT.open();
+
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, std::make_shared<VirtualCANPlugin>());
+	CANHardwareInterface::start();
+
+	auto internalECU = test_helpers::claim_internal_control_function(0x37, 0);
+	auto vtPartner = test_helpers::force_claim_partnered_control_function(0x26, 0);
+
+	DerivedTestVTClient interfaceUnderTest(vtPartner, internalECU);
+	interfaceUnderTest.initialize(false);
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	CANMessageFrame testFrame = {};
+	while (!serverVT.get_queue_empty())
+	{
+		serverVT.read_frame(testFrame);
+	}
+
+	// While not connected, every update of the same numeric value replaces the queued one
+	for (std::uint32_t value = 0; value < 10; value++)
+	{
+		ASSERT_TRUE(interfaceUnderTest.send_change_numeric_value(1000, value));
+		ASSERT_TRUE(interfaceUnderTest.send_change_numeric_value(1001, value + 100));
+	}
+	ASSERT_TRUE(serverVT.get_queue_empty());
+
+	interfaceUnderTest.test_wrapper_set_state(VirtualTerminalClient::StateMachineState::Connected);
+
+	const std::uint16_t expectedObjectIDs[] = { 1000, 1001 };
+	const std::uint32_t expectedValues[] = { 9, 109 };
+	for (std::uint8_t i = 0; i < 2; i++)
+	{
+		interfaceUnderTest.test_wrapper_process_command_queue();
+		ASSERT_TRUE(serverVT.read_frame(testFrame));
+		EXPECT_EQ(168, testFrame.data[0]); // VT function (change numeric value)
+		std::uint16_t objectID = (static_cast<std::uint16_t>(testFrame.data[1]) | (static_cast<std::uint16_t>(testFrame.data[2]) << 8));
+		EXPECT_EQ(expectedObjectIDs[i], objectID);
+		std::uint32_t value = (static_cast<std::uint32_t>(testFrame.data[4]) |
+		                       (static_cast<std::uint32_t>(testFrame.data[5]) << 8) |
+		                       (static_cast<std::uint32_t>(testFrame.data[6]) << 16) |
+		                       (static_cast<std::uint32_t>(testFrame.data[7]) << 24));
+		EXPECT_EQ(expectedValues[i], value);
+
+		// The next command waits for the VT to respond to this one
+		interfaceUnderTest.test_wrapper_process_command_queue();
+		EXPECT_TRUE(serverVT.get_queue_empty());
+
+		testFrame.identifier = 0x14E63726; // VT->ECU
+		testFrame.data[3] = 0xFF; // Reserved
+		testFrame.data[7] = 0; // No errors
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(testFrame);
+		CANNetworkManager::CANNetwork.update();
+	}
+
+	// Everything was sent, only the latest value of each object
+	interfaceUnderTest.test_wrapper_process_command_queue();
+	EXPECT_TRUE(serverVT.get_queue_empty());
+
+	serverVT.close();
+	CANHardwareInterface::stop();
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+}
+
+TEST(VIRTUAL_TERMINAL_TESTS, CommandTransactions)
+{
+	VirtualCANPlugin serverVT;
+	serverVT.open();
+
+	CANHardwareInterface::set_number_of_can_channels(1);
+	CANHardwareInterface::assign_can_channel_frame_handler(0, std::make_shared<VirtualCANPlugin>());
+	CANHardwareInterface::start();
+
+	auto internalECU = test_helpers::claim_internal_control_function(0x37, 0);
+	auto vtPartner = test_helpers::force_claim_partnered_control_function(0x26, 0);
+
+	DerivedTestVTClient interfaceUnderTest(vtPartner, internalECU);
+	interfaceUnderTest.initialize(false);
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	CANMessageFrame testFrame = {};
+	while (!serverVT.get_queue_empty())
+	{
+		serverVT.read_frame(testFrame);
+	}
+
+	std::vector<VirtualTerminalClient::VTTransactionCompletedEvent> completedTransactions;
+	auto listener = interfaceUnderTest.get_transaction_completed_event_dispatcher().add_listener([&completedTransactions](const VirtualTerminalClient::VTTransactionCompletedEvent &event) {
+		completedTransactions.push_back(event);
+	});
+
+	interfaceUnderTest.test_wrapper_set_state(VirtualTerminalClient::StateMachineState::Connected);
+
+	// Nothing is sent while the transaction is open, even though the VT is idle
+	EXPECT_EQ(0, interfaceUnderTest.end_transaction());
+	interfaceUnderTest.begin_transaction();
+	EXPECT_TRUE(interfaceUnderTest.get_is_transaction_open());
+	for (std::uint32_t value = 0; value < 10; value++)
+	{
+		for (std::uint16_t objectID = 1000; objectID < 1003; objectID++)
+		{
+			ASSERT_TRUE(interfaceUnderTest.send_change_numeric_value(objectID, value + objectID));
+		}
+	}
+	ASSERT_TRUE(interfaceUnderTest.send_hide_show_object(2000, VirtualTerminalClient::HideShowObjectCommand::ShowObject));
+	interfaceUnderTest.test_wrapper_process_command_queue();
+	EXPECT_TRUE(serverVT.get_queue_empty());
+
+	std::uint32_t transactionID = interfaceUnderTest.end_transaction();
+	EXPECT_NE(0, transactionID);
+	EXPECT_FALSE(interfaceUnderTest.get_is_transaction_open());
+
+	// Each command is sent as soon as the VT responds to the previous one
+	const std::uint8_t expectedFunctions[] = { 168, 168, 168, 160 };
+	const std::uint16_t expectedObjectIDs[] = { 1000, 1001, 1002, 2000 };
+	for (std::uint8_t i = 0; i < 4; i++)
+	{
+		ASSERT_TRUE(serverVT.read_frame(testFrame));
+		EXPECT_EQ(expectedFunctions[i], testFrame.data[0]);
+		std::uint16_t objectID = (static_cast<std::uint16_t>(testFrame.data[1]) | (static_cast<std::uint16_t>(testFrame.data[2]) << 8));
+		EXPECT_EQ(expectedObjectIDs[i], objectID);
+		if (168 == testFrame.data[0])
+		{
+			EXPECT_EQ(9 + objectID, testFrame.data[4] | (testFrame.data[5] << 8)); // Only the final value is sent
+		}
+		EXPECT_TRUE(serverVT.get_queue_empty());
+		EXPECT_TRUE(completedTransactions.empty());
+
+		testFrame.identifier = 0x14E63726; // VT->ECU
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(testFrame);
+		CANNetworkManager::CANNetwork.update();
+	}
+
+	ASSERT_EQ(1, completedTransactions.size());
+	EXPECT_EQ(transactionID, completedTransactions[0].transactionID);
+	EXPECT_EQ(4, completedTransactions[0].numberOfCommands);
+	EXPECT_EQ(0, completedTransactions[0].numberOfTimedOutCommands);
+	EXPECT_TRUE(serverVT.get_queue_empty());
+
+	// A transaction without commands completes right away
+	interfaceUnderTest.begin_transaction();
+	transactionID = interfaceUnderTest.end_transaction();
+	ASSERT_EQ(2, completedTransactions.size());
+	EXPECT_EQ(transactionID, completedTransactions[1].transactionID);
+	EXPECT_EQ(0, completedTransactions[1].numberOfCommands);
+
+	// Commands queued before the transaction are not merged into it, and commands that do not replace each other are all sent
+	ASSERT_TRUE(interfaceUnderTest.send_change_numeric_value(1000, 1)); // Sent right away
+	ASSERT_TRUE(interfaceUnderTest.send_change_numeric_value(1001, 2)); // Queued, the VT has not responded yet
+	interfaceUnderTest.begin_transaction();
+	ASSERT_TRUE(interfaceUnderTest.send_change_numeric_value(1001, 3));
+	ASSERT_TRUE(interfaceUnderTest.send_execute_extended_macro(1));
+	ASSERT_TRUE(interfaceUnderTest.send_execute_extended_macro(2));
+	ASSERT_TRUE(interfaceUnderTest.send_change_object_label(3000, 4000, 0, 0xFFFF));
+	ASSERT_TRUE(interfaceUnderTest.send_change_object_label(3001, 4001, 0, 0xFFFF));
+	transactionID = interfaceUnderTest.end_transaction();
+
+	const std::uint8_t expectedTransactionFunctions[] = { 168, 168, 168, 188, 188, 181, 181 };
+	const std::uint16_t expectedTransactionObjectIDs[] = { 1000, 1001, 1001, 1, 2, 3000, 3001 };
+	for (std::uint8_t i = 0; i < 7; i++)
+	{
+		ASSERT_TRUE(serverVT.read_frame(testFrame));
+		EXPECT_EQ(expectedTransactionFunctions[i], testFrame.data[0]);
+		std::uint16_t objectID = (static_cast<std::uint16_t>(testFrame.data[1]) | (static_cast<std::uint16_t>(testFrame.data[2]) << 8));
+		EXPECT_EQ(expectedTransactionObjectIDs[i], objectID);
+		EXPECT_TRUE(serverVT.get_queue_empty());
+		EXPECT_EQ(2, completedTransactions.size());
+
+		testFrame.identifier = 0x14E63726; // VT->ECU
+		CANNetworkManager::CANNetwork.process_receive_can_message_frame(testFrame);
+		CANNetworkManager::CANNetwork.update();
+	}
+
+	ASSERT_EQ(3, completedTransactions.size());
+	EXPECT_EQ(transactionID, completedTransactions[2].transactionID);
+	EXPECT_EQ(5, completedTransactions[2].numberOfCommands);
+
+	interfaceUnderTest.get_transaction_completed_event_dispatcher().remove_listener(listener);
+	serverVT.close();
+	CANHardwareInterface::stop();
+
+	CANNetworkManager::CANNetwork.deactivate_control_function(vtPartner);
+	CANNetworkManager::CANNetwork.deactivate_control_function(internalECU);
+}
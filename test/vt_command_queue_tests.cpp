@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include "isobus/isobus/isobus_virtual_terminal_command_queue.hpp"
+
+#include "helpers/allocation_counter.hpp"
+
+using namespace isobus;
+
+static std::array<std::uint8_t, CAN_DATA_LENGTH> create_test_command(std::uint16_t objectID, std::uint8_t value)
+{
+	return { 0xA8, static_cast<std::uint8_t>(objectID & 0xFF), static_cast<std::uint8_t>(objectID >> 8), 0xFF, value, 0x00, 0x00, 0x00 };
+}
+
+static void push_test_command(VirtualTerminalCommandQueue &queue, std::uint16_t objectID, std::uint8_t value, bool coalesce)
+{
+	auto command = create_test_command(objectID, value);
+	queue.push(command.data(), static_cast<std::uint32_t>(command.size()), objectID, coalesce);
+}
+
+TEST(VT_COMMAND_QUEUE_TESTS, CommandsAreQueuedInOrder)
+{
+	VirtualTerminalCommandQueue queue(4);
+	EXPECT_TRUE(queue.empty());
+	EXPECT_EQ(4, queue.get_capacity());
+
+	for (std::uint8_t i = 0; i < 3; i++)
+	{
+		push_test_command(queue, i, i, false);
+	}
+	EXPECT_EQ(3, queue.size());
+
+	for (std::uint8_t i = 0; i < 3; i++)
+	{
+		ASSERT_FALSE(queue.empty());
+		EXPECT_TRUE(queue.front().is_inline());
+		EXPECT_EQ(CAN_DATA_LENGTH, queue.front().size());
+		EXPECT_EQ(i, queue.front().data()[1]);
+		EXPECT_EQ(i, queue.front().data()[4]);
+		queue.pop();
+	}
+	EXPECT_TRUE(queue.empty());
+}
+
+TEST(VT_COMMAND_QUEUE_TESTS, CommandsWithTheSameKeyAreCoalescedInPlace)
+{
+	VirtualTerminalCommandQueue queue(4);
+
+	push_test_command(queue, 1, 10, true);
+	push_test_command(queue, 2, 20, true);
+	push_test_command(queue, 3, 30, false);
+
+	// Replaces the first command, but keeps its position
+	auto command = create_test_command(1, 11);
+	EXPECT_TRUE(queue.push(command.data(), static_cast<std::uint32_t>(command.size()), 1, true));
+	EXPECT_EQ(3, queue.size());
+
+	// Commands that are not coalescable are never replaced, nor replace others
+	command = create_test_command(3, 31);
+	EXPECT_FALSE(queue.push(command.data(), static_cast<std::uint32_t>(command.size()), 3, true));
+	command = create_test_command(1, 12);
+	EXPECT_FALSE(queue.push(command.data(), static_cast<std::uint32_t>(command.size()), 1, false));
+	EXPECT_EQ(5, queue.size());
+
+	const std::uint8_t expectedValues[] = { 11, 20, 30, 31, 12 };
+	for (std::uint8_t expectedValue : expectedValues)
+	{
+		ASSERT_FALSE(queue.empty());
+		EXPECT_EQ(expectedValue, queue.front().data()[4]);
+		queue.pop();
+	}
+	EXPECT_TRUE(queue.empty());
+
+	// Once a command was popped, a new one with the same key is appended again
+	push_test_command(queue, 2, 21, true);
+	push_test_command(queue, 1, 13, true);
+	EXPECT_EQ(2, queue.size());
+	EXPECT_EQ(21, queue.front().data()[4]);
+}
+
+TEST(VT_COMMAND_QUEUE_TESTS, LongCommands)
+{
+	VirtualTerminalCommandQueue queue(2);
+
+	std::vector<std::uint8_t> longCommand = { 0xB3, 0x01, 0x00, 0x05, 0x00, 'H', 'e', 'l', 'l', 'o' };
+	EXPECT_FALSE(queue.push(std::move(longCommand), 1, true));
+
+	std::vector<std::uint8_t> replacement = { 0xB3, 0x01, 0x00, 0x05, 0x00, 'W', 'o', 'r', 'l', 'd' };
+	EXPECT_TRUE(queue.push(replacement.data(), static_cast<std::uint32_t>(replacement.size()), 1, true));
+	EXPECT_EQ(1, queue.size());
+
+	ASSERT_FALSE(queue.empty());
+	EXPECT_FALSE(queue.front().is_inline());
+	ASSERT_EQ(replacement.size(), queue.front().size());
+	EXPECT_EQ(0, memcmp(replacement.data(), queue.front().data(), replacement.size()));
+	EXPECT_EQ(replacement, queue.front().get_long_payload());
+
+	// Short commands can be moved in as well, and are stored inline
+	std::vector<std::uint8_t> shortCommand = { 0xA0, 0x02, 0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF };
+	queue.push(std::move(shortCommand), 2, true);
+	queue.pop();
+	ASSERT_FALSE(queue.empty());
+	EXPECT_TRUE(queue.front().is_inline());
+	EXPECT_EQ(0xA0, queue.front().data()[0]);
+}
+
+TEST(VT_COMMAND_QUEUE_TESTS, GrowingKeepsOrderAndCoalescing)
+{
+	VirtualTerminalCommandQueue queue(4);
+
+	// Move the head away from the start of the ring before it has to grow
+	push_test_command(queue, 1000, 0, true);
+	push_test_command(queue, 1001, 0, true);
+	queue.pop();
+	queue.pop();
+
+	for (std::uint16_t i = 0; i < 100; i++)
+	{
+		push_test_command(queue, i, 1, true);
+	}
+	EXPECT_EQ(100, queue.size());
+	EXPECT_GE(queue.get_capacity(), 100);
+
+	for (std::uint16_t i = 0; i < 100; i++)
+	{
+		auto command = create_test_command(i, 2);
+		EXPECT_TRUE(queue.push(command.data(), static_cast<std::uint32_t>(command.size()), i, true));
+	}
+	EXPECT_EQ(100, queue.size());
+
+	for (std::uint16_t i = 0; i < 100; i++)
+	{
+		ASSERT_FALSE(queue.empty());
+		EXPECT_EQ(i & 0xFF, queue.front().data()[1]);
+		EXPECT_EQ(2, queue.front().data()[4]);
+		queue.pop();
+	}
+	EXPECT_TRUE(queue.empty());
+}
+
+TEST(VT_COMMAND_QUEUE_TESTS, QueueingDoesNotAllocate)
+{
+	// Enough room for a busy VT, so the queue never has to grow
+	VirtualTerminalCommandQueue queue(256);
+
+	const std::size_t allocationsBefore = test_helpers::get_number_of_allocations();
+	for (std::uint8_t update = 0; update < 10; update++)
+	{
+		for (std::uint16_t objectID = 0; objectID < 200; objectID++)
+		{
+			push_test_command(queue, objectID, update, true);
+		}
+		push_test_command(queue, 0xFFFF, update, false);
+	}
+	EXPECT_EQ(allocationsBefore, test_helpers::get_number_of_allocations());
+	EXPECT_EQ(210, queue.size());
+
+	while (!queue.empty())
+	{
+		queue.pop();
+	}
+	EXPECT_EQ(allocationsBefore, test_helpers::get_number_of_allocations());
+}
+
+TEST(VT_COMMAND_QUEUE_TESTS, Clear)
+{
+	VirtualTerminalCommandQueue queue(4);
+
+	push_test_command(queue, 1, 1, true);
+	push_test_command(queue, 2, 1, true);
+	queue.clear();
+	EXPECT_TRUE(queue.empty());
+	EXPECT_EQ(0, queue.size());
+
+	// The index was cleared too, so nothing is coalesced with the removed commands
+	auto command = create_test_command(1, 2);
+	EXPECT_FALSE(queue.push(command.data(), static_cast<std::uint32_t>(command.size()), 1, true));
+	EXPECT_EQ(1, queue.size());
+}
+
+TEST(VT_COMMAND_QUEUE_TESTS, CommandsAreOnlyCoalescedWithinTheirGroup)
+{
+	VirtualTerminalCommandQueue queue(4);
+
+	auto command = create_test_command(1, 1);
+	EXPECT_FALSE(queue.push(command.data(), static_cast<std::uint32_t>(command.size()), 1, true, 7));
+	command = create_test_command(1, 2);
+	EXPECT_FALSE(queue.push(command.data(), static_cast<std::uint32_t>(command.size()), 1, true, 8));
+	command = create_test_command(1, 3);
+	EXPECT_TRUE(queue.push(command.data(), static_cast<std::uint32_t>(command.size()), 1, true, 8));
+
+	ASSERT_EQ(2, queue.size());
+	EXPECT_EQ(7, queue.front().get_group());
+	EXPECT_EQ(1, queue.front().data()[4]);
+	queue.pop();
+	EXPECT_EQ(8, queue.front().get_group());
+	EXPECT_EQ(3, queue.front().data()[4]);
+
+	// The index entry of the popped command is gone, the command of the other group is still found
+	command = create_test_command(1, 4);
+	EXPECT_TRUE(queue.push(command.data(), static_cast<std::uint32_t>(command.size()), 1, true, 8));
+	EXPECT_EQ(1, queue.size());
+	EXPECT_EQ(4, queue.front().data()[4]);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include "isobus/isobus/isobus_virtual_terminal_working_set_base.hpp"
+#include "isobus/utility/iop_file_interface.hpp"
+
+#include <algorithm>
+
+using namespace isobus;
+
+static std::vector<std::uint8_t> read_example_pool(const std::string &path)
+{
+	std::vector<std::uint8_t> pool = IOPFileInterface::read_iop_file("../../examples/" + path);
+
+	if (pool.empty())
+	{
+		// Try a different path to mitigate differences between how IDEs run the unit test
+		pool = IOPFileInterface::read_iop_file("../examples/" + path);
+	}
+	return pool;
+}
+
+static void expect_same_object_trees(const VirtualTerminalWorkingSetBase &expected, const VirtualTerminalWorkingSetBase &actual)
+{
+	const auto &expectedTree = expected.get_object_tree();
+	const auto &actualTree = actual.get_object_tree();
+	ASSERT_EQ(expectedTree.size(), actualTree.size());
+
+	auto actualObject = actualTree.begin();
+	for (const auto &expectedObject : expectedTree)
+	{
+		ASSERT_EQ(expectedObject.first, actualObject->first);
+		ASSERT_NE(nullptr, actualObject->second);
+		EXPECT_EQ(expectedObject.second->get_object_type(), actualObject->second->get_object_type());
+		EXPECT_EQ(expectedObject.second->get_width(), actualObject->second->get_width());
+		EXPECT_EQ(expectedObject.second->get_height(), actualObject->second->get_height());
+		EXPECT_EQ(expectedObject.second->get_background_color(), actualObject->second->get_background_color());
+		ASSERT_EQ(expectedObject.second->get_number_children(), actualObject->second->get_number_children());
+		for (std::uint16_t i = 0; i < expectedObject.second->get_number_children(); i++)
+		{
+			EXPECT_EQ(expectedObject.second->get_child_id(i), actualObject->second->get_child_id(i));
+		}
+		actualObject++;
+	}
+}
+
+TEST(VIRTUAL_TERMINAL_WORKING_SET_TESTS, ObjectBoundariesArePreScanned)
+{
+	std::vector<std::uint8_t> pool = read_example_pool("seeder_example/BasePool.iop");
+	ASSERT_FALSE(pool.empty());
+
+	std::vector<std::uint32_t> offsets;
+	ASSERT_TRUE(find_object_offsets(pool.data(), static_cast<std::uint32_t>(pool.size()), offsets));
+	ASSERT_FALSE(offsets.empty());
+	EXPECT_EQ(0, offsets.front());
+
+	// The objects found by the pre-scan are the same as the ones found by parsing
+	VirtualTerminalWorkingSetBase workingSet;
+	workingSet.set_object_pool_parsing_threads(1);
+	ASSERT_TRUE(workingSet.parse_iop_into_objects(pool.data(), static_cast<std::uint32_t>(pool.size())));
+	for (std::uint32_t offset : offsets)
+	{
+		std::uint16_t objectID = static_cast<std::uint16_t>(pool[offset] | (pool[offset + 1] << 8));
+		EXPECT_NE(workingSet.get_object_tree().end(), workingSet.get_object_tree().find(objectID));
+	}
+
+	// Nothing past the end of a truncated pool is read
+	std::uint32_t lastObjectLength = static_cast<std::uint32_t>(pool.size()) - offsets.back();
+	EXPECT_EQ(lastObjectLength, get_number_bytes_in_object(&pool[offsets.back()], lastObjectLength));
+	EXPECT_EQ(0, get_number_bytes_in_object(&pool[offsets.back()], lastObjectLength - 1));
+	EXPECT_FALSE(find_object_offsets(pool.data(), static_cast<std::uint32_t>(pool.size()) - 1, offsets));
+	EXPECT_TRUE(offsets.empty());
+}
+
+TEST(VIRTUAL_TERMINAL_WORKING_SET_TESTS, ParallelParsingMatchesSequentialParsing)
+{
+	const std::string poolPaths[] = { "seeder_example/BasePool.iop", "virtual_terminal/version3_object_pool/VT3TestPool.iop" };
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+	std::size_t maxThreadsUsed = 1;
+#endif
+
+	for (const auto &poolPath : poolPaths)
+	{
+		std::vector<std::uint8_t> pool = read_example_pool(poolPath);
+		ASSERT_FALSE(pool.empty());
+
+		std::vector<std::uint32_t> offsets;
+		ASSERT_TRUE(find_object_offsets(pool.data(), static_cast<std::uint32_t>(pool.size()), offsets));
+
+		VirtualTerminalWorkingSetBase sequentialWorkingSet;
+		sequentialWorkingSet.set_object_pool_parsing_threads(1);
+		EXPECT_EQ(1, sequentialWorkingSet.get_object_pool_parsing_threads());
+		ASSERT_TRUE(sequentialWorkingSet.parse_iop_into_objects(pool.data(), static_cast<std::uint32_t>(pool.size())));
+		EXPECT_EQ(1, sequentialWorkingSet.get_last_object_pool_parsing_threads());
+
+		for (std::size_t numberOfThreads = 2; numberOfThreads <= 4; numberOfThreads++)
+		{
+			VirtualTerminalWorkingSetBase parallelWorkingSet;
+			parallelWorkingSet.set_object_pool_parsing_threads(numberOfThreads);
+			ASSERT_TRUE(parallelWorkingSet.parse_iop_into_objects(pool.data(), static_cast<std::uint32_t>(pool.size())));
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+			// Pools are only split into ranges of at least MIN_OBJECTS_PER_PARSING_THREAD objects
+			const std::size_t expectedThreads = std::max<std::size_t>(1, std::min(numberOfThreads, offsets.size() / VirtualTerminalWorkingSetBase::MIN_OBJECTS_PER_PARSING_THREAD));
+			EXPECT_EQ(numberOfThreads, parallelWorkingSet.get_object_pool_parsing_threads());
+			EXPECT_EQ(expectedThreads, parallelWorkingSet.get_last_object_pool_parsing_threads());
+			maxThreadsUsed = std::max(maxThreadsUsed, parallelWorkingSet.get_last_object_pool_parsing_threads());
+#else
+			EXPECT_EQ(1, parallelWorkingSet.get_object_pool_parsing_threads());
+			EXPECT_EQ(1, parallelWorkingSet.get_last_object_pool_parsing_threads());
+#endif
+			expect_same_object_trees(sequentialWorkingSet, parallelWorkingSet);
+			EXPECT_EQ(sequentialWorkingSet.get_working_set_object()->get_id(), parallelWorkingSet.get_working_set_object()->get_id());
+		}
+	}
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+	// At least one of the pools is big enough that the objects really were constructed on several threads
+	EXPECT_GT(maxThreadsUsed, 1);
+#endif
+
+	// Choosing the number of threads automatically always uses at least one
+	VirtualTerminalWorkingSetBase workingSet;
+	EXPECT_EQ(0, workingSet.get_last_object_pool_parsing_threads());
+	EXPECT_GE(workingSet.get_object_pool_parsing_threads(), 1);
+	EXPECT_LE(workingSet.get_object_pool_parsing_threads(), VirtualTerminalWorkingSetBase::DEFAULT_MAX_PARSING_THREADS);
+}
+
+TEST(VIRTUAL_TERMINAL_WORKING_SET_TESTS, ParallelParsingReportsTheSameFaultingObject)
+{
+	std::vector<std::uint8_t> pool = read_example_pool("seeder_example/BasePool.iop");
+	ASSERT_FALSE(pool.empty());
+
+	std::vector<std::uint32_t> offsets;
+	ASSERT_TRUE(find_object_offsets(pool.data(), static_cast<std::uint32_t>(pool.size()), offsets));
+
+	// Append a second working set object, which is only rejected once the objects are added in order
+	for (std::size_t i = 0; i < offsets.size(); i++)
+	{
+		if (static_cast<std::uint8_t>(VirtualTerminalObjectType::WorkingSet) == pool[offsets[i] + 2])
+		{
+			std::uint32_t end = ((i + 1) < offsets.size()) ? offsets[i + 1] : static_cast<std::uint32_t>(pool.size());
+			std::vector<std::uint8_t> secondWorkingSet(pool.begin() + offsets[i], pool.begin() + end);
+			secondWorkingSet[0] = 0xFE;
+			secondWorkingSet[1] = 0xFE;
+			pool.insert(pool.end(), secondWorkingSet.begin(), secondWorkingSet.end());
+			break;
+		}
+	}
+
+	for (std::size_t numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads *= 2)
+	{
+		VirtualTerminalWorkingSetBase workingSet;
+		workingSet.set_object_pool_parsing_threads(numberOfThreads);
+		EXPECT_FALSE(workingSet.parse_iop_into_objects(pool.data(), static_cast<std::uint32_t>(pool.size())));
+		EXPECT_EQ(0xFEFE, workingSet.get_object_pool_faulting_object_id());
+	}
+}
@@ -12,39 +12,67 @@
 #include "isobus/utility/thread_synchronization.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
-#include <queue>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace isobus
 {
 	using EventCallbackHandle = std::size_t;
 
 	/// @brief A dispatcher that notifies listeners when an event is invoked.
+	/// @details The listeners are stored in an immutable snapshot that is swapped out as a whole when
+	/// listeners are added or removed. Invoking an event registers with the current epoch and loads the current
+	/// snapshot with atomic operations only, so it never takes a lock and is safe to do from any thread, also from
+	/// within a listener. Changes made while an event is being invoked take effect from the next invocation on.
+	///
+	/// Replaced snapshots are retired with the epoch they were replaced in. A change moves on to the other epoch once
+	/// no invocation is registered with it anymore, after which the snapshots retired two epochs ago can't be seen by
+	/// any invocation and are freed. Old snapshots are therefore freed by a later change once the invocations that were
+	/// running when they were replaced have returned, even if other invocations keep overlapping.
 	template<typename... E>
 	class EventDispatcher
 	{
 	public:
 		using Callback = std::function<void(const E &...)>;
 
+		/// @brief Default constructor
+		EventDispatcher() = default;
+
+		/// @brief Deleted copy constructor, the snapshots are owned by this dispatcher
+		EventDispatcher(const EventDispatcher &) = delete;
+
+		/// @brief Deleted copy assignment operator, the snapshots are owned by this dispatcher
+		/// @returns A reference to this dispatcher
+		EventDispatcher &operator=(const EventDispatcher &) = delete;
+
+		/// @brief Destructor, frees the current and all retired snapshots
+		~EventDispatcher()
+		{
+			delete publishedListeners.load();
+		}
+
 		/// @brief Register a callback to be invoked when the event is invoked.
 		/// @param callback The callback to register.
 		/// @return A unique identifier for the callback, which can be used to remove the listener.
 		EventCallbackHandle add_listener(const Callback &callback)
 		{
+			LOCK_GUARD(Mutex, callbacksMutex);
 			EventCallbackHandle id = nextId;
 			nextId += 1;
 
-			LOCK_GUARD(Mutex, callbacksMutex);
-			if (isExecuting)
+			const ListenerList *currentListeners = publishedListeners.load();
+			std::unique_ptr<ListenerList> newListeners(new ListenerList());
+			if (nullptr != currentListeners)
 			{
-				modifications.push([this, id, callback]() { callbacks[id] = callback; });
-			}
-			else
-			{
-				callbacks[id] = callback;
+				newListeners->reserve(currentListeners->size() + 1);
+				*newListeners = *currentListeners;
 			}
+			newListeners->emplace_back(id, callback);
+			publish(newListeners.release());
 			return id;
 		}
 
@@ -79,31 +107,36 @@ namespace isobus
 
 		/// @brief Remove a callback from the list of listeners.
 		/// @param id The unique identifier of the callback to remove.
-		void remove_listener(EventCallbackHandle id) noexcept
+		void remove_listener(EventCallbackHandle id)
 		{
 			LOCK_GUARD(Mutex, callbacksMutex);
-			if (isExecuting)
-			{
-				modifications.push([this, id]() { callbacks.erase(id); });
-			}
-			else
+			const ListenerList *currentListeners = publishedListeners.load();
+			if (nullptr != currentListeners)
 			{
-				callbacks.erase(id);
+				auto result = std::find_if(currentListeners->begin(), currentListeners->end(), [id](const Listener &listener) {
+					return listener.first == id;
+				});
+
+				if (result != currentListeners->end())
+				{
+					std::unique_ptr<ListenerList> newListeners;
+					if (currentListeners->size() > 1)
+					{
+						newListeners.reset(new ListenerList());
+						newListeners->reserve(currentListeners->size() - 1);
+						newListeners->insert(newListeners->end(), currentListeners->begin(), result);
+						newListeners->insert(newListeners->end(), result + 1, currentListeners->end());
+					}
+					publish(newListeners.release());
+				}
 			}
 		}
 
 		/// @brief Remove all listeners from the event.
-		void clear_listeners() noexcept
+		void clear_listeners()
 		{
 			LOCK_GUARD(Mutex, callbacksMutex);
-			if (isExecuting)
-			{
-				modifications.push([this]() { callbacks.clear(); });
-			}
-			else
-			{
-				callbacks.clear();
-			}
+			publish(nullptr);
 		}
 
 		/// @brief Get the number of listeners registered to this event.
@@ -111,7 +144,8 @@ namespace isobus
 		std::size_t get_listener_count()
 		{
 			LOCK_GUARD(Mutex, callbacksMutex);
-			return callbacks.size();
+			const ListenerList *currentListeners = publishedListeners.load();
+			return (nullptr != currentListeners) ? currentListeners->size() : 0;
 		}
 
 		/// @brief Call and event with context that is forwarded to all listeners.
@@ -127,37 +161,48 @@ namespace isobus
 		/// @return True if the event was successfully invoked, false otherwise.
 		void call(const E &...args)
 		{
-			{
-				// Set flag to indicate we will be reading the list of callbacks, and
-				// prevent other threads from modifying the list directly during this time
-				LOCK_GUARD(Mutex, callbacksMutex);
-				isExecuting = true;
-			}
-
-			// Execute the callbacks
-			for (const auto &callback : callbacks)
-			{
-				callback.second(args...);
-			}
+			// Register before loading the snapshot, so that it isn't freed while we're using it
+			const std::uint_fast8_t epoch = currentEpoch.load();
+			activeCalls[epoch]++;
+			const ListenerList *listeners = publishedListeners.load();
 
+			if (nullptr != listeners)
 			{
-				LOCK_GUARD(Mutex, callbacksMutex);
-				isExecuting = false;
-
-				// Apply pending modifications to the callbacks list
-				while (!modifications.empty())
+				for (const auto &listener : *listeners)
 				{
-					modifications.front()();
-					modifications.pop();
+					listener.second(args...);
 				}
 			}
+			activeCalls[epoch]--;
 		}
 
 	private:
-		std::unordered_map<EventCallbackHandle, Callback> callbacks; ///< The list of callbacks
-		bool isExecuting = false; ///< Whether the dispatcher is currently executing an event
-		std::queue<std::function<void()>> modifications; ///< The modifications to the callbacks list
-		Mutex callbacksMutex; ///< The mutex to protect the object from (unwanted) concurrent access
+		using Listener = std::pair<EventCallbackHandle, Callback>; ///< A callback and its unique identifier
+		using ListenerList = std::vector<Listener>; ///< A snapshot of all listeners, in the order they were added
+
+		/// @brief Makes a new snapshot of the listeners visible to calls, and frees the old snapshots no call can see anymore
+		/// @details Must be called with the mutex held.
+		/// @param newListeners The new snapshot, or nullptr if there are no listeners
+		void publish(ListenerList *newListeners)
+		{
+			const std::uint_fast8_t epoch = currentEpoch.load();
+			retiredListeners[epoch].emplace_back(publishedListeners.exchange(newListeners));
+
+			// Calls that registered with the other epoch started before it was left, so once none are left
+			// no call can see the snapshots retired in it, and new calls can register with it again.
+			const std::uint_fast8_t otherEpoch = 1 - epoch;
+			if (0 == activeCalls[otherEpoch].load())
+			{
+				retiredListeners[otherEpoch].clear();
+				currentEpoch.store(otherEpoch);
+			}
+		}
+
+		std::atomic<const ListenerList *> publishedListeners = { nullptr }; ///< The snapshot that new calls will use, owned by this dispatcher
+		std::atomic<std::uint_fast8_t> currentEpoch = { 0 }; ///< The epoch that new calls register with
+		std::atomic<std::size_t> activeCalls[2] = { { 0 }, { 0 } }; ///< The number of running calls that registered with each epoch
+		std::vector<std::unique_ptr<const ListenerList>> retiredListeners[2]; ///< The replaced snapshots of each epoch, only accessed with the mutex held
+		Mutex callbacksMutex; ///< The mutex to serialize changes to the listeners
 		EventCallbackHandle nextId = 0; // Counter for generating unique IDs
 	};
 } // namespace isobus
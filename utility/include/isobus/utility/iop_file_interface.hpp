@@ -32,6 +32,19 @@ namespace isobus
 		/// @returns A vector with an object pool in it, or an empty vector if reading failed
 		static std::vector<std::uint8_t> read_iop_file(const std::string &filename);
 
+		/// @brief Writes an object pool to an IOP file, for example a pool that was scaled for a specific VT
+		/// @param[in] filename A string filepath for the IOP file to write
+		/// @param[in] iopData The object pool to write
+		/// @returns true if the whole pool was written
+		static bool write_iop_file(const std::string &filename, const std::vector<std::uint8_t> &iopData);
+
+		/// @brief Hashes an object pool
+		/// @details This is the hash that hash_object_pool_to_version turns into a version string.
+		/// @param[in] iopData A pointer to the object pool to hash
+		/// @param[in] size The number of bytes in the object pool
+		/// @returns A hash of the object pool
+		static std::size_t hash_object_pool(const std::uint8_t *iopData, std::size_t size);
+
 		/// @brief Reads an object pool and generates a string version by hashing it
 		/// @details Credit for the hash algorithm here goes to "see" on stack overflow.
 		/// @param[in] iopData The object pool to hash and generate a version for
@@ -0,0 +1,96 @@
+//================================================================================================
+/// @file memory_mapped_file.hpp
+///
+/// @brief A file whose contents are accessed as memory, used for large binary files that
+/// should not be read or written with a system call per record.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#ifndef MEMORY_MAPPED_FILE_HPP
+#define MEMORY_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class MemoryMappedFile
+	///
+	/// @brief A file that is mapped into memory
+	/// @details On Linux and macOS the file is mapped with mmap, so the operating system pages it in and
+	/// out as needed. On other platforms the file is read into memory when it is opened, and written
+	/// back when it is closed, so the same code works everywhere.
+	//================================================================================================
+	class MemoryMappedFile
+	{
+	public:
+		/// @brief Enumerates the ways a file can be opened
+		enum class Mode
+		{
+			ReadOnly, ///< Maps an existing file for reading
+			ReadWrite ///< Creates or truncates a file for writing, starting with a size of 0
+		};
+
+		/// @brief Constructs a closed file
+		MemoryMappedFile() = default;
+
+		/// @brief Closes the file if it is open
+		~MemoryMappedFile();
+
+		/// @brief Deleted copy constructor
+		MemoryMappedFile(const MemoryMappedFile &) = delete;
+
+		/// @brief Deleted assignment operator
+		/// @returns Nothing, this function is deleted
+		MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+		/// @brief Opens and maps a file, closing any file that was open before
+		/// @param[in] filePath The path of the file
+		/// @param[in] mode Whether to read an existing file or to write a new one
+		/// @returns true if the file was opened
+		bool open(const std::string &filePath, Mode mode);
+
+		/// @brief Writes any changes to disk and closes the file
+		void close();
+
+		/// @brief Changes the size of a file that was opened for writing, keeping its contents
+		/// @details The file may be mapped at a new address afterwards, so pointers from data() become invalid.
+		/// @param[in] newSize The new size of the file in bytes
+		/// @returns true if the file was resized
+		bool resize(std::size_t newSize);
+
+		/// @brief Returns the contents of the file
+		/// @returns A pointer to the first byte of the file, or nullptr if the file is empty or not open
+		std::uint8_t *data();
+
+		/// @brief Returns the contents of the file
+		/// @returns A pointer to the first byte of the file, or nullptr if the file is empty or not open
+		const std::uint8_t *data() const;
+
+		/// @brief Returns the size of the file
+		/// @returns The size of the file in bytes
+		std::size_t size() const;
+
+		/// @brief Returns if a file is open
+		/// @returns true if a file is open
+		bool get_is_open() const;
+
+	private:
+		std::string path; ///< The path of the open file
+		Mode mode = Mode::ReadOnly; ///< The mode the file was opened with
+		std::uint8_t *mappedData = nullptr; ///< The start of the mapped contents
+		std::size_t mappedSize = 0; ///< The size of the mapped contents
+		bool isOpen = false; ///< Whether a file is open
+#if defined __linux__ || defined __APPLE__
+		int fileDescriptor = -1; ///< The descriptor of the open file
+#else
+		std::vector<std::uint8_t> buffer; ///< The contents of the file, on platforms without mmap support
+#endif
+	};
+} // namespace isobus
+
+#endif // MEMORY_MAPPED_FILE_HPP
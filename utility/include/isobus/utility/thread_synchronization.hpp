@@ -10,7 +10,9 @@
 #define THREAD_SYNCHRONIZATION_HPP
 
 #if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
-#include <queue>
+#include <deque>
+#include <limits>
+#include <utility>
 
 namespace isobus
 {
@@ -40,10 +42,20 @@ public:
 	/// @return Simply returns true, since this version of the queue is not limited in size.
 	bool push(const T &item)
 	{
-		queue.push(item);
+		queue.push_back(item);
 		return true;
 	}
 
+	/// @brief Push multiple items to the queue, in order.
+	/// @param items The items to push to the queue.
+	/// @param count The number of items to push.
+	/// @return Simply returns `count`, since this version of the queue is not limited in size.
+	std::size_t push_n(const T *items, std::size_t count)
+	{
+		queue.insert(queue.end(), items, items + count);
+		return count;
+	}
+
 	/// @brief Peek at the next item in the queue.
 	/// @param item The item to peek at in the queue.
 	/// @return True if the item was peeked at in the queue, false if the queue is empty.
@@ -67,10 +79,70 @@ public:
 			return false;
 		}
 
-		queue.pop();
+		queue.pop_front();
+		return true;
+	}
+
+	/// @brief Pop the next item from the queue, retrieving it in the same step.
+	/// @param item The item that was popped from the queue.
+	/// @return True if an item was popped from the queue, false if the queue is empty.
+	bool try_pop(T &item)
+	{
+		if (queue.empty())
+		{
+			return false;
+		}
+
+		item = std::move(queue.front());
+		queue.pop_front();
 		return true;
 	}
 
+	/// @brief Peek at multiple items at the front of the queue without removing them.
+	/// @param items The buffer to copy the items to.
+	/// @param maxItems The maximum number of items to copy.
+	/// @return The number of items that were copied.
+	std::size_t peek(T *items, std::size_t maxItems)
+	{
+		std::size_t count = 0;
+		while ((count < maxItems) && (count < queue.size()))
+		{
+			items[count] = queue[count];
+			count++;
+		}
+		return count;
+	}
+
+	/// @brief Pop multiple items from the queue.
+	/// @param count The number of items to pop.
+	/// @return The number of items that were popped.
+	std::size_t pop(std::size_t count)
+	{
+		std::size_t popped = 0;
+		while ((popped < count) && (!queue.empty()))
+		{
+			queue.pop_front();
+			popped++;
+		}
+		return popped;
+	}
+
+	/// @brief Pop multiple items from the queue, retrieving them in the same step.
+	/// @param items The buffer to move the items to.
+	/// @param maxItems The maximum number of items to pop.
+	/// @return The number of items that were popped.
+	std::size_t pop_n(T *items, std::size_t maxItems)
+	{
+		std::size_t count = 0;
+		while ((count < maxItems) && (!queue.empty()))
+		{
+			items[count] = std::move(queue.front());
+			queue.pop_front();
+			count++;
+		}
+		return count;
+	}
+
 	/// @brief Check if the queue is full.
 	/// @return Always returns false, since this version of the queue is not limited in size.
 	bool is_full() const
@@ -78,14 +150,35 @@ public:
 		return false;
 	}
 
+	/// @brief Get the number of items that can still be pushed to the queue.
+	/// @return Always returns the maximum value, since this version of the queue is not limited in size.
+	std::size_t free_space() const
+	{
+		return std::numeric_limits<std::size_t>::max();
+	}
+
+	/// @brief Get the number of items in the queue.
+	/// @return The number of items in the queue.
+	std::size_t size() const
+	{
+		return queue.size();
+	}
+
+	/// @brief Get the number of items the queue can hold.
+	/// @return Always returns the maximum value, since this version of the queue is not limited in size.
+	std::size_t get_capacity() const
+	{
+		return std::numeric_limits<std::size_t>::max();
+	}
+
 	/// @brief Clear the queue.
 	void clear()
 	{
-		queue = {};
+		queue.clear();
 	}
 
 private:
-	std::queue<T> queue; ///< The queue
+	std::deque<T> queue; ///< The queue
 };
 
 #else
@@ -93,6 +186,7 @@ private:
 #include <atomic>
 #include <cassert>
 #include <mutex>
+#include <utility>
 #include <vector>
 namespace isobus
 {
@@ -104,22 +198,25 @@ namespace isobus
 /// @param x The mutex to lock.
 #define LOCK_GUARD(type, x) const std::lock_guard<type> x##Lock(x)
 
-/// @brief A template class for a lock free queue.
+/// @brief A template class for a lock free single producer, single consumer queue.
+/// @details The capacity is rounded up to a power of two so that positions can be wrapped with a mask,
+/// and the read and write positions live on separate cache lines to avoid false sharing between the
+/// producer and consumer threads. Each side also caches the last seen position of the other side, so
+/// the shared position only has to be re-read when the queue looks full or empty.
 /// @tparam T The item type for the queue.
 template<typename T>
 class LockFreeQueue
 {
 public:
 	/// @brief Constructor for the lock free queue.
+	/// @param size The minimum number of items the queue must be able to hold, rounded up to a power of two.
 	explicit LockFreeQueue(std::size_t size) :
-	  buffer(size), capacity(size)
+	  capacity(round_up_to_power_of_two(size)),
+	  mask(capacity - 1),
+	  buffer(capacity)
 	{
-		// Validate the size of the queue, if assertion is disabled, set the size to 1.
+		// Validate the size of the queue, if assertion is disabled, the size is rounded up to 1.
 		assert(size > 0 && "The size of the queue must be greater than 0.");
-		if (size == 0)
-		{
-			size = 1;
-		}
 	}
 
 	/// @brief Push an item to the queue.
@@ -127,18 +224,31 @@ public:
 	/// @return True if the item was pushed to the queue, false if the queue is full.
 	bool push(const T &item)
 	{
-		const auto currentWriteIndex = writeIndex.load(std::memory_order_relaxed);
-		const auto nextWriteIndex = nextIndex(currentWriteIndex);
+		return 1 == push_n(&item, 1);
+	}
+
+	/// @brief Push multiple items to the queue, in order.
+	/// @param items The items to push to the queue.
+	/// @param count The number of items to push.
+	/// @return The number of items that were pushed, which is less than `count` if the queue became full.
+	std::size_t push_n(const T *items, std::size_t count)
+	{
+		const auto currentWriteIndex = producer.index.load(std::memory_order_relaxed);
+		std::size_t freeSlots = capacity - (currentWriteIndex - producer.cachedOppositeIndex);
 
-		if (nextWriteIndex == readIndex.load(std::memory_order_acquire))
+		if (freeSlots < count)
 		{
-			// The buffer is full.
-			return false;
+			producer.cachedOppositeIndex = consumer.index.load(std::memory_order_acquire);
+			freeSlots = capacity - (currentWriteIndex - producer.cachedOppositeIndex);
 		}
 
-		buffer[currentWriteIndex] = item;
-		writeIndex.store(nextWriteIndex, std::memory_order_release);
-		return true;
+		const std::size_t pushed = (count < freeSlots) ? count : freeSlots;
+		for (std::size_t i = 0; i < pushed; i++)
+		{
+			buffer[(currentWriteIndex + i) & mask] = items[i];
+		}
+		producer.index.store(currentWriteIndex + pushed, std::memory_order_release);
+		return pushed;
 	}
 
 	/// @brief Peek at the next item in the queue.
@@ -146,59 +256,155 @@ public:
 	/// @return True if the item was peeked at in the queue, false if the queue is empty.
 	bool peek(T &item)
 	{
-		const auto currentReadIndex = readIndex.load(std::memory_order_relaxed);
-		if (currentReadIndex == writeIndex.load(std::memory_order_acquire))
-		{
-			// The buffer is empty.
-			return false;
-		}
-
-		item = buffer[currentReadIndex];
-		return true;
+		return 1 == peek(&item, 1);
 	}
 
 	/// @brief Pop an item from the queue.
 	/// @return True if the item was popped from the queue, false if the queue is empty.
 	bool pop()
 	{
-		const auto currentReadIndex = readIndex.load(std::memory_order_relaxed);
-		if (currentReadIndex == writeIndex.load(std::memory_order_acquire))
+		return 1 == pop(1);
+	}
+
+	/// @brief Pop the next item from the queue, retrieving it in the same step.
+	/// @param item The item that was popped from the queue.
+	/// @return True if an item was popped from the queue, false if the queue is empty.
+	bool try_pop(T &item)
+	{
+		return 1 == pop_n(&item, 1);
+	}
+
+	/// @brief Peek at multiple items at the front of the queue without removing them.
+	/// @param items The buffer to copy the items to.
+	/// @param maxItems The maximum number of items to copy.
+	/// @return The number of items that were copied.
+	std::size_t peek(T *items, std::size_t maxItems)
+	{
+		const auto currentReadIndex = consumer.index.load(std::memory_order_relaxed);
+		const std::size_t count = readable_items(currentReadIndex, maxItems);
+
+		for (std::size_t i = 0; i < count; i++)
 		{
-			// The buffer is empty.
-			return false;
+			items[i] = buffer[(currentReadIndex + i) & mask];
 		}
+		return count;
+	}
 
-		readIndex.store(nextIndex(currentReadIndex), std::memory_order_release);
-		return true;
+	/// @brief Pop multiple items from the queue.
+	/// @param count The number of items to pop.
+	/// @return The number of items that were popped.
+	std::size_t pop(std::size_t count)
+	{
+		const auto currentReadIndex = consumer.index.load(std::memory_order_relaxed);
+		const std::size_t popped = readable_items(currentReadIndex, count);
+
+		consumer.index.store(currentReadIndex + popped, std::memory_order_release);
+		return popped;
+	}
+
+	/// @brief Pop multiple items from the queue, retrieving them in the same step.
+	/// @param items The buffer to move the items to.
+	/// @param maxItems The maximum number of items to pop.
+	/// @return The number of items that were popped.
+	std::size_t pop_n(T *items, std::size_t maxItems)
+	{
+		const auto currentReadIndex = consumer.index.load(std::memory_order_relaxed);
+		const std::size_t count = readable_items(currentReadIndex, maxItems);
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			items[i] = std::move(buffer[(currentReadIndex + i) & mask]);
+		}
+		consumer.index.store(currentReadIndex + count, std::memory_order_release);
+		return count;
 	}
 
 	/// @brief Check if the queue is full.
 	/// @return True if the queue is full, false if the queue is not full.
 	bool is_full() const
 	{
-		return nextIndex(writeIndex.load(std::memory_order_acquire)) == readIndex.load(std::memory_order_acquire);
+		return 0 == free_space();
+	}
+
+	/// @brief Get the number of items that can still be pushed to the queue.
+	/// @return The number of free slots in the queue.
+	std::size_t free_space() const
+	{
+		const auto currentWriteIndex = producer.index.load(std::memory_order_acquire);
+		const auto currentReadIndex = consumer.index.load(std::memory_order_acquire);
+		return capacity - (currentWriteIndex - currentReadIndex);
+	}
+
+	/// @brief Get the number of items in the queue.
+	/// @return The number of items in the queue.
+	std::size_t size() const
+	{
+		const auto currentReadIndex = consumer.index.load(std::memory_order_acquire);
+		const auto currentWriteIndex = producer.index.load(std::memory_order_acquire);
+		return currentWriteIndex - currentReadIndex;
+	}
+
+	/// @brief Get the number of items the queue can hold.
+	/// @return The capacity of the queue, which is always a power of two.
+	std::size_t get_capacity() const
+	{
+		return capacity;
 	}
 
 	/// @brief Clear the queue.
 	void clear()
 	{
-		// Simply move the read index to the write index.
-		readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+		// Simply move the read position to the write position.
+		consumer.index.store(producer.index.load(std::memory_order_acquire), std::memory_order_release);
 	}
 
 private:
-	std::vector<T> buffer; ///< The buffer for the circular buffer.
-	std::atomic<std::size_t> readIndex = { 0 }; ///< The read index for the circular buffer.
-	std::atomic<std::size_t> writeIndex = { 0 }; ///< The write index for the circular buffer.
-	const std::size_t capacity; ///< The capacity of the circular buffer.
+	static constexpr std::size_t CACHE_LINE_SIZE = 64; ///< The assumed size of a cache line, used to keep the positions apart
+
+	/// @brief Get the number of items the consumer can read, limited to a maximum.
+	/// @param currentReadIndex The current read position.
+	/// @param maxItems The maximum number of items wanted.
+	/// @return The number of items that can be read, at most `maxItems`.
+	std::size_t readable_items(std::size_t currentReadIndex, std::size_t maxItems)
+	{
+		std::size_t available = consumer.cachedOppositeIndex - currentReadIndex;
 
-	/// @brief Get the next index in the circular buffer.
-	/// @param current The current index.
-	/// @return The next index in the circular buffer.
-	std::size_t nextIndex(std::size_t current) const
+		// The cached position can lag behind after a clear, in which case the difference wraps around
+		if ((available < maxItems) || (available > capacity))
+		{
+			consumer.cachedOppositeIndex = producer.index.load(std::memory_order_acquire);
+			available = consumer.cachedOppositeIndex - currentReadIndex;
+		}
+		return (maxItems < available) ? maxItems : available;
+	}
+
+	/// @brief Round a number up to the next power of two.
+	/// @param value The value to round up.
+	/// @return The smallest power of two that is greater than or equal to `value`, at least 1.
+	static std::size_t round_up_to_power_of_two(std::size_t value)
 	{
-		return (current + 1) % capacity;
+		std::size_t result = 1;
+		while (result < value)
+		{
+			result <<= 1;
+		}
+		return result;
 	}
+
+	/// @brief The position owned by one side of the queue, padded so it has a cache line to itself.
+	struct PaddedPosition
+	{
+		char leadingPadding[CACHE_LINE_SIZE]; ///< Keeps the position off the cache line of the preceding members.
+		std::atomic<std::size_t> index = { 0 }; ///< The total number of items written or read, only modified by the owning side.
+		std::size_t cachedOppositeIndex = 0; ///< The owning side's last seen value of the other side's `index`.
+		char trailingPadding[CACHE_LINE_SIZE]; ///< Keeps the position off the cache line of the following members.
+	};
+
+	const std::size_t capacity; ///< The capacity of the circular buffer, a power of two.
+	const std::size_t mask; ///< The mask to wrap a position into the circular buffer.
+	std::vector<T> buffer; ///< The buffer for the circular buffer.
+	PaddedPosition producer; ///< The write position and the producer's cached read position.
+	PaddedPosition consumer; ///< The read position and the consumer's cached write position.
 };
 
 #endif
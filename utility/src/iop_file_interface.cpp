@@ -10,7 +10,6 @@
 
 #include <fstream>
 #include <iomanip>
-#include <iterator>
 #include <sstream>
 
 namespace isobus
@@ -18,40 +17,55 @@ namespace isobus
 	std::vector<std::uint8_t> IOPFileInterface::read_iop_file(const std::string &filename)
 	{
 		std::vector<std::uint8_t> retVal;
-		std::streampos fileSize;
 
-		std::ifstream file(filename, std::ios::binary);
+		std::ifstream file(filename, std::ios::binary | std::ios::ate);
 
 		if (file.is_open())
 		{
-			// Ignore newlines
-			file.unsetf(std::ios::skipws);
-
-			file.seekg(0, std::ios::end);
-			fileSize = file.tellg();
+			std::streamoff fileSize = file.tellg();
 			file.seekg(0, std::ios::beg);
 
-			retVal.reserve(fileSize);
-
-			// Read in the data
-			retVal.insert(retVal.begin(), std::istream_iterator<std::uint8_t>(file), std::istream_iterator<std::uint8_t>());
+			if (fileSize > 0)
+			{
+				// Read the whole file in one go rather than byte by byte
+				retVal.resize(static_cast<std::size_t>(fileSize));
+				file.read(reinterpret_cast<char *>(retVal.data()), fileSize);
+				retVal.resize(static_cast<std::size_t>(file.gcount()));
+			}
 		}
 		return retVal;
 	}
 
-	std::string IOPFileInterface::hash_object_pool_to_version(std::vector<std::uint8_t> &iopData)
+	bool IOPFileInterface::write_iop_file(const std::string &filename, const std::vector<std::uint8_t> &iopData)
 	{
-		std::size_t seed = iopData.size();
-		std::stringstream stream;
+		std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+
+		if (file.is_open())
+		{
+			file.write(reinterpret_cast<const char *>(iopData.data()), static_cast<std::streamsize>(iopData.size()));
+		}
+		return static_cast<bool>(file);
+	}
+
+	std::size_t IOPFileInterface::hash_object_pool(const std::uint8_t *iopData, std::size_t size)
+	{
+		std::size_t seed = size;
 
-		for (std::uint32_t x : iopData)
+		for (std::size_t i = 0; i < size; i++)
 		{
+			std::uint32_t x = iopData[i];
 			x = ((x >> 16) ^ x) * 0x45d9f3b;
 			x = ((x >> 16) ^ x) * 0x45d9f3b;
 			x = (x >> 16) ^ x;
 			seed ^= x + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 		}
-		stream << std::hex << seed;
+		return seed;
+	}
+
+	std::string IOPFileInterface::hash_object_pool_to_version(std::vector<std::uint8_t> &iopData)
+	{
+		std::stringstream stream;
+		stream << std::hex << hash_object_pool(iopData.data(), iopData.size());
 		return stream.str();
 	}
 }
@@ -0,0 +1,203 @@
+//================================================================================================
+/// @file memory_mapped_file.cpp
+///
+/// @brief A file whose contents are accessed as memory, used for large binary files that
+/// should not be read or written with a system call per record.
+/// @author The Open-Agriculture Developers
+///
+/// @copyright 2026 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/utility/memory_mapped_file.hpp"
+
+#if defined __linux__ || defined __APPLE__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace isobus
+{
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		close();
+	}
+
+#if defined __linux__ || defined __APPLE__
+	bool MemoryMappedFile::open(const std::string &filePath, Mode openMode)
+	{
+		close();
+
+		if (Mode::ReadOnly == openMode)
+		{
+			fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+		}
+		else
+		{
+			fileDescriptor = ::open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		}
+
+		if (fileDescriptor < 0)
+		{
+			return false;
+		}
+
+		struct stat fileStatus;
+		if (0 != fstat(fileDescriptor, &fileStatus))
+		{
+			::close(fileDescriptor);
+			fileDescriptor = -1;
+			return false;
+		}
+
+		mappedSize = static_cast<std::size_t>(fileStatus.st_size);
+		if (0 != mappedSize)
+		{
+			void *mapping = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+			if (MAP_FAILED == mapping)
+			{
+				::close(fileDescriptor);
+				fileDescriptor = -1;
+				mappedSize = 0;
+				return false;
+			}
+			mappedData = static_cast<std::uint8_t *>(mapping);
+		}
+		path = filePath;
+		mode = openMode;
+		isOpen = true;
+		return true;
+	}
+
+	void MemoryMappedFile::close()
+	{
+		if (nullptr != mappedData)
+		{
+			if (Mode::ReadWrite == mode)
+			{
+				msync(mappedData, mappedSize, MS_SYNC);
+			}
+			munmap(mappedData, mappedSize);
+			mappedData = nullptr;
+		}
+		if (fileDescriptor >= 0)
+		{
+			::close(fileDescriptor);
+			fileDescriptor = -1;
+		}
+		mappedSize = 0;
+		isOpen = false;
+	}
+
+	bool MemoryMappedFile::resize(std::size_t newSize)
+	{
+		if ((!isOpen) || (Mode::ReadWrite != mode))
+		{
+			return false;
+		}
+
+		if (nullptr != mappedData)
+		{
+			munmap(mappedData, mappedSize);
+			mappedData = nullptr;
+			mappedSize = 0;
+		}
+
+		if (0 != ftruncate(fileDescriptor, static_cast<off_t>(newSize)))
+		{
+			return false;
+		}
+
+		if (0 != newSize)
+		{
+			void *mapping = mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+			if (MAP_FAILED == mapping)
+			{
+				return false;
+			}
+			mappedData = static_cast<std::uint8_t *>(mapping);
+			mappedSize = newSize;
+		}
+		return true;
+	}
+#else
+	bool MemoryMappedFile::open(const std::string &filePath, Mode openMode)
+	{
+		close();
+
+		if (Mode::ReadOnly == openMode)
+		{
+			std::ifstream file(filePath, std::ios::binary);
+			if (!file.is_open())
+			{
+				return false;
+			}
+			buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+		else
+		{
+			std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+			{
+				return false;
+			}
+			buffer.clear();
+		}
+		mappedData = buffer.empty() ? nullptr : buffer.data();
+		mappedSize = buffer.size();
+		path = filePath;
+		mode = openMode;
+		isOpen = true;
+		return true;
+	}
+
+	void MemoryMappedFile::close()
+	{
+		if (isOpen && (Mode::ReadWrite == mode))
+		{
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+		}
+		buffer.clear();
+		buffer.shrink_to_fit();
+		mappedData = nullptr;
+		mappedSize = 0;
+		isOpen = false;
+	}
+
+	bool MemoryMappedFile::resize(std::size_t newSize)
+	{
+		if ((!isOpen) || (Mode::ReadWrite != mode))
+		{
+			return false;
+		}
+		buffer.resize(newSize);
+		mappedData = buffer.empty() ? nullptr : buffer.data();
+		mappedSize = buffer.size();
+		return true;
+	}
+#endif
+
+	std::uint8_t *MemoryMappedFile::data()
+	{
+		return mappedData;
+	}
+
+	const std::uint8_t *MemoryMappedFile::data() const
+	{
+		return mappedData;
+	}
+
+	std::size_t MemoryMappedFile::size() const
+	{
+		return mappedSize;
+	}
+
+	bool MemoryMappedFile::get_is_open() const
+	{
+		return isOpen;
+	}
+} // namespace isobus